@@ -0,0 +1,304 @@
+/*
+  ZipInflate.cpp - streaming DEFLATE decoder for ZIP entries
+
+  Copyright (C) 2021  Stephan Hadinger
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ZipInflate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/********************************************************************
+** Static tables from RFC 1951
+********************************************************************/
+static const uint16_t inflate_lens[29] = {  // size base for length codes 257..285
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t inflate_lext[29] = {   // extra bits for length codes 257..285
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t inflate_dists[30] = { // offset base for distance codes 0..29
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+  8193, 12289, 16385, 24577 };
+static const uint8_t inflate_dext[30] = {   // extra bits for distance codes 0..29
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t inflate_order[19] = {  // permutation of code length codes
+  16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+/********************************************************************
+** Decoder
+********************************************************************/
+ZipInflate::ZipInflate(input_cb input, void * ctx, uint32_t uncompressed_len) :
+  _input(input), _ctx(ctx), _len(uncompressed_len), _window(nullptr), _window_mask(0)
+{
+  // back-references never reach further than what was already decoded
+  uint32_t window_size = 1;
+  while ((window_size < _len) && (window_size < 32768)) { window_size <<= 1; }
+  _window = (uint8_t*) malloc(window_size);
+  _window_mask = window_size - 1;
+  _lencode.count = _lencnt;
+  _lencode.symbol = _lensym;
+  _distcode.count = _distcnt;
+  _distcode.symbol = _distsym;
+  reset();
+}
+
+ZipInflate::~ZipInflate() {
+  free(_window);
+}
+
+void ZipInflate::reset(void) {
+  _out = 0;
+  _in_pos = 0;
+  _in_len = 0;
+  _bitbuf = 0;
+  _bitcnt = 0;
+  _last = false;
+  _stored_left = 0;
+  _copy_len = 0;
+  _copy_dist = 0;
+  _state = (_window != nullptr) ? HEADER : ERROR;
+}
+
+// return `need` bits from the input stream, or -1 if input is exhausted
+int32_t ZipInflate::bits(uint32_t need) {
+  uint32_t val = _bitbuf;
+  while (_bitcnt < need) {
+    if (_in_pos >= _in_len) {
+      _in_len = _input(_ctx, _in_buf, sizeof(_in_buf));
+      _in_pos = 0;
+      if (0 == _in_len) { return -1; }
+    }
+    val |= (uint32_t)_in_buf[_in_pos++] << _bitcnt;
+    _bitcnt += 8;
+  }
+  _bitbuf = (uint32_t)(val >> need);
+  _bitcnt -= need;
+  return (int32_t)(val & ((1UL << need) - 1));
+}
+
+// decode a code using the canonical Huffman table, returns symbol or -1
+int32_t ZipInflate::decode(const Huffman * h) {
+  int32_t code = 0;           // bits being decoded
+  int32_t first = 0;          // first code of length len
+  int32_t index = 0;          // index of first code of length len in symbol table
+  for (uint32_t len = 1; len <= MAXBITS; len++) {
+    int32_t bit = bits(1);
+    if (bit < 0) { return -1; }
+    code |= bit;
+    int32_t count = h->count[len];
+    if (code - count < first) {
+      return h->symbol[index + (code - first)];
+    }
+    index += count;
+    first += count;
+    first <<= 1;
+    code <<= 1;
+  }
+  return -1;                  // ran out of codes
+}
+
+// build canonical Huffman table, returns 0 if complete, >0 if incomplete, <0 if over-subscribed
+int32_t ZipInflate::construct(Huffman * h, const int16_t * length, uint32_t n) {
+  int16_t offs[MAXBITS + 1];
+  for (uint32_t len = 0; len <= MAXBITS; len++) { h->count[len] = 0; }
+  for (uint32_t symbol = 0; symbol < n; symbol++) { h->count[length[symbol]]++; }
+  if (h->count[0] == (int16_t)n) { return 0; }   // no codes, complete but decode() will fail
+
+  int32_t left = 1;           // one possible code of zero length
+  for (uint32_t len = 1; len <= MAXBITS; len++) {
+    left <<= 1;
+    left -= h->count[len];
+    if (left < 0) { return left; }
+  }
+  offs[1] = 0;
+  for (uint32_t len = 1; len < MAXBITS; len++) {
+    offs[len + 1] = offs[len] + h->count[len];
+  }
+  for (uint32_t symbol = 0; symbol < n; symbol++) {
+    if (length[symbol] != 0) {
+      h->symbol[offs[length[symbol]]++] = symbol;
+    }
+  }
+  return left;
+}
+
+bool ZipInflate::storedHeader(void) {
+  _bitbuf = 0;                // discard leftover bits to go to byte boundary
+  _bitcnt = 0;
+  int32_t len = bits(16);
+  int32_t nlen = bits(16);
+  if ((len < 0) || (nlen < 0) || (len != (~nlen & 0xFFFF))) { return false; }
+  _stored_left = len;
+  _state = STORED;
+  return true;
+}
+
+bool ZipInflate::fixedTables(void) {
+  int16_t lengths[288];
+  uint32_t symbol = 0;
+  for (; symbol < 144; symbol++) { lengths[symbol] = 8; }
+  for (; symbol < 256; symbol++) { lengths[symbol] = 9; }
+  for (; symbol < 280; symbol++) { lengths[symbol] = 7; }
+  for (; symbol < 288; symbol++) { lengths[symbol] = 8; }
+  construct(&_lencode, lengths, 288);
+  for (symbol = 0; symbol < 30; symbol++) { lengths[symbol] = 5; }
+  construct(&_distcode, lengths, 30);
+  _state = CODES;
+  return true;
+}
+
+bool ZipInflate::dynamicTables(void) {
+  int16_t lengths[286 + 30];
+  int32_t nlen = bits(5);
+  int32_t ndist = bits(5);
+  int32_t ncode = bits(4);
+  if ((nlen < 0) || (ndist < 0) || (ncode < 0)) { return false; }
+  nlen += 257;
+  ndist += 1;
+  ncode += 4;
+  if ((nlen > 286) || (ndist > 30)) { return false; }
+
+  // code length code lengths, temporarily use the lencode table
+  int32_t index = 0;
+  for (; index < ncode; index++) {
+    int32_t len = bits(3);
+    if (len < 0) { return false; }
+    lengths[inflate_order[index]] = len;
+  }
+  for (; index < 19; index++) { lengths[inflate_order[index]] = 0; }
+  if (construct(&_lencode, lengths, 19) != 0) { return false; }
+
+  // literal/length and distance code lengths
+  index = 0;
+  while (index < nlen + ndist) {
+    int32_t symbol = decode(&_lencode);
+    if (symbol < 0) { return false; }
+    if (symbol < 16) {
+      lengths[index++] = symbol;
+    } else {
+      int16_t len = 0;
+      int32_t repeat;
+      if (16 == symbol) {
+        if (0 == index) { return false; }
+        len = lengths[index - 1];
+        repeat = bits(2) + 3;
+      } else if (17 == symbol) {
+        repeat = bits(3) + 3;
+      } else {
+        repeat = bits(7) + 11;
+      }
+      if ((repeat < 3) || (index + repeat > nlen + ndist)) { return false; }
+      while (repeat--) { lengths[index++] = len; }
+    }
+  }
+  if (0 == lengths[256]) { return false; }   // no end-of-block code
+
+  // incomplete codes are only allowed with a single length 1 code
+  int32_t err = construct(&_lencode, lengths, nlen);
+  if ((err < 0) || ((err > 0) && (nlen - _lencode.count[0] != 1))) { return false; }
+  err = construct(&_distcode, lengths + nlen, ndist);
+  if ((err < 0) || ((err > 0) && (ndist - _distcode.count[0] != 1))) { return false; }
+  _state = CODES;
+  return true;
+}
+
+bool ZipInflate::blockHeader(void) {
+  int32_t last = bits(1);
+  int32_t type = bits(2);
+  if ((last < 0) || (type < 0)) { return false; }
+  _last = last;
+  switch (type) {
+    case 0:   return storedHeader();
+    case 1:   return fixedTables();
+    case 2:   return dynamicTables();
+    default:  return false;
+  }
+}
+
+// decode next literal or back-reference, returns literal, 256 for end of block,
+// 257 when a back-reference was stored in `_copy_len`/`_copy_dist`, or -1 on error
+int32_t ZipInflate::nextSymbol(void) {
+  int32_t symbol = decode(&_lencode);
+  if ((symbol < 0) || (symbol <= 256)) { return symbol; }
+
+  symbol -= 257;
+  if (symbol >= 29) { return -1; }
+  int32_t len = bits(inflate_lext[symbol]);
+  int32_t dist_sym = decode(&_distcode);
+  if ((len < 0) || (dist_sym < 0) || (dist_sym >= 30)) { return -1; }
+  int32_t dist = bits(inflate_dext[dist_sym]);
+  if (dist < 0) { return -1; }
+  _copy_len = inflate_lens[symbol] + len;
+  _copy_dist = inflate_dists[dist_sym] + dist;
+  if ((_copy_dist > _out) || (_copy_dist > _window_mask + 1)) { return -1; }   // distance too far back
+  return 257;
+}
+
+void ZipInflate::output(uint8_t b) {
+  _window[_out & _window_mask] = b;
+  _out++;
+}
+
+int32_t ZipInflate::read(uint8_t * buf, size_t size) {
+  if (ERROR == _state) { return -1; }
+  size_t done = 0;
+  while ((done < size) && (_out < _len)) {
+    if (_copy_len) {
+      uint8_t b = _window[(_out - _copy_dist) & _window_mask];
+      output(b);
+      buf[done++] = b;
+      _copy_len--;
+      continue;
+    }
+    switch (_state) {
+      case HEADER:
+        if (!blockHeader()) { _state = ERROR; return -1; }
+        break;
+      case STORED:
+        if (_stored_left) {
+          int32_t b = bits(8);
+          if (b < 0) { _state = ERROR; return -1; }
+          output(b);
+          buf[done++] = b;
+          _stored_left--;
+        } else {
+          _state = _last ? DONE : HEADER;
+        }
+        break;
+      case CODES:
+        {
+          int32_t symbol = nextSymbol();
+          if (symbol < 0) { _state = ERROR; return -1; }
+          if (symbol < 256) {
+            output(symbol);
+            buf[done++] = symbol;
+          } else if (256 == symbol) {
+            _state = _last ? DONE : HEADER;
+          }
+        }
+        break;
+      case DONE:
+        _state = ERROR;       // stream ended before the expected uncompressed size
+        return -1;
+      default:
+        return -1;
+    }
+  }
+  return done;
+}
@@ -0,0 +1,93 @@
+/*
+  ZipInflate.h - streaming DEFLATE decoder for ZIP entries
+
+  Copyright (C) 2021  Stephan Hadinger
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __ZIP_INFLATE__
+#define __ZIP_INFLATE__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/********************************************************************
+** Streaming inflate (RFC 1951), derived from Mark Adler's puff.c
+**
+** Output is produced on demand by `read()`, so only a window of
+** min(32KB, uncompressed size) is needed for back-references.
+** Compressed input is pulled through a callback in small chunks.
+********************************************************************/
+
+class ZipInflate {
+public:
+  // read at most `len` bytes of compressed input, returns bytes read
+  typedef size_t (*input_cb)(void * ctx, uint8_t * buf, size_t len);
+
+  ZipInflate(input_cb input, void * ctx, uint32_t uncompressed_len);
+  ~ZipInflate();
+
+  void reset(void);                             // restart decoding from start, input must be rewound by caller
+  int32_t read(uint8_t * buf, size_t size);     // returns bytes decoded, or -1 on error
+  bool error(void) const { return _state == ERROR; }
+
+protected:
+  static const uint32_t MAXBITS = 15;
+  struct Huffman {
+    int16_t * count;          // number of symbols of each length
+    int16_t * symbol;         // canonically ordered symbols
+  };
+
+  enum State { HEADER, STORED, CODES, DONE, ERROR };
+
+  int32_t bits(uint32_t need);
+  int32_t decode(const Huffman * h);
+  static int32_t construct(Huffman * h, const int16_t * length, uint32_t n);
+  bool blockHeader(void);
+  bool storedHeader(void);
+  bool fixedTables(void);
+  bool dynamicTables(void);
+  int32_t nextSymbol(void);
+  inline void output(uint8_t b);
+
+  input_cb  _input;
+  void *    _ctx;
+  uint32_t  _len;             // uncompressed length
+  uint32_t  _out;             // bytes decoded so far
+
+  uint8_t   _in_buf[64];
+  uint8_t   _in_pos;
+  uint8_t   _in_len;
+  uint32_t  _bitbuf;
+  uint32_t  _bitcnt;
+
+  State     _state;
+  bool      _last;            // last block
+  uint32_t  _stored_left;     // bytes left in stored block
+  uint32_t  _copy_len;        // pending back-reference
+  uint32_t  _copy_dist;
+
+  uint8_t * _window;          // ring buffer of last decoded bytes
+  uint32_t  _window_mask;
+
+  int16_t   _lencnt[MAXBITS + 1];
+  int16_t   _lensym[288];
+  int16_t   _distcnt[MAXBITS + 1];
+  int16_t   _distsym[30];
+  Huffman   _lencode;
+  Huffman   _distcode;
+};
+
+#endif // __ZIP_INFLATE__
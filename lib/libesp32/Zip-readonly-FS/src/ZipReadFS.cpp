@@ -1,5 +1,5 @@
 /*
-  ZipReadFS.cpp - FS overlay to read uncompressed ZIP files
+  ZipReadFS.cpp - FS overlay to read stored or deflated ZIP files
 
   Copyright (C) 2021  Stephan Hadinger
 
@@ -20,6 +20,7 @@
 #ifdef ESP32
 
 #include "ZipReadFS.h"
+#include "ZipInflate.h"
 
 extern FS *zip_ufsp;
 
@@ -79,42 +80,64 @@ struct ZipHeader {
   uint16_t      extra_field_size;
 };
 
+const uint16_t ZIP_STORED = 0;
+const uint16_t ZIP_DEFLATED = 8;
+const uint32_t ZIP_CACHE_SIZE = 4;        // number of archives with cached central directory
+
+static inline uint16_t zip_get16(const uint8_t * p) { return p[0] | (p[1] << 8); }
+static inline uint32_t zip_get32(const uint8_t * p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24); }
+
+// FNV-1a hash of entry name
+static uint32_t zip_name_hash(const char * name) {
+  uint32_t hash = 0x811C9DC5;
+  while (*name) {
+    hash = (hash ^ (uint8_t)*name++) * 0x01000193;
+  }
+  return hash;
+}
+
 class ZipEntry {
 public:
   ZipEntry() :
-    file_name(), file_start(0), file_len(0), last_mod(0)
+    file_name(), file_start(0), file_len(0), file_len_compressed(0), name_hash(0), compression(ZIP_STORED), last_mod(0)
     {};
-  // ZipEntry(const char * fname, uint32_t start, uint32_t len) :
-  //   file_name(fname), file_start(start), file_len(len)
-  //   {};
 
   String file_name;       // name of the file as used by Berry, with all directories removed
   uint32_t file_start;    // offset in bytes where this file starts in the archive
   uint32_t file_len;      // length in bytes of the file
+  uint32_t file_len_compressed;   // length in bytes of the file in the archive
+  uint32_t name_hash;
+  uint16_t compression;   // ZIP_STORED or ZIP_DEFLATED
   time_t   last_mod;
 };
 
 class ZipArchive {
 public:
-  ZipArchive(File * _f) :
-    f(_f), entries()
+  ZipArchive(void) :
+    path(), size(0), last_write(0), last_used(0), entries(), index(nullptr), index_mask(0)
     {};
   ~ZipArchive(void) {
-    f->close();      // TODO
+    clear();
   }
 
-  bool parse(void);
+  void clear(void);
+  bool parse(File & f);
+  ZipEntry * find(const char * name);
 
-  File * f;
+  String path;            // path of the archive in the underlying FS
+  size_t size;            // size and timestamp used to invalidate the cache
+  time_t last_write;
+  uint32_t last_used;     // LRU counter
   LList<ZipEntry> entries;
-};
-
-class ZipEntryFileImpl : public FileImpl {
-public:
-  ZipEntryFileImpl(File * f) : zip(f) { }
 
 protected:
-  ZipArchive zip;
+  bool parseCentralDirectory(File & f);
+  bool parseLocalHeaders(File & f);
+  ZipEntry * addEntry(char * fname, uint32_t start, uint32_t len, uint32_t len_compressed, uint16_t compression, uint32_t dostime);
+  void buildIndex(void);
+
+  ZipEntry ** index;      // open addressing hash table of entries
+  uint32_t index_mask;
 };
 
 /********************************************************************
@@ -294,28 +317,214 @@ protected:
   time_t    _last_mod;
 };
 
+/********************************************************************
+** Subfile implementation for deflated entries
+** 
+** Decompresses on the fly, seeking backwards restarts decompression
+********************************************************************/
+
+class ZipInflateItemImpl;
+typedef std::shared_ptr<ZipInflateItemImpl> ZipInflateItemImplPtr;
+
+class ZipInflateItemImpl : public ZipItemImpl {
+public:
+
+  ZipInflateItemImpl(File f, uint32_t first_byte, uint32_t len_compressed, uint32_t len, time_t last_mod) :
+    ZipItemImpl(f, first_byte, len, last_mod),
+    _len_compressed(len_compressed),
+    _in_seek(0),
+    _inflate(ZipInflateItemImpl::input, this, len)
+    {}
+
+  virtual ~ZipInflateItemImpl() {}
+
+  size_t read(uint8_t* buf, size_t size) {
+    if (_seek >= _len) { return 0; }
+    if (size + _seek > _len) {
+      size = _len - _seek;
+    }
+    int32_t ret = _inflate.read(buf, size);
+    if (ret < 0) {
+      AddLog(LOG_LEVEL_INFO, "ZIP: inflate error at %i", _seek);
+      return 0;
+    }
+    _seek += ret;
+    return ret;
+  }
+
+  bool seek(uint32_t pos, SeekMode mode) {
+    if (SeekCur == mode) {
+      pos += _seek;
+    } else if (SeekEnd == mode) {
+      pos = _len;
+    }
+    if (pos > _len) { return false; }
+    if (pos < _seek) {            // restart decompression from the beginning
+      _inflate.reset();
+      _in_seek = 0;
+      _seek = 0;
+    }
+    uint8_t skip_buf[32];
+    while (_seek < pos) {
+      size_t chunk = pos - _seek;
+      if (chunk > sizeof(skip_buf)) { chunk = sizeof(skip_buf); }
+      if (read(skip_buf, chunk) == 0) { return false; }
+    }
+    return true;
+  }
+
+protected:
+  // feed compressed bytes to the decoder
+  static size_t input(void * ctx, uint8_t * buf, size_t len) {
+    ZipInflateItemImpl * item = (ZipInflateItemImpl*) ctx;
+    if (item->_in_seek >= item->_len_compressed) { return 0; }
+    if (len > item->_len_compressed - item->_in_seek) {
+      len = item->_len_compressed - item->_in_seek;
+    }
+    if (!item->_f.seek(item->_first_byte + item->_in_seek, SeekSet)) { return 0; }
+    size_t ret = item->_f.read(buf, len);
+    item->_in_seek += ret;
+    return ret;
+  }
+
+  uint32_t    _len_compressed;
+  uint32_t    _in_seek;
+  ZipInflate  _inflate;
+};
+
 /********************************************************************
 ** Zip file parser
 ** Implementation
 ********************************************************************/
 
+void ZipArchive::clear(void) {
+  entries.reset();
+  free(index);
+  index = nullptr;
+  index_mask = 0;
+}
+
 // parse the Zip archive to extract all entries
 // returns true if ok
-bool ZipArchive::parse(void) {
+bool ZipArchive::parse(File & f) {
+  clear();
+  bool ok = parseCentralDirectory(f);
+  if (!ok) {
+    clear();
+    ok = parseLocalHeaders(f);    // no central directory, walk local headers
+  }
+  if (ok) {
+    buildIndex();
+  }
+  return ok;
+}
+
+// add entry if compression is supported
+ZipEntry * ZipArchive::addEntry(char * fname, uint32_t start, uint32_t len, uint32_t len_compressed, uint16_t compression, uint32_t dostime) {
+  if ((compression != ZIP_STORED) && (compression != ZIP_DEFLATED)) {
+    AddLog(LOG_LEVEL_INFO, "ZIP: compression unsupported 0x%04X for '%s'", compression, fname);
+    return nullptr;
+  }
+  if ((ZIP_STORED == compression) && (len_compressed != len)) {
+    AddLog(LOG_LEVEL_INFO, "ZIP: compressed size differs from uncompressed %i - %i", len_compressed, len);
+    return nullptr;
+  }
+
+  // Remove any directory names, and keep only what's after the last `/``
+  char * fname_suffix;
+  char * saveptr;
+  fname_suffix = strtok_r(fname, "#", &saveptr);
+  char * res = fname_suffix;
+  while (res) {
+    res = strtok_r(nullptr, "#", &saveptr);
+    if (res) { fname_suffix = res; }
+  }
+  if (fname_suffix == nullptr) { return nullptr; }
+
+  ZipEntry & entry = entries.addToLast();
+  entry.file_name = fname_suffix;
+  entry.name_hash = zip_name_hash(fname_suffix);
+  entry.file_start = start;
+  entry.file_len = len;
+  entry.file_len_compressed = len_compressed;
+  entry.compression = compression;
+  entry.last_mod = dos2unixtime(dostime);
+  // AddLog(LOG_LEVEL_DEBUG_MORE, "ZIP: found file '%s' (%i bytes - offset %i)", fname_suffix, len, start);
+  return &entry;
+}
+
+// read the End Of Central Directory record and all central directory entries
+bool ZipArchive::parseCentralDirectory(File & f) {
+  const size_t eocd_size = 22;
+  uint8_t buf[46];            // large enough for a central directory header
+  size_t file_size = f.size();
+  if (file_size < eocd_size) { return false; }
+
+  // search EOCD backwards, it is followed by an optional comment
+  int32_t eocd = -1;
+  uint8_t tail[64];
+  size_t tail_len = (file_size < sizeof(tail)) ? file_size : sizeof(tail);
+  if (!f.seek(file_size - tail_len, SeekSet) || (f.read(tail, tail_len) != tail_len)) { return false; }
+  for (int32_t i = tail_len - eocd_size; i >= 0; i--) {
+    if (zip_get32(&tail[i]) == 0x06054B50) {
+      eocd = i;
+      break;
+    }
+  }
+  if (eocd < 0) { return false; }
+
+  uint32_t count = zip_get16(&tail[eocd + 10]);
+  uint32_t offset = zip_get32(&tail[eocd + 16]);
+  for (uint32_t i = 0; i < count; i++) {
+    if (!f.seek(offset, SeekSet) || (f.read(buf, 46) != 46)) { return false; }
+    if (zip_get32(&buf[0]) != 0x02014B50) {
+      AddLog(LOG_LEVEL_INFO, "ZIP: invalid central directory signature");
+      return false;
+    }
+    uint16_t flags = zip_get16(&buf[8]);
+    uint16_t compression = zip_get16(&buf[10]);
+    uint32_t dostime = zip_get32(&buf[12]);
+    uint32_t size_compressed = zip_get32(&buf[20]);
+    uint32_t size_uncompressed = zip_get32(&buf[24]);
+    uint16_t filename_size = zip_get16(&buf[28]);
+    uint32_t local_offset = zip_get32(&buf[42]);
+    uint32_t next = offset + 46 + filename_size + zip_get16(&buf[30]) + zip_get16(&buf[32]);
+
+    if (flags & 0x0001) {
+      AddLog(LOG_LEVEL_INFO, "ZIP: encrypted files unsupported");
+      return false;
+    }
+    if (filename_size > 64) {
+      AddLog(LOG_LEVEL_INFO, "ZIP: entry filename size too long %i", filename_size);
+      return false;
+    }
+    char fname[filename_size + 1];
+    if (f.read((uint8_t*) &fname[0], filename_size) != filename_size) { return false; }
+    fname[filename_size] = 0;  // add NULL termination
+
+    // local header may have a different extra field size
+    if (!f.seek(local_offset + 26, SeekSet) || (f.read(buf, 4) != 4)) { return false; }
+    uint32_t start = local_offset + 30 + zip_get16(&buf[0]) + zip_get16(&buf[2]);
+    if (start + size_compressed > file_size) { return false; }
+
+    addEntry(fname, start, size_uncompressed, size_compressed, compression, dostime);
+    offset = next;
+  }
+  return true;
+}
+
+// walk the local headers, only used if the central directory is missing
+bool ZipArchive::parseLocalHeaders(File & f) {
   ZipHeader header;
-  f->seek(0);    // start of file
   int32_t offset = 0;
   const size_t zip_header_size = sizeof(header) - sizeof(header.padding);
 
   while (1) {
-    f->seek(offset);
-    int32_t bytes_read = f->read(sizeof(header.padding) + (uint8_t*) &header, zip_header_size);
+    f.seek(offset);
+    int32_t bytes_read = f.read(sizeof(header.padding) + (uint8_t*) &header, zip_header_size);
     if (bytes_read != zip_header_size) {
       break;
     }
-    // AddLog(LOG_LEVEL_DEBUG, "ZIG: header version=%i flags=%p compress=%i mod_time=%i mod_date=%i size=%i-%i fnamesize=%i",
-    //   header.version, header.gen_purpose_flags, header.compression, header.last_mod_time, header.last_mod_date,
-    //   header.size_compressed, header.size_uncompressed, header.filename_size);
     // Check signature
     if (header.signature1 != 0x4B50) {
       AddLog(LOG_LEVEL_INFO, "ZIP: invalid zip signature");
@@ -325,21 +534,11 @@ bool ZipArchive::parse(void) {
       // AddLog(LOG_LEVEL_DEBUG, "ZIP: end of file section");
       break;
     }
-    // Check no extra field
-    if (header.gen_purpose_flags != 0x0000) {
+    // Sizes must be in the local header
+    if (header.gen_purpose_flags & 0x0009) {
       AddLog(LOG_LEVEL_INFO, "ZIP: invalid general purpose flags 0x%04X", header.gen_purpose_flags);
       return false;
     }
-    // Check no compression
-    if (header.compression != 0x0000) {
-      AddLog(LOG_LEVEL_INFO, "ZIP: compressed files unsupported 0x%04X", header.compression);
-      return false;
-    }
-    // Check size is the same for compressed and uncompressed
-    if (header.size_compressed != header.size_uncompressed) {
-      AddLog(LOG_LEVEL_INFO, "ZIP: compressed size differs from uncompressed %i - %i", header.size_compressed, header.size_uncompressed);
-      return false;
-    }
     // Check file name size
     if (header.filename_size > 64) {
       AddLog(LOG_LEVEL_INFO, "ZIP: entry filename size too long %i", header.filename_size);
@@ -348,35 +547,104 @@ bool ZipArchive::parse(void) {
 
     // read full filename
     char fname[header.filename_size + 1];
-    if (f->read((uint8_t*) &fname[0], header.filename_size) != header.filename_size) {
+    if (f.read((uint8_t*) &fname[0], header.filename_size) != header.filename_size) {
       return false;
     }
     fname[header.filename_size] = 0;  // add NULL termination
 
-    // Remove any directory names, and keep only what's after the last `/``
-    char * fname_suffix;
-    char * saveptr;
-    fname_suffix = strtok_r(&fname[0], "#", &saveptr);
-    char * res = fname_suffix;
-    while (res) {
-      res = strtok_r(nullptr, "#", &saveptr);
-      if (res) { fname_suffix = res; }
-    }
     offset += zip_header_size + header.filename_size + header.extra_field_size;
+    addEntry(fname, offset, header.size_uncompressed, header.size_compressed, header.compression,
+             (header.last_mod_date << 16) | header.last_mod_time);
+    offset += header.size_compressed;
+  }
 
-    ZipEntry & entry = entries.addToLast();
-    entry.file_name = fname_suffix;
-    entry.file_start = offset;
-    entry.file_len = header.size_uncompressed;
-    entry.last_mod = dos2unixtime((header.last_mod_date << 16) | header.last_mod_time);
-    offset += header.size_uncompressed;
+  return true;
+}
 
-    // AddLog(LOG_LEVEL_DEBUG_MORE, "ZIP: found file '%s' (%i bytes - offset %i) - next entry %i", &fname[0], header.size_uncompressed, entry.file_start, offset);
+// build hash index on entry names, twice the number of entries rounded to power of 2
+void ZipArchive::buildIndex(void) {
+  size_t count = entries.length();
+  if (0 == count) { return; }
+  uint32_t index_size = 4;
+  while (index_size < count * 2) { index_size <<= 1; }
+  index = (ZipEntry**) calloc(index_size, sizeof(ZipEntry*));
+  if (index == nullptr) { return; }     // fall back to linear search
+  index_mask = index_size - 1;
+  for (auto & entry : entries) {
+    uint32_t slot = entry.name_hash & index_mask;
+    while (index[slot] != nullptr) { slot = (slot + 1) & index_mask; }
+    index[slot] = &entry;
   }
+}
 
-  return true;
+ZipEntry * ZipArchive::find(const char * name) {
+  uint32_t hash = zip_name_hash(name);
+  if (index) {
+    uint32_t slot = hash & index_mask;
+    while (index[slot] != nullptr) {
+      if ((index[slot]->name_hash == hash) && index[slot]->file_name.equals(name)) {
+        return index[slot];
+      }
+      slot = (slot + 1) & index_mask;
+    }
+    return nullptr;
+  }
+  for (auto & entry : entries) {
+    if ((entry.name_hash == hash) && entry.file_name.equals(name)) {
+      return &entry;
+    }
+  }
+  return nullptr;
 }
 
+/********************************************************************
+** Cache of parsed archives
+** 
+** Entries are kept until the archive size or timestamp changes
+********************************************************************/
+
+static ZipArchive zip_cache[ZIP_CACHE_SIZE];
+static uint32_t zip_cache_counter = 0;
+
+// returns the parsed archive from cache, or parse it
+static ZipArchive * ZipCacheGet(FS * fs, const char * prefix) {
+  File zipfile = fs->open(prefix, "r", false);
+  if (!(bool)zipfile) {
+    AddLog(LOG_LEVEL_INFO, "ZIP: could not open '%s'", prefix);
+    return nullptr;
+  }
+  size_t size = zipfile.size();
+  time_t last_write = zipfile.getLastWrite();
+
+  ZipArchive * slot = &zip_cache[0];
+  for (uint32_t i = 0; i < ZIP_CACHE_SIZE; i++) {
+    ZipArchive * zip = &zip_cache[i];
+    if (zip->path.equals(prefix)) {
+      if ((zip->size == size) && (zip->last_write == last_write)) {
+        zip->last_used = ++zip_cache_counter;
+        zipfile.close();
+        return zip;
+      }
+      slot = zip;                 // archive changed, parse again in same slot
+      break;
+    }
+    if (zip->last_used < slot->last_used) { slot = zip; }  // least recently used
+  }
+
+  bool ok = slot->parse(zipfile);
+  zipfile.close();
+  if (!ok) {
+    slot->clear();
+    slot->path = "";
+    slot->last_used = 0;
+    return nullptr;
+  }
+  slot->path = prefix;
+  slot->size = size;
+  slot->last_write = last_write;
+  slot->last_used = ++zip_cache_counter;
+  return slot;
+}
 
 /********************************************************************
 ** Encapsulation of FS and File to piggyback on Arduino
@@ -403,25 +671,19 @@ FileImplPtr ZipReadFSImpl::open(const char* path, const char* mode, const bool c
     // if suffix starts with '/', skip the first char
     if (*suffix == '/') { suffix++; }
     // AddLog(LOG_LEVEL_DEBUG, "ZIP: prefix=%s suffix=%s", prefix, suffix);
-    // parse ZIP archive
-    File zipfile = (*_fs)->open(prefix, "r", false);
-    if ((bool)zipfile) {
-      // we could read the file
-      ZipArchive zip_archive = ZipArchive(&zipfile);
-      zip_archive.parse();
-
-      for (auto & entry : zip_archive.entries) {
-        if (entry.file_name.equals(suffix)) {
-          // found
-          // AddLog(LOG_LEVEL_DEBUG, "ZIP: file '%s' in archive (start=%i - len=%i - last_mod=%i)", suffix, entry.file_start, entry.file_len, entry.last_mod);
-          return ZipItemImplPtr(new ZipItemImpl((*_fs)->open(prefix, "r", false), entry.file_start, entry.file_len, entry.last_mod));
+    // find entry in cached ZIP archive
+    ZipArchive * zip_archive = ZipCacheGet(*_fs, prefix);
+    if (zip_archive) {
+      ZipEntry * entry = zip_archive->find(suffix);
+      if (entry) {
+        // AddLog(LOG_LEVEL_DEBUG, "ZIP: file '%s' in archive (start=%i - len=%i - last_mod=%i)", suffix, entry->file_start, entry->file_len, entry->last_mod);
+        if (ZIP_DEFLATED == entry->compression) {
+          return ZipInflateItemImplPtr(new ZipInflateItemImpl((*_fs)->open(prefix, "r", false), entry->file_start, entry->file_len_compressed, entry->file_len, entry->last_mod));
         }
+        return ZipItemImplPtr(new ZipItemImpl((*_fs)->open(prefix, "r", false), entry->file_start, entry->file_len, entry->last_mod));
       }
-      return ZipReadFileImplPtr();    // return an error
-    } else {
-      AddLog(LOG_LEVEL_INFO, "ZIP: could not open '%s'", prefix);
-      return ZipReadFileImplPtr();    // return an error
     }
+    return ZipReadFileImplPtr();    // return an error
   } else {
     // simple file, do nothing
     return ZipReadFileImplPtr(new ZipReadFileImpl((*_fs)->open(path, mode, create)));
@@ -440,18 +702,12 @@ bool ZipReadFSImpl::exists(const char* path) {
     char *tok;
     char *prefix = strtok_r(sub_path, "#", &tok);
     char *suffix = strtok_r(NULL, "", &tok);
-    // parse ZIP archive
-    File zipfile = (*_fs)->open(prefix, "r", false);
-    if ((bool)zipfile) {
-      // we could read the file
-      ZipArchive zip_archive = ZipArchive(&zipfile);
-      zip_archive.parse();
-
-      for (auto & entry : zip_archive.entries) {
-        if (entry.file_name.equals(suffix)) {
-          return true;
-        }
-      }
+    if (suffix == nullptr) { return false; }
+    if (*suffix == '/') { suffix++; }
+    // find entry in cached ZIP archive
+    ZipArchive * zip_archive = ZipCacheGet(*_fs, prefix);
+    if (zip_archive && zip_archive->find(suffix)) {
+      return true;
     }
     return false;
   } else {
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Regenerates the .tapp archives used by test_zip_read_fs.cpp from `files/`.
+# The archives are committed, run this only when the test cases change.
+#
+#   stored.tapp       stored entries, like `zip -j -0` makes them
+#   stored_v2.tapp    same entry names, other contents and size
+#   stored_v3.tapp    same size as stored.tapp, entries in the other order
+#   deflated.tapp     deflated entries (fixed, dynamic and stored blocks)
+#                     and one stored entry
+#   no_cd.tapp        stored entries without central directory
+#   corrupt.tapp      deflated entries with an invalid block type and
+#                     a truncated stream
+
+import os
+import random
+import struct
+import zlib
+
+DOS_TIME = (6 << 11) | (30 << 5)                # 06:30:00
+DOS_DATE = ((2021 - 1980) << 9) | (11 << 5) | 14  # 2021-11-14
+STORED, DEFLATED = 0, 8
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+def deflate(data):
+    c = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return c.compress(data) + c.flush()
+
+# entries: list of (name, data, method) or (name, data, method, raw)
+# where `raw` replaces the compressed stream, sizes and crc stay those of `data`
+def write_zip(name, entries, central_directory=True):
+    out = bytearray()
+    central = bytearray()
+    for e in entries:
+        fname, data, method = e[0].encode(), e[1], e[2]
+        raw = e[3] if len(e) > 3 else (deflate(data) if method == DEFLATED else data)
+        crc = zlib.crc32(data)
+        offset = len(out)
+        out += struct.pack('<IHHHHHIIIHH', 0x04034B50, 20, 0, method, DOS_TIME, DOS_DATE,
+                           crc, len(raw), len(data), len(fname), 0)
+        out += fname + raw
+        central += struct.pack('<IHHHHHHIIIHHHHHII', 0x02014B50, 20, 20, 0, method, DOS_TIME, DOS_DATE,
+                               crc, len(raw), len(data), len(fname), 0, 0, 0, 0, 0, offset)
+        central += fname
+    if central_directory:
+        count = len(entries)
+        out_offset = len(out)
+        out += central
+        out += struct.pack('<IHHHHIIH', 0x06054B50, 0, 0, count, count, len(central), out_offset, 0)
+    with open(os.path.join(here, name), 'wb') as f:
+        f.write(out)
+
+def read(name):
+    with open(os.path.join(here, 'files', name), 'rb') as f:
+        return f.read()
+
+def write(name, data):
+    with open(os.path.join(here, 'files', name), 'wb') as f:
+        f.write(data)
+
+# text larger than the 32KB window, and incompressible bytes
+lines = []
+for i in range(1200):
+    lines.append('%05d: tasmota.add_rule("Power%i#State", def (v) print("relay %i", v) end)\n' % (i, i % 8, i % 8))
+write('big.txt', ''.join(lines).encode())
+rnd = random.Random(1)
+write('random.bin', bytes(rnd.randrange(256) for _ in range(5000)))
+
+autoexec = read('autoexec.be')
+lib = read('lib.be')
+big = read('big.txt')
+bin_ = read('random.bin')
+
+write_zip('stored.tapp', [('autoexec.be', autoexec, STORED), ('lib.be', lib, STORED)])
+write_zip('stored_v2.tapp', [('autoexec.be', b'print("v2")\n', STORED), ('lib.be', lib + b'# v2\n', STORED)])
+v3 = bytearray(autoexec)
+v3[0:6] = b'#- v3 '
+write_zip('stored_v3.tapp', [('lib.be', lib, STORED), ('autoexec.be', bytes(v3), STORED)])
+write_zip('deflated.tapp', [('autoexec.be', autoexec, DEFLATED), ('big.txt', big, DEFLATED),
+                            ('random.bin', bin_, DEFLATED), ('lib.be', lib, STORED),
+                            ('empty.txt', b'', DEFLATED)])
+write_zip('no_cd.tapp', [('autoexec.be', autoexec, STORED), ('lib.be', lib, STORED)], central_directory=False)
+
+bad_type = bytearray(deflate(lib))
+bad_type[0] |= 0x06                             # BTYPE = 11, reserved
+truncated = deflate(big)[:2000]
+write_zip('corrupt.tapp', [('autoexec.be', autoexec, DEFLATED), ('bad_type.be', lib, DEFLATED, bytes(bad_type)),
+                           ('truncated.txt', big, DEFLATED, truncated)])
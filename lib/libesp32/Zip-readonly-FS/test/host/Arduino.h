@@ -0,0 +1,32 @@
+/*
+  Arduino.h - minimal host replacement to build Zip-readonly-FS in tests
+*/
+
+#ifndef __HOST_ARDUINO__
+#define __HOST_ARDUINO__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <memory>
+#include <string>
+
+typedef bool boolean;
+#define PGM_P const char *
+
+class String {
+public:
+  String(void) : _s() {}
+  String(const char * s) : _s(s ? s : "") {}
+  String & operator=(const char * s) { _s = s ? s : ""; return *this; }
+  bool equals(const char * s) const { return _s == s; }
+  const char * c_str(void) const { return _s.c_str(); }
+  size_t length(void) const { return _s.length(); }
+
+protected:
+  std::string _s;
+};
+
+#endif // __HOST_ARDUINO__
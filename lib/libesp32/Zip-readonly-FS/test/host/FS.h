@@ -0,0 +1,112 @@
+/*
+  FS.h - minimal host replacement of the arduino-esp32 FS API,
+  same signatures as the members used by Zip-readonly-FS
+*/
+
+#ifndef __HOST_FS__
+#define __HOST_FS__
+
+#include <Arduino.h>
+
+namespace fs {
+
+#define FILE_READ   "r"
+
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+class File;
+class FileImpl;
+typedef std::shared_ptr<FileImpl> FileImplPtr;
+class FSImpl;
+typedef std::shared_ptr<FSImpl> FSImplPtr;
+
+class FileImpl {
+public:
+  virtual ~FileImpl() {}
+  virtual size_t write(const uint8_t *buf, size_t size) = 0;
+  virtual size_t read(uint8_t* buf, size_t size) = 0;
+  virtual void flush() = 0;
+  virtual bool seek(uint32_t pos, SeekMode mode) = 0;
+  virtual size_t position() const = 0;
+  virtual size_t size() const = 0;
+  virtual void close() = 0;
+  virtual time_t getLastWrite() = 0;
+  virtual const char* path() const = 0;
+  virtual const char* name() const = 0;
+  virtual boolean isDirectory(void) = 0;
+  virtual FileImplPtr openNextFile(const char* mode) = 0;
+  virtual void rewindDirectory(void) = 0;
+  virtual operator bool() = 0;
+};
+
+class FSImpl {
+public:
+  FSImpl() {}
+  virtual ~FSImpl() {}
+  virtual FileImplPtr open(const char* path, const char* mode, const bool create) = 0;
+  virtual bool exists(const char* path) = 0;
+  virtual bool rename(const char* pathFrom, const char* pathTo) = 0;
+  virtual bool remove(const char* path) = 0;
+  virtual bool mkdir(const char *path) = 0;
+  virtual bool rmdir(const char *path) = 0;
+};
+
+class File {
+public:
+  File(FileImplPtr p = FileImplPtr()) : _p(p) {}
+
+  size_t write(const uint8_t *buf, size_t size) { return _p ? _p->write(buf, size) : 0; }
+  size_t read(uint8_t* buf, size_t size) { return _p ? _p->read(buf, size) : 0; }
+  void flush() { if (_p) { _p->flush(); } }
+  bool seek(uint32_t pos, SeekMode mode) { return _p ? _p->seek(pos, mode) : false; }
+  bool seek(uint32_t pos) { return seek(pos, SeekSet); }
+  size_t position() const { return _p ? _p->position() : 0; }
+  size_t size() const { return _p ? _p->size() : 0; }
+  void close() { if (_p) { _p->close(); _p = nullptr; } }
+  operator bool() const { return _p != nullptr && *_p; }
+  time_t getLastWrite() { return _p ? _p->getLastWrite() : 0; }
+  const char* path() const { return _p ? _p->path() : nullptr; }
+  const char* name() const { return _p ? _p->name() : nullptr; }
+  boolean isDirectory(void) { return _p ? _p->isDirectory() : false; }
+  File openNextFile(const char* mode = FILE_READ) { return _p ? File(_p->openNextFile(mode)) : File(); }
+  void rewindDirectory(void) { if (_p) { _p->rewindDirectory(); } }
+
+protected:
+  FileImplPtr _p;
+};
+
+class FS {
+public:
+  FS(FSImplPtr impl) : _impl(impl) {}
+
+  File open(const char* path, const char* mode = FILE_READ, const bool create = false) {
+    return _impl ? File(_impl->open(path, mode, create)) : File();
+  }
+  bool exists(const char* path) { return _impl ? _impl->exists(path) : false; }
+  bool remove(const char* path) { return _impl ? _impl->remove(path) : false; }
+  bool rename(const char* pathFrom, const char* pathTo) { return _impl ? _impl->rename(pathFrom, pathTo) : false; }
+  bool mkdir(const char *path) { return _impl ? _impl->mkdir(path) : false; }
+  bool rmdir(const char *path) { return _impl ? _impl->rmdir(path) : false; }
+
+protected:
+  FSImplPtr _impl;
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+using fs::FileImpl;
+using fs::FileImplPtr;
+using fs::FSImpl;
+using fs::FSImplPtr;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif // __HOST_FS__
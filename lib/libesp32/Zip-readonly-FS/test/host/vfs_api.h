@@ -0,0 +1,3 @@
+/*
+  vfs_api.h - empty host replacement, the VFS classes are not used by the tests
+*/
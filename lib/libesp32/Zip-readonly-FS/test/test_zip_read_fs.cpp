@@ -0,0 +1,304 @@
+/*
+  test_zip_read_fs.cpp - host tests of Zip-readonly-FS on the .tapp archives in `fixtures/`
+
+  Copyright (C) 2021  Stephan Hadinger
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdarg.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include "ZipReadFS.h"
+
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+    checks++; \
+    if (!(cond)) { failures++; printf("FAIL %s:%i: %s\n", __FILE__, __LINE__, #cond); } \
+  } while (0)
+
+/********************************************************************
+** Tasmota logging, keeps the last message for the checks
+********************************************************************/
+static char last_log[128] = "";
+
+void AddLog(uint32_t loglevel, PGM_P formatP, ...) {
+  va_list arg;
+  va_start(arg, formatP);
+  vsnprintf(last_log, sizeof(last_log), formatP, arg);
+  va_end(arg);
+}
+
+FS *zip_ufsp = nullptr;
+
+/********************************************************************
+** Host file system rooted in a directory
+********************************************************************/
+class HostFileImpl : public FileImpl {
+public:
+  HostFileImpl(FILE * f, const char * path) : _f(f), _path(path) {}
+  virtual ~HostFileImpl() { close(); }
+
+  size_t write(const uint8_t *buf, size_t size) { return _f ? fwrite(buf, 1, size, _f) : 0; }
+  size_t read(uint8_t* buf, size_t size) { return _f ? fread(buf, 1, size, _f) : 0; }
+  void flush() { if (_f) { fflush(_f); } }
+  bool seek(uint32_t pos, SeekMode mode) {
+    static const int whence[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+    return _f && (fseek(_f, pos, whence[mode]) == 0);
+  }
+  size_t position() const { return _f ? ftell(_f) : 0; }
+  size_t size() const {
+    struct stat st;
+    return (_f && fstat(fileno(_f), &st) == 0) ? st.st_size : 0;
+  }
+  void close() { if (_f) { fclose(_f); _f = nullptr; } }
+  time_t getLastWrite() {
+    struct stat st;
+    return (_f && fstat(fileno(_f), &st) == 0) ? st.st_mtime : 0;
+  }
+  const char* path() const { return _path.c_str(); }
+  const char* name() const {
+    const char * slash = strrchr(_path.c_str(), '/');
+    return slash ? slash + 1 : _path.c_str();
+  }
+  boolean isDirectory(void) { return false; }
+  FileImplPtr openNextFile(const char* mode) { return nullptr; }
+  void rewindDirectory(void) {}
+  operator bool() { return _f != nullptr; }
+
+protected:
+  FILE * _f;
+  String _path;
+};
+
+class HostFSImpl : public FSImpl {
+public:
+  HostFSImpl(const char * root) : _root(root) {}
+
+  FileImplPtr open(const char* path, const char* mode, const bool create) {
+    FILE * f = fopen(real(path).c_str(), mode);
+    if (f == nullptr) { return FileImplPtr(); }
+    return FileImplPtr(new HostFileImpl(f, path));
+  }
+  bool exists(const char* path) { return access(real(path).c_str(), F_OK) == 0; }
+  bool rename(const char* pathFrom, const char* pathTo) { return ::rename(real(pathFrom).c_str(), real(pathTo).c_str()) == 0; }
+  bool remove(const char* path) { return ::remove(real(path).c_str()) == 0; }
+  bool mkdir(const char *path) { return ::mkdir(real(path).c_str(), 0777) == 0; }
+  bool rmdir(const char *path) { return ::rmdir(real(path).c_str()) == 0; }
+
+protected:
+  std::string real(const char * path) { return _root + path; }
+  std::string _root;
+};
+
+/********************************************************************
+** Helpers
+********************************************************************/
+static char root[] = "/tmp/zipfs-XXXXXX";
+static FS * host_fs = nullptr;
+static FS * zip_fs = nullptr;
+
+static std::string readFixture(const char * name) {
+  std::string ret;
+  std::string path = std::string("fixtures/files/") + name;
+  FILE * f = fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    printf("missing fixture %s\n", path.c_str());
+    exit(2);
+  }
+  char buf[512];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), f)) > 0) { ret.append(buf, len); }
+  fclose(f);
+  return ret;
+}
+
+// copy a fixture archive into the test root, with the given modification time
+static void installArchive(const char * fixture, const char * name, time_t mtime) {
+  std::string src = std::string("fixtures/") + fixture;
+  std::string dst = std::string(root) + "/" + name;
+  FILE * in = fopen(src.c_str(), "rb");
+  FILE * out = fopen(dst.c_str(), "wb");
+  if (in == nullptr || out == nullptr) {
+    printf("could not copy %s to %s\n", src.c_str(), dst.c_str());
+    exit(2);
+  }
+  char buf[512];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), in)) > 0) { fwrite(buf, 1, len, out); }
+  fclose(in);
+  fclose(out);
+  struct utimbuf t = { mtime, mtime };
+  utime(dst.c_str(), &t);
+}
+
+// read a whole entry in chunks of `chunk` bytes, returns false if it can't be opened
+static bool readEntry(const char * path, size_t chunk, std::string & out) {
+  out.clear();
+  File f = zip_fs->open(path, "r", false);
+  if (!f) { return false; }
+  uint8_t buf[4096];
+  if (chunk > sizeof(buf)) { chunk = sizeof(buf); }
+  size_t len;
+  while ((len = f.read(buf, chunk)) > 0) { out.append((const char*) buf, len); }
+  f.close();
+  return true;
+}
+
+static std::string readAt(File & f, size_t len) {
+  std::string ret(len, '\0');
+  size_t got = f.read((uint8_t*) &ret[0], len);
+  ret.resize(got);
+  return ret;
+}
+
+/********************************************************************
+** Tests
+********************************************************************/
+static void testStored(void) {
+  std::string autoexec = readFixture("autoexec.be");
+  std::string lib = readFixture("lib.be");
+  std::string out;
+
+  CHECK(zip_fs->exists("/stored.tapp#autoexec.be"));
+  CHECK(zip_fs->exists("/stored.tapp#/lib.be"));
+  CHECK(!zip_fs->exists("/stored.tapp#missing.be"));
+  CHECK(!zip_fs->exists("/missing.tapp#autoexec.be"));
+
+  CHECK(readEntry("/stored.tapp#autoexec.be", 5, out) && out == autoexec);
+  CHECK(readEntry("/stored.tapp#/lib.be", 4096, out) && out == lib);
+  CHECK(!readEntry("/stored.tapp#missing.be", 4096, out));
+  CHECK(!zip_fs->open("/stored.tapp#autoexec.be", "w", false));
+
+  File f = zip_fs->open("/stored.tapp#autoexec.be", "r", false);
+  CHECK(f.size() == autoexec.size());
+  struct tm t = {};
+  t.tm_year = 2021 - 1900; t.tm_mon = 10; t.tm_mday = 14; t.tm_hour = 6; t.tm_min = 30; t.tm_isdst = -1;
+  CHECK(f.getLastWrite() == mktime(&t));
+  CHECK(f.seek(10, SeekSet) && readAt(f, 8) == autoexec.substr(10, 8));
+  CHECK(f.seek(4, SeekCur) && f.position() == 22);
+  CHECK(f.seek(0, SeekEnd) && readAt(f, 8).empty());
+  CHECK(!f.seek(autoexec.size() + 1, SeekSet));
+  f.close();
+
+  // archive without central directory, entries are found from the local headers
+  CHECK(readEntry("/no_cd.tapp#autoexec.be", 4096, out) && out == autoexec);
+  CHECK(readEntry("/no_cd.tapp#lib.be", 4096, out) && out == lib);
+}
+
+static void testDeflated(void) {
+  std::string autoexec = readFixture("autoexec.be");
+  std::string lib = readFixture("lib.be");
+  std::string big = readFixture("big.txt");
+  std::string bin = readFixture("random.bin");
+  std::string out;
+
+  CHECK(readEntry("/deflated.tapp#autoexec.be", 1, out) && out == autoexec);  // fixed Huffman block
+  CHECK(readEntry("/deflated.tapp#big.txt", 7, out) && out == big);           // dynamic blocks, window wraps
+  CHECK(readEntry("/deflated.tapp#big.txt", 4096, out) && out == big);
+  CHECK(readEntry("/deflated.tapp#random.bin", 100, out) && out == bin);      // stored blocks in the stream
+  CHECK(readEntry("/deflated.tapp#lib.be", 4096, out) && out == lib);         // stored entry in the same archive
+  CHECK(readEntry("/deflated.tapp#empty.txt", 4096, out) && out.empty());
+
+  File f = zip_fs->open("/deflated.tapp#big.txt", "r", false);
+  CHECK(f.size() == big.size());
+  CHECK(f.seek(50000, SeekSet) && readAt(f, 100) == big.substr(50000, 100));
+  CHECK(f.seek(100, SeekSet) && readAt(f, 100) == big.substr(100, 100));      // backwards restarts decoding
+  CHECK(f.seek(10, SeekCur) && f.position() == 210 && readAt(f, 50) == big.substr(210, 50));
+  CHECK(f.seek(0, SeekEnd) && readAt(f, 10).empty());
+  CHECK(!f.seek(big.size() + 1, SeekSet));
+  f.close();
+}
+
+static void testStaleCache(void) {
+  std::string autoexec = readFixture("autoexec.be");
+  std::string out;
+  time_t t0 = 1600000000;
+
+  installArchive("stored.tapp", "app.tapp", t0);
+  CHECK(readEntry("/app.tapp#autoexec.be", 4096, out) && out == autoexec);
+
+  // same size, newer timestamp
+  installArchive("stored_v3.tapp", "app.tapp", t0 + 10);
+  CHECK(readEntry("/app.tapp#autoexec.be", 4096, out) && out.compare(0, 6, "#- v3 ") == 0 && out.size() == autoexec.size());
+
+  // same timestamp, other size
+  installArchive("stored_v2.tapp", "app.tapp", t0 + 10);
+  CHECK(readEntry("/app.tapp#autoexec.be", 4096, out) && out == "print(\"v2\")\n");
+
+  // more archives than cache slots, the least recently used is parsed again
+  const char * names[] = { "a1.tapp", "a2.tapp", "a3.tapp", "a4.tapp", "a5.tapp" };
+  for (auto name : names) {
+    installArchive("stored.tapp", name, t0);
+    std::string path = std::string("/") + name + "#autoexec.be";
+    CHECK(readEntry(path.c_str(), 4096, out) && out == autoexec);
+  }
+  CHECK(readEntry("/app.tapp#autoexec.be", 4096, out) && out == "print(\"v2\")\n");
+  CHECK(readEntry("/a1.tapp#autoexec.be", 4096, out) && out == autoexec);
+}
+
+static void testCorrupt(void) {
+  std::string autoexec = readFixture("autoexec.be");
+  std::string big = readFixture("big.txt");
+  std::string out;
+
+  CHECK(readEntry("/corrupt.tapp#autoexec.be", 4096, out) && out == autoexec);
+
+  // reserved block type
+  last_log[0] = 0;
+  CHECK(readEntry("/corrupt.tapp#bad_type.be", 4096, out) && out.empty());
+  CHECK(strstr(last_log, "inflate error") != nullptr);
+
+  // stream ends before the uncompressed size is reached
+  last_log[0] = 0;
+  CHECK(readEntry("/corrupt.tapp#truncated.txt", 4096, out));
+  CHECK(out.size() < big.size() && big.compare(0, out.size(), out) == 0);
+  CHECK(strstr(last_log, "inflate error") != nullptr);
+
+  // not a zip archive
+  std::string garbage = std::string(root) + "/garbage.tapp";
+  FILE * g = fopen(garbage.c_str(), "wb");
+  fputs("this is not a zip archive, only some text long enough to be searched\n", g);
+  fclose(g);
+  CHECK(!zip_fs->exists("/garbage.tapp#autoexec.be"));
+  CHECK(!readEntry("/garbage.tapp#autoexec.be", 4096, out));
+}
+
+int main(int argc, char* argv[]) {
+  if (mkdtemp(root) == nullptr) {
+    printf("could not create temporary directory\n");
+    return 2;
+  }
+  host_fs = new FS(FSImplPtr(new HostFSImpl(root)));
+  zip_fs = new FS(ZipReadFSImplPtr(new ZipReadFSImpl(&host_fs)));
+
+  const char * fixtures[] = { "stored.tapp", "deflated.tapp", "no_cd.tapp", "corrupt.tapp" };
+  for (auto name : fixtures) {
+    installArchive(name, name, 1600000000);
+  }
+
+  testStored();
+  testDeflated();
+  testStaleCache();
+  testCorrupt();
+
+  std::string cmd = std::string("rm -rf ") + root;
+  if (system(cmd.c_str()) != 0) { printf("could not remove %s\n", root); }
+
+  printf("%u checks, %u failed\n", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -22,6 +22,7 @@ be_extern_native_module(gc);
 be_extern_native_module(solidify);
 be_extern_native_module(introspect);
 be_extern_native_module(strict);
+be_extern_native_module(coroutine);
 
 /* Berry extensions */
 #include "be_mapping.h"
@@ -89,6 +90,9 @@ BERRY_LOCAL const bntvmodule* const be_module_table[] = {
 #if BE_USE_STRICT_MODULE
     &be_native_module(strict),
 #endif
+#if BE_USE_COROUTINE_MODULE
+    &be_native_module(coroutine),
+#endif
 
     /* Berry extensions */
     &be_native_module(cb),
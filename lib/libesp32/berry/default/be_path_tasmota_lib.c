@@ -59,12 +59,26 @@ static int m_path_remove(bvm *vm)
     be_return(vm);
 }
 
+extern int be_rename(const char *from, const char *to);
+
+/* returns true if `from` was renamed to `to`, some file systems fail if `to` exists */
+static int m_path_rename(bvm *vm)
+{
+    if (be_top(vm) >= 2 && be_isstring(vm, 1) && be_isstring(vm, 2)) {
+        be_pushbool(vm, be_rename(be_tostring(vm, 1), be_tostring(vm, 2)));
+    } else {
+        be_pushbool(vm, bfalse);
+    }
+    be_return(vm);
+}
+
 /* @const_object_info_begin
 module path (scope: global, file: tasmota_path) {
     exists, func(m_path_exists)
     last_modified, func(m_path_last_modified)
     listdir, func(m_path_listdir)
     remove, func(m_path_remove)
+    rename, func(m_path_rename)
 }
 @const_object_info_end */
 #include "../generate/be_fixed_tasmota_path.h"
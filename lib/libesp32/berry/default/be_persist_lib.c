@@ -7,6 +7,235 @@
  *******************************************************************/
 #include "be_constobj.h"
 
+/********************************************************************
+** Solidified function: save
+********************************************************************/
+be_local_closure(Persist_save,   /* name */
+  be_nested_proto(
+    3,                          /* nstack */
+    1,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 4]) {     /* constants */
+    /* K0   */  be_nested_str(_full),
+    /* K1   */  be_nested_str(_log_size),
+    /* K2   */  be_nested_str(save_full),
+    /* K3   */  be_nested_str(save_log),
+    }),
+    &be_const_str_save,
+    &be_const_str_solidified,
+    ( &(const binstruction[12]) {  /* code */
+      0x88040100,  //  0000  GETMBR	R1	R0	K0
+      0x74060003,  //  0001  JMPT	R1	#0006
+      0x88040101,  //  0002  GETMBR	R1	R0	K1
+      0x540A0FFF,  //  0003  LDINT	R2	4096
+      0x24040202,  //  0004  GT	R1	R1	R2
+      0x78060002,  //  0005  JMPF	R1	#0009
+      0x8C040102,  //  0006  GETMET	R1	R0	K2
+      0x7C040200,  //  0007  CALL	R1	1
+      0x70020001,  //  0008  JMP		#000B
+      0x8C040103,  //  0009  GETMET	R1	R0	K3
+      0x7C040200,  //  000A  CALL	R1	1
+      0x80000000,  //  000B  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: setmember
+********************************************************************/
+be_local_closure(Persist_setmember,   /* name */
+  be_nested_proto(
+    5,                          /* nstack */
+    3,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 2]) {     /* constants */
+    /* K0   */  be_nested_str(_p),
+    /* K1   */  be_nested_str(_dirty),
+    }),
+    &be_const_str_setmember,
+    &be_const_str_solidified,
+    ( &(const binstruction[ 6]) {  /* code */
+      0x880C0100,  //  0000  GETMBR	R3	R0	K0
+      0x980C0202,  //  0001  SETIDX	R3	R1	R2
+      0x880C0101,  //  0002  GETMBR	R3	R0	K1
+      0x50100200,  //  0003  LDBOOL	R4	1	0
+      0x980C0204,  //  0004  SETIDX	R3	R1	R4
+      0x80000000,  //  0005  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: init
+********************************************************************/
+be_local_closure(Persist_init,   /* name */
+  be_nested_proto(
+    6,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[11]) {     /* constants */
+    /* K0   */  be_nested_str(_filename),
+    /* K1   */  be_nested_str(_persist_X2Ejson),
+    /* K2   */  be_nested_str(_logname),
+    /* K3   */  be_nested_str(_persist_X2Elog),
+    /* K4   */  be_nested_str(_p),
+    /* K5   */  be_nested_str(copy),
+    /* K6   */  be_nested_str(_dirty),
+    /* K7   */  be_nested_str(_full),
+    /* K8   */  be_nested_str(_log_size),
+    /* K9   */  be_const_int(0),
+    /* K10  */  be_nested_str(load),
+    }),
+    &be_const_str_init,
+    &be_const_str_solidified,
+    ( &(const binstruction[25]) {  /* code */
+      0x90020101,  //  0000  SETMBR	R0	K0	K1
+      0x90020503,  //  0001  SETMBR	R0	K2	K3
+      0x6008000F,  //  0002  GETGBL	R2	G15
+      0x5C0C0200,  //  0003  MOVE	R3	R1
+      0x60100013,  //  0004  GETGBL	R4	G19
+      0x7C080400,  //  0005  CALL	R2	2
+      0x780A0003,  //  0006  JMPF	R2	#000B
+      0x8C080305,  //  0007  GETMET	R2	R1	K5
+      0x7C080200,  //  0008  CALL	R2	1
+      0x90020802,  //  0009  SETMBR	R0	K4	R2
+      0x70020002,  //  000A  JMP		#000E
+      0x60080013,  //  000B  GETGBL	R2	G19
+      0x7C080000,  //  000C  CALL	R2	0
+      0x90020802,  //  000D  SETMBR	R0	K4	R2
+      0x60080013,  //  000E  GETGBL	R2	G19
+      0x7C080000,  //  000F  CALL	R2	0
+      0x90020C02,  //  0010  SETMBR	R0	K6	R2
+      0x50080000,  //  0011  LDBOOL	R2	0	0
+      0x90020E02,  //  0012  SETMBR	R0	K7	R2
+      0x90021109,  //  0013  SETMBR	R0	K8	K9
+      0x8C08010A,  //  0014  GETMET	R2	R0	K10
+      0x88100104,  //  0015  GETMBR	R4	R0	K4
+      0x88140100,  //  0016  GETMBR	R5	R0	K0
+      0x7C080600,  //  0017  CALL	R2	3
+      0x80000000,  //  0018  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: load
+********************************************************************/
+be_local_closure(Persist_load,   /* name */
+  be_nested_proto(
+    9,                          /* nstack */
+    1,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[15]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(path),
+    /* K2   */  be_nested_str(recover),
+    /* K3   */  be_nested_str(exists),
+    /* K4   */  be_nested_str(_filename),
+    /* K5   */  be_nested_str(r),
+    /* K6   */  be_nested_str(load),
+    /* K7   */  be_nested_str(read),
+    /* K8   */  be_nested_str(close),
+    /* K9   */  be_nested_str(_p),
+    /* K10  */  be_nested_str(BRY_X3A_X20failed_X20to_X20load_X20_persist_X2Ejson),
+    /* K11  */  be_nested_str(_dirty),
+    /* K12  */  be_nested_str(_full),
+    /* K13  */  be_nested_str(load_log),
+    /* K14  */  be_nested_str(save),
+    }),
+    &be_const_str_load,
+    &be_const_str_solidified,
+    ( &(const binstruction[58]) {  /* code */
+      0xA4060000,  //  0000  IMPORT	R1	K0
+      0xA40A0200,  //  0001  IMPORT	R2	K1
+      0x4C0C0000,  //  0002  LDNIL	R3
+      0x4C100000,  //  0003  LDNIL	R4
+      0x8C140102,  //  0004  GETMET	R5	R0	K2
+      0x7C140200,  //  0005  CALL	R5	1
+      0x8C140503,  //  0006  GETMET	R5	R2	K3
+      0x881C0104,  //  0007  GETMBR	R7	R0	K4
+      0x7C140400,  //  0008  CALL	R5	2
+      0x7816002A,  //  0009  JMPF	R5	#0035
+      0xA802000D,  //  000A  EXBLK	0	#0019
+      0x60140011,  //  000B  GETGBL	R5	G17
+      0x88180104,  //  000C  GETMBR	R6	R0	K4
+      0x581C0005,  //  000D  LDCONST	R7	K5
+      0x7C140400,  //  000E  CALL	R5	2
+      0x5C0C0A00,  //  000F  MOVE	R3	R5
+      0x8C140306,  //  0010  GETMET	R5	R1	K6
+      0x8C1C0707,  //  0011  GETMET	R7	R3	K7
+      0x7C1C0200,  //  0012  CALL	R7	1
+      0x7C140400,  //  0013  CALL	R5	2
+      0x5C100A00,  //  0014  MOVE	R4	R5
+      0x8C140708,  //  0015  GETMET	R5	R3	K8
+      0x7C140200,  //  0016  CALL	R5	1
+      0xA8040001,  //  0017  EXBLK	1	1
+      0x70020009,  //  0018  JMP		#0023
+      0xAC140002,  //  0019  CATCH	R5	0	2
+      0x70020006,  //  001A  JMP		#0022
+      0x4C1C0000,  //  001B  LDNIL	R7
+      0x201C0607,  //  001C  NE	R7	R3	R7
+      0x781E0001,  //  001D  JMPF	R7	#0020
+      0x8C1C0708,  //  001E  GETMET	R7	R3	K8
+      0x7C1C0200,  //  001F  CALL	R7	1
+      0xB0040A06,  //  0020  RAISE	1	R5	R6
+      0x70020000,  //  0021  JMP		#0023
+      0xB0080000,  //  0022  RAISE	2	R0	R0
+      0x6014000F,  //  0023  GETGBL	R5	G15
+      0x5C180800,  //  0024  MOVE	R6	R4
+      0x601C0013,  //  0025  GETGBL	R7	G19
+      0x7C140400,  //  0026  CALL	R5	2
+      0x78160001,  //  0027  JMPF	R5	#002A
+      0x90021204,  //  0028  SETMBR	R0	K9	R4
+      0x70020002,  //  0029  JMP		#002D
+      0x60140001,  //  002A  GETGBL	R5	G1
+      0x5818000A,  //  002B  LDCONST	R6	K10
+      0x7C140200,  //  002C  CALL	R5	1
+      0x60140013,  //  002D  GETGBL	R5	G19
+      0x7C140000,  //  002E  CALL	R5	0
+      0x90021605,  //  002F  SETMBR	R0	K11	R5
+      0x50140000,  //  0030  LDBOOL	R5	0	0
+      0x90021805,  //  0031  SETMBR	R0	K12	R5
+      0x8C14010D,  //  0032  GETMET	R5	R0	K13
+      0x7C140200,  //  0033  CALL	R5	1
+      0x70020003,  //  0034  JMP		#0039
+      0x50140200,  //  0035  LDBOOL	R5	1	0
+      0x90021805,  //  0036  SETMBR	R0	K12	R5
+      0x8C14010E,  //  0037  GETMET	R5	R0	K14
+      0x7C140200,  //  0038  CALL	R5	1
+      0x80000000,  //  0039  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
 /********************************************************************
 ** Solidified function: json_fdump_map
 ********************************************************************/
@@ -83,30 +312,135 @@ be_local_closure(Persist_json_fdump_map,   /* name */
 
 
 /********************************************************************
-** Solidified function: setmember
+** Solidified function: load_log
 ********************************************************************/
-be_local_closure(Persist_setmember,   /* name */
+be_local_closure(Persist_load_log,   /* name */
   be_nested_proto(
-    4,                          /* nstack */
-    3,                          /* argc */
+    11,                          /* nstack */
+    1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 2]) {     /* constants */
-    /* K0   */  be_nested_str(_p),
-    /* K1   */  be_nested_str(_dirty),
+    ( &(const bvalue[17]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(path),
+    /* K2   */  be_nested_str(_log_size),
+    /* K3   */  be_const_int(0),
+    /* K4   */  be_nested_str(exists),
+    /* K5   */  be_nested_str(_logname),
+    /* K6   */  be_nested_str(r),
+    /* K7   */  be_nested_str(size),
+    /* K8   */  be_nested_str(readline),
+    /* K9   */  be_nested_str(load),
+    /* K10  */  be_nested_str(keys),
+    /* K11  */  be_nested_str(_p),
+    /* K12  */  be_nested_str(stop_iteration),
+    /* K13  */  be_nested_str(remove),
+    /* K14  */  be_nested_str(_full),
+    /* K15  */  be_nested_str(_X0A),
+    /* K16  */  be_nested_str(close),
     }),
-    &be_const_str_setmember,
+    &be_const_str_load_log,
     &be_const_str_solidified,
-    ( &(const binstruction[ 5]) {  /* code */
-      0x880C0100,  //  0000  GETMBR	R3	R0	K0
-      0x980C0202,  //  0001  SETIDX	R3	R1	R2
-      0x500C0200,  //  0002  LDBOOL	R3	1	0
-      0x90020203,  //  0003  SETMBR	R0	K1	R3
-      0x80000000,  //  0004  RET	0
+    ( &(const binstruction[95]) {  /* code */
+      0xA4060000,  //  0000  IMPORT	R1	K0
+      0xA40A0200,  //  0001  IMPORT	R2	K1
+      0x4C0C0000,  //  0002  LDNIL	R3
+      0x90020503,  //  0003  SETMBR	R0	K2	K3
+      0x8C100504,  //  0004  GETMET	R4	R2	K4
+      0x88180105,  //  0005  GETMBR	R6	R0	K5
+      0x7C100400,  //  0006  CALL	R4	2
+      0x74120000,  //  0007  JMPT	R4	#0009
+      0x80000800,  //  0008  RET	0
+      0xA8020049,  //  0009  EXBLK	0	#0054
+      0x60100011,  //  000A  GETGBL	R4	G17
+      0x88140105,  //  000B  GETMBR	R5	R0	K5
+      0x58180006,  //  000C  LDCONST	R6	K6
+      0x7C100400,  //  000D  CALL	R4	2
+      0x5C0C0800,  //  000E  MOVE	R3	R4
+      0x8C100707,  //  000F  GETMET	R4	R3	K7
+      0x7C100200,  //  0010  CALL	R4	1
+      0x90020404,  //  0011  SETMBR	R0	K2	R4
+      0x8C100708,  //  0012  GETMET	R4	R3	K8
+      0x7C100200,  //  0013  CALL	R4	1
+      0x6014000C,  //  0014  GETGBL	R5	G12
+      0x5C180800,  //  0015  MOVE	R6	R4
+      0x7C140200,  //  0016  CALL	R5	1
+      0x24140B03,  //  0017  GT	R5	R5	K3
+      0x78160036,  //  0018  JMPF	R5	#0050
+      0x8C140309,  //  0019  GETMET	R5	R1	K9
+      0x5C1C0800,  //  001A  MOVE	R7	R4
+      0x7C140400,  //  001B  CALL	R5	2
+      0x6018000F,  //  001C  GETGBL	R6	G15
+      0x5C1C0A00,  //  001D  MOVE	R7	R5
+      0x60200013,  //  001E  GETGBL	R8	G19
+      0x7C180400,  //  001F  CALL	R6	2
+      0x781A000E,  //  0020  JMPF	R6	#0030
+      0x60180010,  //  0021  GETGBL	R6	G16
+      0x8C1C0B0A,  //  0022  GETMET	R7	R5	K10
+      0x7C1C0200,  //  0023  CALL	R7	1
+      0x7C180200,  //  0024  CALL	R6	1
+      0xA8020005,  //  0025  EXBLK	0	#002C
+      0x5C1C0C00,  //  0026  MOVE	R7	R6
+      0x7C1C0000,  //  0027  CALL	R7	0
+      0x8820010B,  //  0028  GETMBR	R8	R0	K11
+      0x94240A07,  //  0029  GETIDX	R9	R5	R7
+      0x98200E09,  //  002A  SETIDX	R8	R7	R9
+      0x7001FFF9,  //  002B  JMP		#0026
+      0x5818000C,  //  002C  LDCONST	R6	K12
+      0xAC180200,  //  002D  CATCH	R6	1	0
+      0xB0080000,  //  002E  RAISE	2	R0	R0
+      0x70020015,  //  002F  JMP		#0046
+      0x6018000F,  //  0030  GETGBL	R6	G15
+      0x5C1C0A00,  //  0031  MOVE	R7	R5
+      0x60200012,  //  0032  GETGBL	R8	G18
+      0x7C180400,  //  0033  CALL	R6	2
+      0x781A000E,  //  0034  JMPF	R6	#0044
+      0x60180010,  //  0035  GETGBL	R6	G16
+      0x5C1C0A00,  //  0036  MOVE	R7	R5
+      0x7C180200,  //  0037  CALL	R6	1
+      0xA8020006,  //  0038  EXBLK	0	#0040
+      0x5C1C0C00,  //  0039  MOVE	R7	R6
+      0x7C1C0000,  //  003A  CALL	R7	0
+      0x8820010B,  //  003B  GETMBR	R8	R0	K11
+      0x8C20110D,  //  003C  GETMET	R8	R8	K13
+      0x5C280E00,  //  003D  MOVE	R10	R7
+      0x7C200400,  //  003E  CALL	R8	2
+      0x7001FFF8,  //  003F  JMP		#0039
+      0x5818000C,  //  0040  LDCONST	R6	K12
+      0xAC180200,  //  0041  CATCH	R6	1	0
+      0xB0080000,  //  0042  RAISE	2	R0	R0
+      0x70020001,  //  0043  JMP		#0046
+      0x50180200,  //  0044  LDBOOL	R6	1	0
+      0x90021C06,  //  0045  SETMBR	R0	K14	R6
+      0x5419FFFE,  //  0046  LDINT	R6	-1
+      0x94180806,  //  0047  GETIDX	R6	R4	R6
+      0x20180D0F,  //  0048  NE	R6	R6	K15
+      0x781A0001,  //  0049  JMPF	R6	#004C
+      0x50180200,  //  004A  LDBOOL	R6	1	0
+      0x90021C06,  //  004B  SETMBR	R0	K14	R6
+      0x8C180708,  //  004C  GETMET	R6	R3	K8
+      0x7C180200,  //  004D  CALL	R6	1
+      0x5C100C00,  //  004E  MOVE	R4	R6
+      0x7001FFC3,  //  004F  JMP		#0014
+      0x8C140710,  //  0050  GETMET	R5	R3	K16
+      0x7C140200,  //  0051  CALL	R5	1
+      0xA8040001,  //  0052  EXBLK	1	1
+      0x70020009,  //  0053  JMP		#005E
+      0xAC100002,  //  0054  CATCH	R4	0	2
+      0x70020006,  //  0055  JMP		#005D
+      0x4C180000,  //  0056  LDNIL	R6
+      0x20180606,  //  0057  NE	R6	R3	R6
+      0x781A0001,  //  0058  JMPF	R6	#005B
+      0x8C180710,  //  0059  GETMET	R6	R3	K16
+      0x7C180200,  //  005A  CALL	R6	1
+      0xB0040805,  //  005B  RAISE	1	R4	R5
+      0x70020000,  //  005C  JMP		#005E
+      0xB0080000,  //  005D  RAISE	2	R0	R0
+      0x80000000,  //  005E  RET	0
     })
   )
 );
@@ -114,31 +448,55 @@ be_local_closure(Persist_setmember,   /* name */
 
 
 /********************************************************************
-** Solidified function: zero
+** Solidified function: json_fdump_any
 ********************************************************************/
-be_local_closure(Persist_zero,   /* name */
+be_local_closure(Persist_json_fdump_any,   /* name */
   be_nested_proto(
-    2,                          /* nstack */
-    1,                          /* argc */
+    9,                          /* nstack */
+    3,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 2]) {     /* constants */
-    /* K0   */  be_nested_str(_p),
-    /* K1   */  be_nested_str(_dirty),
+    ( &(const bvalue[ 5]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(json_fdump_map),
+    /* K2   */  be_nested_str(json_fdump_list),
+    /* K3   */  be_nested_str(write),
+    /* K4   */  be_nested_str(dump),
     }),
-    &be_const_str_zero,
+    &be_const_str_json_fdump_any,
     &be_const_str_solidified,
-    ( &(const binstruction[ 6]) {  /* code */
-      0x60040013,  //  0000  GETGBL	R1	G19
-      0x7C040000,  //  0001  CALL	R1	0
-      0x90020001,  //  0002  SETMBR	R0	K0	R1
-      0x50040200,  //  0003  LDBOOL	R1	1	0
-      0x90020201,  //  0004  SETMBR	R0	K1	R1
-      0x80000000,  //  0005  RET	0
+    ( &(const binstruction[27]) {  /* code */
+      0xA40E0000,  //  0000  IMPORT	R3	K0
+      0x6010000F,  //  0001  GETGBL	R4	G15
+      0x5C140400,  //  0002  MOVE	R5	R2
+      0x60180013,  //  0003  GETGBL	R6	G19
+      0x7C100400,  //  0004  CALL	R4	2
+      0x78120004,  //  0005  JMPF	R4	#000B
+      0x8C100101,  //  0006  GETMET	R4	R0	K1
+      0x5C180200,  //  0007  MOVE	R6	R1
+      0x5C1C0400,  //  0008  MOVE	R7	R2
+      0x7C100600,  //  0009  CALL	R4	3
+      0x7002000E,  //  000A  JMP		#001A
+      0x6010000F,  //  000B  GETGBL	R4	G15
+      0x5C140400,  //  000C  MOVE	R5	R2
+      0x60180012,  //  000D  GETGBL	R6	G18
+      0x7C100400,  //  000E  CALL	R4	2
+      0x78120004,  //  000F  JMPF	R4	#0015
+      0x8C100102,  //  0010  GETMET	R4	R0	K2
+      0x5C180200,  //  0011  MOVE	R6	R1
+      0x5C1C0400,  //  0012  MOVE	R7	R2
+      0x7C100600,  //  0013  CALL	R4	3
+      0x70020004,  //  0014  JMP		#001A
+      0x8C100303,  //  0015  GETMET	R4	R1	K3
+      0x8C180704,  //  0016  GETMET	R6	R3	K4
+      0x5C200400,  //  0017  MOVE	R8	R2
+      0x7C180400,  //  0018  CALL	R6	2
+      0x7C100400,  //  0019  CALL	R4	2
+      0x80000000,  //  001A  RET	0
     })
   )
 );
@@ -146,12 +504,12 @@ be_local_closure(Persist_zero,   /* name */
 
 
 /********************************************************************
-** Solidified function: member
+** Solidified function: find
 ********************************************************************/
-be_local_closure(Persist_member,   /* name */
+be_local_closure(Persist_find,   /* name */
   be_nested_proto(
-    5,                          /* nstack */
-    2,                          /* argc */
+    7,                          /* nstack */
+    3,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
@@ -162,14 +520,15 @@ be_local_closure(Persist_member,   /* name */
     /* K0   */  be_nested_str(_p),
     /* K1   */  be_nested_str(find),
     }),
-    &be_const_str_member,
+    &be_const_str_find,
     &be_const_str_solidified,
-    ( &(const binstruction[ 5]) {  /* code */
-      0x88080100,  //  0000  GETMBR	R2	R0	K0
-      0x8C080501,  //  0001  GETMET	R2	R2	K1
-      0x5C100200,  //  0002  MOVE	R4	R1
-      0x7C080400,  //  0003  CALL	R2	2
-      0x80040400,  //  0004  RET	1	R2
+    ( &(const binstruction[ 6]) {  /* code */
+      0x880C0100,  //  0000  GETMBR	R3	R0	K0
+      0x8C0C0701,  //  0001  GETMET	R3	R3	K1
+      0x5C140200,  //  0002  MOVE	R5	R1
+      0x5C180400,  //  0003  MOVE	R6	R2
+      0x7C0C0600,  //  0004  CALL	R3	3
+      0x80040600,  //  0005  RET	1	R3
     })
   )
 );
@@ -219,9 +578,66 @@ be_local_closure(Persist_json_fdump,   /* name */
 
 
 /********************************************************************
-** Solidified function: remove
+** Solidified function: json_fdump_list
 ********************************************************************/
-be_local_closure(Persist_remove,   /* name */
+be_local_closure(Persist_json_fdump_list,   /* name */
+  be_nested_proto(
+    9,                          /* nstack */
+    3,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 8]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(write),
+    /* K2   */  be_nested_str(_X5B),
+    /* K3   */  be_const_int(0),
+    /* K4   */  be_nested_str(_X2C),
+    /* K5   */  be_nested_str(json_fdump_any),
+    /* K6   */  be_const_int(1),
+    /* K7   */  be_nested_str(_X5D),
+    }),
+    &be_const_str_json_fdump_list,
+    &be_const_str_solidified,
+    ( &(const binstruction[25]) {  /* code */
+      0xA40E0000,  //  0000  IMPORT	R3	K0
+      0x8C100301,  //  0001  GETMET	R4	R1	K1
+      0x58180002,  //  0002  LDCONST	R6	K2
+      0x7C100400,  //  0003  CALL	R4	2
+      0x58100003,  //  0004  LDCONST	R4	K3
+      0x6014000C,  //  0005  GETGBL	R5	G12
+      0x5C180400,  //  0006  MOVE	R6	R2
+      0x7C140200,  //  0007  CALL	R5	1
+      0x14140805,  //  0008  LT	R5	R4	R5
+      0x7816000A,  //  0009  JMPF	R5	#0015
+      0x24140903,  //  000A  GT	R5	R4	K3
+      0x78160002,  //  000B  JMPF	R5	#000F
+      0x8C140301,  //  000C  GETMET	R5	R1	K1
+      0x581C0004,  //  000D  LDCONST	R7	K4
+      0x7C140400,  //  000E  CALL	R5	2
+      0x8C140105,  //  000F  GETMET	R5	R0	K5
+      0x5C1C0200,  //  0010  MOVE	R7	R1
+      0x94200404,  //  0011  GETIDX	R8	R2	R4
+      0x7C140600,  //  0012  CALL	R5	3
+      0x00100906,  //  0013  ADD	R4	R4	K6
+      0x7001FFEF,  //  0014  JMP		#0005
+      0x8C140301,  //  0015  GETMET	R5	R1	K1
+      0x581C0007,  //  0016  LDCONST	R7	K7
+      0x7C140400,  //  0017  CALL	R5	2
+      0x80000000,  //  0018  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: member
+********************************************************************/
+be_local_closure(Persist_member,   /* name */
   be_nested_proto(
     5,                          /* nstack */
     2,                          /* argc */
@@ -231,21 +647,18 @@ be_local_closure(Persist_remove,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 3]) {     /* constants */
+    ( &(const bvalue[ 2]) {     /* constants */
     /* K0   */  be_nested_str(_p),
-    /* K1   */  be_nested_str(remove),
-    /* K2   */  be_nested_str(_dirty),
+    /* K1   */  be_nested_str(find),
     }),
-    &be_const_str_remove,
+    &be_const_str_member,
     &be_const_str_solidified,
-    ( &(const binstruction[ 7]) {  /* code */
+    ( &(const binstruction[ 5]) {  /* code */
       0x88080100,  //  0000  GETMBR	R2	R0	K0
       0x8C080501,  //  0001  GETMET	R2	R2	K1
       0x5C100200,  //  0002  MOVE	R4	R1
       0x7C080400,  //  0003  CALL	R2	2
-      0x50080200,  //  0004  LDBOOL	R2	1	0
-      0x90020402,  //  0005  SETMBR	R0	K2	R2
-      0x80000000,  //  0006  RET	0
+      0x80040400,  //  0004  RET	1	R2
     })
   )
 );
@@ -253,55 +666,30 @@ be_local_closure(Persist_remove,   /* name */
 
 
 /********************************************************************
-** Solidified function: json_fdump_any
+** Solidified function: has
 ********************************************************************/
-be_local_closure(Persist_json_fdump_any,   /* name */
+be_local_closure(Persist_has,   /* name */
   be_nested_proto(
-    9,                          /* nstack */
-    3,                          /* argc */
+    5,                          /* nstack */
+    2,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 5]) {     /* constants */
-    /* K0   */  be_nested_str(json),
-    /* K1   */  be_nested_str(json_fdump_map),
-    /* K2   */  be_nested_str(json_fdump_list),
-    /* K3   */  be_nested_str(write),
-    /* K4   */  be_nested_str(dump),
+    ( &(const bvalue[ 2]) {     /* constants */
+    /* K0   */  be_nested_str(_p),
+    /* K1   */  be_nested_str(has),
     }),
-    &be_const_str_json_fdump_any,
+    &be_const_str_has,
     &be_const_str_solidified,
-    ( &(const binstruction[27]) {  /* code */
-      0xA40E0000,  //  0000  IMPORT	R3	K0
-      0x6010000F,  //  0001  GETGBL	R4	G15
-      0x5C140400,  //  0002  MOVE	R5	R2
-      0x60180013,  //  0003  GETGBL	R6	G19
-      0x7C100400,  //  0004  CALL	R4	2
-      0x78120004,  //  0005  JMPF	R4	#000B
-      0x8C100101,  //  0006  GETMET	R4	R0	K1
-      0x5C180200,  //  0007  MOVE	R6	R1
-      0x5C1C0400,  //  0008  MOVE	R7	R2
-      0x7C100600,  //  0009  CALL	R4	3
-      0x7002000E,  //  000A  JMP		#001A
-      0x6010000F,  //  000B  GETGBL	R4	G15
-      0x5C140400,  //  000C  MOVE	R5	R2
-      0x60180012,  //  000D  GETGBL	R6	G18
-      0x7C100400,  //  000E  CALL	R4	2
-      0x78120004,  //  000F  JMPF	R4	#0015
-      0x8C100102,  //  0010  GETMET	R4	R0	K2
-      0x5C180200,  //  0011  MOVE	R6	R1
-      0x5C1C0400,  //  0012  MOVE	R7	R2
-      0x7C100600,  //  0013  CALL	R4	3
-      0x70020004,  //  0014  JMP		#001A
-      0x8C100303,  //  0015  GETMET	R4	R1	K3
-      0x8C180704,  //  0016  GETMET	R6	R3	K4
-      0x5C200400,  //  0017  MOVE	R8	R2
-      0x7C180400,  //  0018  CALL	R6	2
-      0x7C100400,  //  0019  CALL	R4	2
-      0x80000000,  //  001A  RET	0
+    ( &(const binstruction[ 5]) {  /* code */
+      0x88080100,  //  0000  GETMBR	R2	R0	K0
+      0x8C080501,  //  0001  GETMET	R2	R2	K1
+      0x5C100200,  //  0002  MOVE	R4	R1
+      0x7C080400,  //  0003  CALL	R2	2
+      0x80040400,  //  0004  RET	1	R2
     })
   )
 );
@@ -309,11 +697,11 @@ be_local_closure(Persist_json_fdump_any,   /* name */
 
 
 /********************************************************************
-** Solidified function: save
+** Solidified function: zero
 ********************************************************************/
-be_local_closure(Persist_save,   /* name */
+be_local_closure(Persist_zero,   /* name */
   be_nested_proto(
-    7,                          /* nstack */
+    2,                          /* nstack */
     1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -321,55 +709,19 @@ be_local_closure(Persist_save,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 7]) {     /* constants */
-    /* K0   */  be_nested_str(_filename),
-    /* K1   */  be_nested_str(w),
-    /* K2   */  be_nested_str(json_fdump),
-    /* K3   */  be_nested_str(close),
-    /* K4   */  be_nested_str(write),
-    /* K5   */  be_nested_str(_X7B_X7D),
-    /* K6   */  be_nested_str(_dirty),
+    ( &(const bvalue[ 2]) {     /* constants */
+    /* K0   */  be_nested_str(_p),
+    /* K1   */  be_nested_str(_full),
     }),
-    &be_const_str_save,
+    &be_const_str_zero,
     &be_const_str_solidified,
-    ( &(const binstruction[37]) {  /* code */
-      0x4C040000,  //  0000  LDNIL	R1
-      0xA802000B,  //  0001  EXBLK	0	#000E
-      0x60080011,  //  0002  GETGBL	R2	G17
-      0x880C0100,  //  0003  GETMBR	R3	R0	K0
-      0x58100001,  //  0004  LDCONST	R4	K1
-      0x7C080400,  //  0005  CALL	R2	2
-      0x5C040400,  //  0006  MOVE	R1	R2
-      0x8C080102,  //  0007  GETMET	R2	R0	K2
-      0x5C100200,  //  0008  MOVE	R4	R1
-      0x7C080400,  //  0009  CALL	R2	2
-      0x8C080303,  //  000A  GETMET	R2	R1	K3
-      0x7C080200,  //  000B  CALL	R2	1
-      0xA8040001,  //  000C  EXBLK	1	1
-      0x70020013,  //  000D  JMP		#0022
-      0xAC080002,  //  000E  CATCH	R2	0	2
-      0x70020010,  //  000F  JMP		#0021
-      0x4C100000,  //  0010  LDNIL	R4
-      0x20100204,  //  0011  NE	R4	R1	R4
-      0x78120001,  //  0012  JMPF	R4	#0015
-      0x8C100303,  //  0013  GETMET	R4	R1	K3
-      0x7C100200,  //  0014  CALL	R4	1
-      0x60100011,  //  0015  GETGBL	R4	G17
-      0x88140100,  //  0016  GETMBR	R5	R0	K0
-      0x58180001,  //  0017  LDCONST	R6	K1
-      0x7C100400,  //  0018  CALL	R4	2
-      0x5C040800,  //  0019  MOVE	R1	R4
-      0x8C100304,  //  001A  GETMET	R4	R1	K4
-      0x58180005,  //  001B  LDCONST	R6	K5
-      0x7C100400,  //  001C  CALL	R4	2
-      0x8C100303,  //  001D  GETMET	R4	R1	K3
-      0x7C100200,  //  001E  CALL	R4	1
-      0xB0040403,  //  001F  RAISE	1	R2	R3
-      0x70020000,  //  0020  JMP		#0022
-      0xB0080000,  //  0021  RAISE	2	R0	R0
-      0x50080000,  //  0022  LDBOOL	R2	0	0
-      0x90020C02,  //  0023  SETMBR	R0	K6	R2
-      0x80000000,  //  0024  RET	0
+    ( &(const binstruction[ 6]) {  /* code */
+      0x60040013,  //  0000  GETGBL	R1	G19
+      0x7C040000,  //  0001  CALL	R1	0
+      0x90020001,  //  0002  SETMBR	R0	K0	R1
+      0x50040200,  //  0003  LDBOOL	R1	1	0
+      0x90020201,  //  0004  SETMBR	R0	K1	R1
+      0x80000000,  //  0005  RET	0
     })
   )
 );
@@ -377,84 +729,45 @@ be_local_closure(Persist_save,   /* name */
 
 
 /********************************************************************
-** Solidified function: load
+** Solidified function: replace
 ********************************************************************/
-be_local_closure(Persist_load,   /* name */
+be_local_closure(Persist_replace,   /* name */
   be_nested_proto(
-    9,                          /* nstack */
-    1,                          /* argc */
+    8,                          /* nstack */
+    3,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[12]) {     /* constants */
-    /* K0   */  be_nested_str(json),
-    /* K1   */  be_nested_str(path),
-    /* K2   */  be_nested_str(exists),
-    /* K3   */  be_nested_str(_filename),
-    /* K4   */  be_nested_str(r),
-    /* K5   */  be_nested_str(load),
-    /* K6   */  be_nested_str(read),
-    /* K7   */  be_nested_str(close),
-    /* K8   */  be_nested_str(_p),
-    /* K9   */  be_nested_str(BRY_X3A_X20failed_X20to_X20load_X20_persist_X2Ejson),
-    /* K10  */  be_nested_str(_dirty),
-    /* K11  */  be_nested_str(save),
+    ( &(const bvalue[ 5]) {     /* constants */
+    /* K0   */  be_nested_str(path),
+    /* K1   */  be_nested_str(rename),
+    /* K2   */  be_nested_str(remove),
+    /* K3   */  be_nested_str(cannot_X20rename_X20),
+    /* K4   */  be_nested_str(io_error),
     }),
-    &be_const_str_load,
+    &be_const_str_replace,
     &be_const_str_solidified,
-    ( &(const binstruction[49]) {  /* code */
-      0xA4060000,  //  0000  IMPORT	R1	K0
-      0xA40A0200,  //  0001  IMPORT	R2	K1
-      0x4C0C0000,  //  0002  LDNIL	R3
-      0x4C100000,  //  0003  LDNIL	R4
-      0x8C140502,  //  0004  GETMET	R5	R2	K2
-      0x881C0103,  //  0005  GETMBR	R7	R0	K3
-      0x7C140400,  //  0006  CALL	R5	2
-      0x78160025,  //  0007  JMPF	R5	#002E
-      0xA802000D,  //  0008  EXBLK	0	#0017
-      0x60140011,  //  0009  GETGBL	R5	G17
-      0x88180103,  //  000A  GETMBR	R6	R0	K3
-      0x581C0004,  //  000B  LDCONST	R7	K4
-      0x7C140400,  //  000C  CALL	R5	2
-      0x5C0C0A00,  //  000D  MOVE	R3	R5
-      0x8C140305,  //  000E  GETMET	R5	R1	K5
-      0x8C1C0706,  //  000F  GETMET	R7	R3	K6
-      0x7C1C0200,  //  0010  CALL	R7	1
-      0x7C140400,  //  0011  CALL	R5	2
-      0x5C100A00,  //  0012  MOVE	R4	R5
-      0x8C140707,  //  0013  GETMET	R5	R3	K7
-      0x7C140200,  //  0014  CALL	R5	1
-      0xA8040001,  //  0015  EXBLK	1	1
-      0x70020009,  //  0016  JMP		#0021
-      0xAC140002,  //  0017  CATCH	R5	0	2
-      0x70020006,  //  0018  JMP		#0020
-      0x4C1C0000,  //  0019  LDNIL	R7
-      0x201C0607,  //  001A  NE	R7	R3	R7
-      0x781E0001,  //  001B  JMPF	R7	#001E
-      0x8C1C0707,  //  001C  GETMET	R7	R3	K7
-      0x7C1C0200,  //  001D  CALL	R7	1
-      0xB0040A06,  //  001E  RAISE	1	R5	R6
-      0x70020000,  //  001F  JMP		#0021
-      0xB0080000,  //  0020  RAISE	2	R0	R0
-      0x6014000F,  //  0021  GETGBL	R5	G15
-      0x5C180800,  //  0022  MOVE	R6	R4
-      0x601C0013,  //  0023  GETGBL	R7	G19
-      0x7C140400,  //  0024  CALL	R5	2
-      0x78160001,  //  0025  JMPF	R5	#0028
-      0x90021004,  //  0026  SETMBR	R0	K8	R4
-      0x70020002,  //  0027  JMP		#002B
-      0x60140001,  //  0028  GETGBL	R5	G1
-      0x58180009,  //  0029  LDCONST	R6	K9
-      0x7C140200,  //  002A  CALL	R5	1
-      0x50140000,  //  002B  LDBOOL	R5	0	0
-      0x90021405,  //  002C  SETMBR	R0	K10	R5
-      0x70020001,  //  002D  JMP		#0030
-      0x8C14010B,  //  002E  GETMET	R5	R0	K11
-      0x7C140200,  //  002F  CALL	R5	1
-      0x80000000,  //  0030  RET	0
+    ( &(const binstruction[17]) {  /* code */
+      0xA40E0000,  //  0000  IMPORT	R3	K0
+      0x8C100701,  //  0001  GETMET	R4	R3	K1
+      0x5C180200,  //  0002  MOVE	R6	R1
+      0x5C1C0400,  //  0003  MOVE	R7	R2
+      0x7C100600,  //  0004  CALL	R4	3
+      0x74120009,  //  0005  JMPT	R4	#0010
+      0x8C100702,  //  0006  GETMET	R4	R3	K2
+      0x5C180400,  //  0007  MOVE	R6	R2
+      0x7C100400,  //  0008  CALL	R4	2
+      0x8C100701,  //  0009  GETMET	R4	R3	K1
+      0x5C180200,  //  000A  MOVE	R6	R1
+      0x5C1C0400,  //  000B  MOVE	R7	R2
+      0x7C100600,  //  000C  CALL	R4	3
+      0x74120001,  //  000D  JMPT	R4	#0010
+      0x00120601,  //  000E  ADD	R4	K3	R1
+      0xB0060804,  //  000F  RAISE	1	K4	R4
+      0x80000000,  //  0010  RET	0
     })
   )
 );
@@ -462,31 +775,88 @@ be_local_closure(Persist_load,   /* name */
 
 
 /********************************************************************
-** Solidified function: find
+** Solidified function: recover
 ********************************************************************/
-be_local_closure(Persist_find,   /* name */
+be_local_closure(Persist_recover,   /* name */
   be_nested_proto(
-    7,                          /* nstack */
-    3,                          /* argc */
+    10,                          /* nstack */
+    1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 2]) {     /* constants */
-    /* K0   */  be_nested_str(_p),
-    /* K1   */  be_nested_str(find),
+    ( &(const bvalue[12]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(path),
+    /* K2   */  be_nested_str(_filename),
+    /* K3   */  be_nested_str(_X2Etmp),
+    /* K4   */  be_nested_str(exists),
+    /* K5   */  be_nested_str(_logname),
+    /* K6   */  be_nested_str(r),
+    /* K7   */  be_nested_str(load),
+    /* K8   */  be_nested_str(read),
+    /* K9   */  be_nested_str(close),
+    /* K10  */  be_nested_str(replace),
+    /* K11  */  be_nested_str(remove),
     }),
-    &be_const_str_find,
+    &be_const_str_recover,
     &be_const_str_solidified,
-    ( &(const binstruction[ 6]) {  /* code */
-      0x880C0100,  //  0000  GETMBR	R3	R0	K0
-      0x8C0C0701,  //  0001  GETMET	R3	R3	K1
-      0x5C140200,  //  0002  MOVE	R5	R1
-      0x5C180400,  //  0003  MOVE	R6	R2
-      0x7C0C0600,  //  0004  CALL	R3	3
-      0x80040600,  //  0005  RET	1	R3
+    ( &(const binstruction[53]) {  /* code */
+      0xA4060000,  //  0000  IMPORT	R1	K0
+      0xA40A0200,  //  0001  IMPORT	R2	K1
+      0x880C0102,  //  0002  GETMBR	R3	R0	K2
+      0x000C0703,  //  0003  ADD	R3	R3	K3
+      0x8C100504,  //  0004  GETMET	R4	R2	K4
+      0x5C180600,  //  0005  MOVE	R6	R3
+      0x7C100400,  //  0006  CALL	R4	2
+      0x74120000,  //  0007  JMPT	R4	#0009
+      0x80000800,  //  0008  RET	0
+      0x4C100000,  //  0009  LDNIL	R4
+      0x8C140504,  //  000A  GETMET	R5	R2	K4
+      0x881C0105,  //  000B  GETMBR	R7	R0	K5
+      0x7C140400,  //  000C  CALL	R5	2
+      0x74160018,  //  000D  JMPT	R5	#0027
+      0x4C140000,  //  000E  LDNIL	R5
+      0xA802000D,  //  000F  EXBLK	0	#001E
+      0x60180011,  //  0010  GETGBL	R6	G17
+      0x5C1C0600,  //  0011  MOVE	R7	R3
+      0x58200006,  //  0012  LDCONST	R8	K6
+      0x7C180400,  //  0013  CALL	R6	2
+      0x5C140C00,  //  0014  MOVE	R5	R6
+      0x8C180307,  //  0015  GETMET	R6	R1	K7
+      0x8C200B08,  //  0016  GETMET	R8	R5	K8
+      0x7C200200,  //  0017  CALL	R8	1
+      0x7C180400,  //  0018  CALL	R6	2
+      0x5C100C00,  //  0019  MOVE	R4	R6
+      0x8C180B09,  //  001A  GETMET	R6	R5	K9
+      0x7C180200,  //  001B  CALL	R6	1
+      0xA8040001,  //  001C  EXBLK	1	1
+      0x70020008,  //  001D  JMP		#0027
+      0xAC180000,  //  001E  CATCH	R6	0	0
+      0x70020005,  //  001F  JMP		#0026
+      0x4C180000,  //  0020  LDNIL	R6
+      0x20180A06,  //  0021  NE	R6	R5	R6
+      0x781A0001,  //  0022  JMPF	R6	#0025
+      0x8C180B09,  //  0023  GETMET	R6	R5	K9
+      0x7C180200,  //  0024  CALL	R6	1
+      0x70020000,  //  0025  JMP		#0027
+      0xB0080000,  //  0026  RAISE	2	R0	R0
+      0x6014000F,  //  0027  GETGBL	R5	G15
+      0x5C180800,  //  0028  MOVE	R6	R4
+      0x601C0013,  //  0029  GETGBL	R7	G19
+      0x7C140400,  //  002A  CALL	R5	2
+      0x78160004,  //  002B  JMPF	R5	#0031
+      0x8C14010A,  //  002C  GETMET	R5	R0	K10
+      0x5C1C0600,  //  002D  MOVE	R7	R3
+      0x88200102,  //  002E  GETMBR	R8	R0	K2
+      0x7C140600,  //  002F  CALL	R5	3
+      0x70020002,  //  0030  JMP		#0034
+      0x8C14050B,  //  0031  GETMET	R5	R2	K11
+      0x5C1C0600,  //  0032  MOVE	R7	R3
+      0x7C140400,  //  0033  CALL	R5	2
+      0x80000000,  //  0034  RET	0
     })
   )
 );
@@ -494,11 +864,11 @@ be_local_closure(Persist_find,   /* name */
 
 
 /********************************************************************
-** Solidified function: init
+** Solidified function: remove
 ********************************************************************/
-be_local_closure(Persist_init,   /* name */
+be_local_closure(Persist_remove,   /* name */
   be_nested_proto(
-    6,                          /* nstack */
+    5,                          /* nstack */
     2,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -506,37 +876,22 @@ be_local_closure(Persist_init,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 6]) {     /* constants */
-    /* K0   */  be_nested_str(_filename),
-    /* K1   */  be_nested_str(_persist_X2Ejson),
-    /* K2   */  be_nested_str(_p),
-    /* K3   */  be_nested_str(copy),
-    /* K4   */  be_nested_str(load),
-    /* K5   */  be_nested_str(_dirty),
+    ( &(const bvalue[ 3]) {     /* constants */
+    /* K0   */  be_nested_str(_p),
+    /* K1   */  be_nested_str(remove),
+    /* K2   */  be_nested_str(_dirty),
     }),
-    &be_const_str_init,
+    &be_const_str_remove,
     &be_const_str_solidified,
-    ( &(const binstruction[20]) {  /* code */
-      0x90020101,  //  0000  SETMBR	R0	K0	K1
-      0x6008000F,  //  0001  GETGBL	R2	G15
-      0x5C0C0200,  //  0002  MOVE	R3	R1
-      0x60100013,  //  0003  GETGBL	R4	G19
-      0x7C080400,  //  0004  CALL	R2	2
-      0x780A0003,  //  0005  JMPF	R2	#000A
-      0x8C080303,  //  0006  GETMET	R2	R1	K3
-      0x7C080200,  //  0007  CALL	R2	1
-      0x90020402,  //  0008  SETMBR	R0	K2	R2
-      0x70020002,  //  0009  JMP		#000D
-      0x60080013,  //  000A  GETGBL	R2	G19
-      0x7C080000,  //  000B  CALL	R2	0
-      0x90020402,  //  000C  SETMBR	R0	K2	R2
-      0x8C080104,  //  000D  GETMET	R2	R0	K4
-      0x88100102,  //  000E  GETMBR	R4	R0	K2
-      0x88140100,  //  000F  GETMBR	R5	R0	K0
-      0x7C080600,  //  0010  CALL	R2	3
-      0x50080000,  //  0011  LDBOOL	R2	0	0
-      0x90020A02,  //  0012  SETMBR	R0	K5	R2
-      0x80000000,  //  0013  RET	0
+    ( &(const binstruction[ 8]) {  /* code */
+      0x88080100,  //  0000  GETMBR	R2	R0	K0
+      0x8C080501,  //  0001  GETMET	R2	R2	K1
+      0x5C100200,  //  0002  MOVE	R4	R1
+      0x7C080400,  //  0003  CALL	R2	2
+      0x88080102,  //  0004  GETMBR	R2	R0	K2
+      0x500C0200,  //  0005  LDBOOL	R3	1	0
+      0x98080203,  //  0006  SETIDX	R2	R1	R3
+      0x80000000,  //  0007  RET	0
     })
   )
 );
@@ -544,56 +899,85 @@ be_local_closure(Persist_init,   /* name */
 
 
 /********************************************************************
-** Solidified function: json_fdump_list
+** Solidified function: save_full
 ********************************************************************/
-be_local_closure(Persist_json_fdump_list,   /* name */
+be_local_closure(Persist_save_full,   /* name */
   be_nested_proto(
     9,                          /* nstack */
-    3,                          /* argc */
+    1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 8]) {     /* constants */
-    /* K0   */  be_nested_str(json),
-    /* K1   */  be_nested_str(write),
-    /* K2   */  be_nested_str(_X5B),
-    /* K3   */  be_const_int(0),
-    /* K4   */  be_nested_str(_X2C),
-    /* K5   */  be_nested_str(json_fdump_any),
-    /* K6   */  be_const_int(1),
-    /* K7   */  be_nested_str(_X5D),
+    ( &(const bvalue[14]) {     /* constants */
+    /* K0   */  be_nested_str(path),
+    /* K1   */  be_nested_str(_filename),
+    /* K2   */  be_nested_str(_X2Etmp),
+    /* K3   */  be_nested_str(w),
+    /* K4   */  be_nested_str(json_fdump),
+    /* K5   */  be_nested_str(close),
+    /* K6   */  be_nested_str(remove),
+    /* K7   */  be_nested_str(exists),
+    /* K8   */  be_nested_str(_logname),
+    /* K9   */  be_nested_str(_log_size),
+    /* K10  */  be_const_int(0),
+    /* K11  */  be_nested_str(replace),
+    /* K12  */  be_nested_str(_dirty),
+    /* K13  */  be_nested_str(_full),
     }),
-    &be_const_str_json_fdump_list,
+    &be_const_str_save_full,
     &be_const_str_solidified,
-    ( &(const binstruction[25]) {  /* code */
-      0xA40E0000,  //  0000  IMPORT	R3	K0
-      0x8C100301,  //  0001  GETMET	R4	R1	K1
-      0x58180002,  //  0002  LDCONST	R6	K2
-      0x7C100400,  //  0003  CALL	R4	2
-      0x58100003,  //  0004  LDCONST	R4	K3
-      0x6014000C,  //  0005  GETGBL	R5	G12
-      0x5C180400,  //  0006  MOVE	R6	R2
-      0x7C140200,  //  0007  CALL	R5	1
-      0x14140805,  //  0008  LT	R5	R4	R5
-      0x7816000A,  //  0009  JMPF	R5	#0015
-      0x24140903,  //  000A  GT	R5	R4	K3
-      0x78160002,  //  000B  JMPF	R5	#000F
-      0x8C140301,  //  000C  GETMET	R5	R1	K1
-      0x581C0004,  //  000D  LDCONST	R7	K4
-      0x7C140400,  //  000E  CALL	R5	2
-      0x8C140105,  //  000F  GETMET	R5	R0	K5
-      0x5C1C0200,  //  0010  MOVE	R7	R1
-      0x94200404,  //  0011  GETIDX	R8	R2	R4
-      0x7C140600,  //  0012  CALL	R5	3
-      0x00100906,  //  0013  ADD	R4	R4	K6
-      0x7001FFEF,  //  0014  JMP		#0005
-      0x8C140301,  //  0015  GETMET	R5	R1	K1
-      0x581C0007,  //  0016  LDCONST	R7	K7
-      0x7C140400,  //  0017  CALL	R5	2
-      0x80000000,  //  0018  RET	0
+    ( &(const binstruction[48]) {  /* code */
+      0xA4060000,  //  0000  IMPORT	R1	K0
+      0x4C080000,  //  0001  LDNIL	R2
+      0x880C0101,  //  0002  GETMBR	R3	R0	K1
+      0x000C0702,  //  0003  ADD	R3	R3	K2
+      0xA802000B,  //  0004  EXBLK	0	#0011
+      0x60100011,  //  0005  GETGBL	R4	G17
+      0x5C140600,  //  0006  MOVE	R5	R3
+      0x58180003,  //  0007  LDCONST	R6	K3
+      0x7C100400,  //  0008  CALL	R4	2
+      0x5C080800,  //  0009  MOVE	R2	R4
+      0x8C100104,  //  000A  GETMET	R4	R0	K4
+      0x5C180400,  //  000B  MOVE	R6	R2
+      0x7C100400,  //  000C  CALL	R4	2
+      0x8C100505,  //  000D  GETMET	R4	R2	K5
+      0x7C100200,  //  000E  CALL	R4	1
+      0xA8040001,  //  000F  EXBLK	1	1
+      0x7002000C,  //  0010  JMP		#001E
+      0xAC100002,  //  0011  CATCH	R4	0	2
+      0x70020009,  //  0012  JMP		#001D
+      0x4C180000,  //  0013  LDNIL	R6
+      0x20180406,  //  0014  NE	R6	R2	R6
+      0x781A0001,  //  0015  JMPF	R6	#0018
+      0x8C180505,  //  0016  GETMET	R6	R2	K5
+      0x7C180200,  //  0017  CALL	R6	1
+      0x8C180306,  //  0018  GETMET	R6	R1	K6
+      0x5C200600,  //  0019  MOVE	R8	R3
+      0x7C180400,  //  001A  CALL	R6	2
+      0xB0040805,  //  001B  RAISE	1	R4	R5
+      0x70020000,  //  001C  JMP		#001E
+      0xB0080000,  //  001D  RAISE	2	R0	R0
+      0x8C100307,  //  001E  GETMET	R4	R1	K7
+      0x88180108,  //  001F  GETMBR	R6	R0	K8
+      0x7C100400,  //  0020  CALL	R4	2
+      0x78120002,  //  0021  JMPF	R4	#0025
+      0x8C100306,  //  0022  GETMET	R4	R1	K6
+      0x88180108,  //  0023  GETMBR	R6	R0	K8
+      0x7C100400,  //  0024  CALL	R4	2
+      0x9002130A,  //  0025  SETMBR	R0	K9	K10
+      0x8C10010B,  //  0026  GETMET	R4	R0	K11
+      0x5C180600,  //  0027  MOVE	R6	R3
+      0x881C0101,  //  0028  GETMBR	R7	R0	K1
+      0x7C100600,  //  0029  CALL	R4	3
+      0x60100013,  //  002A  GETGBL	R4	G19
+      0x7C100000,  //  002B  CALL	R4	0
+      0x90021804,  //  002C  SETMBR	R0	K12	R4
+      0x50100000,  //  002D  LDBOOL	R4	0	0
+      0x90021A04,  //  002E  SETMBR	R0	K13	R4
+      0x80000000,  //  002F  RET	0
     })
   )
 );
@@ -601,30 +985,164 @@ be_local_closure(Persist_json_fdump_list,   /* name */
 
 
 /********************************************************************
-** Solidified function: has
+** Solidified function: save_log
 ********************************************************************/
-be_local_closure(Persist_has,   /* name */
+be_local_closure(Persist_save_log,   /* name */
   be_nested_proto(
-    5,                          /* nstack */
-    2,                          /* argc */
+    12,                          /* nstack */
+    1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 2]) {     /* constants */
-    /* K0   */  be_nested_str(_p),
-    /* K1   */  be_nested_str(has),
+    ( &(const bvalue[20]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(_p),
+    /* K2   */  be_nested_str(keys),
+    /* K3   */  be_nested_str(_dirty),
+    /* K4   */  be_nested_str(stop_iteration),
+    /* K5   */  be_const_int(0),
+    /* K6   */  be_nested_str(_logname),
+    /* K7   */  be_nested_str(a),
+    /* K8   */  be_nested_str(has),
+    /* K9   */  be_nested_str(write),
+    /* K10  */  be_nested_str(_X7B),
+    /* K11  */  be_nested_str(dump),
+    /* K12  */  be_nested_str(_X3A),
+    /* K13  */  be_nested_str(json_fdump_any),
+    /* K14  */  be_nested_str(_X7D_X0A),
+    /* K15  */  be_nested_str(push),
+    /* K16  */  be_nested_str(_X0A),
+    /* K17  */  be_nested_str(_log_size),
+    /* K18  */  be_nested_str(size),
+    /* K19  */  be_nested_str(close),
     }),
-    &be_const_str_has,
+    &be_const_str_save_log,
     &be_const_str_solidified,
-    ( &(const binstruction[ 5]) {  /* code */
-      0x88080100,  //  0000  GETMBR	R2	R0	K0
-      0x8C080501,  //  0001  GETMET	R2	R2	K1
-      0x5C100200,  //  0002  MOVE	R4	R1
-      0x7C080400,  //  0003  CALL	R2	2
-      0x80040400,  //  0004  RET	1	R2
+    ( &(const binstruction[121]) {  /* code */
+      0xA4060000,  //  0000  IMPORT	R1	K0
+      0x4C080000,  //  0001  LDNIL	R2
+      0x600C0012,  //  0002  GETGBL	R3	G18
+      0x7C0C0000,  //  0003  CALL	R3	0
+      0x60100010,  //  0004  GETGBL	R4	G16
+      0x88140101,  //  0005  GETMBR	R5	R0	K1
+      0x8C140B02,  //  0006  GETMET	R5	R5	K2
+      0x7C140200,  //  0007  CALL	R5	1
+      0x7C100200,  //  0008  CALL	R4	1
+      0xA8020011,  //  0009  EXBLK	0	#001C
+      0x5C140800,  //  000A  MOVE	R5	R4
+      0x7C140000,  //  000B  CALL	R5	0
+      0x88180101,  //  000C  GETMBR	R6	R0	K1
+      0x94180C05,  //  000D  GETIDX	R6	R6	R5
+      0x601C000F,  //  000E  GETGBL	R7	G15
+      0x5C200C00,  //  000F  MOVE	R8	R6
+      0x60240013,  //  0010  GETGBL	R9	G19
+      0x7C1C0400,  //  0011  CALL	R7	2
+      0x741E0004,  //  0012  JMPT	R7	#0018
+      0x601C000F,  //  0013  GETGBL	R7	G15
+      0x5C200C00,  //  0014  MOVE	R8	R6
+      0x60240012,  //  0015  GETGBL	R9	G18
+      0x7C1C0400,  //  0016  CALL	R7	2
+      0x781E0002,  //  0017  JMPF	R7	#001B
+      0x881C0103,  //  0018  GETMBR	R7	R0	K3
+      0x50200200,  //  0019  LDBOOL	R8	1	0
+      0x981C0A08,  //  001A  SETIDX	R7	R5	R8
+      0x7001FFED,  //  001B  JMP		#000A
+      0x58100004,  //  001C  LDCONST	R4	K4
+      0xAC100200,  //  001D  CATCH	R4	1	0
+      0xB0080000,  //  001E  RAISE	2	R0	R0
+      0x6010000C,  //  001F  GETGBL	R4	G12
+      0x88140103,  //  0020  GETMBR	R5	R0	K3
+      0x7C100200,  //  0021  CALL	R4	1
+      0x1C100905,  //  0022  EQ	R4	R4	K5
+      0x78120000,  //  0023  JMPF	R4	#0025
+      0x80000800,  //  0024  RET	0
+      0xA8020044,  //  0025  EXBLK	0	#006B
+      0x60100011,  //  0026  GETGBL	R4	G17
+      0x88140106,  //  0027  GETMBR	R5	R0	K6
+      0x58180007,  //  0028  LDCONST	R6	K7
+      0x7C100400,  //  0029  CALL	R4	2
+      0x5C080800,  //  002A  MOVE	R2	R4
+      0x60100010,  //  002B  GETGBL	R4	G16
+      0x88140103,  //  002C  GETMBR	R5	R0	K3
+      0x8C140B02,  //  002D  GETMET	R5	R5	K2
+      0x7C140200,  //  002E  CALL	R5	1
+      0x7C100200,  //  002F  CALL	R4	1
+      0xA8020022,  //  0030  EXBLK	0	#0054
+      0x5C140800,  //  0031  MOVE	R5	R4
+      0x7C140000,  //  0032  CALL	R5	0
+      0x88180101,  //  0033  GETMBR	R6	R0	K1
+      0x8C180D08,  //  0034  GETMET	R6	R6	K8
+      0x5C200A00,  //  0035  MOVE	R8	R5
+      0x7C180400,  //  0036  CALL	R6	2
+      0x781A0015,  //  0037  JMPF	R6	#004E
+      0x8C180509,  //  0038  GETMET	R6	R2	K9
+      0x5820000A,  //  0039  LDCONST	R8	K10
+      0x7C180400,  //  003A  CALL	R6	2
+      0x8C180509,  //  003B  GETMET	R6	R2	K9
+      0x8C20030B,  //  003C  GETMET	R8	R1	K11
+      0x60280008,  //  003D  GETGBL	R10	G8
+      0x5C2C0A00,  //  003E  MOVE	R11	R5
+      0x7C280200,  //  003F  CALL	R10	1
+      0x7C200400,  //  0040  CALL	R8	2
+      0x7C180400,  //  0041  CALL	R6	2
+      0x8C180509,  //  0042  GETMET	R6	R2	K9
+      0x5820000C,  //  0043  LDCONST	R8	K12
+      0x7C180400,  //  0044  CALL	R6	2
+      0x8C18010D,  //  0045  GETMET	R6	R0	K13
+      0x5C200400,  //  0046  MOVE	R8	R2
+      0x88240101,  //  0047  GETMBR	R9	R0	K1
+      0x94241205,  //  0048  GETIDX	R9	R9	R5
+      0x7C180600,  //  0049  CALL	R6	3
+      0x8C180509,  //  004A  GETMET	R6	R2	K9
+      0x5820000E,  //  004B  LDCONST	R8	K14
+      0x7C180400,  //  004C  CALL	R6	2
+      0x70020004,  //  004D  JMP		#0053
+      0x8C18070F,  //  004E  GETMET	R6	R3	K15
+      0x60200008,  //  004F  GETGBL	R8	G8
+      0x5C240A00,  //  0050  MOVE	R9	R5
+      0x7C200200,  //  0051  CALL	R8	1
+      0x7C180400,  //  0052  CALL	R6	2
+      0x7001FFDC,  //  0053  JMP		#0031
+      0x58100004,  //  0054  LDCONST	R4	K4
+      0xAC100200,  //  0055  CATCH	R4	1	0
+      0xB0080000,  //  0056  RAISE	2	R0	R0
+      0x6010000C,  //  0057  GETGBL	R4	G12
+      0x5C140600,  //  0058  MOVE	R5	R3
+      0x7C100200,  //  0059  CALL	R4	1
+      0x24100905,  //  005A  GT	R4	R4	K5
+      0x78120007,  //  005B  JMPF	R4	#0064
+      0x8C100509,  //  005C  GETMET	R4	R2	K9
+      0x8C18030B,  //  005D  GETMET	R6	R1	K11
+      0x5C200600,  //  005E  MOVE	R8	R3
+      0x7C180400,  //  005F  CALL	R6	2
+      0x7C100400,  //  0060  CALL	R4	2
+      0x8C100509,  //  0061  GETMET	R4	R2	K9
+      0x58180010,  //  0062  LDCONST	R6	K16
+      0x7C100400,  //  0063  CALL	R4	2
+      0x8C100512,  //  0064  GETMET	R4	R2	K18
+      0x7C100200,  //  0065  CALL	R4	1
+      0x90022204,  //  0066  SETMBR	R0	K17	R4
+      0x8C100513,  //  0067  GETMET	R4	R2	K19
+      0x7C100200,  //  0068  CALL	R4	1
+      0xA8040001,  //  0069  EXBLK	1	1
+      0x70020009,  //  006A  JMP		#0075
+      0xAC100002,  //  006B  CATCH	R4	0	2
+      0x70020006,  //  006C  JMP		#0074
+      0x4C180000,  //  006D  LDNIL	R6
+      0x20180406,  //  006E  NE	R6	R2	R6
+      0x781A0001,  //  006F  JMPF	R6	#0072
+      0x8C180513,  //  0070  GETMET	R6	R2	K19
+      0x7C180200,  //  0071  CALL	R6	1
+      0xB0040805,  //  0072  RAISE	1	R4	R5
+      0x70020000,  //  0073  JMP		#0075
+      0xB0080000,  //  0074  RAISE	2	R0	R0
+      0x60100013,  //  0075  GETGBL	R4	G19
+      0x7C100000,  //  0076  CALL	R4	0
+      0x90020604,  //  0077  SETMBR	R0	K3	R4
+      0x80000000,  //  0078  RET	0
     })
   )
 );
@@ -635,26 +1153,34 @@ be_local_closure(Persist_has,   /* name */
 ** Solidified class: Persist
 ********************************************************************/
 be_local_class(Persist,
-    3,
+    6,
     NULL,
-    be_nested_map(16,
+    be_nested_map(24,
     ( (struct bmapnode*) &(const bmapnode[]) {
-        { be_const_key(has, 6), be_const_closure(Persist_has_closure) },
-        { be_const_key(setmember, -1), be_const_closure(Persist_setmember_closure) },
-        { be_const_key(remove, -1), be_const_closure(Persist_remove_closure) },
-        { be_const_key(zero, 0), be_const_closure(Persist_zero_closure) },
-        { be_const_key(json_fdump, -1), be_const_closure(Persist_json_fdump_closure) },
-        { be_const_key(json_fdump_list, 2), be_const_closure(Persist_json_fdump_list_closure) },
-        { be_const_key(init, 15), be_const_closure(Persist_init_closure) },
+        { be_const_key(save, 22), be_const_closure(Persist_save_closure) },
+        { be_const_key(setmember, 23), be_const_closure(Persist_setmember_closure) },
+        { be_const_key(_p, -1), be_const_var(2) },
+        { be_const_key(init, -1), be_const_closure(Persist_init_closure) },
+        { be_const_key(save_log, -1), be_const_closure(Persist_save_log_closure) },
+        { be_const_key(save_full, -1), be_const_closure(Persist_save_full_closure) },
+        { be_const_key(json_fdump_list, -1), be_const_closure(Persist_json_fdump_list_closure) },
+        { be_const_key(recover, 16), be_const_closure(Persist_recover_closure) },
+        { be_const_key(_log_size, -1), be_const_var(5) },
+        { be_const_key(json_fdump_any, 4), be_const_closure(Persist_json_fdump_any_closure) },
         { be_const_key(find, -1), be_const_closure(Persist_find_closure) },
-        { be_const_key(save, -1), be_const_closure(Persist_save_closure) },
-        { be_const_key(json_fdump_any, 12), be_const_closure(Persist_json_fdump_any_closure) },
-        { be_const_key(_p, 7), be_const_var(1) },
         { be_const_key(_filename, -1), be_const_var(0) },
+        { be_const_key(json_fdump, 5), be_const_closure(Persist_json_fdump_closure) },
+        { be_const_key(json_fdump_map, 6), be_const_closure(Persist_json_fdump_map_closure) },
+        { be_const_key(_dirty, -1), be_const_var(3) },
+        { be_const_key(_logname, 20), be_const_var(1) },
+        { be_const_key(replace, 17), be_const_closure(Persist_replace_closure) },
+        { be_const_key(zero, 18), be_const_closure(Persist_zero_closure) },
+        { be_const_key(has, -1), be_const_closure(Persist_has_closure) },
+        { be_const_key(member, 7), be_const_closure(Persist_member_closure) },
+        { be_const_key(_full, -1), be_const_var(4) },
+        { be_const_key(remove, -1), be_const_closure(Persist_remove_closure) },
+        { be_const_key(load_log, -1), be_const_closure(Persist_load_log_closure) },
         { be_const_key(load, -1), be_const_closure(Persist_load_closure) },
-        { be_const_key(json_fdump_map, 5), be_const_closure(Persist_json_fdump_map_closure) },
-        { be_const_key(_dirty, -1), be_const_var(2) },
-        { be_const_key(member, -1), be_const_closure(Persist_member_closure) },
     })),
     be_str_literal("Persist")
 );
@@ -688,7 +1214,6 @@ be_local_closure(persist__anonymous_,   /* name */
 );
 /*******************************************************************/
 
-
 /********************************************************************
 ** Solidified module: persist
 ********************************************************************/
@@ -342,6 +342,19 @@ int be_unlink(const char *filename)
     return 0;
 }
 
+int be_rename(const char *from, const char *to)
+{
+#ifdef USE_UFILESYS
+    char from2[strlen(from) + 2];
+    char to2[strlen(to) + 2];
+    from2[0] = to2[0] = '/';
+    strcpy(from2 + (from[0] == '/' ? 0 : 1), from);   // prepend with '/' if needed
+    strcpy(to2 + (to[0] == '/' ? 0 : 1), to);
+    return zip_ufsp.rename(from2, to2);
+#endif // USE_UFILESYS
+    return 0;
+}
+
 #if BE_USE_FILE_SYSTEM
 #if defined(USE_FATFS) /* FatFs */
 
@@ -7,6 +7,7 @@
  *******************************************************************/
 #include "be_constobj.h"
 #include "be_mem.h"
+#include "be_exec.h"
 #include "re1.5.h"
 
 /********************************************************************
@@ -17,6 +18,7 @@ class re_pattern
   var _p          # comobj containing the compiled bytecode for the pattern
 
   def search() end
+  def searchall() end
   def match() end
   def split() end
 end
@@ -26,6 +28,7 @@ re = module("re")
 re.compile = def (regex_str) end    # native
 re.match = def (regex_str, str) end # native
 re.search = def (regex_str, str) end # native
+re.searchall = def (regex_str, str [, limit]) end # native
 re.split = def (regex_str, str) end # native
 
 
@@ -42,22 +45,124 @@ int be_free_comobj(bvm* vm) {
   be_return_nil(vm);
 }
 
+/********************************************************************
+** Compiled patterns
+**
+** Patterns passed as strings to `re.search()`, `re.match()`, `re.split()`
+** and `re.searchall()` are compiled once and kept in a small LRU cache.
+** The cache only holds plain memory, not Berry objects.
+********************************************************************/
+#define BE_RE_CACHE_SIZE          4       // number of compiled patterns kept
+#define BE_RE_BACKTRACK_MAX_LEN   64      // use pikevm for non-anchored search on longer strings
+
+typedef struct {
+  char *pattern;          // copy of the pattern, NULL if slot is empty
+  ByteProg *code;
+  uint32_t last_used;
+} be_re_cache_t;
+
+static be_re_cache_t be_re_cache[BE_RE_CACHE_SIZE];
+static uint32_t be_re_cache_counter = 0;
+
+// compile pattern, raises an exception in case of error
+static ByteProg * be_re_compile_code(bvm *vm, const char *regex_str) {
+  int sz = re1_5_sizecode(regex_str);
+  if (sz < 0) {
+    be_raise(vm, "internal_error", "error in regex");
+  }
+
+  ByteProg *code = be_os_malloc(sizeof(ByteProg) + sz);
+  if (code == NULL) {
+    be_throw(vm, BE_MALLOC_FAIL);
+  }
+  int ret = re1_5_compilecode(code, regex_str);
+  if (ret != 0) {
+    be_os_free(code);
+    be_raise(vm, "internal_error", "error in regex");
+  }
+  return code;
+}
+
+// get compiled pattern from cache, or compile it and evict the least recently used
+static ByteProg * be_re_get_code(bvm *vm, const char *regex_str) {
+  be_re_cache_t *slot = &be_re_cache[0];
+  for (int i = 0; i < BE_RE_CACHE_SIZE; i++) {
+    be_re_cache_t *entry = &be_re_cache[i];
+    if (entry->pattern && strcmp(entry->pattern, regex_str) == 0) {
+      entry->last_used = ++be_re_cache_counter;
+      return entry->code;
+    }
+    if (entry->last_used < slot->last_used) { slot = entry; }
+  }
+
+  ByteProg *code = be_re_compile_code(vm, regex_str);
+  size_t len = strlen(regex_str) + 1;
+  char *pattern = be_os_malloc(len);
+  if (pattern == NULL) {
+    be_os_free(code);
+    be_throw(vm, BE_MALLOC_FAIL);
+  }
+  memcpy(pattern, regex_str, len);
+  be_os_free(slot->pattern);
+  be_os_free(slot->code);
+  slot->pattern = pattern;
+  slot->code = code;
+  slot->last_used = ++be_re_cache_counter;
+  return code;
+}
+
+// returns true if the pattern contains a loop (`*`, `+` or `?` with backward jump)
+// besides the non-anchored prefix, backtracking can then be exponential
+static bbool be_re_has_loop(ByteProg *code) {
+  const char *pc = code->insts + NON_ANCHORED_PREFIX;
+  const char *end = code->insts + code->bytelen;
+  while (pc < end) {
+    switch (*pc & 0x7f) {
+      case Jmp:
+      case Split:
+      case RSplit:
+        if ((signed char)pc[1] < 0) { return btrue; }
+        pc += 2;
+        break;
+      case Class:
+      case ClassNot:
+        pc += (unsigned char)pc[1] * 2 + 2;
+        break;
+      case Char:
+      case NamedClass:
+      case Save:
+        pc += 2;
+        break;
+      default:
+        pc++;
+        break;
+    }
+  }
+  return bfalse;
+}
+
+// run the matcher, the recursive backtracker is fast for short subjects and patterns
+// without loops, otherwise use the pikevm which runs in linear time with bounded stack
+static int be_re_run(bvm *vm, ByteProg *code, Subject *subj, const char **sub, int sub_els, bbool is_anchored) {
+  if (sub_els <= MAXSUB &&
+      ((!is_anchored && (subj->end - subj->begin > BE_RE_BACKTRACK_MAX_LEN)) || be_re_has_loop(code))) {
+    int ret = re1_5_pikevm(code, subj, sub, sub_els, is_anchored);
+    cleanmarks(code);     // pikevm leaves marks in the bytecode
+    if (ret == RE1_5_NOMEM) {
+      be_throw(vm, BE_MALLOC_FAIL);
+    }
+    return ret;
+  }
+  return re1_5_recursiveloopprog(code, subj, sub, sub_els, is_anchored);
+}
+
 // Native functions be_const_func()
 // Berry: `re.compile(pattern:string) -> instance(be_pattern)`
 int be_re_compile(bvm *vm) {
   int32_t argc = be_top(vm); // Get the number of arguments
   if (argc >= 1 && be_isstring(vm, 1)) {
     const char * regex_str = be_tostring(vm, 1);
-	  int sz = re1_5_sizecode(regex_str);
-  	if (sz < 0) {
-      be_raise(vm, "internal_error", "error in regex");
-	  }
-
-    ByteProg *code = be_os_malloc(sizeof(ByteProg) + sz);
-    int ret = re1_5_compilecode(code, regex_str);
-    if (ret != 0) {
-      be_raise(vm, "internal_error", "error in regex");
-    }
+    ByteProg *code = be_re_compile_code(vm, regex_str);
     be_pushntvclass(vm, &be_class_re_pattern);
     be_call(vm, 0);
     be_newcomobj(vm, code, &be_free_comobj);
@@ -68,6 +173,20 @@ int be_re_compile(bvm *vm) {
   be_raise(vm, "type_error", NULL);
 }
 
+// push a list of the matched groups
+static void be_re_push_match(bvm *vm, const char **sub, int sub_els) {
+  be_newobject(vm, "list");
+  int k;
+  for(k = sub_els; k > 0; k--)
+    if(sub[k-1])
+      break;
+  for (int i = 0; i < k; i += 2) {
+    be_pushnstring(vm, sub[i], sub[i+1] - sub[i]);
+    be_data_push(vm, -2);
+    be_pop(vm, 1);
+  }
+  be_pop(vm, 1);    // remove list
+}
 
 int be_re_match_search_run(bvm *vm, ByteProg *code, const char *hay, bbool is_anchored) {
   Subject subj = {hay, hay + strlen(hay)};
@@ -75,21 +194,34 @@ int be_re_match_search_run(bvm *vm, ByteProg *code, const char *hay, bbool is_an
   int sub_els = (code->sub + 1) * 2;
   const char *sub[sub_els];
 
-  if (!re1_5_recursiveloopprog(code, &subj, sub, sub_els, is_anchored)) {
+  if (!be_re_run(vm, code, &subj, sub, sub_els, is_anchored)) {
     be_return_nil(vm);    // no match
   }
 
+  be_re_push_match(vm, sub, sub_els);
+  be_return(vm);    // return list object
+}
+
+// returns a list of all non-overlapping matches, each being a list of groups
+int be_re_search_all_run(bvm *vm, ByteProg *code, const char *hay, int limit) {
+  Subject subj = {hay, hay + strlen(hay)};
+
+  int sub_els = (code->sub + 1) * 2;
+  const char *sub[sub_els];
+
   be_newobject(vm, "list");
-  int k;
-  for(k = sub_els; k > 0; k--)
-    if(sub[k-1])
+  while (limit != 0 && subj.begin <= subj.end) {
+    if (!be_re_run(vm, code, &subj, sub, sub_els, bfalse)) {
       break;
-  for (int i = 0; i < k; i += 2) {
-    be_pushnstring(vm, sub[i], sub[i+1] - sub[i]);
+    }
+    be_re_push_match(vm, sub, sub_els);
     be_data_push(vm, -2);
     be_pop(vm, 1);
+    // continue after the match, skip one char if the match is empty
+    subj.begin = (sub[1] > sub[0]) ? sub[1] : sub[1] + 1;
+    limit--;
   }
-  be_pop(vm, 1);    // remove list 
+  be_pop(vm, 1);    // remove list
   be_return(vm);    // return list object
 }
 
@@ -98,16 +230,7 @@ int be_re_match_search(bvm *vm, bbool is_anchored) {
   if (argc >= 2 && be_isstring(vm, 1) && be_isstring(vm, 2)) {
     const char * regex_str = be_tostring(vm, 1);
     const char * hay = be_tostring(vm, 2);
-	  int sz = re1_5_sizecode(regex_str);
-  	if (sz < 0) {
-      be_raise(vm, "internal_error", "error in regex");
-	  }
-
-    ByteProg *code = be_os_malloc(sizeof(ByteProg) + sz);
-    int ret = re1_5_compilecode(code, regex_str);
-    if (ret != 0) {
-      be_raise(vm, "internal_error", "error in regex");
-    }
+    ByteProg *code = be_re_get_code(vm, regex_str);
     return be_re_match_search_run(vm, code, hay, is_anchored);
   }
   be_raise(vm, "type_error", NULL);
@@ -122,6 +245,22 @@ int be_re_search(bvm *vm) {
   return be_re_match_search(vm, bfalse);
 }
 
+// Berry: `re.searchall(pattern:string, s:string [, limit:int]) -> list(list(string))`
+int be_re_search_all(bvm *vm) {
+  int32_t argc = be_top(vm); // Get the number of arguments
+  if (argc >= 2 && be_isstring(vm, 1) && be_isstring(vm, 2)) {
+    const char * regex_str = be_tostring(vm, 1);
+    const char * hay = be_tostring(vm, 2);
+    int limit = -1;
+    if (argc >= 3) {
+      limit = be_toint(vm, 3);
+    }
+    ByteProg *code = be_re_get_code(vm, regex_str);
+    return be_re_search_all_run(vm, code, hay, limit);
+  }
+  be_raise(vm, "type_error", NULL);
+}
+
 // Berry: `re_pattern.search(s:string) -> list(string)`
 int re_pattern_search(bvm *vm) {
   int32_t argc = be_top(vm); // Get the number of arguments
@@ -134,6 +273,22 @@ int re_pattern_search(bvm *vm) {
   be_raise(vm, "type_error", NULL);
 }
 
+// Berry: `re_pattern.searchall(s:string [, limit:int]) -> list(list(string))`
+int re_pattern_search_all(bvm *vm) {
+  int32_t argc = be_top(vm); // Get the number of arguments
+  if (argc >= 2 && be_isstring(vm, 2)) {
+    const char * hay = be_tostring(vm, 2);
+    int limit = -1;
+    if (argc >= 3) {
+      limit = be_toint(vm, 3);
+    }
+    be_getmember(vm, 1, "_p");
+    ByteProg * code = (ByteProg*) be_tocomptr(vm, -1);
+    return be_re_search_all_run(vm, code, hay, limit);
+  }
+  be_raise(vm, "type_error", NULL);
+}
+
 // Berry: `re_pattern.match(s:string) -> list(string)`
 int re_pattern_match(bvm *vm) {
   int32_t argc = be_top(vm); // Get the number of arguments
@@ -155,7 +310,7 @@ int re_pattern_split_run(bvm *vm, ByteProg *code, const char *hay, int split_lim
 
   be_newobject(vm, "list");
   while (1) {
-    if (split_limit == 0 || !re1_5_recursiveloopprog(code, &subj, sub, sub_els, bfalse)) {
+    if (split_limit == 0 || !be_re_run(vm, code, &subj, sub, sub_els, bfalse)) {
       be_pushnstring(vm, subj.begin, subj.end - subj.begin);
       be_data_push(vm, -2);
       be_pop(vm, 1);
@@ -202,16 +357,7 @@ int be_re_split(bvm *vm) {
     if (argc >= 3) {
       split_limit = be_toint(vm, 3);
     }
-	  int sz = re1_5_sizecode(regex_str);
-  	if (sz < 0) {
-      be_raise(vm, "internal_error", "error in regex");
-	  }
-
-    ByteProg *code = be_os_malloc(sizeof(ByteProg) + sz);
-    int ret = re1_5_compilecode(code, regex_str);
-    if (ret != 0) {
-      be_raise(vm, "internal_error", "error in regex");
-    }
+    ByteProg *code = be_re_get_code(vm, regex_str);
     return re_pattern_split_run(vm, code, hay, split_limit);
   }
   be_raise(vm, "type_error", NULL);
@@ -222,12 +368,13 @@ int be_re_split(bvm *vm) {
 ********************************************************************/
 be_local_module(re,
     "re",
-    be_nested_map(4,
+    be_nested_map(5,
     ( (struct bmapnode*) &(const bmapnode[]) {
-        { be_nested_key("compile", 1000265118, 7, -1), be_const_func(be_re_compile) },
-        { be_nested_key("search", -2144130903, 6, -1), be_const_func(be_re_search) },
-        { be_nested_key("match", 2116038550, 5, 0), be_const_func(be_re_match) },
+        { be_nested_key("match", 2116038550, 5, -1), be_const_func(be_re_match) },
         { be_nested_key("split", -2017972765, 5, -1), be_const_func(be_re_split) },
+        { be_nested_key("compile", 1000265118, 7, -1), be_const_func(be_re_compile) },
+        { be_nested_key("search", -2144130903, 6, 2), be_const_func(be_re_search) },
+        { be_nested_key("searchall", -472428912, 9, -1), be_const_func(be_re_search_all) },
     }))
 );
 BE_EXPORT_VARIABLE be_define_const_native_module(re);
@@ -241,12 +388,13 @@ BE_EXPORT_VARIABLE be_define_const_native_module(re);
 be_local_class(re_pattern,
     1,
     NULL,
-    be_nested_map(4,
+    be_nested_map(5,
     ( (struct bmapnode*) &(const bmapnode[]) {
+        { be_nested_key("match", 2116038550, 5, -1), be_const_func(re_pattern_match) },
+        { be_nested_key("split", -2017972765, 5, -1), be_const_func(re_pattern_split) },
         { be_nested_key("_p", 1594591802, 2, -1), be_const_var(0) },
         { be_nested_key("search", -2144130903, 6, -1), be_const_func(re_pattern_search) },
-        { be_nested_key("match", 2116038550, 5, 0), be_const_func(re_pattern_match) },
-        { be_nested_key("split", -2017972765, 5, -1), be_const_func(re_pattern_split) },
+        { be_nested_key("searchall", -472428912, 9, -1), be_const_func(re_pattern_search_all) },
     })),
     (be_nested_const_str("re_pattern", 2041968961, 10))
 );
@@ -50,6 +50,7 @@ extern int l_setlight(bvm *vm);
 extern int l_getpower(bvm *vm);
 extern int l_setpower(bvm *vm);
 extern int l_getswitch(bvm *vm);
+extern int l_rulevalues(bvm *vm);
 
 extern int l_i2cenabled(bvm *vm);
 
@@ -202,176 +203,338 @@ be_local_closure(Tasmota_find_op,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_try_rule,   /* name */
   be_nested_proto(
-    15,                          /* nstack */
-    4,                          /* argc */
+    12,                          /* nstack */
+    3,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
     NULL,                       /* no upvals */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[16]) {     /* constants */
+    ( &(const bvalue[ 9]) {     /* constants */
     /* K0   */  be_nested_str(string),
-    /* K1   */  be_nested_str(find_op),
-    /* K2   */  be_nested_str(split),
-    /* K3   */  be_const_int(0),
-    /* K4   */  be_nested_str(_X23),
+    /* K1   */  be_nested_str(split),
+    /* K2   */  be_const_int(2),
+    /* K3   */  be_nested_str(_X23),
+    /* K4   */  be_const_int(0),
     /* K5   */  be_nested_str(find_key_i),
     /* K6   */  be_const_int(1),
-    /* K7   */  be_const_int(2),
-    /* K8   */  be_nested_str(_X3D_X3D),
-    /* K9   */  be_nested_str(_X21_X3D_X3D),
-    /* K10  */  be_nested_str(_X3D),
-    /* K11  */  be_nested_str(_X21_X3D),
-    /* K12  */  be_nested_str(_X3E),
-    /* K13  */  be_nested_str(_X3E_X3D),
-    /* K14  */  be_nested_str(_X3C),
-    /* K15  */  be_nested_str(_X3C_X3D),
+    /* K7   */  be_nested_str(match_op),
+    /* K8   */  be_const_int(3),
     }),
     &be_const_str_try_rule,
     &be_const_str_solidified,
-    ( &(const binstruction[141]) {  /* code */
-      0xA4120000,  //  0000  IMPORT	R4	K0
-      0x8C140101,  //  0001  GETMET	R5	R0	K1
-      0x5C1C0400,  //  0002  MOVE	R7	R2
-      0x7C140400,  //  0003  CALL	R5	2
-      0x5C180200,  //  0004  MOVE	R6	R1
-      0x8C1C0902,  //  0005  GETMET	R7	R4	K2
-      0x94240B03,  //  0006  GETIDX	R9	R5	K3
-      0x58280004,  //  0007  LDCONST	R10	K4
-      0x7C1C0600,  //  0008  CALL	R7	3
-      0x58200003,  //  0009  LDCONST	R8	K3
-      0x6024000C,  //  000A  GETGBL	R9	G12
-      0x5C280E00,  //  000B  MOVE	R10	R7
-      0x7C240200,  //  000C  CALL	R9	1
-      0x14241009,  //  000D  LT	R9	R8	R9
-      0x7826000C,  //  000E  JMPF	R9	#001C
-      0x94240E08,  //  000F  GETIDX	R9	R7	R8
-      0x8C280105,  //  0010  GETMET	R10	R0	K5
-      0x5C300C00,  //  0011  MOVE	R12	R6
-      0x5C341200,  //  0012  MOVE	R13	R9
-      0x7C280600,  //  0013  CALL	R10	3
-      0x4C2C0000,  //  0014  LDNIL	R11
-      0x1C2C140B,  //  0015  EQ	R11	R10	R11
-      0x782E0001,  //  0016  JMPF	R11	#0019
-      0x502C0000,  //  0017  LDBOOL	R11	0	0
-      0x80041600,  //  0018  RET	1	R11
-      0x94180C0A,  //  0019  GETIDX	R6	R6	R10
-      0x00201106,  //  001A  ADD	R8	R8	K6
-      0x7001FFED,  //  001B  JMP		#000A
-      0x94240B06,  //  001C  GETIDX	R9	R5	K6
-      0x94280B07,  //  001D  GETIDX	R10	R5	K7
-      0x78260066,  //  001E  JMPF	R9	#0086
-      0x1C2C1308,  //  001F  EQ	R11	R9	K8
-      0x782E000A,  //  0020  JMPF	R11	#002C
-      0x602C0008,  //  0021  GETGBL	R11	G8
-      0x5C300C00,  //  0022  MOVE	R12	R6
-      0x7C2C0200,  //  0023  CALL	R11	1
-      0x60300008,  //  0024  GETGBL	R12	G8
-      0x5C341400,  //  0025  MOVE	R13	R10
-      0x7C300200,  //  0026  CALL	R12	1
-      0x202C160C,  //  0027  NE	R11	R11	R12
-      0x782E0001,  //  0028  JMPF	R11	#002B
-      0x502C0000,  //  0029  LDBOOL	R11	0	0
-      0x80041600,  //  002A  RET	1	R11
-      0x70020059,  //  002B  JMP		#0086
-      0x1C2C1309,  //  002C  EQ	R11	R9	K9
-      0x782E000A,  //  002D  JMPF	R11	#0039
-      0x602C0008,  //  002E  GETGBL	R11	G8
-      0x5C300C00,  //  002F  MOVE	R12	R6
-      0x7C2C0200,  //  0030  CALL	R11	1
-      0x60300008,  //  0031  GETGBL	R12	G8
-      0x5C341400,  //  0032  MOVE	R13	R10
-      0x7C300200,  //  0033  CALL	R12	1
-      0x1C2C160C,  //  0034  EQ	R11	R11	R12
-      0x782E0001,  //  0035  JMPF	R11	#0038
-      0x502C0000,  //  0036  LDBOOL	R11	0	0
-      0x80041600,  //  0037  RET	1	R11
-      0x7002004C,  //  0038  JMP		#0086
-      0x1C2C130A,  //  0039  EQ	R11	R9	K10
-      0x782E000A,  //  003A  JMPF	R11	#0046
-      0x602C000A,  //  003B  GETGBL	R11	G10
-      0x5C300C00,  //  003C  MOVE	R12	R6
-      0x7C2C0200,  //  003D  CALL	R11	1
-      0x6030000A,  //  003E  GETGBL	R12	G10
-      0x5C341400,  //  003F  MOVE	R13	R10
-      0x7C300200,  //  0040  CALL	R12	1
-      0x202C160C,  //  0041  NE	R11	R11	R12
-      0x782E0001,  //  0042  JMPF	R11	#0045
-      0x502C0000,  //  0043  LDBOOL	R11	0	0
-      0x80041600,  //  0044  RET	1	R11
-      0x7002003F,  //  0045  JMP		#0086
-      0x1C2C130B,  //  0046  EQ	R11	R9	K11
-      0x782E000A,  //  0047  JMPF	R11	#0053
-      0x602C000A,  //  0048  GETGBL	R11	G10
-      0x5C300C00,  //  0049  MOVE	R12	R6
-      0x7C2C0200,  //  004A  CALL	R11	1
-      0x6030000A,  //  004B  GETGBL	R12	G10
-      0x5C341400,  //  004C  MOVE	R13	R10
-      0x7C300200,  //  004D  CALL	R12	1
-      0x1C2C160C,  //  004E  EQ	R11	R11	R12
-      0x782E0001,  //  004F  JMPF	R11	#0052
-      0x502C0000,  //  0050  LDBOOL	R11	0	0
-      0x80041600,  //  0051  RET	1	R11
-      0x70020032,  //  0052  JMP		#0086
-      0x1C2C130C,  //  0053  EQ	R11	R9	K12
-      0x782E000A,  //  0054  JMPF	R11	#0060
-      0x602C000A,  //  0055  GETGBL	R11	G10
-      0x5C300C00,  //  0056  MOVE	R12	R6
-      0x7C2C0200,  //  0057  CALL	R11	1
-      0x6030000A,  //  0058  GETGBL	R12	G10
-      0x5C341400,  //  0059  MOVE	R13	R10
-      0x7C300200,  //  005A  CALL	R12	1
-      0x182C160C,  //  005B  LE	R11	R11	R12
-      0x782E0001,  //  005C  JMPF	R11	#005F
-      0x502C0000,  //  005D  LDBOOL	R11	0	0
-      0x80041600,  //  005E  RET	1	R11
-      0x70020025,  //  005F  JMP		#0086
-      0x1C2C130D,  //  0060  EQ	R11	R9	K13
-      0x782E000A,  //  0061  JMPF	R11	#006D
-      0x602C000A,  //  0062  GETGBL	R11	G10
-      0x5C300C00,  //  0063  MOVE	R12	R6
-      0x7C2C0200,  //  0064  CALL	R11	1
-      0x6030000A,  //  0065  GETGBL	R12	G10
-      0x5C341400,  //  0066  MOVE	R13	R10
-      0x7C300200,  //  0067  CALL	R12	1
-      0x142C160C,  //  0068  LT	R11	R11	R12
-      0x782E0001,  //  0069  JMPF	R11	#006C
-      0x502C0000,  //  006A  LDBOOL	R11	0	0
-      0x80041600,  //  006B  RET	1	R11
-      0x70020018,  //  006C  JMP		#0086
-      0x1C2C130E,  //  006D  EQ	R11	R9	K14
-      0x782E000A,  //  006E  JMPF	R11	#007A
-      0x602C000A,  //  006F  GETGBL	R11	G10
-      0x5C300C00,  //  0070  MOVE	R12	R6
-      0x7C2C0200,  //  0071  CALL	R11	1
-      0x6030000A,  //  0072  GETGBL	R12	G10
-      0x5C341400,  //  0073  MOVE	R13	R10
-      0x7C300200,  //  0074  CALL	R12	1
-      0x282C160C,  //  0075  GE	R11	R11	R12
-      0x782E0001,  //  0076  JMPF	R11	#0079
-      0x502C0000,  //  0077  LDBOOL	R11	0	0
-      0x80041600,  //  0078  RET	1	R11
-      0x7002000B,  //  0079  JMP		#0086
-      0x1C2C130F,  //  007A  EQ	R11	R9	K15
-      0x782E0009,  //  007B  JMPF	R11	#0086
-      0x602C000A,  //  007C  GETGBL	R11	G10
-      0x5C300C00,  //  007D  MOVE	R12	R6
-      0x7C2C0200,  //  007E  CALL	R11	1
-      0x6030000A,  //  007F  GETGBL	R12	G10
-      0x5C341400,  //  0080  MOVE	R13	R10
-      0x7C300200,  //  0081  CALL	R12	1
-      0x242C160C,  //  0082  GT	R11	R11	R12
-      0x782E0001,  //  0083  JMPF	R11	#0086
-      0x502C0000,  //  0084  LDBOOL	R11	0	0
-      0x80041600,  //  0085  RET	1	R11
-      0x5C2C0600,  //  0086  MOVE	R11	R3
-      0x5C300C00,  //  0087  MOVE	R12	R6
-      0x94340B03,  //  0088  GETIDX	R13	R5	K3
-      0x5C380200,  //  0089  MOVE	R14	R1
-      0x7C2C0600,  //  008A  CALL	R11	3
-      0x502C0200,  //  008B  LDBOOL	R11	1	0
-      0x80041600,  //  008C  RET	1	R11
+    ( &(const binstruction[41]) {  /* code */
+      0xA40E0000,  //  0000  IMPORT	R3	K0
+      0x5C100200,  //  0001  MOVE	R4	R1
+      0x8C140701,  //  0002  GETMET	R5	R3	K1
+      0x941C0502,  //  0003  GETIDX	R7	R2	K2
+      0x58200003,  //  0004  LDCONST	R8	K3
+      0x7C140600,  //  0005  CALL	R5	3
+      0x58180004,  //  0006  LDCONST	R6	K4
+      0x601C000C,  //  0007  GETGBL	R7	G12
+      0x5C200A00,  //  0008  MOVE	R8	R5
+      0x7C1C0200,  //  0009  CALL	R7	1
+      0x141C0C07,  //  000A  LT	R7	R6	R7
+      0x781E000C,  //  000B  JMPF	R7	#0019
+      0x941C0A06,  //  000C  GETIDX	R7	R5	R6
+      0x8C200105,  //  000D  GETMET	R8	R0	K5
+      0x5C280800,  //  000E  MOVE	R10	R4
+      0x5C2C0E00,  //  000F  MOVE	R11	R7
+      0x7C200600,  //  0010  CALL	R8	3
+      0x4C240000,  //  0011  LDNIL	R9
+      0x1C241009,  //  0012  EQ	R9	R8	R9
+      0x78260001,  //  0013  JMPF	R9	#0016
+      0x50240000,  //  0014  LDBOOL	R9	0	0
+      0x80041200,  //  0015  RET	1	R9
+      0x94100808,  //  0016  GETIDX	R4	R4	R8
+      0x00180D06,  //  0017  ADD	R6	R6	K6
+      0x7001FFED,  //  0018  JMP		#0007
+      0x8C1C0107,  //  0019  GETMET	R7	R0	K7
+      0x5C240800,  //  001A  MOVE	R9	R4
+      0x94280508,  //  001B  GETIDX	R10	R2	K8
+      0x542E0003,  //  001C  LDINT	R11	4
+      0x942C040B,  //  001D  GETIDX	R11	R2	R11
+      0x7C1C0800,  //  001E  CALL	R7	4
+      0x741E0001,  //  001F  JMPT	R7	#0022
+      0x501C0000,  //  0020  LDBOOL	R7	0	0
+      0x80040E00,  //  0021  RET	1	R7
+      0x941C0506,  //  0022  GETIDX	R7	R2	K6
+      0x5C200800,  //  0023  MOVE	R8	R4
+      0x94240502,  //  0024  GETIDX	R9	R2	K2
+      0x5C280200,  //  0025  MOVE	R10	R1
+      0x7C1C0600,  //  0026  CALL	R7	3
+      0x501C0200,  //  0027  LDBOOL	R7	1	0
+      0x80040E00,  //  0028  RET	1	R7
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: match_op
+********************************************************************/
+be_local_closure(Tasmota_match_op,   /* name */
+  be_nested_proto(
+    7,                          /* nstack */
+    4,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 8]) {     /* constants */
+    /* K0   */  be_nested_str(_X3D_X3D),
+    /* K1   */  be_nested_str(_X21_X3D_X3D),
+    /* K2   */  be_nested_str(_X3D),
+    /* K3   */  be_nested_str(_X21_X3D),
+    /* K4   */  be_nested_str(_X3E),
+    /* K5   */  be_nested_str(_X3E_X3D),
+    /* K6   */  be_nested_str(_X3C),
+    /* K7   */  be_nested_str(_X3C_X3D),
+    }),
+    &be_const_str_match_op,
+    &be_const_str_solidified,
+    ( &(const binstruction[106]) {  /* code */
+      0x780A0066,  //  0000  JMPF	R2	#0068
+      0x1C100500,  //  0001  EQ	R4	R2	K0
+      0x7812000A,  //  0002  JMPF	R4	#000E
+      0x60100008,  //  0003  GETGBL	R4	G8
+      0x5C140200,  //  0004  MOVE	R5	R1
+      0x7C100200,  //  0005  CALL	R4	1
+      0x60140008,  //  0006  GETGBL	R5	G8
+      0x5C180600,  //  0007  MOVE	R6	R3
+      0x7C140200,  //  0008  CALL	R5	1
+      0x20100805,  //  0009  NE	R4	R4	R5
+      0x78120001,  //  000A  JMPF	R4	#000D
+      0x50100000,  //  000B  LDBOOL	R4	0	0
+      0x80040800,  //  000C  RET	1	R4
+      0x70020059,  //  000D  JMP		#0068
+      0x1C100501,  //  000E  EQ	R4	R2	K1
+      0x7812000A,  //  000F  JMPF	R4	#001B
+      0x60100008,  //  0010  GETGBL	R4	G8
+      0x5C140200,  //  0011  MOVE	R5	R1
+      0x7C100200,  //  0012  CALL	R4	1
+      0x60140008,  //  0013  GETGBL	R5	G8
+      0x5C180600,  //  0014  MOVE	R6	R3
+      0x7C140200,  //  0015  CALL	R5	1
+      0x1C100805,  //  0016  EQ	R4	R4	R5
+      0x78120001,  //  0017  JMPF	R4	#001A
+      0x50100000,  //  0018  LDBOOL	R4	0	0
+      0x80040800,  //  0019  RET	1	R4
+      0x7002004C,  //  001A  JMP		#0068
+      0x1C100502,  //  001B  EQ	R4	R2	K2
+      0x7812000A,  //  001C  JMPF	R4	#0028
+      0x6010000A,  //  001D  GETGBL	R4	G10
+      0x5C140200,  //  001E  MOVE	R5	R1
+      0x7C100200,  //  001F  CALL	R4	1
+      0x6014000A,  //  0020  GETGBL	R5	G10
+      0x5C180600,  //  0021  MOVE	R6	R3
+      0x7C140200,  //  0022  CALL	R5	1
+      0x20100805,  //  0023  NE	R4	R4	R5
+      0x78120001,  //  0024  JMPF	R4	#0027
+      0x50100000,  //  0025  LDBOOL	R4	0	0
+      0x80040800,  //  0026  RET	1	R4
+      0x7002003F,  //  0027  JMP		#0068
+      0x1C100503,  //  0028  EQ	R4	R2	K3
+      0x7812000A,  //  0029  JMPF	R4	#0035
+      0x6010000A,  //  002A  GETGBL	R4	G10
+      0x5C140200,  //  002B  MOVE	R5	R1
+      0x7C100200,  //  002C  CALL	R4	1
+      0x6014000A,  //  002D  GETGBL	R5	G10
+      0x5C180600,  //  002E  MOVE	R6	R3
+      0x7C140200,  //  002F  CALL	R5	1
+      0x1C100805,  //  0030  EQ	R4	R4	R5
+      0x78120001,  //  0031  JMPF	R4	#0034
+      0x50100000,  //  0032  LDBOOL	R4	0	0
+      0x80040800,  //  0033  RET	1	R4
+      0x70020032,  //  0034  JMP		#0068
+      0x1C100504,  //  0035  EQ	R4	R2	K4
+      0x7812000A,  //  0036  JMPF	R4	#0042
+      0x6010000A,  //  0037  GETGBL	R4	G10
+      0x5C140200,  //  0038  MOVE	R5	R1
+      0x7C100200,  //  0039  CALL	R4	1
+      0x6014000A,  //  003A  GETGBL	R5	G10
+      0x5C180600,  //  003B  MOVE	R6	R3
+      0x7C140200,  //  003C  CALL	R5	1
+      0x18100805,  //  003D  LE	R4	R4	R5
+      0x78120001,  //  003E  JMPF	R4	#0041
+      0x50100000,  //  003F  LDBOOL	R4	0	0
+      0x80040800,  //  0040  RET	1	R4
+      0x70020025,  //  0041  JMP		#0068
+      0x1C100505,  //  0042  EQ	R4	R2	K5
+      0x7812000A,  //  0043  JMPF	R4	#004F
+      0x6010000A,  //  0044  GETGBL	R4	G10
+      0x5C140200,  //  0045  MOVE	R5	R1
+      0x7C100200,  //  0046  CALL	R4	1
+      0x6014000A,  //  0047  GETGBL	R5	G10
+      0x5C180600,  //  0048  MOVE	R6	R3
+      0x7C140200,  //  0049  CALL	R5	1
+      0x14100805,  //  004A  LT	R4	R4	R5
+      0x78120001,  //  004B  JMPF	R4	#004E
+      0x50100000,  //  004C  LDBOOL	R4	0	0
+      0x80040800,  //  004D  RET	1	R4
+      0x70020018,  //  004E  JMP		#0068
+      0x1C100506,  //  004F  EQ	R4	R2	K6
+      0x7812000A,  //  0050  JMPF	R4	#005C
+      0x6010000A,  //  0051  GETGBL	R4	G10
+      0x5C140200,  //  0052  MOVE	R5	R1
+      0x7C100200,  //  0053  CALL	R4	1
+      0x6014000A,  //  0054  GETGBL	R5	G10
+      0x5C180600,  //  0055  MOVE	R6	R3
+      0x7C140200,  //  0056  CALL	R5	1
+      0x28100805,  //  0057  GE	R4	R4	R5
+      0x78120001,  //  0058  JMPF	R4	#005B
+      0x50100000,  //  0059  LDBOOL	R4	0	0
+      0x80040800,  //  005A  RET	1	R4
+      0x7002000B,  //  005B  JMP		#0068
+      0x1C100507,  //  005C  EQ	R4	R2	K7
+      0x78120009,  //  005D  JMPF	R4	#0068
+      0x6010000A,  //  005E  GETGBL	R4	G10
+      0x5C140200,  //  005F  MOVE	R5	R1
+      0x7C100200,  //  0060  CALL	R4	1
+      0x6014000A,  //  0061  GETGBL	R5	G10
+      0x5C180600,  //  0062  MOVE	R6	R3
+      0x7C140200,  //  0063  CALL	R5	1
+      0x24100805,  //  0064  GT	R4	R4	R5
+      0x78120001,  //  0065  JMPF	R4	#0068
+      0x50100000,  //  0066  LDBOOL	R4	0	0
+      0x80040800,  //  0067  RET	1	R4
+      0x50100200,  //  0068  LDBOOL	R4	1	0
+      0x80040800,  //  0069  RET	1	R4
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: run_rules
+********************************************************************/
+be_local_closure(Tasmota_run_rules,   /* name */
+  be_nested_proto(
+    17,                          /* nstack */
+    3,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[14]) {     /* constants */
+    /* K0   */  be_nested_str(json),
+    /* K1   */  be_nested_str(_rules),
+    /* K2   */  be_nested_str(copy),
+    /* K3   */  be_nested_str(_rule_values),
+    /* K4   */  be_nested_str(load),
+    /* K5   */  be_nested_str(log),
+    /* K6   */  be_nested_str(BRY_X3A_X20ERROR_X2C_X20bad_X20json_X3A_X20),
+    /* K7   */  be_const_int(3),
+    /* K8   */  be_nested_str(Tele),
+    /* K9   */  be_const_int(0),
+    /* K10  */  be_nested_str(try_rule),
+    /* K11  */  be_const_int(1),
+    /* K12  */  be_nested_str(match_op),
+    /* K13  */  be_const_int(2),
+    }),
+    &be_const_str_run_rules,
+    &be_const_str_solidified,
+    ( &(const binstruction[93]) {  /* code */
+      0xA40E0000,  //  0000  IMPORT	R3	K0
+      0x50100000,  //  0001  LDBOOL	R4	0	0
+      0x88140101,  //  0002  GETMBR	R5	R0	K1
+      0x8C140B02,  //  0003  GETMET	R5	R5	K2
+      0x7C140200,  //  0004  CALL	R5	1
+      0x8C180103,  //  0005  GETMET	R6	R0	K3
+      0x5C200200,  //  0006  MOVE	R8	R1
+      0x5C240A00,  //  0007  MOVE	R9	R5
+      0x5C280400,  //  0008  MOVE	R10	R2
+      0x7C180800,  //  0009  CALL	R6	4
+      0x4C1C0000,  //  000A  LDNIL	R7
+      0x1C1C0C07,  //  000B  EQ	R7	R6	R7
+      0x781E0020,  //  000C  JMPF	R7	#002E
+      0x8C1C0704,  //  000D  GETMET	R7	R3	K4
+      0x5C240200,  //  000E  MOVE	R9	R1
+      0x7C1C0400,  //  000F  CALL	R7	2
+      0x4C200000,  //  0010  LDNIL	R8
+      0x1C200E08,  //  0011  EQ	R8	R7	R8
+      0x78220004,  //  0012  JMPF	R8	#0018
+      0x8C200105,  //  0013  GETMET	R8	R0	K5
+      0x002A0C01,  //  0014  ADD	R10	K6	R1
+      0x582C0007,  //  0015  LDCONST	R11	K7
+      0x7C200600,  //  0016  CALL	R8	3
+      0x5C1C0200,  //  0017  MOVE	R7	R1
+      0x780A0003,  //  0018  JMPF	R2	#001D
+      0x60200013,  //  0019  GETGBL	R8	G19
+      0x7C200000,  //  001A  CALL	R8	0
+      0x98221007,  //  001B  SETIDX	R8	K8	R7
+      0x5C1C1000,  //  001C  MOVE	R7	R8
+      0x58200009,  //  001D  LDCONST	R8	K9
+      0x6024000C,  //  001E  GETGBL	R9	G12
+      0x5C280A00,  //  001F  MOVE	R10	R5
+      0x7C240200,  //  0020  CALL	R9	1
+      0x14241009,  //  0021  LT	R9	R8	R9
+      0x78260009,  //  0022  JMPF	R9	#002D
+      0x8C24010A,  //  0023  GETMET	R9	R0	K10
+      0x5C2C0E00,  //  0024  MOVE	R11	R7
+      0x94300A08,  //  0025  GETIDX	R12	R5	R8
+      0x7C240600,  //  0026  CALL	R9	3
+      0x74260001,  //  0027  JMPT	R9	#002A
+      0x74120000,  //  0028  JMPT	R4	#002A
+      0x50100001,  //  0029  LDBOOL	R4	0	1
+      0x50100200,  //  002A  LDBOOL	R4	1	0
+      0x0020110B,  //  002B  ADD	R8	R8	K11
+      0x7001FFF0,  //  002C  JMP		#001E
+      0x80040800,  //  002D  RET	1	R4
+      0x4C1C0000,  //  002E  LDNIL	R7
+      0x58200009,  //  002F  LDCONST	R8	K9
+      0x6024000C,  //  0030  GETGBL	R9	G12
+      0x5C280C00,  //  0031  MOVE	R10	R6
+      0x7C240200,  //  0032  CALL	R9	1
+      0x14241009,  //  0033  LT	R9	R8	R9
+      0x78260026,  //  0034  JMPF	R9	#005C
+      0x94240C08,  //  0035  GETIDX	R9	R6	R8
+      0x4C280000,  //  0036  LDNIL	R10
+      0x2028120A,  //  0037  NE	R10	R9	R10
+      0x782A0020,  //  0038  JMPF	R10	#005A
+      0x94280A08,  //  0039  GETIDX	R10	R5	R8
+      0x8C2C0704,  //  003A  GETMET	R11	R3	K4
+      0x5C341200,  //  003B  MOVE	R13	R9
+      0x7C2C0400,  //  003C  CALL	R11	2
+      0x8C30010C,  //  003D  GETMET	R12	R0	K12
+      0x5C381600,  //  003E  MOVE	R14	R11
+      0x943C1507,  //  003F  GETIDX	R15	R10	K7
+      0x54420003,  //  0040  LDINT	R16	4
+      0x94401410,  //  0041  GETIDX	R16	R10	R16
+      0x7C300800,  //  0042  CALL	R12	4
+      0x78320015,  //  0043  JMPF	R12	#005A
+      0x4C300000,  //  0044  LDNIL	R12
+      0x1C300E0C,  //  0045  EQ	R12	R7	R12
+      0x7832000C,  //  0046  JMPF	R12	#0054
+      0x8C300704,  //  0047  GETMET	R12	R3	K4
+      0x5C380200,  //  0048  MOVE	R14	R1
+      0x7C300400,  //  0049  CALL	R12	2
+      0x5C1C1800,  //  004A  MOVE	R7	R12
+      0x4C300000,  //  004B  LDNIL	R12
+      0x1C300E0C,  //  004C  EQ	R12	R7	R12
+      0x78320000,  //  004D  JMPF	R12	#004F
+      0x5C1C0200,  //  004E  MOVE	R7	R1
+      0x780A0003,  //  004F  JMPF	R2	#0054
+      0x60300013,  //  0050  GETGBL	R12	G19
+      0x7C300000,  //  0051  CALL	R12	0
+      0x98321007,  //  0052  SETIDX	R12	K8	R7
+      0x5C1C1800,  //  0053  MOVE	R7	R12
+      0x9430150B,  //  0054  GETIDX	R12	R10	K11
+      0x5C341600,  //  0055  MOVE	R13	R11
+      0x9438150D,  //  0056  GETIDX	R14	R10	K13
+      0x5C3C0E00,  //  0057  MOVE	R15	R7
+      0x7C300600,  //  0058  CALL	R12	3
+      0x50100200,  //  0059  LDBOOL	R4	1	0
+      0x0020110B,  //  005A  ADD	R8	R8	K11
+      0x7001FFD3,  //  005B  JMP		#0030
+      0x80040800,  //  005C  RET	1	R4
     })
   )
 );
@@ -459,7 +622,7 @@ be_local_closure(Tasmota_set_light,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_exec_tele,   /* name */
   be_nested_proto(
-    12,                          /* nstack */
+    6,                          /* nstack */
     2,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -467,64 +630,22 @@ be_local_closure(Tasmota_exec_tele,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[12]) {     /* constants */
+    ( &(const bvalue[ 2]) {     /* constants */
     /* K0   */  be_nested_str(_rules),
-    /* K1   */  be_nested_str(json),
-    /* K2   */  be_nested_str(load),
-    /* K3   */  be_nested_str(log),
-    /* K4   */  be_nested_str(BRY_X3A_X20ERROR_X2C_X20bad_X20json_X3A_X20),
-    /* K5   */  be_const_int(3),
-    /* K6   */  be_nested_str(Tele),
-    /* K7   */  be_const_int(0),
-    /* K8   */  be_nested_str(try_rule),
-    /* K9   */  be_nested_str(k),
-    /* K10  */  be_nested_str(v),
-    /* K11  */  be_const_int(1),
+    /* K1   */  be_nested_str(run_rules),
     }),
     &be_const_str_exec_tele,
     &be_const_str_solidified,
-    ( &(const binstruction[41]) {  /* code */
+    ( &(const binstruction[ 9]) {  /* code */
       0x88080100,  //  0000  GETMBR	R2	R0	K0
-      0x780A0024,  //  0001  JMPF	R2	#0027
-      0xA40A0200,  //  0002  IMPORT	R2	K1
-      0x8C0C0502,  //  0003  GETMET	R3	R2	K2
-      0x5C140200,  //  0004  MOVE	R5	R1
-      0x7C0C0400,  //  0005  CALL	R3	2
-      0x50100000,  //  0006  LDBOOL	R4	0	0
-      0x4C140000,  //  0007  LDNIL	R5
-      0x1C140605,  //  0008  EQ	R5	R3	R5
-      0x78160004,  //  0009  JMPF	R5	#000F
-      0x8C140103,  //  000A  GETMET	R5	R0	K3
-      0x001E0801,  //  000B  ADD	R7	K4	R1
-      0x58200005,  //  000C  LDCONST	R8	K5
-      0x7C140600,  //  000D  CALL	R5	3
-      0x5C0C0200,  //  000E  MOVE	R3	R1
-      0x60140013,  //  000F  GETGBL	R5	G19
-      0x7C140000,  //  0010  CALL	R5	0
-      0x98160C03,  //  0011  SETIDX	R5	K6	R3
-      0x5C0C0A00,  //  0012  MOVE	R3	R5
-      0x58140007,  //  0013  LDCONST	R5	K7
-      0x6018000C,  //  0014  GETGBL	R6	G12
-      0x881C0100,  //  0015  GETMBR	R7	R0	K0
-      0x7C180200,  //  0016  CALL	R6	1
-      0x14180A06,  //  0017  LT	R6	R5	R6
-      0x781A000C,  //  0018  JMPF	R6	#0026
-      0x88180100,  //  0019  GETMBR	R6	R0	K0
-      0x94180C05,  //  001A  GETIDX	R6	R6	R5
-      0x8C1C0108,  //  001B  GETMET	R7	R0	K8
-      0x5C240600,  //  001C  MOVE	R9	R3
-      0x88280D09,  //  001D  GETMBR	R10	R6	K9
-      0x882C0D0A,  //  001E  GETMBR	R11	R6	K10
-      0x7C1C0800,  //  001F  CALL	R7	4
-      0x741E0001,  //  0020  JMPT	R7	#0023
-      0x74120000,  //  0021  JMPT	R4	#0023
-      0x50100001,  //  0022  LDBOOL	R4	0	1
-      0x50100200,  //  0023  LDBOOL	R4	1	0
-      0x00140B0B,  //  0024  ADD	R5	R5	K11
-      0x7001FFED,  //  0025  JMP		#0014
-      0x80040800,  //  0026  RET	1	R4
-      0x50080000,  //  0027  LDBOOL	R2	0	0
-      0x80040400,  //  0028  RET	1	R2
+      0x780A0004,  //  0001  JMPF	R2	#0007
+      0x8C080101,  //  0002  GETMET	R2	R0	K1
+      0x5C100200,  //  0003  MOVE	R4	R1
+      0x50140200,  //  0004  LDBOOL	R5	1	0
+      0x7C080600,  //  0005  CALL	R2	3
+      0x80040400,  //  0006  RET	1	R2
+      0x50080000,  //  0007  LDBOOL	R2	0	0
+      0x80040400,  //  0008  RET	1	R2
     })
   )
 );
@@ -536,7 +657,7 @@ be_local_closure(Tasmota_exec_tele,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_run_deferred,   /* name */
   be_nested_proto(
-    6,                          /* nstack */
+    8,                          /* nstack */
     1,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -544,46 +665,65 @@ be_local_closure(Tasmota_run_deferred,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 8]) {     /* constants */
+    ( &(const bvalue[10]) {     /* constants */
     /* K0   */  be_nested_str(_timers),
     /* K1   */  be_const_int(0),
-    /* K2   */  be_nested_str(size),
-    /* K3   */  be_nested_str(time_reached),
-    /* K4   */  be_nested_str(due),
-    /* K5   */  be_nested_str(f),
-    /* K6   */  be_nested_str(remove),
-    /* K7   */  be_const_int(1),
+    /* K2   */  be_nested_str(time_reached),
+    /* K3   */  be_nested_str(due),
+    /* K4   */  be_nested_str(f),
+    /* K5   */  be_nested_str(pop),
+    /* K6   */  be_nested_str(_timer_down),
+    /* K7   */  be_nested_str(coroutine),
+    /* K8   */  be_nested_str(_resume),
+    /* K9   */  be_const_int(1),
     }),
     &be_const_str_run_deferred,
     &be_const_str_solidified,
-    ( &(const binstruction[27]) {  /* code */
+    ( &(const binstruction[44]) {  /* code */
       0x88040100,  //  0000  GETMBR	R1	R0	K0
-      0x78060017,  //  0001  JMPF	R1	#001A
-      0x58040001,  //  0002  LDCONST	R1	K1
-      0x88080100,  //  0003  GETMBR	R2	R0	K0
-      0x8C080502,  //  0004  GETMET	R2	R2	K2
-      0x7C080200,  //  0005  CALL	R2	1
-      0x14080202,  //  0006  LT	R2	R1	R2
-      0x780A0011,  //  0007  JMPF	R2	#001A
-      0x8C080103,  //  0008  GETMET	R2	R0	K3
-      0x88100100,  //  0009  GETMBR	R4	R0	K0
-      0x94100801,  //  000A  GETIDX	R4	R4	R1
-      0x88100904,  //  000B  GETMBR	R4	R4	K4
-      0x7C080400,  //  000C  CALL	R2	2
-      0x780A0009,  //  000D  JMPF	R2	#0018
-      0x88080100,  //  000E  GETMBR	R2	R0	K0
-      0x94080401,  //  000F  GETIDX	R2	R2	R1
-      0x88080505,  //  0010  GETMBR	R2	R2	K5
-      0x880C0100,  //  0011  GETMBR	R3	R0	K0
-      0x8C0C0706,  //  0012  GETMET	R3	R3	K6
-      0x5C140200,  //  0013  MOVE	R5	R1
-      0x7C0C0400,  //  0014  CALL	R3	2
-      0x5C0C0400,  //  0015  MOVE	R3	R2
-      0x7C0C0000,  //  0016  CALL	R3	0
-      0x70020000,  //  0017  JMP		#0019
-      0x00040307,  //  0018  ADD	R1	R1	K7
-      0x7001FFE8,  //  0019  JMP		#0003
-      0x80000000,  //  001A  RET	0
+      0x78060028,  //  0001  JMPF	R1	#002B
+      0x6008000C,  //  0002  GETGBL	R2	G12
+      0x5C0C0200,  //  0003  MOVE	R3	R1
+      0x7C080200,  //  0004  CALL	R2	1
+      0x240C0501,  //  0005  GT	R3	R2	K1
+      0x780E0023,  //  0006  JMPF	R3	#002B
+      0x600C000C,  //  0007  GETGBL	R3	G12
+      0x5C100200,  //  0008  MOVE	R4	R1
+      0x7C0C0200,  //  0009  CALL	R3	1
+      0x240C0701,  //  000A  GT	R3	R3	K1
+      0x780E001E,  //  000B  JMPF	R3	#002B
+      0x8C0C0102,  //  000C  GETMET	R3	R0	K2
+      0x94140301,  //  000D  GETIDX	R5	R1	K1
+      0x88140B03,  //  000E  GETMBR	R5	R5	K3
+      0x7C0C0400,  //  000F  CALL	R3	2
+      0x780E0019,  //  0010  JMPF	R3	#002B
+      0x940C0301,  //  0011  GETIDX	R3	R1	K1
+      0x880C0704,  //  0012  GETMBR	R3	R3	K4
+      0x8C100305,  //  0013  GETMET	R4	R1	K5
+      0x7C100200,  //  0014  CALL	R4	1
+      0x6014000C,  //  0015  GETGBL	R5	G12
+      0x5C180200,  //  0016  MOVE	R6	R1
+      0x7C140200,  //  0017  CALL	R5	1
+      0x24140B01,  //  0018  GT	R5	R5	K1
+      0x78160003,  //  0019  JMPF	R5	#001E
+      0x98060204,  //  001A  SETIDX	R1	K1	R4
+      0x8C140106,  //  001B  GETMET	R5	R0	K6
+      0x581C0001,  //  001C  LDCONST	R7	K1
+      0x7C140400,  //  001D  CALL	R5	2
+      0x60140004,  //  001E  GETGBL	R5	G4
+      0x5C180600,  //  001F  MOVE	R6	R3
+      0x7C140200,  //  0020  CALL	R5	1
+      0x1C140B07,  //  0021  EQ	R5	R5	K7
+      0x78160003,  //  0022  JMPF	R5	#0027
+      0x8C140108,  //  0023  GETMET	R5	R0	K8
+      0x5C1C0600,  //  0024  MOVE	R7	R3
+      0x7C140400,  //  0025  CALL	R5	2
+      0x70020001,  //  0026  JMP		#0029
+      0x5C140600,  //  0027  MOVE	R5	R3
+      0x7C140000,  //  0028  CALL	R5	0
+      0x04080509,  //  0029  SUB	R2	R2	K9
+      0x7001FFD9,  //  002A  JMP		#0005
+      0x80000000,  //  002B  RET	0
     })
   )
 );
@@ -1026,12 +1166,11 @@ be_local_closure(Tasmota_remove_rule,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 5]) {     /* constants */
+    ( &(const bvalue[ 4]) {     /* constants */
     /* K0   */  be_nested_str(_rules),
     /* K1   */  be_const_int(0),
-    /* K2   */  be_nested_str(k),
-    /* K3   */  be_nested_str(remove),
-    /* K4   */  be_const_int(1),
+    /* K2   */  be_nested_str(remove),
+    /* K3   */  be_const_int(1),
     }),
     &be_const_str_remove_rule,
     &be_const_str_solidified,
@@ -1046,15 +1185,15 @@ be_local_closure(Tasmota_remove_rule,   /* name */
       0x780E000B,  //  0007  JMPF	R3	#0014
       0x880C0100,  //  0008  GETMBR	R3	R0	K0
       0x940C0602,  //  0009  GETIDX	R3	R3	R2
-      0x880C0702,  //  000A  GETMBR	R3	R3	K2
+      0x940C0701,  //  000A  GETIDX	R3	R3	K1
       0x1C0C0601,  //  000B  EQ	R3	R3	R1
       0x780E0004,  //  000C  JMPF	R3	#0012
       0x880C0100,  //  000D  GETMBR	R3	R0	K0
-      0x8C0C0703,  //  000E  GETMET	R3	R3	K3
+      0x8C0C0702,  //  000E  GETMET	R3	R3	K2
       0x5C140400,  //  000F  MOVE	R5	R2
       0x7C0C0400,  //  0010  CALL	R3	2
       0x70020000,  //  0011  JMP		#0013
-      0x00080504,  //  0012  ADD	R2	R2	K4
+      0x00080503,  //  0012  ADD	R2	R2	K3
       0x7001FFEE,  //  0013  JMP		#0003
       0x80000000,  //  0014  RET	0
     })
@@ -1441,7 +1580,7 @@ be_local_closure(Tasmota_add_cmd,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_add_rule,   /* name */
   be_nested_proto(
-    9,                          /* nstack */
+    8,                          /* nstack */
     3,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -1449,17 +1588,20 @@ be_local_closure(Tasmota_add_rule,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 6]) {     /* constants */
+    ( &(const bvalue[ 9]) {     /* constants */
     /* K0   */  be_nested_str(_rules),
     /* K1   */  be_nested_str(function),
-    /* K2   */  be_nested_str(push),
-    /* K3   */  be_nested_str(kv),
-    /* K4   */  be_nested_str(value_error),
-    /* K5   */  be_nested_str(the_X20second_X20argument_X20is_X20not_X20a_X20function),
+    /* K2   */  be_nested_str(find_op),
+    /* K3   */  be_nested_str(push),
+    /* K4   */  be_const_int(0),
+    /* K5   */  be_const_int(1),
+    /* K6   */  be_const_int(2),
+    /* K7   */  be_nested_str(value_error),
+    /* K8   */  be_nested_str(the_X20second_X20argument_X20is_X20not_X20a_X20function),
     }),
     &be_const_str_add_rule,
     &be_const_str_solidified,
-    ( &(const binstruction[20]) {  /* code */
+    ( &(const binstruction[29]) {  /* code */
       0x880C0100,  //  0000  GETMBR	R3	R0	K0
       0x740E0002,  //  0001  JMPT	R3	#0005
       0x600C0012,  //  0002  GETGBL	R3	G18
@@ -1469,17 +1611,26 @@ be_local_closure(Tasmota_add_rule,   /* name */
       0x5C100400,  //  0006  MOVE	R4	R2
       0x7C0C0200,  //  0007  CALL	R3	1
       0x1C0C0701,  //  0008  EQ	R3	R3	K1
-      0x780E0007,  //  0009  JMPF	R3	#0012
-      0x880C0100,  //  000A  GETMBR	R3	R0	K0
-      0x8C0C0702,  //  000B  GETMET	R3	R3	K2
-      0x8C140103,  //  000C  GETMET	R5	R0	K3
-      0x5C1C0200,  //  000D  MOVE	R7	R1
-      0x5C200400,  //  000E  MOVE	R8	R2
-      0x7C140600,  //  000F  CALL	R5	3
-      0x7C0C0400,  //  0010  CALL	R3	2
-      0x70020000,  //  0011  JMP		#0013
-      0xB0060905,  //  0012  RAISE	1	K4	K5
-      0x80000000,  //  0013  RET	0
+      0x780E0010,  //  0009  JMPF	R3	#001B
+      0x8C0C0102,  //  000A  GETMET	R3	R0	K2
+      0x5C140200,  //  000B  MOVE	R5	R1
+      0x7C0C0400,  //  000C  CALL	R3	2
+      0x88100100,  //  000D  GETMBR	R4	R0	K0
+      0x8C100903,  //  000E  GETMET	R4	R4	K3
+      0x60180012,  //  000F  GETGBL	R6	G18
+      0x7C180000,  //  0010  CALL	R6	0
+      0x401C0C01,  //  0011  CONNECT	R7	R6	R1
+      0x401C0C02,  //  0012  CONNECT	R7	R6	R2
+      0x941C0704,  //  0013  GETIDX	R7	R3	K4
+      0x401C0C07,  //  0014  CONNECT	R7	R6	R7
+      0x941C0705,  //  0015  GETIDX	R7	R3	K5
+      0x401C0C07,  //  0016  CONNECT	R7	R6	R7
+      0x941C0706,  //  0017  GETIDX	R7	R3	K6
+      0x401C0C07,  //  0018  CONNECT	R7	R6	R7
+      0x7C100400,  //  0019  CALL	R4	2
+      0x70020000,  //  001A  JMP		#001C
+      0xB0060F08,  //  001B  RAISE	1	K7	K8
+      0x80000000,  //  001C  RET	0
     })
   )
 );
@@ -1491,7 +1642,7 @@ be_local_closure(Tasmota_add_rule,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_exec_rules,   /* name */
   be_nested_proto(
-    12,                          /* nstack */
+    8,                          /* nstack */
     2,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -1499,7 +1650,7 @@ be_local_closure(Tasmota_exec_rules,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[12]) {     /* constants */
+    ( &(const bvalue[ 8]) {     /* constants */
     /* K0   */  be_nested_str(_rules),
     /* K1   */  be_nested_str(cmd_res),
     /* K2   */  be_nested_str(json),
@@ -1507,63 +1658,43 @@ be_local_closure(Tasmota_exec_rules,   /* name */
     /* K4   */  be_nested_str(log),
     /* K5   */  be_nested_str(BRY_X3A_X20ERROR_X2C_X20bad_X20json_X3A_X20),
     /* K6   */  be_const_int(3),
-    /* K7   */  be_const_int(0),
-    /* K8   */  be_nested_str(try_rule),
-    /* K9   */  be_nested_str(k),
-    /* K10  */  be_nested_str(v),
-    /* K11  */  be_const_int(1),
+    /* K7   */  be_nested_str(run_rules),
     }),
     &be_const_str_exec_rules,
     &be_const_str_solidified,
-    ( &(const binstruction[48]) {  /* code */
+    ( &(const binstruction[32]) {  /* code */
       0x88080100,  //  0000  GETMBR	R2	R0	K0
       0x740A0003,  //  0001  JMPT	R2	#0006
       0x88080101,  //  0002  GETMBR	R2	R0	K1
       0x4C0C0000,  //  0003  LDNIL	R3
       0x20080403,  //  0004  NE	R2	R2	R3
-      0x780A0027,  //  0005  JMPF	R2	#002E
-      0xA40A0400,  //  0006  IMPORT	R2	K2
-      0x8C0C0503,  //  0007  GETMET	R3	R2	K3
-      0x5C140200,  //  0008  MOVE	R5	R1
-      0x7C0C0400,  //  0009  CALL	R3	2
-      0x50100000,  //  000A  LDBOOL	R4	0	0
-      0x4C140000,  //  000B  LDNIL	R5
-      0x1C140605,  //  000C  EQ	R5	R3	R5
-      0x78160004,  //  000D  JMPF	R5	#0013
-      0x8C140104,  //  000E  GETMET	R5	R0	K4
-      0x001E0A01,  //  000F  ADD	R7	K5	R1
-      0x58200006,  //  0010  LDCONST	R8	K6
-      0x7C140600,  //  0011  CALL	R5	3
-      0x5C0C0200,  //  0012  MOVE	R3	R1
-      0x88140101,  //  0013  GETMBR	R5	R0	K1
-      0x4C180000,  //  0014  LDNIL	R6
-      0x20140A06,  //  0015  NE	R5	R5	R6
-      0x78160000,  //  0016  JMPF	R5	#0018
-      0x90020203,  //  0017  SETMBR	R0	K1	R3
-      0x88140100,  //  0018  GETMBR	R5	R0	K0
-      0x78160012,  //  0019  JMPF	R5	#002D
-      0x58140007,  //  001A  LDCONST	R5	K7
-      0x6018000C,  //  001B  GETGBL	R6	G12
-      0x881C0100,  //  001C  GETMBR	R7	R0	K0
-      0x7C180200,  //  001D  CALL	R6	1
-      0x14180A06,  //  001E  LT	R6	R5	R6
-      0x781A000C,  //  001F  JMPF	R6	#002D
-      0x88180100,  //  0020  GETMBR	R6	R0	K0
-      0x94180C05,  //  0021  GETIDX	R6	R6	R5
-      0x8C1C0108,  //  0022  GETMET	R7	R0	K8
-      0x5C240600,  //  0023  MOVE	R9	R3
-      0x88280D09,  //  0024  GETMBR	R10	R6	K9
-      0x882C0D0A,  //  0025  GETMBR	R11	R6	K10
-      0x7C1C0800,  //  0026  CALL	R7	4
-      0x741E0001,  //  0027  JMPT	R7	#002A
-      0x74120000,  //  0028  JMPT	R4	#002A
-      0x50100001,  //  0029  LDBOOL	R4	0	1
-      0x50100200,  //  002A  LDBOOL	R4	1	0
-      0x00140B0B,  //  002B  ADD	R5	R5	K11
-      0x7001FFED,  //  002C  JMP		#001B
-      0x80040800,  //  002D  RET	1	R4
-      0x50080000,  //  002E  LDBOOL	R2	0	0
-      0x80040400,  //  002F  RET	1	R2
+      0x780A0017,  //  0005  JMPF	R2	#001E
+      0x88080101,  //  0006  GETMBR	R2	R0	K1
+      0x4C0C0000,  //  0007  LDNIL	R3
+      0x20080403,  //  0008  NE	R2	R2	R3
+      0x780A000C,  //  0009  JMPF	R2	#0017
+      0xA40A0400,  //  000A  IMPORT	R2	K2
+      0x8C0C0503,  //  000B  GETMET	R3	R2	K3
+      0x5C140200,  //  000C  MOVE	R5	R1
+      0x7C0C0400,  //  000D  CALL	R3	2
+      0x4C100000,  //  000E  LDNIL	R4
+      0x1C100604,  //  000F  EQ	R4	R3	R4
+      0x78120004,  //  0010  JMPF	R4	#0016
+      0x8C100104,  //  0011  GETMET	R4	R0	K4
+      0x001A0A01,  //  0012  ADD	R6	K5	R1
+      0x581C0006,  //  0013  LDCONST	R7	K6
+      0x7C100600,  //  0014  CALL	R4	3
+      0x5C0C0200,  //  0015  MOVE	R3	R1
+      0x90020203,  //  0016  SETMBR	R0	K1	R3
+      0x88080100,  //  0017  GETMBR	R2	R0	K0
+      0x780A0004,  //  0018  JMPF	R2	#001E
+      0x8C080107,  //  0019  GETMET	R2	R0	K7
+      0x5C100200,  //  001A  MOVE	R4	R1
+      0x50140000,  //  001B  LDBOOL	R5	0	0
+      0x7C080600,  //  001C  CALL	R2	3
+      0x80040400,  //  001D  RET	1	R2
+      0x50080000,  //  001E  LDBOOL	R2	0	0
+      0x80040400,  //  001F  RET	1	R2
     })
   )
 );
@@ -1777,12 +1908,126 @@ be_local_closure(Tasmota_remove_cmd,   /* name */
 /*******************************************************************/
 
 
+/********************************************************************
+** Solidified function: _timer_up
+********************************************************************/
+be_local_closure(Tasmota__timer_up,   /* name */
+  be_nested_proto(
+    7,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 5]) {     /* constants */
+    /* K0   */  be_nested_str(_timers),
+    /* K1   */  be_const_int(0),
+    /* K2   */  be_const_int(1),
+    /* K3   */  be_const_int(2),
+    /* K4   */  be_nested_str(due),
+    }),
+    &be_const_str__timer_up,
+    &be_const_str_solidified,
+    ( &(const binstruction[19]) {  /* code */
+      0x88080100,  //  0000  GETMBR	R2	R0	K0
+      0x940C0401,  //  0001  GETIDX	R3	R2	R1
+      0x24100301,  //  0002  GT	R4	R1	K1
+      0x7812000C,  //  0003  JMPF	R4	#0011
+      0x04100302,  //  0004  SUB	R4	R1	K2
+      0x0C100903,  //  0005  DIV	R4	R4	K3
+      0x88140704,  //  0006  GETMBR	R5	R3	K4
+      0x94180404,  //  0007  GETIDX	R6	R2	R4
+      0x88180D04,  //  0008  GETMBR	R6	R6	K4
+      0x04140A06,  //  0009  SUB	R5	R5	R6
+      0x28140B01,  //  000A  GE	R5	R5	K1
+      0x78160000,  //  000B  JMPF	R5	#000D
+      0x70020003,  //  000C  JMP		#0011
+      0x94140404,  //  000D  GETIDX	R5	R2	R4
+      0x98080205,  //  000E  SETIDX	R2	R1	R5
+      0x5C040800,  //  000F  MOVE	R1	R4
+      0x7001FFF0,  //  0010  JMP		#0002
+      0x98080203,  //  0011  SETIDX	R2	R1	R3
+      0x80000000,  //  0012  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: _timer_down
+********************************************************************/
+be_local_closure(Tasmota__timer_down,   /* name */
+  be_nested_proto(
+    8,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 5]) {     /* constants */
+    /* K0   */  be_nested_str(_timers),
+    /* K1   */  be_const_int(2),
+    /* K2   */  be_const_int(1),
+    /* K3   */  be_nested_str(due),
+    /* K4   */  be_const_int(0),
+    }),
+    &be_const_str__timer_down,
+    &be_const_str_solidified,
+    ( &(const binstruction[37]) {  /* code */
+      0x88080100,  //  0000  GETMBR	R2	R0	K0
+      0x600C000C,  //  0001  GETGBL	R3	G12
+      0x5C100400,  //  0002  MOVE	R4	R2
+      0x7C0C0200,  //  0003  CALL	R3	1
+      0x94100401,  //  0004  GETIDX	R4	R2	R1
+      0x50140200,  //  0005  LDBOOL	R5	1	0
+      0x7816001B,  //  0006  JMPF	R5	#0023
+      0x08160201,  //  0007  MUL	R5	K1	R1
+      0x00140B02,  //  0008  ADD	R5	R5	K2
+      0x28180A03,  //  0009  GE	R6	R5	R3
+      0x781A0000,  //  000A  JMPF	R6	#000C
+      0x70020016,  //  000B  JMP		#0023
+      0x00180B02,  //  000C  ADD	R6	R5	K2
+      0x14180C03,  //  000D  LT	R6	R6	R3
+      0x781A0008,  //  000E  JMPF	R6	#0018
+      0x00180B02,  //  000F  ADD	R6	R5	K2
+      0x94180406,  //  0010  GETIDX	R6	R2	R6
+      0x88180D03,  //  0011  GETMBR	R6	R6	K3
+      0x941C0405,  //  0012  GETIDX	R7	R2	R5
+      0x881C0F03,  //  0013  GETMBR	R7	R7	K3
+      0x04180C07,  //  0014  SUB	R6	R6	R7
+      0x14180D04,  //  0015  LT	R6	R6	K4
+      0x781A0000,  //  0016  JMPF	R6	#0018
+      0x00140B02,  //  0017  ADD	R5	R5	K2
+      0x94180405,  //  0018  GETIDX	R6	R2	R5
+      0x88180D03,  //  0019  GETMBR	R6	R6	K3
+      0x881C0903,  //  001A  GETMBR	R7	R4	K3
+      0x04180C07,  //  001B  SUB	R6	R6	R7
+      0x28180D04,  //  001C  GE	R6	R6	K4
+      0x781A0000,  //  001D  JMPF	R6	#001F
+      0x70020003,  //  001E  JMP		#0023
+      0x94180405,  //  001F  GETIDX	R6	R2	R5
+      0x98080206,  //  0020  SETIDX	R2	R1	R6
+      0x5C040A00,  //  0021  MOVE	R1	R5
+      0x7001FFE1,  //  0022  JMP		#0005
+      0x98080204,  //  0023  SETIDX	R2	R1	R4
+      0x80000000,  //  0024  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
 /********************************************************************
 ** Solidified function: set_timer
 ********************************************************************/
 be_local_closure(Tasmota_set_timer,   /* name */
   be_nested_proto(
-    10,                          /* nstack */
+    11,                          /* nstack */
     4,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -1790,31 +2035,39 @@ be_local_closure(Tasmota_set_timer,   /* name */
     0,                          /* has sup protos */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
-    ( &(const bvalue[ 4]) {     /* constants */
+    ( &(const bvalue[ 6]) {     /* constants */
     /* K0   */  be_nested_str(_timers),
     /* K1   */  be_nested_str(push),
     /* K2   */  be_nested_str(Timer),
     /* K3   */  be_nested_str(millis),
+    /* K4   */  be_nested_str(_timer_up),
+    /* K5   */  be_const_int(1),
     }),
     &be_const_str_set_timer,
     &be_const_str_solidified,
-    ( &(const binstruction[16]) {  /* code */
+    ( &(const binstruction[22]) {  /* code */
       0x88100100,  //  0000  GETMBR	R4	R0	K0
       0x74120002,  //  0001  JMPT	R4	#0005
       0x60100012,  //  0002  GETGBL	R4	G18
       0x7C100000,  //  0003  CALL	R4	0
       0x90020004,  //  0004  SETMBR	R0	K0	R4
       0x88100100,  //  0005  GETMBR	R4	R0	K0
-      0x8C100901,  //  0006  GETMET	R4	R4	K1
-      0xB81A0400,  //  0007  GETNGBL	R6	K2
-      0x8C1C0103,  //  0008  GETMET	R7	R0	K3
-      0x5C240200,  //  0009  MOVE	R9	R1
-      0x7C1C0400,  //  000A  CALL	R7	2
-      0x5C200400,  //  000B  MOVE	R8	R2
-      0x5C240600,  //  000C  MOVE	R9	R3
-      0x7C180600,  //  000D  CALL	R6	3
-      0x7C100400,  //  000E  CALL	R4	2
-      0x80000000,  //  000F  RET	0
+      0x8C140901,  //  0006  GETMET	R5	R4	K1
+      0xB81E0400,  //  0007  GETNGBL	R7	K2
+      0x8C200103,  //  0008  GETMET	R8	R0	K3
+      0x5C280200,  //  0009  MOVE	R10	R1
+      0x7C200400,  //  000A  CALL	R8	2
+      0x5C240400,  //  000B  MOVE	R9	R2
+      0x5C280600,  //  000C  MOVE	R10	R3
+      0x7C1C0600,  //  000D  CALL	R7	3
+      0x7C140400,  //  000E  CALL	R5	2
+      0x8C140104,  //  000F  GETMET	R5	R0	K4
+      0x601C000C,  //  0010  GETGBL	R7	G12
+      0x5C200800,  //  0011  MOVE	R8	R4
+      0x7C1C0200,  //  0012  CALL	R7	1
+      0x041C0F05,  //  0013  SUB	R7	R7	K5
+      0x7C140400,  //  0014  CALL	R5	2
+      0x80000000,  //  0015  RET	0
     })
   )
 );
@@ -1826,7 +2079,7 @@ be_local_closure(Tasmota_set_timer,   /* name */
 ********************************************************************/
 be_local_closure(Tasmota_remove_timer,   /* name */
   be_nested_proto(
-    6,                          /* nstack */
+    8,                          /* nstack */
     2,                          /* argc */
     0,                          /* varg */
     0,                          /* has upvals */
@@ -1835,40 +2088,211 @@ be_local_closure(Tasmota_remove_timer,   /* name */
     NULL,                       /* no sub protos */
     1,                          /* has constants */
     ( &(const bvalue[ 7]) {     /* constants */
-    /* K0   */  be_nested_str(tasmota),
-    /* K1   */  be_nested_str(_timers),
-    /* K2   */  be_const_int(0),
-    /* K3   */  be_nested_str(size),
-    /* K4   */  be_nested_str(id),
-    /* K5   */  be_nested_str(remove),
-    /* K6   */  be_const_int(1),
+    /* K0   */  be_nested_str(_timers),
+    /* K1   */  be_const_int(0),
+    /* K2   */  be_nested_str(id),
+    /* K3   */  be_nested_str(remove),
+    /* K4   */  be_const_int(1),
+    /* K5   */  be_const_int(2),
+    /* K6   */  be_nested_str(_timer_down),
     }),
     &be_const_str_remove_timer,
     &be_const_str_solidified,
-    ( &(const binstruction[23]) {  /* code */
-      0xB80A0000,  //  0000  GETNGBL	R2	K0
-      0x88080501,  //  0001  GETMBR	R2	R2	K1
-      0x780A0012,  //  0002  JMPF	R2	#0016
-      0x58080002,  //  0003  LDCONST	R2	K2
-      0xB80E0000,  //  0004  GETNGBL	R3	K0
-      0x880C0701,  //  0005  GETMBR	R3	R3	K1
-      0x8C0C0703,  //  0006  GETMET	R3	R3	K3
-      0x7C0C0200,  //  0007  CALL	R3	1
-      0x140C0403,  //  0008  LT	R3	R2	R3
-      0x780E000B,  //  0009  JMPF	R3	#0016
-      0x880C0101,  //  000A  GETMBR	R3	R0	K1
-      0x940C0602,  //  000B  GETIDX	R3	R3	R2
-      0x880C0704,  //  000C  GETMBR	R3	R3	K4
-      0x1C0C0601,  //  000D  EQ	R3	R3	R1
-      0x780E0004,  //  000E  JMPF	R3	#0014
-      0x880C0101,  //  000F  GETMBR	R3	R0	K1
-      0x8C0C0705,  //  0010  GETMET	R3	R3	K5
-      0x5C140400,  //  0011  MOVE	R5	R2
-      0x7C0C0400,  //  0012  CALL	R3	2
-      0x70020000,  //  0013  JMP		#0015
-      0x00080506,  //  0014  ADD	R2	R2	K6
-      0x7001FFED,  //  0015  JMP		#0004
-      0x80000000,  //  0016  RET	0
+    ( &(const binstruction[40]) {  /* code */
+      0x88080100,  //  0000  GETMBR	R2	R0	K0
+      0x780A0024,  //  0001  JMPF	R2	#0027
+      0x600C000C,  //  0002  GETGBL	R3	G12
+      0x5C100400,  //  0003  MOVE	R4	R2
+      0x7C0C0200,  //  0004  CALL	R3	1
+      0x58100001,  //  0005  LDCONST	R4	K1
+      0x6014000C,  //  0006  GETGBL	R5	G12
+      0x5C180400,  //  0007  MOVE	R6	R2
+      0x7C140200,  //  0008  CALL	R5	1
+      0x14140805,  //  0009  LT	R5	R4	R5
+      0x78160009,  //  000A  JMPF	R5	#0015
+      0x94140404,  //  000B  GETIDX	R5	R2	R4
+      0x88140B02,  //  000C  GETMBR	R5	R5	K2
+      0x1C140A01,  //  000D  EQ	R5	R5	R1
+      0x78160003,  //  000E  JMPF	R5	#0013
+      0x8C140503,  //  000F  GETMET	R5	R2	K3
+      0x5C1C0800,  //  0010  MOVE	R7	R4
+      0x7C140400,  //  0011  CALL	R5	2
+      0x70020000,  //  0012  JMP		#0014
+      0x00100904,  //  0013  ADD	R4	R4	K4
+      0x7001FFF0,  //  0014  JMP		#0006
+      0x6014000C,  //  0015  GETGBL	R5	G12
+      0x5C180400,  //  0016  MOVE	R6	R2
+      0x7C140200,  //  0017  CALL	R5	1
+      0x20140A03,  //  0018  NE	R5	R5	R3
+      0x7816000C,  //  0019  JMPF	R5	#0027
+      0x6014000C,  //  001A  GETGBL	R5	G12
+      0x5C180400,  //  001B  MOVE	R6	R2
+      0x7C140200,  //  001C  CALL	R5	1
+      0x0C140B05,  //  001D  DIV	R5	R5	K5
+      0x04140B04,  //  001E  SUB	R5	R5	K4
+      0x5C100A00,  //  001F  MOVE	R4	R5
+      0x28140901,  //  0020  GE	R5	R4	K1
+      0x78160004,  //  0021  JMPF	R5	#0027
+      0x8C140106,  //  0022  GETMET	R5	R0	K6
+      0x5C1C0800,  //  0023  MOVE	R7	R4
+      0x7C140400,  //  0024  CALL	R5	2
+      0x04100904,  //  0025  SUB	R4	R4	K4
+      0x7001FFF8,  //  0026  JMP		#0020
+      0x80000000,  //  0027  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: spawn
+********************************************************************/
+be_local_closure(Tasmota_spawn,   /* name */
+  be_nested_proto(
+    7,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 3]) {     /* constants */
+    /* K0   */  be_nested_str(coroutine),
+    /* K1   */  be_nested_str(create),
+    /* K2   */  be_nested_str(_resume),
+    }),
+    &be_const_str_spawn,
+    &be_const_str_solidified,
+    ( &(const binstruction[ 8]) {  /* code */
+      0xA40A0000,  //  0000  IMPORT	R2	K0
+      0x8C0C0501,  //  0001  GETMET	R3	R2	K1
+      0x5C140200,  //  0002  MOVE	R5	R1
+      0x7C0C0400,  //  0003  CALL	R3	2
+      0x8C100102,  //  0004  GETMET	R4	R0	K2
+      0x5C180600,  //  0005  MOVE	R6	R3
+      0x7C100400,  //  0006  CALL	R4	2
+      0x80040600,  //  0007  RET	1	R3
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: _resume
+********************************************************************/
+be_local_closure(Tasmota__resume,   /* name */
+  be_nested_proto(
+    8,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 7]) {     /* constants */
+    /* K0   */  be_nested_str(coroutine),
+    /* K1   */  be_nested_str(resume),
+    /* K2   */  be_nested_str(status),
+    /* K3   */  be_nested_str(suspended),
+    /* K4   */  be_nested_str(set_timer),
+    /* K5   */  be_nested_str(int),
+    /* K6   */  be_const_int(0),
+    }),
+    &be_const_str__resume,
+    &be_const_str_solidified,
+    ( &(const binstruction[21]) {  /* code */
+      0xA40A0000,  //  0000  IMPORT	R2	K0
+      0x8C0C0501,  //  0001  GETMET	R3	R2	K1
+      0x5C140200,  //  0002  MOVE	R5	R1
+      0x7C0C0400,  //  0003  CALL	R3	2
+      0x8C100502,  //  0004  GETMET	R4	R2	K2
+      0x5C180200,  //  0005  MOVE	R6	R1
+      0x7C100400,  //  0006  CALL	R4	2
+      0x1C100903,  //  0007  EQ	R4	R4	K3
+      0x7812000A,  //  0008  JMPF	R4	#0014
+      0x8C100104,  //  0009  GETMET	R4	R0	K4
+      0x60180004,  //  000A  GETGBL	R6	G4
+      0x5C1C0600,  //  000B  MOVE	R7	R3
+      0x7C180200,  //  000C  CALL	R6	1
+      0x1C180D05,  //  000D  EQ	R6	R6	K5
+      0x781A0001,  //  000E  JMPF	R6	#0011
+      0x5C180600,  //  000F  MOVE	R6	R3
+      0x70020000,  //  0010  JMP		#0012
+      0x58180006,  //  0011  LDCONST	R6	K6
+      0x5C1C0200,  //  0012  MOVE	R7	R1
+      0x7C100600,  //  0013  CALL	R4	3
+      0x80000000,  //  0014  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: sleep
+********************************************************************/
+be_local_closure(Tasmota_sleep,   /* name */
+  be_nested_proto(
+    6,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 2]) {     /* constants */
+    /* K0   */  be_nested_str(coroutine),
+    /* K1   */  be_nested_str(yield),
+    }),
+    &be_const_str_sleep,
+    &be_const_str_solidified,
+    ( &(const binstruction[ 5]) {  /* code */
+      0xA40A0000,  //  0000  IMPORT	R2	K0
+      0x8C0C0501,  //  0001  GETMET	R3	R2	K1
+      0x5C140200,  //  0002  MOVE	R5	R1
+      0x7C0C0400,  //  0003  CALL	R3	2
+      0x80000000,  //  0004  RET	0
+    })
+  )
+);
+/*******************************************************************/
+
+
+/********************************************************************
+** Solidified function: wait_until
+********************************************************************/
+be_local_closure(Tasmota_wait_until,   /* name */
+  be_nested_proto(
+    6,                          /* nstack */
+    2,                          /* argc */
+    0,                          /* varg */
+    0,                          /* has upvals */
+    NULL,                       /* no upvals */
+    0,                          /* has sup protos */
+    NULL,                       /* no sub protos */
+    1,                          /* has constants */
+    ( &(const bvalue[ 3]) {     /* constants */
+    /* K0   */  be_nested_str(coroutine),
+    /* K1   */  be_nested_str(yield),
+    /* K2   */  be_const_int(0),
+    }),
+    &be_const_str_wait_until,
+    &be_const_str_solidified,
+    ( &(const binstruction[ 9]) {  /* code */
+      0xA40A0000,  //  0000  IMPORT	R2	K0
+      0x5C0C0200,  //  0001  MOVE	R3	R1
+      0x7C0C0000,  //  0002  CALL	R3	0
+      0x740E0003,  //  0003  JMPT	R3	#0008
+      0x8C0C0501,  //  0004  GETMET	R3	R2	K1
+      0x58140002,  //  0005  LDCONST	R5	K2
+      0x7C0C0400,  //  0006  CALL	R3	2
+      0x7001FFF8,  //  0007  JMP		#0001
+      0x80000000,  //  0008  RET	0
     })
   )
 );
@@ -2043,6 +2467,7 @@ class be_class_tasmota (scope: global, name: Tasmota) {
     get_power, func(l_getpower)
     set_power, func(l_setpower)
     get_switch, func(l_getswitch)
+    _rule_values, func(l_rulevalues)
 
     i2c_enabled, func(l_i2cenabled)
 
@@ -2052,12 +2477,20 @@ class be_class_tasmota (scope: global, name: Tasmota) {
     find_op, closure(Tasmota_find_op_closure)
     add_rule, closure(Tasmota_add_rule_closure)
     remove_rule, closure(Tasmota_remove_rule_closure)
+    match_op, closure(Tasmota_match_op_closure)
     try_rule, closure(Tasmota_try_rule_closure)
+    run_rules, closure(Tasmota_run_rules_closure)
     exec_rules, closure(Tasmota_exec_rules_closure)
     exec_tele, closure(Tasmota_exec_tele_closure)
     set_timer, closure(Tasmota_set_timer_closure)
     run_deferred, closure(Tasmota_run_deferred_closure)
     remove_timer, closure(Tasmota_remove_timer_closure)
+    _timer_up, closure(Tasmota__timer_up_closure)
+    _timer_down, closure(Tasmota__timer_down_closure)
+    spawn, closure(Tasmota_spawn_closure)
+    _resume, closure(Tasmota__resume_closure)
+    sleep, closure(Tasmota_sleep_closure)
+    wait_until, closure(Tasmota_wait_until_closure)
     add_cmd, closure(Tasmota_add_cmd_closure)
     remove_cmd, closure(Tasmota_remove_cmd_closure)
     exec_cmd, closure(Tasmota_exec_cmd_closure)
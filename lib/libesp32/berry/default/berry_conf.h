@@ -193,6 +193,7 @@
 #define BE_USE_SOLIDIFY_MODULE          0
 #define BE_USE_INTROSPECT_MODULE        1
 #define BE_USE_STRICT_MODULE            1
+#define BE_USE_COROUTINE_MODULE         1
 
 #ifdef USE_BERRY_DEBUG
   #undef BE_USE_DEBUG_MODULE
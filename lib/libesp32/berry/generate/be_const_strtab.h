@@ -122,6 +122,7 @@ extern const bcstring be_const_str__X2Ep1;
 extern const bcstring be_const_str__X2Ep2;
 extern const bcstring be_const_str__X2Esize;
 extern const bcstring be_const_str__X2Etapp;
+extern const bcstring be_const_str__X2Etmp;
 extern const bcstring be_const_str__X2Ew;
 extern const bcstring be_const_str__X2F;
 extern const bcstring be_const_str__X2F_X2Eautoconf;
@@ -159,13 +160,13 @@ extern const bcstring be_const_str__X3F;
 extern const bcstring be_const_str__X5B;
 extern const bcstring be_const_str__X5D;
 extern const bcstring be_const_str__X7B;
-extern const bcstring be_const_str__X7B_X7D;
 extern const bcstring be_const_str__X7Bs_X7DBatt_X20Current_X7Bm_X7D_X25_X2E1f_X20mA_X7Be_X7D;
 extern const bcstring be_const_str__X7Bs_X7DBatt_X20Voltage_X7Bm_X7D_X25_X2E3f_X20V_X7Be_X7D;
 extern const bcstring be_const_str__X7Bs_X7DTemp_X20AXP_X7Bm_X7D_X25_X2E1f_X20_X26deg_X3BC_X7Be_X7D;
 extern const bcstring be_const_str__X7Bs_X7DVBus_X20Current_X7Bm_X7D_X25_X2E1f_X20mA_X7Be_X7D;
 extern const bcstring be_const_str__X7Bs_X7DVBus_X20Voltage_X7Bm_X7D_X25_X2E3f_X20V_X7Be_X7D;
 extern const bcstring be_const_str__X7D;
+extern const bcstring be_const_str__X7D_X0A;
 extern const bcstring be_const_str___iterator__;
 extern const bcstring be_const_str___lower__;
 extern const bcstring be_const_str___upper__;
@@ -185,18 +186,26 @@ extern const bcstring be_const_str__end_transmission;
 extern const bcstring be_const_str__energy;
 extern const bcstring be_const_str__error;
 extern const bcstring be_const_str__filename;
+extern const bcstring be_const_str__full;
 extern const bcstring be_const_str__global_addr;
 extern const bcstring be_const_str__global_def;
+extern const bcstring be_const_str__log_size;
+extern const bcstring be_const_str__logname;
 extern const bcstring be_const_str__lvgl;
 extern const bcstring be_const_str__p;
 extern const bcstring be_const_str__persist_X2Ejson;
+extern const bcstring be_const_str__persist_X2Elog;
 extern const bcstring be_const_str__ptr;
 extern const bcstring be_const_str__read;
 extern const bcstring be_const_str__request_from;
+extern const bcstring be_const_str__resume;
+extern const bcstring be_const_str__rule_values;
 extern const bcstring be_const_str__rules;
 extern const bcstring be_const_str__settings_def;
 extern const bcstring be_const_str__settings_ptr;
 extern const bcstring be_const_str__t;
+extern const bcstring be_const_str__timer_down;
+extern const bcstring be_const_str__timer_up;
 extern const bcstring be_const_str__timers;
 extern const bcstring be_const_str__write;
 extern const bcstring be_const_str_a;
@@ -213,6 +222,7 @@ extern const bcstring be_const_str_allocated;
 extern const bcstring be_const_str_alternate;
 extern const bcstring be_const_str_animate;
 extern const bcstring be_const_str_animators;
+extern const bcstring be_const_str_append;
 extern const bcstring be_const_str_arch;
 extern const bcstring be_const_str_area;
 extern const bcstring be_const_str_arg;
@@ -238,6 +248,7 @@ extern const bcstring be_const_str_begin;
 extern const bcstring be_const_str_bool;
 extern const bcstring be_const_str_break;
 extern const bcstring be_const_str_bri;
+extern const bcstring be_const_str_builder;
 extern const bcstring be_const_str_bus;
 extern const bcstring be_const_str_button_pressed;
 extern const bcstring be_const_str_byte;
@@ -247,6 +258,7 @@ extern const bcstring be_const_str_call;
 extern const bcstring be_const_str_call_native;
 extern const bcstring be_const_str_calldepth;
 extern const bcstring be_const_str_can_show;
+extern const bcstring be_const_str_cannot_X20rename_X20;
 extern const bcstring be_const_str_cb;
 extern const bcstring be_const_str_cb_do_nothing;
 extern const bcstring be_const_str_cb_event_closure;
@@ -286,11 +298,13 @@ extern const bcstring be_const_str_content_start;
 extern const bcstring be_const_str_content_stop;
 extern const bcstring be_const_str_continue;
 extern const bcstring be_const_str_copy;
+extern const bcstring be_const_str_coroutine;
 extern const bcstring be_const_str_cos;
 extern const bcstring be_const_str_cosh;
 extern const bcstring be_const_str_couldn_X27t_X20not_X20initialize_X20noepixelbus;
 extern const bcstring be_const_str_count;
 extern const bcstring be_const_str_counters;
+extern const bcstring be_const_str_create;
 extern const bcstring be_const_str_create_custom_widget;
 extern const bcstring be_const_str_create_matrix;
 extern const bcstring be_const_str_create_segment;
@@ -466,6 +480,7 @@ extern const bcstring be_const_str_line_dsc;
 extern const bcstring be_const_str_list;
 extern const bcstring be_const_str_listdir;
 extern const bcstring be_const_str_load;
+extern const bcstring be_const_str_load_log;
 extern const bcstring be_const_str_load_templates;
 extern const bcstring be_const_str_local;
 extern const bcstring be_const_str_log;
@@ -479,6 +494,7 @@ extern const bcstring be_const_str_lv_obj;
 extern const bcstring be_const_str_lv_obj_class;
 extern const bcstring be_const_str_lvgl_event_dispatch;
 extern const bcstring be_const_str_map;
+extern const bcstring be_const_str_match_op;
 extern const bcstring be_const_str_math;
 extern const bcstring be_const_str_matrix;
 extern const bcstring be_const_str_member;
@@ -552,6 +568,7 @@ extern const bcstring be_const_str_readbytes;
 extern const bcstring be_const_str_readline;
 extern const bcstring be_const_str_real;
 extern const bcstring be_const_str_reapply;
+extern const bcstring be_const_str_recover;
 extern const bcstring be_const_str_redirect;
 extern const bcstring be_const_str_refr_size;
 extern const bcstring be_const_str_register_obj;
@@ -560,6 +577,8 @@ extern const bcstring be_const_str_remove_cmd;
 extern const bcstring be_const_str_remove_driver;
 extern const bcstring be_const_str_remove_rule;
 extern const bcstring be_const_str_remove_timer;
+extern const bcstring be_const_str_rename;
+extern const bcstring be_const_str_replace;
 extern const bcstring be_const_str_reset;
 extern const bcstring be_const_str_reset_search;
 extern const bcstring be_const_str_resize;
@@ -570,6 +589,7 @@ extern const bcstring be_const_str_resp_cmnd_error;
 extern const bcstring be_const_str_resp_cmnd_failed;
 extern const bcstring be_const_str_resp_cmnd_str;
 extern const bcstring be_const_str_response_append;
+extern const bcstring be_const_str_resume;
 extern const bcstring be_const_str_return;
 extern const bcstring be_const_str_return_X20code_X3D_X25i;
 extern const bcstring be_const_str_reverse;
@@ -582,9 +602,12 @@ extern const bcstring be_const_str_rule;
 extern const bcstring be_const_str_run;
 extern const bcstring be_const_str_run_bat;
 extern const bcstring be_const_str_run_deferred;
+extern const bcstring be_const_str_run_rules;
 extern const bcstring be_const_str_running;
 extern const bcstring be_const_str_save;
 extern const bcstring be_const_str_save_before_restart;
+extern const bcstring be_const_str_save_full;
+extern const bcstring be_const_str_save_log;
 extern const bcstring be_const_str_scale_uint;
 extern const bcstring be_const_str_scan;
 extern const bcstring be_const_str_search;
@@ -632,13 +655,16 @@ extern const bcstring be_const_str_sin;
 extern const bcstring be_const_str_sinh;
 extern const bcstring be_const_str_size;
 extern const bcstring be_const_str_skip;
+extern const bcstring be_const_str_sleep;
 extern const bcstring be_const_str_solidified;
+extern const bcstring be_const_str_spawn;
 extern const bcstring be_const_str_split;
 extern const bcstring be_const_str_sqrt;
 extern const bcstring be_const_str_srand;
 extern const bcstring be_const_str_start;
 extern const bcstring be_const_str_state;
 extern const bcstring be_const_str_static;
+extern const bcstring be_const_str_status;
 extern const bcstring be_const_str_stop;
 extern const bcstring be_const_str_stop_iteration;
 extern const bcstring be_const_str_str;
@@ -647,6 +673,7 @@ extern const bcstring be_const_str_string;
 extern const bcstring be_const_str_strip;
 extern const bcstring be_const_str_strptime;
 extern const bcstring be_const_str_super;
+extern const bcstring be_const_str_suspended;
 extern const bcstring be_const_str_sys;
 extern const bcstring be_const_str_tag;
 extern const bcstring be_const_str_tan;
@@ -686,6 +713,7 @@ extern const bcstring be_const_str_value_error;
 extern const bcstring be_const_str_valuer_error;
 extern const bcstring be_const_str_var;
 extern const bcstring be_const_str_w;
+extern const bcstring be_const_str_wait_until;
 extern const bcstring be_const_str_wd;
 extern const bcstring be_const_str_web_add_button;
 extern const bcstring be_const_str_web_add_config_button;
@@ -0,0 +1,25 @@
+#include "be_constobj.h"
+
+static be_define_const_map_slots(be_class_string_builder_map) {
+    { be_const_key(size, -1), be_const_func(sb_size) },
+    { be_const_key(_X2Ep, -1), be_const_var(0) },
+    { be_const_key(init, -1), be_const_func(sb_init) },
+    { be_const_key(deinit, -1), be_const_func(sb_deinit) },
+    { be_const_key(append, 3), be_const_func(sb_append_m) },
+    { be_const_key(clear, -1), be_const_func(sb_clear) },
+    { be_const_key(_X2E_X2E, 2), be_const_func(sb_append_m) },
+    { be_const_key(tostring, -1), be_const_func(sb_tostring) },
+    { be_const_key(format, -1), be_const_func(sb_format) },
+};
+
+static be_define_const_map(
+    be_class_string_builder_map,
+    9
+);
+
+BE_EXPORT_VARIABLE be_define_const_class(
+    be_class_string_builder,
+    1,
+    NULL,
+    builder
+);
@@ -0,0 +1,21 @@
+#include "be_constobj.h"
+
+static be_define_const_map_slots(m_libcoroutine_map) {
+    { be_const_key(running, -1), be_const_func(m_running) },
+    { be_const_key(resume, -1), be_const_func(m_resume) },
+    { be_const_key(create, -1), be_const_func(m_create) },
+    { be_const_key(status, -1), be_const_func(m_status) },
+    { be_const_key(yield, 3), be_const_func(m_yield) },
+};
+
+static be_define_const_map(
+    m_libcoroutine_map,
+    5
+);
+
+static be_define_const_module(
+    m_libcoroutine,
+    "coroutine"
+);
+
+BE_EXPORT_VARIABLE be_define_const_native_module(coroutine);
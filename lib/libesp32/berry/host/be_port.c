@@ -0,0 +1,187 @@
+/********************************************************************
+** Copyright (c) 2018-2020 Guan Wenliang
+** This file is part of the Berry default interpreter.
+** skiars@qq.com, https://github.com/Skiars/berry
+** See Copyright Notice in the LICENSE file or at
+** https://github.com/Skiars/berry/blob/master/LICENSE
+********************************************************************/
+#define _POSIX_C_SOURCE 200809L   /* for fileno() */
+#include "berry.h"
+#include "be_sys.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/* standard input and output */
+
+BERRY_API void be_writebuffer(const char *buffer, size_t length)
+{
+    be_fwrite(stdout, buffer, length);
+}
+
+BERRY_API char* be_readstring(char *buffer, size_t size)
+{
+    return be_fgets(stdin, buffer, (int)size);
+}
+
+/* used by the Tasmota logging of native modules, e.g. `re` */
+void berry_log_C(const char * berry_buf, ...)
+{
+    va_list arg;
+    va_start(arg, berry_buf);
+    vprintf(berry_buf, arg);
+    va_end(arg);
+    printf("\n");
+}
+
+/* file system */
+
+void* be_fopen(const char *filename, const char *modes)
+{
+    return fopen(filename, modes);
+}
+
+int be_fclose(void *hfile)
+{
+    return fclose(hfile);
+}
+
+size_t be_fwrite(void *hfile, const void *buffer, size_t length)
+{
+    return fwrite(buffer, 1, length, hfile);
+}
+
+size_t be_fread(void *hfile, void *buffer, size_t length)
+{
+    return fread(buffer, 1, length, hfile);
+}
+
+char* be_fgets(void *hfile, void *buffer, int size)
+{
+    return fgets(buffer, size, hfile);
+}
+
+int be_fseek(void *hfile, long offset)
+{
+    return fseek(hfile, offset, SEEK_SET);
+}
+
+long int be_ftell(void *hfile)
+{
+    return ftell(hfile);
+}
+
+long int be_fflush(void *hfile)
+{
+    return fflush(hfile);
+}
+
+size_t be_fsize(void *hfile)
+{
+    struct stat st;
+    if (fstat(fileno(hfile), &st) == 0) {
+        return (size_t)st.st_size;
+    }
+    return 0;
+}
+
+int be_isexist(const char *filename)
+{
+    struct stat st;
+    return stat(filename, &st) == 0;
+}
+
+int be_isdir(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+int be_isfile(const char *path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISREG(st.st_mode);
+}
+
+char* be_getcwd(char *buf, size_t size)
+{
+    return getcwd(buf, size);
+}
+
+int be_chdir(const char *path)
+{
+    return chdir(path);
+}
+
+int be_mkdir(const char *path)
+{
+    return mkdir(path, 0777);
+}
+
+int be_unlink(const char *filename)
+{
+    return remove(filename);
+}
+
+int be_dirfirst(bdirinfo *info, const char *path)
+{
+    info->dir = opendir(path);
+    if (info->dir) {
+        return be_dirnext(info);
+    }
+    return 1;
+}
+
+int be_dirnext(bdirinfo *info)
+{
+    struct dirent *file = readdir(info->dir);
+    info->name = file ? file->d_name : NULL;
+    return file == NULL;
+}
+
+int be_dirclose(bdirinfo *info)
+{
+    return closedir(info->dir) != 0;
+}
+
+/* used by the Tasmota `path` module */
+
+int be_rename(const char *from, const char *to)
+{
+    return rename(from, to) == 0;
+}
+
+time_t be_last_modified(void *hfile)
+{
+    struct stat st;
+    if (hfile && fstat(fileno(hfile), &st) == 0) {
+        return st.st_mtime;
+    }
+    return 0;
+}
+
+int m_path_listdir(bvm *vm)
+{
+    if (be_top(vm) >= 1 && be_isstring(vm, 1)) {
+        DIR *dir = opendir(be_tostring(vm, 1));
+        be_newobject(vm, "list");
+        if (dir) {
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != NULL) {
+                if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+                    be_pushstring(vm, entry->d_name);
+                    be_data_push(vm, -2);
+                    be_pop(vm, 1);
+                }
+            }
+            closedir(dir);
+        }
+        be_pop(vm, 1);
+        be_return(vm);
+    }
+    be_return_nil(vm);
+}
@@ -0,0 +1,107 @@
+/********************************************************************
+** Copyright (c) 2018-2020 Guan Wenliang
+** This file is part of the Berry default interpreter.
+** skiars@qq.com, https://github.com/Skiars/berry
+** See Copyright Notice in the LICENSE file or at
+** https://github.com/Skiars/berry/blob/master/LICENSE
+********************************************************************/
+#include "berry.h"
+#include "be_repl.h"
+#include "be_vm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef USE_READLINE_LIB
+#include <readline/readline.h>
+#include <readline/history.h>
+#endif
+
+/* host interpreter used by `make test` and `make bench`:
+ *   berry [-O]                 start the REPL
+ *   berry [-O] script [args]   run a script, `_argv` holds the script
+ *                              name and its arguments
+ * `-O` folds constants and runs the peephole pass (COMP_OPTIMIZE) */
+
+#ifdef USE_READLINE_LIB
+static char* get_line(const char *prompt)
+{
+    char *line = readline(prompt);
+    if (line && strlen(line)) {
+        add_history(line);
+    }
+    return line;
+}
+
+static void free_line(char *ptr)
+{
+    free(ptr);
+}
+#else
+static char line_buf[1024];
+
+static char* get_line(const char *prompt)
+{
+    fputs(prompt, stdout);
+    fflush(stdout);
+    return be_readstring(line_buf, sizeof(line_buf));
+}
+
+static void free_line(char *ptr)
+{
+    (void)ptr;
+}
+#endif
+
+static void push_args(bvm *vm, int argc, char *argv[])
+{
+    int i;
+    be_newobject(vm, "list");
+    for (i = 0; i < argc; ++i) {
+        be_pushstring(vm, argv[i]);
+        be_data_push(vm, -2);
+        be_pop(vm, 1);
+    }
+    be_pop(vm, 1);
+    be_setglobal(vm, "_argv");
+    be_pop(vm, 1);
+}
+
+static int run_script(bvm *vm, int argc, char *argv[])
+{
+    int res;
+    push_args(vm, argc, argv);  /* before compiling, so that the script can name `_argv` */
+    res = be_loadfile(vm, argv[0]);
+    if (res == BE_OK) {
+        res = be_pcall(vm, 0);
+    }
+    switch (res) {
+    case BE_OK:
+        return 0;
+    case BE_IO_ERROR:
+        be_writestring("error: ");
+        be_writestring(be_tostring(vm, -1));
+        be_writenewline();
+        return -2;
+    default:
+        be_dumpexcept(vm);
+        return -1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int res, argi = 1;
+    bvm *vm = be_vm_new();
+    if (argc > argi && !strcmp(argv[argi], "-O")) {
+        comp_set_optimize(vm);
+        ++argi;
+    }
+    if (argc > argi) {
+        res = run_script(vm, argc - argi, argv + argi);
+    } else {
+        res = be_repl(vm, get_line, free_line) == BE_MALLOC_FAIL ? -1 : 0;
+    }
+    be_vm_delete(vm);
+    return res;
+}
@@ -14,6 +14,7 @@
 #include "be_var.h"
 #include "be_exec.h"
 #include "be_vm.h"
+#include "be_mem.h"
 
 #define NOT_MASK                (1 << 0)
 #define NOT_EXPR                (1 << 1)
@@ -26,6 +27,8 @@
 #define exp2anyreg(f, e)        exp2reg(f, e, -1)   /* -1 means allocate a new register if needed */
 #define var2anyreg(f, e)        var2reg(f, e, -1)   /* -1 means allocate a new register if needed */
 #define hasjump(e)              ((e)->t != (e)->f || notexpr(e))
+#define isimmop(op)             ((op) >= OP_ADDI && (op) <= OP_GEI)
+#define isnumlit(e)             (((e)->type == ETINT || (e)->type == ETREAL) && !hasjump(e))
 #define code_bool(f, r, b, j)   codeABC(f, OP_LDBOOL, r, b, j)
 #define code_call(f, a, b)      codeABC(f, OP_CALL, a, b, 0)
 #define code_getmbr(f, a, b, c) codeABC(f, OP_GETMBR, a, b, c)
@@ -86,7 +89,7 @@ static void code_move(bfuncinfo *finfo, int a, int b)
     if (finfo->pc) {  /* If not the first instruction of the function */
         binstruction *i = be_vector_end(&finfo->code);  /* get the last instruction */
         bopcode op = IGET_OP(*i);
-        if (op <= OP_LDNIL) { /* binop or unop */
+        if (op <= OP_LDNIL || isimmop(op)) { /* binop or unop */
             /* remove redundant MOVE instruction */
             int x = IGET_RA(*i), y = IGET_RKB(*i), z = IGET_RKC(*i);
             if (b == x && (a == y || (op < OP_NEG && a == z))) {
@@ -507,10 +510,36 @@ static int codedestreg(bfuncinfo *finfo, bexpdesc *e1, bexpdesc *e2, int dst)
     }
 }
 
+/* Immediate variant of `op` if e2 is a small int literal, or `op` itself */
+/* Immediates are only emitted when optimizing, they are not understood by upstream VMs */
+static bopcode immop(bfuncinfo *finfo, bopcode op, bexpdesc *e2)
+{
+    if (comp_is_optimize(finfo->lexer->vm) && e2->type == ETINT && !hasjump(e2)
+            && e2->v.i >= -IsC_MAX && e2->v.i <= IsC_MAX) {
+        switch (op) {
+        case OP_ADD: return OP_ADDI;
+        case OP_SUB: return OP_SUBI;
+        case OP_LT: case OP_LE: case OP_EQ: case OP_NE: case OP_GT: case OP_GE:
+            return (bopcode)(op - OP_LT + OP_LTI);
+        default: break;
+        }
+    }
+    return op;
+}
+
 /* compute binary expression and update e1 as result */
 /* On exit, e1 is guaranteed to be ETREG, which may have been allocated */
 static void binaryexp(bfuncinfo *finfo, bopcode op, bexpdesc *e1, bexpdesc *e2, int dst)
 {
+    bopcode iop = immop(finfo, op, e2);
+    if (iop != op) { /* R(A) <- RK(B) op sC, the literal is not materialized */
+        int src1 = exp2reg(finfo, e1, dst);
+        dst = codedestreg(finfo, e1, e2, dst);
+        codeinst(finfo, ISET_OP(iop) | ISET_RA(dst) | ISET_RKB(src1) | ISET_sC(e2->v.i));
+        e1->type = ETREG;
+        e1->v.idx = dst;
+        return;
+    }
     int src1 = exp2reg(finfo, e1, dst);  /* potentially force the target for src1 reg */
     int src2 = exp2anyreg(finfo, e2);
     dst = codedestreg(finfo, e1, e2, dst);
@@ -529,11 +558,80 @@ void be_code_prebinop(bfuncinfo *finfo, int op, bexpdesc *e)
         be_code_jumpbool(finfo, e, btrue);
         break;
     default:
-        exp2anyreg(finfo, e);
+        /* keep number literals as is so that `be_code_binop` can fold them */
+        if (!(comp_is_optimize(finfo->lexer->vm) && isnumlit(e))) {
+            exp2anyreg(finfo, e);
+        }
         break;
     }
 }
 
+/* Compute binary operator on two number literals at compile time */
+/* Returns true if e1 was replaced by the result */
+/* Anything that would raise an error or depend on the target at runtime is left to the VM */
+static bbool code_fold(bfuncinfo *finfo, int op, bexpdesc *e1, bexpdesc *e2)
+{
+    if (!comp_is_optimize(finfo->lexer->vm) || !isnumlit(e1) || !isnumlit(e2)) {
+        return bfalse;
+    }
+    if (e1->type == ETINT && e2->type == ETINT) {
+        bint x = e1->v.i, y = e2->v.i;
+        switch (op) {
+        case OptAdd: x = x + y; break;
+        case OptSub: x = x - y; break;
+        case OptMul: x = x * y; break;
+        case OptDiv: if (y == 0 || y == -1) { return bfalse; } x = x / y; break;
+        case OptMod: if (y == 0 || y == -1) { return bfalse; } x = x % y; break;
+        case OptBitAnd: x = x & y; break;
+        case OptBitOr: x = x | y; break;
+        case OptBitXor: x = x ^ y; break;
+        case OptShiftL:
+        case OptShiftR:
+            if (y < 0 || y >= (bint)(sizeof(bint) * 8)) { return bfalse; }
+            x = (op == OptShiftL) ? x << y : x >> y;
+            break;
+        case OptLT: case OptLE: case OptEQ: case OptNE: case OptGT: case OptGE:
+            e1->type = ETBOOL;
+            switch (op) {
+            case OptLT: e1->v.i = x < y; break;
+            case OptLE: e1->v.i = x <= y; break;
+            case OptEQ: e1->v.i = x == y; break;
+            case OptNE: e1->v.i = x != y; break;
+            case OptGT: e1->v.i = x > y; break;
+            default: e1->v.i = x >= y; break;
+            }
+            return btrue;
+        default: return bfalse;
+        }
+        e1->v.i = x;
+        return btrue;
+    } else {
+        breal x = e1->type == ETREAL ? e1->v.r : (breal)e1->v.i;
+        breal y = e2->type == ETREAL ? e2->v.r : (breal)e2->v.i;
+        switch (op) {
+        case OptAdd: x = x + y; break;
+        case OptSub: x = x - y; break;
+        case OptMul: x = x * y; break;
+        case OptDiv: if (y == cast(breal, 0)) { return bfalse; } x = x / y; break;
+        case OptLT: case OptLE: case OptEQ: case OptNE: case OptGT: case OptGE:
+            e1->type = ETBOOL;
+            switch (op) {
+            case OptLT: e1->v.i = x < y; break;
+            case OptLE: e1->v.i = x <= y; break;
+            case OptEQ: e1->v.i = x == y; break;
+            case OptNE: e1->v.i = x != y; break;
+            case OptGT: e1->v.i = x > y; break;
+            default: e1->v.i = x >= y; break;
+            }
+            return btrue;
+        default: return bfalse;
+        }
+        e1->type = ETREAL;
+        e1->v.r = x;
+        return btrue;
+    }
+}
+
 /* Apply binary operator `op` to e1 and e2, result in e1 */
 void be_code_binop(bfuncinfo *finfo, int op, bexpdesc *e1, bexpdesc *e2, int dst)
 {
@@ -553,6 +651,9 @@ void be_code_binop(bfuncinfo *finfo, int op, bexpdesc *e1, bexpdesc *e2, int dst
     case OptNE: case OptGT: case OptGE: case OptConnect:
     case OptBitAnd: case OptBitOr: case OptBitXor:
     case OptShiftL: case OptShiftR:
+        if (code_fold(finfo, op, e1, e2)) {
+            break;
+        }
         binaryexp(finfo, (bopcode)(op - OptAdd), e1, e2, dst);
         break;
     default: break;
@@ -733,6 +834,12 @@ int be_code_getmethod(bfuncinfo *finfo, bexpdesc *e)
     return dst;
 }
 
+/* itvar <- .it(), with an inline path in the VM for ranges */
+void be_code_foriter(bfuncinfo *finfo, bexpdesc *v, bexpdesc *it)
+{
+    codeABC(finfo, OP_FORITER, v->v.idx, it->v.idx, 0);
+}
+
 /* Generate a CALL instruction at base register with argc consecutive values */
 /* i.e. arg1 is base+1... */
 /* Important: argc registers are freed upon call, which are supposed to be registers above base */
@@ -927,4 +1034,143 @@ void be_code_raise(bfuncinfo *finfo, bexpdesc *e1, bexpdesc *e2)
     free_expreg(finfo, e2);
 }
 
+
+/********************************************************************
+** Peephole pass, run on each function once it is completely coded
+**
+** - jumps landing on a JMP go directly to its destination, and a JMP
+**   landing on a RET is replaced by the RET itself
+** - JMP to the next instruction and `MOVE Rx Rx` are removed
+** - unreachable instructions are removed
+** Jump offsets and debug information are updated after compaction.
+********************************************************************/
+#define isbranch(i)     (IGET_OP(i) == OP_JMP || IGET_OP(i) == OP_JMPT || IGET_OP(i) == OP_JMPF || \
+                         (IGET_OP(i) == OP_EXBLK && !IGET_RA(i)))
+/* LDBOOL with C set and CATCH skip the next instruction, which must stay in place */
+#define isskip(i)       ((IGET_OP(i) == OP_LDBOOL && IGET_RKC(i)) || IGET_OP(i) == OP_CATCH)
+#define isfallthru(i)   (IGET_OP(i) != OP_JMP && IGET_OP(i) != OP_RET && IGET_OP(i) != OP_RAISE)
+#define branch_dst(pc, i)   ((pc) + 1 + IGET_sBx(i))
+
+static void thread_jumps(bfuncinfo *finfo, binstruction *code)
+{
+    int pc, n = finfo->pc;
+    for (pc = 0; pc < n; ++pc) {
+        bopcode op = IGET_OP(code[pc]);
+        if (op == OP_JMP || op == OP_JMPT || op == OP_JMPF) {
+            int dst = branch_dst(pc, code[pc]), hops = 0;
+            while (IGET_OP(code[dst]) == OP_JMP && hops++ < 8) { /* bounded, `while true end` jumps to itself */
+                dst = branch_dst(dst, code[dst]);
+            }
+            if (op == OP_JMP && IGET_OP(code[dst]) == OP_RET) {
+                code[pc] = code[dst];
+            } else {
+                setjump(finfo, pc, dst);
+            }
+        }
+    }
+}
+
+/* Mark reachable instructions with 1 in `mark`, `stack` needs room for `n` entries */
+static void mark_reachable(binstruction *code, int n, int *mark, int *stack)
+{
+    int top = 0;
+    mark[0] = 1;
+    stack[top++] = 0;
+    while (top) {
+        int pc = stack[--top], next[3], cnt = 0;
+        binstruction ins = code[pc];
+        if (isbranch(ins)) {
+            next[cnt++] = branch_dst(pc, ins);
+        }
+        if (isfallthru(ins)) {
+            next[cnt++] = pc + 1;
+        }
+        if (isskip(ins)) {
+            next[cnt++] = pc + 2;
+        }
+        while (cnt--) {
+            if (next[cnt] < n && !mark[next[cnt]]) {
+                mark[next[cnt]] = 1;
+                stack[top++] = next[cnt];
+            }
+        }
+    }
+}
+
+void be_code_optimize(bfuncinfo *finfo)
+{
+    bvm *vm = finfo->lexer->vm;
+    binstruction *code = be_vector_data(&finfo->code);
+    int pc, count = 0, n = finfo->pc;
+    int *newpc, *stack;
+    if (n == 0) {
+        return;
+    }
+    for (pc = 0; pc < n; ++pc) { /* leave the function untouched if a jump is still unpatched */
+        if (isbranch(code[pc])) {
+            int dst = branch_dst(pc, code[pc]);
+            if (dst < 0 || dst >= n) {
+                return;
+            }
+        }
+    }
+    thread_jumps(finfo, code);
+    /* `newpc` holds the keep flag of each instruction, then its index in the compacted code */
+    newpc = be_malloc(vm, sizeof(int) * (2 * n + 1));
+    stack = newpc + n + 1;
+    for (pc = 0; pc <= n; ++pc) {
+        newpc[pc] = 0;
+    }
+    mark_reachable(code, n, newpc, stack);
+    for (pc = 0; pc < n; ++pc) {
+        binstruction ins = code[pc];
+        bbool nop = (IGET_OP(ins) == OP_JMP && IGET_sBx(ins) == 0) ||
+                    (IGET_OP(ins) == OP_MOVE && IGET_RA(ins) == IGET_RKB(ins));
+        if (nop && !(pc > 0 && isskip(code[pc - 1]))) {
+            newpc[pc] = 0;
+        }
+    }
+    for (pc = 0; pc < n; ++pc) {
+        int keep = newpc[pc];
+        newpc[pc] = count;
+        count += keep;
+    }
+    newpc[n] = count;
+    if (count < n) {
+        for (pc = 0; pc < n; ++pc) {
+            if (newpc[pc + 1] != newpc[pc]) { /* instruction is kept */
+                binstruction ins = code[pc];
+                if (isbranch(ins)) {
+                    int dst = newpc[branch_dst(pc, ins)];
+                    ins = (ins & ~IBx_MASK) | ISET_sBx(dst - (newpc[pc] + 1));
+                }
+                code[newpc[pc]] = ins;
+            }
+        }
+#if BE_DEBUG_RUNTIME_INFO
+        {
+            blineinfo *li = be_vector_data(&finfo->linevec);
+            blineinfo *end = li + be_vector_count(&finfo->linevec);
+            for (; li < end; ++li) { /* `endpc` is the last instruction of the line */
+                int last = newpc[li->endpc < n ? li->endpc + 1 : n] - 1;
+                li->endpc = last > 0 ? last : 0;
+            }
+        }
+#endif
+#if BE_DEBUG_VAR_INFO
+        {
+            bvarinfo *vi = be_vector_data(&finfo->varvec);
+            bvarinfo *end = vi + be_vector_count(&finfo->varvec);
+            for (; vi < end; ++vi) {
+                vi->beginpc = newpc[vi->beginpc < n ? vi->beginpc : n];
+                vi->endpc = newpc[vi->endpc < n ? vi->endpc : n];
+            }
+        }
+#endif
+        be_vector_resize(vm, &finfo->code, count);
+        finfo->pc = count;
+    }
+    be_free(vm, newpc, sizeof(int) * (2 * n + 1));
+}
+
 #endif
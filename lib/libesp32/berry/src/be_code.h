@@ -25,6 +25,7 @@ void be_code_conjump(bfuncinfo *finfo, int *list, int jmp);
 void be_code_patchlist(bfuncinfo *finfo, int list, int dst);
 void be_code_patchjump(bfuncinfo *finfo, int jmp);
 int be_code_getmethod(bfuncinfo *finfo, bexpdesc *e);
+void be_code_foriter(bfuncinfo *finfo, bexpdesc *v, bexpdesc *it);
 void be_code_call(bfuncinfo *finfo, int base, int argc);
 int be_code_proto(bfuncinfo *finfo, bproto *proto);
 void be_code_closure(bfuncinfo *finfo, bexpdesc *e, int idx);
@@ -39,5 +40,6 @@ void be_code_import(bfuncinfo *finfo, bexpdesc *m, bexpdesc *v);
 int be_code_exblk(bfuncinfo *finfo, int depth);
 void be_code_catch(bfuncinfo *finfo, int base, int ecnt, int vcnt, int *jmp);
 void be_code_raise(bfuncinfo *finfo, bexpdesc *e1, bexpdesc *e2);
+void be_code_optimize(bfuncinfo *finfo);
 
 #endif
@@ -0,0 +1,238 @@
+/********************************************************************
+** Copyright (c) 2018-2020 Guan Wenliang
+** This file is part of the Berry default interpreter.
+** skiars@qq.com, https://github.com/Skiars/berry
+** See Copyright Notice in the LICENSE file or at
+** https://github.com/Skiars/berry/blob/master/LICENSE
+********************************************************************/
+#include "be_coroutine.h"
+#include "be_vm.h"
+#include "be_exec.h"
+#include "be_func.h"
+#include "be_gc.h"
+#include "be_mem.h"
+#include "be_vector.h"
+
+/* the stack grows on demand like the main stack, start small */
+#define CO_STACK_START          (BE_STACK_FREE_MIN * 2)
+
+#define swap_state(vm, co, field, T) \
+    { T _t = (vm)->field; (vm)->field = (co)->field; (co)->field = _t; }
+
+struct coresume {
+    bcoroutine *co;
+    bvalue *argv; /* arguments, on the stack of the resumer */
+    int argc;
+};
+
+static const char *co_statusname[] = {
+    "suspended", "running", "normal", "dead"
+};
+
+bcoroutine* be_coroutine_new(bvm *vm, bvalue *func)
+{
+    bgcobject *gco = be_gcnew(vm, BE_COROUTINE, bcoroutine);
+    bcoroutine *co = cast_coroutine(gco);
+    if (co) {
+        co->status = CO_SUSPENDED;
+        co->prev = NULL;
+        co->errjmp = NULL;
+        co->retpos = -1;
+        co->stack = NULL;
+        co->upvalist = NULL;
+        co->cf = NULL;
+        co->ip = NULL;
+        be_stack_init(vm, &co->callstack, sizeof(bcallframe));
+        be_stack_init(vm, &co->exceptstack, sizeof(struct bexecptframe));
+        var_setobj(vm->top, BE_COROUTINE, co);
+        be_incrtop(vm);
+        co->stack = be_malloc(vm, sizeof(bvalue) * CO_STACK_START);
+        co->stacktop = co->stack + CO_STACK_START;
+        co->reg = co->stack;
+        for (co->top = co->stack; co->top < co->stacktop; ++co->top) {
+            var_setnil(co->top); /* the GC scans the registers of the frames */
+        }
+        co->stack[0] = *func; /* the function is called from the bottom of the stack */
+        co->top = co->stack + 1;
+        be_stackpop(vm, 1);
+    }
+    return co;
+}
+
+/* close the open upvalues of the coroutine and release its stacks */
+static void co_release(bvm *vm, bcoroutine *co)
+{
+    if (co->stack) {
+        bupval *upvalist = vm->upvalist;
+        vm->upvalist = co->upvalist;
+        be_upvals_close(vm, co->stack);
+        vm->upvalist = upvalist;
+        be_free(vm, co->stack, (co->stacktop - co->stack) * sizeof(bvalue));
+        be_stack_delete(vm, &co->callstack);
+        be_stack_delete(vm, &co->exceptstack);
+        co->stack = co->stacktop = co->reg = co->top = NULL;
+        co->upvalist = NULL;
+        co->cf = NULL;
+    }
+}
+
+void be_coroutine_delete(bvm *vm, bcoroutine *co)
+{
+    co_release(vm, co);
+    be_free(vm, co, sizeof(bcoroutine));
+}
+
+const char* be_coroutine_status(bcoroutine *co)
+{
+    return co_statusname[co->status];
+}
+
+/* exchange the execution state of the VM and of the coroutine */
+static void co_swap(bvm *vm, bcoroutine *co)
+{
+    swap_state(vm, co, stack, bvalue*);
+    swap_state(vm, co, stacktop, bvalue*);
+    swap_state(vm, co, upvalist, bupval*);
+    swap_state(vm, co, callstack, bstack);
+    swap_state(vm, co, exceptstack, bstack);
+    swap_state(vm, co, cf, bcallframe*);
+    swap_state(vm, co, reg, bvalue*);
+    swap_state(vm, co, top, bvalue*);
+    swap_state(vm, co, ip, binstruction*);
+}
+
+static void co_run(bvm *vm, void *data)
+{
+    struct coresume *r = cast(struct coresume*, data);
+    bcoroutine *co = r->co;
+    co->errjmp = vm->errjmp;
+    if (co->retpos < 0) { /* first resume, call the function with the arguments */
+        int i;
+        be_stack_require(vm, r->argc + BE_STACK_FREE_MIN);
+        for (i = 0; i < r->argc; ++i) {
+            *vm->top++ = r->argv[i];
+        }
+        be_dofunc(vm, vm->stack, r->argc);
+    } else { /* `yield()` returns the first argument of `resume()` */
+        bvalue *ret = vm->stack + co->retpos;
+        if (!be_stack_isempty(&vm->exceptstack)) { /* chain the pending `try` blocks to `resume()` */
+            struct bexecptframe *base = be_stack_base(&vm->exceptstack);
+            struct bexecptframe *top = be_stack_top(&vm->exceptstack);
+            base->errjmp.prev = vm->errjmp;
+            vm->errjmp = &top->errjmp;
+        }
+        if (r->argc) {
+            *ret = r->argv[0];
+        } else {
+            var_setnil(ret);
+        }
+        be_vm_resume(vm);
+    }
+}
+
+/* Resume `co` with the `argc` values at the top of the stack.
+ * The value yielded or returned by the coroutine is pushed on the
+ * stack, an exception raised by the coroutine is raised again. */
+void be_coroutine_resume(bvm *vm, bcoroutine *co, int argc)
+{
+    int res;
+    struct coresume r;
+    bvalue *ret;
+    if (co->status != CO_SUSPENDED) {
+        be_raise(vm, "runtime_error", be_pushfstring(vm,
+            "cannot resume %s coroutine", be_coroutine_status(co)));
+    }
+    r.co = co;
+    r.argv = vm->top - argc;
+    r.argc = argc;
+    co_swap(vm, co);
+    co->prev = vm->co;
+    if (co->prev) {
+        co->prev->status = CO_NORMAL;
+    }
+    vm->co = co;
+    co->status = CO_RUNNING;
+    res = be_execprotected(vm, co_run, &r);
+    if (res == 0) { /* returned, the value is in the function slot */
+        ret = vm->stack;
+        co->status = CO_DEAD;
+    } else if (res == BE_COYIELD) {
+        ret = vm->stack + co->retpos;
+        co->status = CO_SUSPENDED;
+    } else { /* keep the exception values below the top, so they are marked */
+        ret = vm->top;
+        vm->top += 2;
+        co->status = CO_DEAD;
+    }
+    co->errjmp = NULL;
+    co_swap(vm, co);
+    vm->co = co->prev;
+    if (vm->co) {
+        vm->co->status = CO_RUNNING;
+    }
+    co->prev = NULL;
+    be_stack_require(vm, 2 + BE_STACK_FREE_MIN);
+    vm->top[0] = ret[0];
+    if (res != 0 && res != BE_COYIELD) {
+        vm->top[1] = ret[1];
+        co_release(vm, co);
+        be_throw(vm, res);
+    }
+    be_incrtop(vm);
+    if (co->status == CO_DEAD) {
+        co_release(vm, co);
+    }
+}
+
+/* a Berry frame can be left and re-entered by `be_vm_resume()` only if
+ * it was not entered from native code: the C stack would be lost */
+static bbool co_yieldable(bvm *vm)
+{
+    bcoroutine *co = vm->co;
+    bcallframe *base = be_stack_base(&vm->callstack);
+    bcallframe *cf = vm->cf - 1; /* skip the frame of `yield()` */
+    /* only the `try` blocks of the coroutine may catch errors, not a protected call */
+    if (be_stack_isempty(&vm->exceptstack)) {
+        if (vm->errjmp != co->errjmp) {
+            return bfalse;
+        }
+    } else if (vm->errjmp != &cast(struct bexecptframe*, be_stack_top(&vm->exceptstack))->errjmp) {
+        return bfalse;
+    }
+    for (; cf >= base; --cf) {
+        if (cf->status & PRIM_FUNC) {
+            return bfalse;
+        }
+        if (cf != base && (cf->status & BASE_FRAME) && !(cf->status & CO_FRAME)) {
+            return bfalse;
+        }
+    }
+    return btrue;
+}
+
+/* Yield the first argument of the native function calling it, which
+ * must be called from Berry code: the native frame is popped so the
+ * coroutine continues after the call when resumed. */
+void be_coroutine_yield(bvm *vm)
+{
+    bcoroutine *co = vm->co;
+    bcallframe *cf = vm->cf;
+    if (co == NULL) {
+        be_raise(vm, "runtime_error", "cannot yield outside a coroutine");
+    }
+    if (!co_yieldable(vm)) {
+        be_raise(vm, "runtime_error", "cannot yield across a native call");
+    }
+    if (vm->top > vm->reg) {
+        *cf->func = *vm->reg;
+    } else {
+        var_setnil(cf->func);
+    }
+    co->retpos = cast_int(cf->func - vm->stack);
+    vm->reg = cf->reg;
+    vm->top = cf->top;
+    be_stack_pop(&vm->callstack);
+    vm->cf = be_stack_top(&vm->callstack);
+    vm->errjmp = co->errjmp; /* skip the `try` blocks, they are resumed by `be_vm_resume()` */
+    be_throw(vm, BE_COYIELD);
+}
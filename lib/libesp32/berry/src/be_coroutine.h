@@ -0,0 +1,50 @@
+/********************************************************************
+** Copyright (c) 2018-2020 Guan Wenliang
+** This file is part of the Berry default interpreter.
+** skiars@qq.com, https://github.com/Skiars/berry
+** See Copyright Notice in the LICENSE file or at
+** https://github.com/Skiars/berry/blob/master/LICENSE
+********************************************************************/
+#ifndef BE_COROUTINE_H
+#define BE_COROUTINE_H
+
+#include "be_vm.h"
+
+/* coroutine status */
+#define CO_SUSPENDED        0 /* created or yielded, can be resumed */
+#define CO_RUNNING          1
+#define CO_NORMAL           2 /* resumed another coroutine */
+#define CO_DEAD             3 /* returned or raised an exception */
+
+/* status of `be_throw()` when a coroutine yields back to `resume()` */
+#define BE_COYIELD          (-1)
+
+/* A coroutine owns a value stack and a call stack of its own.
+ * While it is suspended, the fields below hold its execution
+ * state. While it runs they are swapped with the VM, so they
+ * hold the state of the resumer until it yields or returns. */
+struct bcoroutine {
+    bcommon_header;
+    bbyte status;
+    bgcobject *gray; /* for gc gray list */
+    struct bcoroutine *prev; /* resumer, while running */
+    struct blongjmp *errjmp; /* jump point of `resume()`, while running */
+    int retpos; /* stack slot receiving the value of `resume()`, -1 if not started */
+    bvalue *stack;
+    bvalue *stacktop;
+    bupval *upvalist;
+    bstack callstack;
+    bstack exceptstack;
+    bcallframe *cf;
+    bvalue *reg;
+    bvalue *top;
+    binstruction *ip;
+};
+
+bcoroutine* be_coroutine_new(bvm *vm, bvalue *func);
+void be_coroutine_delete(bvm *vm, bcoroutine *co);
+void be_coroutine_resume(bvm *vm, bcoroutine *co, int argc);
+void be_coroutine_yield(bvm *vm);
+const char* be_coroutine_status(bcoroutine *co);
+
+#endif
@@ -0,0 +1,94 @@
+/********************************************************************
+** Copyright (c) 2018-2020 Guan Wenliang
+** This file is part of the Berry default interpreter.
+** skiars@qq.com, https://github.com/Skiars/berry
+** See Copyright Notice in the LICENSE file or at
+** https://github.com/Skiars/berry/blob/master/LICENSE
+********************************************************************/
+#include "be_object.h"
+#include "be_coroutine.h"
+#include "be_exec.h"
+
+#if BE_USE_COROUTINE_MODULE
+
+static bcoroutine* check_coroutine(bvm *vm)
+{
+    if (be_top(vm) < 1 || !var_istype(be_indexof(vm, 1), BE_COROUTINE)) {
+        be_raise(vm, "type_error", "coroutine expected");
+    }
+    return var_toobj(be_indexof(vm, 1));
+}
+
+/* `coroutine.create(f) -> coroutine`, `f` runs on the first resume */
+static int m_create(bvm *vm)
+{
+    bcoroutine *co;
+    if (be_top(vm) < 1 || !var_isclosure(be_indexof(vm, 1))) {
+        be_raise(vm, "type_error", "a Berry function is expected");
+    }
+    co = be_coroutine_new(vm, be_indexof(vm, 1));
+    var_setobj(vm->top, BE_COROUTINE, co);
+    be_incrtop(vm);
+    be_return(vm);
+}
+
+/* `coroutine.resume(co, ...) -> any`, returns the value yielded or returned
+ * by `co`. Arguments of the first resume are passed to the function, later
+ * the first argument is returned by `yield()`. */
+static int m_resume(bvm *vm)
+{
+    bcoroutine *co = check_coroutine(vm);
+    be_coroutine_resume(vm, co, be_top(vm) - 1);
+    be_return(vm);
+}
+
+/* `coroutine.yield([value]) -> any` */
+static int m_yield(bvm *vm)
+{
+    be_coroutine_yield(vm);
+    be_return_nil(vm);
+}
+
+/* `coroutine.status(co) -> string`, one of `suspended`, `running`, `normal` or `dead` */
+static int m_status(bvm *vm)
+{
+    bcoroutine *co = check_coroutine(vm);
+    be_pushstring(vm, be_coroutine_status(co));
+    be_return(vm);
+}
+
+/* `coroutine.running() -> coroutine or nil` */
+static int m_running(bvm *vm)
+{
+    if (vm->co) {
+        var_setobj(vm->top, BE_COROUTINE, vm->co);
+        be_incrtop(vm);
+        be_return(vm);
+    }
+    be_return_nil(vm);
+}
+
+#if !BE_USE_PRECOMPILED_OBJECT
+be_native_module_attr_table(coroutine) {
+    be_native_module_function("create", m_create),
+    be_native_module_function("resume", m_resume),
+    be_native_module_function("yield", m_yield),
+    be_native_module_function("status", m_status),
+    be_native_module_function("running", m_running)
+};
+
+be_define_native_module(coroutine, NULL);
+#else
+/* @const_object_info_begin
+module coroutine (scope: global, depend: BE_USE_COROUTINE_MODULE) {
+    create, func(m_create)
+    resume, func(m_resume)
+    yield, func(m_yield)
+    status, func(m_status)
+    running, func(m_running)
+}
+@const_object_info_end */
+#include "../generate/be_fixed_coroutine.h"
+#endif
+
+#endif /* BE_USE_COROUTINE_MODULE */
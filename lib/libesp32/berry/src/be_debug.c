@@ -64,6 +64,14 @@ void be_print_inst(binstruction ins, int pc)
                 isKB(ins) ? 'K' : 'R', IGET_RKB(ins) & KR_MASK,
                 isKC(ins) ? 'K' : 'R', IGET_RKC(ins) & KR_MASK);
         break;
+    case OP_ADDI: case OP_SUBI: case OP_LTI: case OP_LEI:
+    case OP_EQI: case OP_NEI: case OP_GTI: case OP_GEI:
+        logbuf("%s\tR%d\t%c%d\t%d", opc2str(op), IGET_RA(ins),
+                isKB(ins) ? 'K' : 'R', IGET_RKB(ins) & KR_MASK, IGET_sC(ins));
+        break;
+    case OP_FORITER:
+        logbuf("%s\tR%d\tR%d", opc2str(op), IGET_RA(ins), IGET_RKB(ins));
+        break;
     case OP_GETNGBL: case OP_SETNGBL:
         logbuf("%s\tR%d\t%c%d", opc2str(op), IGET_RA(ins),
                 isKB(ins) ? 'K' : 'R', IGET_RKB(ins) & KR_MASK);
@@ -170,6 +170,8 @@ static int m_counters(bvm *vm)
     map_insert(vm, "try", vm->counter_try);
     map_insert(vm, "raise", vm->counter_exc);
     map_insert(vm, "objects", vm->counter_gc_kept);
+    map_insert(vm, "gc", vm->counter_gc_count);
+    map_insert(vm, "mem_peak", (int)vm->counter_mem_peak);
     be_pop(vm, 1);
     be_return(vm);
 }
@@ -45,6 +45,7 @@
 #define IBx_MASK                INS_MASK(0, IBx_BITS)
 #define IsBx_MAX                cast_int(IBx_MASK >> 1)
 #define IsBx_MIN                cast_int(-IsBx_MAX - 1)
+#define IsC_MAX                 cast_int(IRKC_MASK >> 1)    /* signed immediate in C field */
 
 /* mask for K/R values */
 #define KR_MASK                 ((1 << (IRKB_BITS-1)) - 1)
@@ -56,6 +57,7 @@
 #define IGET_RKC(i)             INS_GETx(i, IRKC_MASK, IRKC_POS)
 #define IGET_Bx(i)              INS_GETx(i, IBx_MASK, 0)
 #define IGET_sBx(i)             (IGET_Bx(i) - IsBx_MAX)
+#define IGET_sC(i)              (IGET_RKC(i) - IsC_MAX)
 
 /* set field */
 #define ISET_OP(i)              INS_SETx(i, IOP_MASK, IOP_POS)
@@ -64,6 +66,7 @@
 #define ISET_RKC(i)             INS_SETx(i, IRKC_MASK, IRKC_POS)
 #define ISET_Bx(i)              INS_SETx(i, IBx_MASK, 0)
 #define ISET_sBx(i)             (ISET_Bx(cast_int(i) + IsBx_MAX))
+#define ISET_sC(i)              (ISET_RKC(cast_int(i) + IsC_MAX))
 
 typedef enum {
     #define OPCODE(opc) OP_##opc
@@ -16,8 +16,10 @@
 #include "be_func.h"
 #include "be_map.h"
 #include "be_module.h"
+#include "be_coroutine.h"
 #include "be_exec.h"
 #include "be_debug.h"
+#include <string.h>
 
 #define GC_PAUSE    (1 << 0) /* GC will not be executed automatically */
 #define GC_HALT     (1 << 1) /* GC completely stopped */
@@ -39,6 +41,7 @@ static void free_object(bvm *vm, bgcobject *obj);
 void be_gc_init(bvm *vm)
 {
     vm->gc.usage = sizeof(bvm);
+    vm->gc.sampler = NULL;
     be_gc_setsteprate(vm, 200);
 }
 
@@ -62,6 +65,7 @@ void be_gc_deleteall(bvm *vm)
         uvnext = uv->u.next;
         be_free(vm, uv, sizeof(bupval));
     }
+    be_gc_sampling(vm, 0);
 }
 
 void be_gc_setsteprate(bvm *vm, int rate)
@@ -80,6 +84,71 @@ void be_gc_setpause(bvm *vm, int pause)
     }
 }
 
+/* record the innermost Berry function as allocation site of `obj` */
+static void sample_object(bvm *vm, bgcobject *obj)
+{
+    struct bgcsampler *sp = vm->gc.sampler;
+    const char *site = "?";
+    int i;
+    if (--sp->countdown > 0) {
+        return;
+    }
+    sp->countdown = sp->rate;
+    if (!be_stack_isempty(&vm->callstack)) {
+        bcallframe *base = be_stack_base(&vm->callstack), *cf = vm->cf;
+        for (; cf >= base; --cf) {
+            if (var_isclosure(cf->func)) {
+                bproto *proto = cast(bclosure*, var_toobj(cf->func))->proto;
+                site = str(proto->name);
+                break;
+            }
+        }
+    }
+    for (i = 0; i < GC_SAMPLE_SLOTS && sp->slot[i].obj; ++i);
+    if (i == GC_SAMPLE_SLOTS) { /* all taken, replace in turn */
+        i = sp->next;
+        sp->next = (sp->next + 1) % GC_SAMPLE_SLOTS;
+    }
+    sp->slot[i].obj = obj;
+    strncpy(sp->slot[i].site, site, GC_SAMPLE_SITE_LEN - 1);
+    sp->slot[i].site[GC_SAMPLE_SITE_LEN - 1] = '\0';
+}
+
+static void sample_forget(struct bgcsampler *sp, bgcobject *obj)
+{
+    int i;
+    for (i = 0; i < GC_SAMPLE_SLOTS; ++i) {
+        if (sp->slot[i].obj == obj) {
+            sp->slot[i].obj = NULL;
+            break;
+        }
+    }
+}
+
+/* Sample one GC object allocation out of `rate` with the function that allocated it */
+/* rate <= 0 disables sampling; the table lives outside of the Berry heap */
+void be_gc_sampling(bvm *vm, int rate)
+{
+    struct bgcsampler *sp = vm->gc.sampler;
+    if (rate <= 0) {
+        if (sp) {
+            be_os_free(sp);
+            vm->gc.sampler = NULL;
+        }
+        return;
+    }
+    if (!sp) {
+        sp = be_os_malloc(sizeof(struct bgcsampler));
+        if (!sp) {
+            return;
+        }
+        memset(sp, 0, sizeof(struct bgcsampler));
+        vm->gc.sampler = sp;
+    }
+    sp->rate = rate;
+    sp->countdown = rate;
+}
+
 bgcobject* be_newgcobj(bvm *vm, int type, size_t size)
 {
     bgcobject *obj = be_malloc(vm, size);
@@ -88,6 +157,9 @@ bgcobject* be_newgcobj(bvm *vm, int type, size_t size)
     obj->marked = GC_WHITE; /* default gc object type is white */
     obj->next = vm->gc.list; /* link to the next field */
     vm->gc.list = obj; /* insert to head */
+    if (vm->gc.sampler) {
+        sample_object(vm, obj);
+    }
     return obj;
 }
 
@@ -149,6 +221,7 @@ static void mark_gray(bvm *vm, bgcobject *obj)
         case BE_NTVCLOS: link_gray(vm, cast_ntvclos(obj)); break;
         case BE_MODULE: link_gray(vm, cast_module(obj)); break;
         case BE_COMOBJ: gc_setdark(obj); break; /* just set dark */
+        case BE_COROUTINE: link_gray(vm, cast_coroutine(obj)); break;
         default: break;
         }
     }
@@ -289,6 +362,21 @@ static void mark_module(bvm *vm, bgcobject *obj)
     }
 }
 
+static void mark_coroutine(bvm *vm, bgcobject *obj)
+{
+    bcoroutine *co = cast_coroutine(obj);
+    gc_try (co != NULL) {
+        vm->gc.gray = co->gray; /* remove object from gray list */
+        if (co->stack) { /* own state, or the state of the resumer while running */
+            bvalue *v = co->stack, *end = co->top;
+            for (; v < end; ++v) {
+                mark_gray_var(vm, v);
+            }
+        }
+        mark_gray(vm, gc_object(co->prev));
+    }
+}
+
 static void free_proto(bvm *vm, bgcobject *obj)
 {
     bproto *proto = cast_proto(obj);
@@ -348,6 +436,9 @@ static void free_instance(bvm *vm, bgcobject *obj)
 
 static void free_object(bvm *vm, bgcobject *obj)
 {
+    if (vm->gc.sampler) {
+        sample_forget(vm->gc.sampler, obj);
+    }
     switch (var_type(obj)) {
     case BE_STRING: free_lstring(vm, obj); break; /* long string */
     case BE_CLASS: be_free(vm, obj, sizeof(bclass)); break;
@@ -359,6 +450,7 @@ static void free_object(bvm *vm, bgcobject *obj)
     case BE_PROTO: free_proto(vm, obj); break;
     case BE_MODULE: be_module_delete(vm, cast_module(obj)); break;
     case BE_COMOBJ: be_commonobj_delete(vm, obj); break;
+    case BE_COROUTINE: be_coroutine_delete(vm, cast_coroutine(obj)); break;
     default: break; /* case BE_STRING: break; */
     }
 }
@@ -369,6 +461,7 @@ static void premark_internal(bvm *vm)
     mark_gray(vm, gc_object(vm->module.path));
     mark_gray(vm, gc_object(vm->ntvclass));
     mark_gray(vm, gc_object(vm->registry));
+    mark_gray(vm, gc_object(vm->co)); /* resumers are reached from the running coroutine */
 #if BE_USE_DEBUG_HOOK
     if (be_isgcobj(&vm->hook)) {
         mark_gray(vm, gc_object(var_toobj(&vm->hook)));
@@ -441,6 +534,7 @@ static void mark_unscanned(bvm *vm)
             case BE_CLOSURE: mark_closure(vm, obj); break;
             case BE_NTVCLOS: mark_ntvclos(vm, obj); break;
             case BE_MODULE: mark_module(vm, obj); break;
+            case BE_COROUTINE: mark_coroutine(vm, obj); break;
             default:
                 be_assert(0); /* error */
                 break;
@@ -535,6 +629,53 @@ size_t be_gc_memcount(bvm *vm)
     return vm->gc.usage;
 }
 
+/* Bytes held by a GC object including the buffers it owns, as released by `free_object()` */
+size_t be_gc_objsize(bgcobject *obj)
+{
+    switch (var_type(obj)) {
+    case BE_STRING: {
+        bstring *s = cast_str(obj);
+        if (s->slen == 255) {
+            return sizeof(blstring) + cast(blstring*, s)->llen + 1;
+        }
+        return sizeof(bsstring) + s->slen + 1;
+    }
+    case BE_CLASS: return sizeof(bclass);
+    case BE_INSTANCE:
+        return sizeof(binstance) + sizeof(bvalue) * (be_instance_member_count(cast_instance(obj)) - 1);
+    case BE_MAP: return sizeof(bmap) + sizeof(bmapnode) * cast_map(obj)->size;
+    case BE_LIST: return sizeof(blist) + sizeof(bvalue) * cast_list(obj)->capacity;
+    case BE_CLOSURE:
+        return sizeof(bclosure) + sizeof(bupval*) * ((size_t)cast_closure(obj)->nupvals - 1);
+    case BE_NTVCLOS:
+        return sizeof(bntvclos) + (sizeof(bupval*) + sizeof(bupval)) * cast_ntvclos(obj)->nupvals;
+    case BE_PROTO: {
+        bproto *p = cast_proto(obj);
+        size_t size = sizeof(bproto) + p->nupvals * sizeof(bupvaldesc) + p->nconst * sizeof(bvalue)
+                    + p->nproto * sizeof(bproto*) + p->codesize * sizeof(binstruction);
+#if BE_DEBUG_RUNTIME_INFO
+        size += p->nlineinfo * sizeof(blineinfo);
+#endif
+#if BE_DEBUG_VAR_INFO
+        size += p->nvarinfo * sizeof(bvarinfo);
+#endif
+        return size;
+    }
+    case BE_MODULE: return sizeof(bmodule);
+    case BE_COMOBJ: return sizeof(bcommomobj);
+    case BE_COROUTINE: {
+        bcoroutine *co = cast_coroutine(obj);
+        size_t size = sizeof(bcoroutine);
+        if (co->stack) {
+            size += (co->stacktop - co->stack) * sizeof(bvalue)
+                  + be_vector_capacity(&co->callstack) * sizeof(bcallframe);
+        }
+        return size;
+    }
+    default: return 0;
+    }
+}
+
 void be_gc_collect(bvm *vm)
 {
     if (vm->gc.status & GC_HALT) {
@@ -543,6 +684,7 @@ void be_gc_collect(bvm *vm)
 #if BE_USE_PERF_COUNTERS
     vm->counter_gc_kept = 0;
     vm->counter_gc_freed = 0;
+    vm->counter_gc_count++;
 #endif
     if (vm->obshook != NULL) (*vm->obshook)(vm, BE_OBS_GC_START, vm->gc.usage);
     /* step 1: set root-set reference objects to unscanned */
@@ -21,6 +21,7 @@
 #define cast_map(o)         gc_cast(o, BE_MAP, bmap)
 #define cast_list(o)        gc_cast(o, BE_LIST, blist)
 #define cast_module(o)      gc_cast(o, BE_MODULE, bmodule)
+#define cast_coroutine(o)   gc_cast(o, BE_COROUTINE, bcoroutine)
 
 #define gc_ismark(o, m)     (((o)->marked & 0x03) == m)
 #define gc_iswhite(o)       gc_ismark((o), GC_WHITE)
@@ -64,6 +65,22 @@ typedef enum {
     GC_CONST = 0x08  /* constant object mark */
 } bgcmark;
 
+/* allocation-site sampling, see `be_gc_sampling()` */
+#define GC_SAMPLE_SLOTS     32
+#define GC_SAMPLE_SITE_LEN  24
+
+typedef struct {
+    bgcobject *obj; /* sampled object, still alive */
+    char site[GC_SAMPLE_SITE_LEN]; /* name of the Berry function that allocated it */
+} bgcsample;
+
+struct bgcsampler {
+    int rate; /* one allocation out of `rate` is sampled */
+    int countdown;
+    int next; /* next slot to reuse when all are taken */
+    bgcsample slot[GC_SAMPLE_SLOTS];
+};
+
 void be_gc_init(bvm *vm);
 void be_gc_deleteall(bvm *vm);
 void be_gc_setsteprate(bvm *vm, int rate);
@@ -76,5 +93,7 @@ void be_gc_unfix(bvm *vm, bgcobject *obj);
 bbool be_gc_fix_set(bvm *vm, bgcobject *obj, bbool fix);
 void be_gc_collect(bvm *vm);
 void be_gc_auto(bvm *vm);
+size_t be_gc_objsize(bgcobject *obj);
+void be_gc_sampling(bvm *vm, int rate);
 
 #endif
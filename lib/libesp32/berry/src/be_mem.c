@@ -75,5 +75,10 @@ BERRY_API void* be_realloc(bvm *vm, void *ptr, size_t old_size, size_t new_size)
         }
     }
     vm->gc.usage = vm->gc.usage + new_size - old_size; /* update allocated count */
+#if BE_USE_PERF_COUNTERS
+    if (vm->gc.usage > vm->counter_mem_peak) {
+        vm->counter_mem_peak = vm->gc.usage;
+    }
+#endif
     return block;
 }
@@ -29,6 +29,7 @@ const char* be_vtype2str(bvalue *v)
     case BE_MAP: return "map";
     case BE_INSTANCE: return "instance";
     case BE_MODULE: return "module";
+    case BE_COROUTINE: return "coroutine";
     case BE_INDEX: return "var";
     case BE_COMPTR: return "ptr";
     default: return "invalid type";
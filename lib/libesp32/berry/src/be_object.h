@@ -30,6 +30,7 @@
 #define BE_MAP          21
 #define BE_MODULE       22
 #define BE_COMOBJ       23      /* common object */
+#define BE_COROUTINE    24      /* coroutine, see be_coroutine.h */
 
 #define BE_NTVFUNC      ((0 << 5) | BE_FUNCTION)
 #define BE_CLOSURE      ((1 << 5) | BE_FUNCTION)
@@ -63,6 +64,7 @@ typedef struct binstance binstance;
 typedef struct blist blist;
 typedef struct bmap bmap;
 typedef struct bupval bupval;
+typedef struct bcoroutine bcoroutine;
 
 typedef uint32_t binstruction;
 
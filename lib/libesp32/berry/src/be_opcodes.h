@@ -54,4 +54,13 @@ OPCODE(CATCH),      /*  A, B, C  |   ... */
 OPCODE(RAISE),      /*  A, B, C  |   RAISE(B,C) B is code, C is description. A==0 only B provided, A==1 B and C are provided, A==2 rethrow with both parameters already on stack */
 OPCODE(CLASS),      /*  Bx       |   init class in K[Bx] */
 OPCODE(GETNGBL),    /*  A, B     |   R(A) <- GLOBAL[RK(B)] by name */
-OPCODE(SETNGBL)     /*  A, B     |   R(A) -> GLOBAL[RK(B)] by name */
+OPCODE(SETNGBL),    /*  A, B     |   R(A) -> GLOBAL[RK(B)] by name */
+OPCODE(ADDI),       /*  A, B, sC |   R(A) <- RK(B) + sC */
+OPCODE(SUBI),       /*  A, B, sC |   R(A) <- RK(B) - sC */
+OPCODE(LTI),        /*  A, B, sC |   R(A) <- RK(B) < sC */
+OPCODE(LEI),        /*  A, B, sC |   R(A) <- RK(B) <= sC */
+OPCODE(EQI),        /*  A, B, sC |   R(A) <- RK(B) == sC */
+OPCODE(NEI),        /*  A, B, sC |   R(A) <- RK(B) != sC */
+OPCODE(GTI),        /*  A, B, sC |   R(A) <- RK(B) > sC */
+OPCODE(GEI),        /*  A, B, sC |   R(A) <- RK(B) >= sC */
+OPCODE(FORITER)     /*  A, B     |   R(A) <- R(B)(), range iterators are stepped inline */
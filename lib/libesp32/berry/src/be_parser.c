@@ -313,6 +313,9 @@ static void end_func(bparser *parser)
     be_code_ret(finfo, NULL); /* append a return to last code */
     end_block(parser); /* close block */
     setupvals(finfo); /* close upvals */
+    if (comp_is_optimize(vm)) {
+        be_code_optimize(finfo); /* peephole pass on the complete function */
+    }
     proto->code = be_vector_release(vm, &finfo->code); /* compact all vectors and return NULL if empty */
     proto->codesize = finfo->pc;
     proto->ktab = be_vector_release(vm, &finfo->kvec);
@@ -1224,8 +1227,12 @@ static void for_iter(bparser *parser, bstring *var, bexpdesc *it)
     finfo->binfo->beginpc = finfo->pc;
     /* itvar = .it() */
     init_exp(&e, ETLOCAL, new_localvar(parser, var)); /* new itvar */
-    be_code_setvar(finfo, &e, it); /* code function to variable '.it' */
-    be_code_call(finfo, e.v.idx, 0); /* itvar <- call .it() */
+    if (comp_is_optimize(parser->vm)) {
+        be_code_foriter(finfo, &e, it); /* itvar <- .it() in a single opcode */
+    } else {
+        be_code_setvar(finfo, &e, it); /* code function to variable '.it' */
+        be_code_call(finfo, e.v.idx, 0); /* itvar <- call .it() */
+    }
     stmtlist(parser);
 }
 
@@ -61,7 +61,8 @@ static int m_setrange(bvm *vm)
     be_return_nil(vm);
 }
 
-static int iter_closure(bvm *vm)
+/* also stepped inline by OP_FORITER */
+int be_range_iter(bvm *vm)
 {
     /* for better performance, we operate the upvalues
      * directly without using by the stack. */
@@ -80,7 +81,7 @@ static int iter_closure(bvm *vm)
 
 static int m_iter(bvm *vm)
 {
-    be_pushntvclosure(vm, iter_closure, 2);
+    be_pushntvclosure(vm, be_range_iter, 2);
     be_getmember(vm, 1, "__lower__");
     be_setupval(vm, -2, 0);
     be_pop(vm, 1);
@@ -100,6 +100,9 @@ static bstring* sim2str(bvm *vm, bvalue *v)
     case BE_COMPTR:
         sprintf(sbuf, "<ptr: %p>", var_toobj(v));
         break;
+    case BE_COROUTINE:
+        sprintf(sbuf, "<coroutine: %p>", var_toobj(v));
+        break;
     default:
         strcpy(sbuf, "(unknown value)");
         break;
@@ -838,6 +841,178 @@ static int str_escape(bvm *vm)
     be_return_nil(vm);
 }
 
+/* string.builder: mutable string buffer with amortized appends
+ *
+ * `sb = string.builder([s])`
+ * `sb.append(v1, ...)` or `sb .. v` -> self, non-string values are converted with `str()`
+ * `sb.format(fmt, ...)` -> self, appends `string.format(fmt, ...)`
+ * `sb.tostring()` -> string, `sb.size()` -> int, `sb.clear()`
+ **/
+#define SB_MIN_SIZE     32
+
+typedef struct sb_buf {
+    size_t size;    /* allocated size of `data` */
+    size_t len;     /* current length of the string */
+    char data[1];
+} sb_buf;
+
+static sb_buf* sb_get(bvm *vm)
+{
+    be_getmember(vm, 1, ".p");
+    sb_buf *sb = be_tocomptr(vm, -1);
+    be_pop(vm, 1);
+    return sb;
+}
+
+/* make room for `add` more chars, the buffer grows by doubling */
+static sb_buf* sb_reserve(bvm *vm, sb_buf *sb, size_t add)
+{
+    size_t len = sb ? sb->len : 0;
+    size_t size = sb ? sb->size : 0;
+    if (len + add > size) {
+        size_t new_size = size * 2;
+        if (new_size < len + add) { new_size = len + add; }
+        if (new_size < SB_MIN_SIZE) { new_size = SB_MIN_SIZE; }
+        size_t old_alloc = sb ? sizeof(sb_buf) + size : 0;
+        sb = be_realloc(vm, sb, old_alloc, sizeof(sb_buf) + new_size);
+        if (sb == NULL) {
+            be_throw(vm, BE_MALLOC_FAIL);
+        }
+        sb->size = new_size;
+        sb->len = len;
+        be_pushcomptr(vm, sb);
+        be_setmember(vm, 1, ".p");
+        be_pop(vm, 1);
+    }
+    return sb;
+}
+
+/* append the value at `index` converted to string */
+static void sb_append(bvm *vm, int index)
+{
+    const char *s = be_tostring(vm, index);
+    size_t len = be_strlen(vm, index);
+    if (len > 0) {
+        sb_buf *sb = sb_reserve(vm, sb_get(vm), len);
+        memcpy(sb->data + sb->len, s, len);
+        sb->len += len;
+    }
+}
+
+static int sb_init(bvm *vm)
+{
+    be_pushcomptr(vm, NULL);
+    be_setmember(vm, 1, ".p");
+    be_pop(vm, 1);
+    if (be_top(vm) >= 2) {
+        sb_append(vm, 2);
+    }
+    be_return_nil(vm);
+}
+
+static int sb_deinit(bvm *vm)
+{
+    sb_buf *sb = sb_get(vm);
+    if (sb) {
+        be_free(vm, sb, sizeof(sb_buf) + sb->size);
+        be_pushcomptr(vm, NULL);
+        be_setmember(vm, 1, ".p");
+        be_pop(vm, 1);
+    }
+    be_return_nil(vm);
+}
+
+static int sb_append_m(bvm *vm)
+{
+    int top = be_top(vm);
+    for (int i = 2; i <= top; i++) {
+        sb_append(vm, i);
+    }
+    be_pushvalue(vm, 1);
+    be_return(vm); /* return self */
+}
+
+static int sb_format(bvm *vm)
+{
+    int top = be_top(vm);
+    if (top >= 2 && be_isstring(vm, 2)) {
+        be_pushntvfunction(vm, str_format);
+        for (int i = 2; i <= top; i++) {
+            be_pushvalue(vm, i);
+        }
+        be_call(vm, top - 1);
+        be_pop(vm, top - 1);    /* result is on top */
+        sb_append(vm, -1);
+        be_pushvalue(vm, 1);
+        be_return(vm); /* return self */
+    }
+    be_raise(vm, "type_error", "format string expected");
+    be_return_nil(vm);
+}
+
+static int sb_tostring(bvm *vm)
+{
+    sb_buf *sb = sb_get(vm);
+    be_pushnstring(vm, sb ? sb->data : "", sb ? sb->len : 0);
+    be_return(vm);
+}
+
+static int sb_size(bvm *vm)
+{
+    sb_buf *sb = sb_get(vm);
+    be_pushint(vm, sb ? (bint)sb->len : 0);
+    be_return(vm);
+}
+
+static int sb_clear(bvm *vm)
+{
+    sb_buf *sb = sb_get(vm);
+    if (sb) { sb->len = 0; }
+    be_return_nil(vm);
+}
+
+#if BE_USE_PRECOMPILED_OBJECT
+/* @const_object_info_begin
+class be_class_string_builder (scope: global, name: builder) {
+    .p, var
+    init, func(sb_init)
+    deinit, func(sb_deinit)
+    append, func(sb_append_m)
+    .., func(sb_append_m)
+    format, func(sb_format)
+    tostring, func(sb_tostring)
+    size, func(sb_size)
+    clear, func(sb_clear)
+}
+@const_object_info_end */
+#include "../generate/be_fixed_be_class_string_builder.h"
+#else
+/* without const objects `string.builder([s])` is a factory that makes a new class on each call */
+static int str_builder(bvm *vm)
+{
+    static const bnfuncinfo members[] = {
+        { ".p", NULL },
+        { "init", sb_init },
+        { "deinit", sb_deinit },
+        { "append", sb_append_m },
+        { "..", sb_append_m },
+        { "format", sb_format },
+        { "tostring", sb_tostring },
+        { "size", sb_size },
+        { "clear", sb_clear },
+        { NULL, NULL }
+    };
+    int i, argc = be_top(vm);
+    be_pushclass(vm, "builder", members);
+    for (i = 1; i <= argc; ++i) {
+        be_pushvalue(vm, i);
+    }
+    be_call(vm, argc);
+    be_pop(vm, argc);
+    be_return(vm);
+}
+#endif
+
 #if !BE_USE_PRECOMPILED_OBJECT
 be_native_module_attr_table(string) {
     be_native_module_function("format", str_format),
@@ -851,6 +1026,7 @@ be_native_module_attr_table(string) {
     be_native_module_function("toupper", str_toupper),
     be_native_module_function("tr", str_tr),
     be_native_module_function("escape", str_escape),
+    be_native_module_function("builder", str_builder),
 };
 
 be_define_native_module(string, NULL);
@@ -868,6 +1044,7 @@ module string (scope: global, depend: BE_USE_STRING_MODULE) {
     toupper, func(str_toupper)
     tr, func(str_tr)
     escape, func(str_escape)
+    builder, class(be_class_string_builder)
 }
 @const_object_info_end */
 #include "../generate/be_fixed_string.h"
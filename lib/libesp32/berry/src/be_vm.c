@@ -96,7 +96,7 @@
             res = var_tobool(a) op var_tobool(b); \
         } else if (var_isstr(a)) { /* string op string */ \
             res = 1 op be_eqstr(a->v.s, b->v.s); \
-        } else if (var_isclass(a) || var_isfunction(a) || var_iscomptr(a)) { \
+        } else if (var_isclass(a) || var_isfunction(a) || var_iscomptr(a) || var_istype(a, BE_COROUTINE)) { \
             res = var_toobj(a) op var_toobj(b); \
         } else { \
             binop_error(vm, #op, a, b); \
@@ -127,6 +127,59 @@
     } \
     return res
 
+/* int/int and real/real are compared inline, anything else goes through `func` */
+#define relop_block(op, func) \
+    bvalue *a = RKB(), *b = RKC(), *dst; \
+    bbool res; \
+    if (var_isint(a) && var_isint(b)) { \
+        res = ibinop(op, a, b); \
+    } else if (var_isreal(a) && var_isreal(b)) { \
+        res = a->v.r op b->v.r; \
+    } else { \
+        res = func(vm, a, b); \
+    } \
+    reg = vm->reg; \
+    dst = RA(); \
+    var_setbool(dst, res);
+
+/* same with a signed immediate in C */
+#define relop_imm_block(op, func) \
+    bvalue *a = RKB(), *dst; \
+    bint c = IGET_sC(ins); \
+    bbool res; \
+    if (var_isint(a)) { \
+        res = var_toint(a) op c; \
+    } else if (var_isreal(a)) { \
+        res = a->v.r op (breal)c; \
+    } else { \
+        bvalue imm; \
+        var_setint(&imm, c); \
+        res = func(vm, a, &imm); \
+    } \
+    reg = vm->reg; \
+    dst = RA(); \
+    var_setbool(dst, res);
+
+/* R(A) <- RK(B) op sC, instances get their operator method called with an int */
+#define arith_imm_block(op) \
+    bvalue *dst = RA(), *a = RKB(); \
+    bint c = IGET_sC(ins); \
+    if (var_isint(a)) { \
+        var_setint(dst, var_toint(a) op c); \
+    } else if (var_isreal(a)) { \
+        var_setreal(dst, a->v.r op (breal)c); \
+    } else { \
+        bvalue imm; \
+        var_setint(&imm, c); \
+        if (var_isinstance(a)) { \
+            object_binop(vm, #op, *a, imm); \
+            reg = vm->reg; \
+            *RA() = *vm->top; \
+        } else { \
+            binop_error(vm, #op, a, &imm); \
+        } \
+    }
+
 #define bitwise_block(op) \
     bvalue *dst = RA(), *a = RKB(), *b = RKC(); \
     if (var_isint(a) && var_isint(b)) { \
@@ -442,6 +495,60 @@ static void connect_str(bvm *vm, bstring *a, bvalue *b)
     }
 }
 
+/* `a .. b .. c` is compiled as a run of CONNECT into the same register:
+ *   CONNECT R(A) RK(B) RK(C)
+ *   CONNECT R(A) R(A)  RK(C')
+ *   ...
+ * When the operands are strings, the whole run is concatenated at once
+ * instead of allocating and copying each intermediate string.
+ * Returns the number of instructions merged after the current one,
+ * the result is stored at vm->top */
+static int connect_run(bvm *vm, binstruction ins, bvalue *reg, bvalue *ktab)
+{
+    bstring *a = var_tostr(RKB()), *b = var_tostr(RKC());
+    int ra = IGET_RA(ins), count = 0;
+    size_t len = (size_t)str_len(a) + str_len(b);
+    binstruction *ip = vm->ip;
+    for (;;) {
+        binstruction next = *ip;
+        if (IGET_OP(next) != OP_CONNECT || IGET_RA(next) != ra || isKB(next) || IGET_RKB(next) != ra
+            || (!isKC(next) && IGET_RKC(next) == ra)) {
+            break;
+        }
+        bvalue *c = (isKC(next) ? ktab : reg) + KR2idx(IGET_RKC(next));
+        if (!var_isstr(c)) {
+            break;
+        }
+        len += str_len(var_tostr(c));
+        ++count, ++ip;
+    }
+    if (count) {
+        char buf[SHORT_STR_MAX_LEN + 1];
+        bstring *s = NULL;
+        char *p = buf;
+        if (len > SHORT_STR_MAX_LEN) { /* long string, write in place */
+            s = be_newstrn(vm, NULL, len);
+            p = (char*)str(s);
+        }
+        memcpy(p, str(a), str_len(a));
+        p += str_len(a);
+        memcpy(p, str(b), str_len(b));
+        p += str_len(b);
+        for (ip = vm->ip; ip < vm->ip + count; ++ip) {
+            bstring *c = var_tostr((isKC(*ip) ? ktab : reg) + KR2idx(IGET_RKC(*ip)));
+            memcpy(p, str(c), str_len(c));
+            p += str_len(c);
+        }
+        *p = '\0';
+        if (s == NULL) {
+            s = be_newstrn(vm, buf, len);
+        }
+        var_setstr(vm->top, s);
+        vm->ip += count;
+    }
+    return count;
+}
+
 BERRY_API bvm* be_vm_new(void)
 {
     bvm *vm = be_os_malloc(sizeof(bvm));
@@ -472,6 +579,8 @@ BERRY_API bvm* be_vm_new(void)
     vm->counter_exc = 0;
     vm->counter_gc_kept = 0;
     vm->counter_gc_freed = 0;
+    vm->counter_gc_count = 0;
+    vm->counter_mem_peak = vm->gc.usage;
 #endif
     return vm;
 }
@@ -663,9 +772,14 @@ newframe: /* a new call frame */
         opcase(MOD): {
             bvalue *dst = RA(), *a = RKB(), *b = RKC();
             if (var_isint(a) && var_isint(b)) {
-                var_setint(dst, ibinop(%, a, b));
+                bint x = var_toint(a), y = var_toint(b);
+                if (y == 0) {
+                    vm_error(vm, "divzero_error", "division by zero");
+                } else {
+                    var_setint(dst, x % y);
+                }
             } else if (var_isnumber(a) && var_isnumber(b)) {
-                var_setreal(dst, mathfunc(fmod)(var_toreal(a), var_toreal(b)));
+                var_setreal(dst, mathfunc(fmod)(var2real(a), var2real(b)));
             } else if (var_isinstance(a)) {
                 ins_binop(vm, "%", ins);
             } else {
@@ -674,51 +788,27 @@ newframe: /* a new call frame */
             dispatch();
         }
         opcase(LT): {
-            bbool res = be_vm_islt(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(<, be_vm_islt);
             dispatch();
         }
         opcase(LE): {
-            bbool res = be_vm_isle(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(<=, be_vm_isle);
             dispatch();
         }
         opcase(EQ): {
-            bbool res = be_vm_iseq(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(==, be_vm_iseq);
             dispatch();
         }
         opcase(NE): {
-            bbool res = be_vm_isneq(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(!=, be_vm_isneq);
             dispatch();
         }
         opcase(GT): {
-            bbool res = be_vm_isgt(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(>, be_vm_isgt);
             dispatch();
         }
         opcase(GE): {
-            bbool res = be_vm_isge(vm, RKB(), RKC());
-            bvalue *dst;
-            reg = vm->reg;
-            dst = RA();
-            var_setbool(dst, res);
+            relop_block(>=, be_vm_isge);
             dispatch();
         }
         opcase(CONNECT): {
@@ -726,7 +816,9 @@ newframe: /* a new call frame */
             if (var_isint(a) && var_isint(b)) {
                 make_range(vm, *RKB(), *RKC());
             } else if (var_isstr(a)) {
-                connect_str(vm, var_tostr(a), b);
+                if (!var_isstr(b) || !connect_run(vm, ins, reg, ktab)) {
+                    connect_str(vm, var_tostr(a), b);
+                }
             } else if (var_isinstance(a)) {
                 object_binop(vm, "..", *RKB(), *RKC());
             } else {
@@ -756,6 +848,38 @@ newframe: /* a new call frame */
             bitwise_block(>>);
             dispatch();
         }
+        opcase(ADDI): {
+            arith_imm_block(+);
+            dispatch();
+        }
+        opcase(SUBI): {
+            arith_imm_block(-);
+            dispatch();
+        }
+        opcase(LTI): {
+            relop_imm_block(<, be_vm_islt);
+            dispatch();
+        }
+        opcase(LEI): {
+            relop_imm_block(<=, be_vm_isle);
+            dispatch();
+        }
+        opcase(EQI): {
+            relop_imm_block(==, be_vm_iseq);
+            dispatch();
+        }
+        opcase(NEI): {
+            relop_imm_block(!=, be_vm_isneq);
+            dispatch();
+        }
+        opcase(GTI): {
+            relop_imm_block(>, be_vm_isgt);
+            dispatch();
+        }
+        opcase(GEI): {
+            relop_imm_block(>=, be_vm_isge);
+            dispatch();
+        }
         opcase(NEG): {
             bvalue *dst = RA(), *a = RKB();
             if (var_isint(a)) {
@@ -1075,7 +1199,26 @@ newframe: /* a new call frame */
             }
             dispatch();
         }
-        opcase(CALL): {
+        opcase(FORITER): {
+            bvalue *it = RKB();
+            if (var_type(it) == BE_NTVCLOS && ((bntvclos*)var_toobj(it))->f == be_range_iter) {
+                /* step the range iterator without a native call */
+                bntvclos *f = var_toobj(it);
+                bvalue *uv0 = be_ntvclos_upval(f, 0)->value;
+                bint lower = var_toint(uv0);
+                if (lower <= var_toint(be_ntvclos_upval(f, 1)->value)) {
+                    var_toint(uv0) = lower + 1;
+                    var_setint(RA(), lower);
+                    dispatch();
+                }
+            }
+            /* same as MOVE then CALL without argument, which raises `stop_iteration` at the end */
+            *RA() = *it;
+            ins = ISET_OP(OP_CALL) | ISET_RA(IGET_RA(ins));
+            goto docall;
+        }
+        opcase(CALL):
+        docall: {
 #if BE_USE_PERF_COUNTERS
             vm->counter_call++;
 #endif
@@ -1268,6 +1411,34 @@ void be_dofunc(bvm *vm, bvalue *v, int argc)
     }
 }
 
+/* Continue the Berry frames left on the callstack by a coroutine that
+ * yielded. Each frame is run as a base frame, when it returns the loop
+ * enters its caller, until the function of the coroutine returns. */
+void be_vm_resume(bvm *vm)
+{
+    bjmpbuf jmp;
+    if (be_setjmp(jmp) == 0) {
+        /* the pending `try` blocks jumped into the C stack of the previous
+         * run, they now land here. Like `fixup_exceptstack()`, this relies
+         * on jump buffers being movable. */
+        struct bexecptframe *frame = be_stack_base(&vm->exceptstack);
+        struct bexecptframe *top = be_stack_top(&vm->exceptstack);
+        for (; frame <= top; ++frame) {
+            memcpy(frame->errjmp.b, jmp, sizeof(bjmpbuf));
+        }
+    } else { /* same as the handler of OP_EXBLK */
+        bvalue e1 = vm->top[0];
+        bvalue e2 = vm->top[1];
+        be_except_block_resume(vm);
+        vm->top[0] = e1;
+        vm->top[1] = e2;
+    }
+    while (!be_stack_isempty(&vm->callstack)) {
+        vm->cf->status |= CO_FRAME;
+        vm_exec(vm);
+    }
+}
+
 BERRY_API void be_set_obs_hook(bvm *vm, bobshook hook)
 {
     (void)vm;       /* avoid comiler warning */
@@ -18,10 +18,15 @@
 #define comp_set_strict(vm)      ((vm)->compopt |= (1<<COMP_STRICT))
 #define comp_clear_strict(vm)    ((vm)->compopt &= ~(1<<COMP_STRICT))
 
+#define comp_is_optimize(vm)       ((vm)->compopt & (1<<COMP_OPTIMIZE))
+#define comp_set_optimize(vm)      ((vm)->compopt |= (1<<COMP_OPTIMIZE))
+#define comp_clear_optimize(vm)    ((vm)->compopt &= ~(1<<COMP_OPTIMIZE))
+
 /* Compilation options */
 typedef enum {
     COMP_NAMED_GBL = 0x00, /* compile with named globals */
     COMP_STRICT = 0x01, /* compile with named globals */
+    COMP_OPTIMIZE = 0x02, /* fold constants and run the peephole pass on each function */
 } compoptmask;
 
 typedef struct {
@@ -54,6 +59,7 @@ struct bgc {
     size_t threshold; /* he threshold of allocation for the next GC */
     bbyte steprate; /* the rate of increase in the distribution between two GCs (percentage) */
     bbyte status;
+    struct bgcsampler *sampler; /* allocation-site sampling, NULL when disabled */
 };
 
 struct bstringtable {
@@ -100,6 +106,7 @@ struct bvm {
     bmap *ntvclass; /* native class table */
     blist *registry; /* registry list */
     struct bgc gc;
+    bcoroutine *co; /* running coroutine, NULL in the main thread */
     bbyte compopt; /* compilation options */
     bobshook obshook;
 #if BE_USE_PERF_COUNTERS
@@ -112,6 +119,8 @@ struct bvm {
     uint32_t counter_exc; /* counter for raised exceptions */
     uint32_t counter_gc_kept; /* counter for objects scanned by last gc */
     uint32_t counter_gc_freed; /* counter for objects freed by last gc */
+    uint32_t counter_gc_count; /* counter for garbage collections */
+    size_t counter_mem_peak; /* highest `gc.usage` reached */
 #endif
 #if BE_USE_DEBUG_HOOK
     bvalue hook;
@@ -122,8 +131,10 @@ struct bvm {
 #define NONE_FLAG           0
 #define BASE_FRAME          (1 << 0)
 #define PRIM_FUNC           (1 << 1)
+#define CO_FRAME            (1 << 2) /* base frame re-entered by `be_vm_resume()` */
 
 void be_dofunc(bvm *vm, bvalue *v, int argc);
+void be_vm_resume(bvm *vm);
 bbool be_value2bool(bvm *vm, bvalue *v);
 bbool be_vm_iseq(bvm *vm, bvalue *a, bvalue *b);
 bbool be_vm_isneq(bvm *vm, bvalue *a, bvalue *b);
@@ -131,5 +142,6 @@ bbool be_vm_islt(bvm *vm, bvalue *a, bvalue *b);
 bbool be_vm_isle(bvm *vm, bvalue *a, bvalue *b);
 bbool be_vm_isgt(bvm *vm, bvalue *a, bvalue *b);
 bbool be_vm_isge(bvm *vm, bvalue *a, bvalue *b);
+int be_range_iter(bvm *vm); /* native iterator of `range`, see be_rangelib.c */
 
 #endif
@@ -11,6 +11,9 @@
 
 #include "be_mapping.h"
 #include "be_exec.h"
+#include "be_class.h"
+#include "be_gc.h"
+#include "be_mem.h"
 #include <string.h>
 
 /*********************************************************************************************\
@@ -132,7 +135,25 @@ int be_find_global_or_module_member(bvm *vm, const char * name) {
 
 // read a single value at stack position idx, convert to int.
 // if object instance, get `_p` member and convert it recursively
+// return the class at stack position idx if it is solidified, i.e. can't be garbage collected, or NULL
+static const bclass * be_get_const_class(bvm *vm, int idx) {
+  bvalue *v = be_indexof(vm, idx);
+  if (var_isclass(v)) {
+    bclass *cl = var_toobj(v);
+    if (gc_isconst(cl)) { return cl; }
+  }
+  return NULL;
+}
+
+// same as `be_convert_single_elt()`, `cl_cache` (can be NULL) holds the class
+// resolved from `arg_type`, and is filled on first resolution
+static intptr_t be_convert_single_elt_cl(bvm *vm, int idx, const char * arg_type, const char * gen_cb, const bclass ** cl_cache);
+
 intptr_t be_convert_single_elt(bvm *vm, int idx, const char * arg_type, const char * gen_cb) {
+  return be_convert_single_elt_cl(vm, idx, arg_type, gen_cb, NULL);
+}
+
+static intptr_t be_convert_single_elt_cl(bvm *vm, int idx, const char * arg_type, const char * gen_cb, const bclass ** cl_cache) {
   // berry_log_C("be_convert_single_elt(idx=%i, argtype='%s', gen_cb=%p", idx, arg_type, gen_cb);
   int ret = 0;
   char provided_type = 0;
@@ -213,7 +234,14 @@ intptr_t be_convert_single_elt(bvm *vm, int idx, const char * arg_type, const ch
       if (arg_type_len > 1) {
         // Check type
         be_classof(vm, idx);
-        int class_found = be_find_global_or_module_member(vm, arg_type);
+        int class_found;
+        if (cl_cache && *cl_cache) {
+          be_pushntvclass(vm, *cl_cache);
+          class_found = 1;
+        } else {
+          class_found = be_find_global_or_module_member(vm, arg_type);
+          if (cl_cache && class_found == 1) { *cl_cache = be_get_const_class(vm, -1); }
+        }
         // Stack: class_of_idx, class_of_target (or nil)
         if (class_found) {
           if (!be_isderived(vm, -2)) {
@@ -311,6 +339,171 @@ void be_check_arg_type(bvm *vm, int arg_start, int argc, const char * arg_type,
   }
 }
 
+/*********************************************************************************************\
+ * Precompiled signatures
+ *
+ * `return_type` and `arg_type` are parsed once and kept in a small cache indexed
+ * by the address of the descriptors, which are constant strings in all mappings.
+ * A hash of their contents is checked on each hit, so a descriptor built at
+ * runtime whose address gets reused for another signature is parsed again.
+ * Classes are resolved on first use and kept if they are solidified.
+ *
+ * Descriptors with more than `BE_NTV_SIG_ARGS` types are parsed at each call
+ * by `be_check_arg_type()`.
+ *
+ * Argument conversion and the native call can run Berry code that calls another
+ * mapped function, so a call works on a copy of its entry and not on the cache.
+\*********************************************************************************************/
+#define BE_NTV_SIG_CACHE    32      // number of cached signatures, must be a power of 2
+#define BE_NTV_SIG_ARGS     8       // max number of types in a precompiled `arg_type`
+#define BE_NTV_SIG_NAME     32      // max size of a type name, same as `be_check_arg_type()`
+
+typedef struct be_ntv_arg_t {
+  char type;                  // '-', '.', 'a'..'z', '(' for class, '^' for callback
+  uint8_t start;              // offset of the type in `arg_type`, for error messages
+  uint8_t name;               // offset of the name as expected by `be_convert_single_elt()`
+  uint8_t len;                // length of the name
+  const bclass * cl;          // resolved class, or NULL
+} be_ntv_arg_t;
+
+typedef struct be_ntv_sig_t {
+  const char * return_type;   // key
+  const char * arg_type;      // key
+  uint32_t hash;              // hash of the contents of both keys
+  const bclass * ret_cl;      // resolved class of return type, or NULL
+  char ret;                   // 0 no value, '+' constructor, 'i'/'b'/'s'/'c'/'.' simple type, '(' class
+  uint8_t valid;              // cache entry is populated
+  uint8_t compiled;           // `args[]` is valid, otherwise use `be_check_arg_type()`
+  uint8_t argc;               // number of types in `args[]`
+  be_ntv_arg_t args[BE_NTV_SIG_ARGS];
+} be_ntv_sig_t;
+
+static be_ntv_sig_t * be_ntv_sig_cache = NULL;
+
+// parse `arg_type` the same way `be_check_arg_type()` does, returns false if it can't be precompiled
+static bbool be_ntv_sig_compile_args(be_ntv_sig_t * sig, const char * arg_type) {
+  sig->argc = 0;
+  if (arg_type == NULL) { return btrue; }
+  if (strlen(arg_type) > 255) { return bfalse; }
+  uint32_t idx = 0;
+  while (arg_type[idx] != 0) {
+    if (sig->argc >= BE_NTV_SIG_ARGS) { return bfalse; }
+    be_ntv_arg_t * arg = &sig->args[sig->argc++];
+    char c = arg_type[idx];
+    arg->type = c;
+    arg->start = idx;
+    arg->name = idx;
+    arg->len = 1;
+    arg->cl = NULL;
+    switch (c) {
+      case '-':
+      case '.':
+      case 'a'...'z':
+        idx++;
+        break;
+      case '(':
+      case '^':
+        {
+          uint32_t prefix = (c == '^') ? 1 : 0;
+          uint32_t offset = 0;
+          while (arg_type[idx + 1 + offset] != ')' && arg_type[idx + 1 + offset] != '^' && arg_type[idx + 1 + offset] != 0) {
+            offset++;
+          }
+          if (offset + prefix + 1 >= BE_NTV_SIG_NAME) { return bfalse; }   // would be truncated
+          arg->name = prefix ? idx : idx + 1;
+          arg->len = offset + prefix;
+          if (arg_type[idx + 1 + offset] == 0) { return btrue; }    // no more parameters
+          idx += offset + 2;
+        }
+        break;
+      default:
+        return bfalse;
+    }
+  }
+  return btrue;
+}
+
+// FNV-1a hash of both descriptors, NULL and "" are equivalent
+static uint32_t be_ntv_sig_hash(const char * return_type, const char * arg_type) {
+  uint32_t hash = 2166136261u;
+  if (return_type) {
+    while (*return_type) { hash = (hash ^ (uint8_t)*return_type++) * 16777619u; }
+  }
+  hash = (hash ^ '|') * 16777619u;
+  if (arg_type) {
+    while (*arg_type) { hash = (hash ^ (uint8_t)*arg_type++) * 16777619u; }
+  }
+  return hash;
+}
+
+// cache slot of a signature, from the address of its descriptors
+static inline uint32_t be_ntv_sig_slot(const char * return_type, const char * arg_type) {
+  return (((uintptr_t) return_type >> 2) * 31 + ((uintptr_t) arg_type >> 2)) & (BE_NTV_SIG_CACHE - 1);
+}
+
+// get the precompiled signature, compile it if not in cache
+static be_ntv_sig_t * be_ntv_sig_get(bvm *vm, const char * return_type, const char * arg_type) {
+  if (be_ntv_sig_cache == NULL) {
+    be_ntv_sig_cache = (be_ntv_sig_t *) be_os_malloc(sizeof(be_ntv_sig_t) * BE_NTV_SIG_CACHE);
+    if (be_ntv_sig_cache == NULL) { be_throw(vm, BE_MALLOC_FAIL); }
+    memset(be_ntv_sig_cache, 0, sizeof(be_ntv_sig_t) * BE_NTV_SIG_CACHE);
+  }
+  be_ntv_sig_t * sig = &be_ntv_sig_cache[be_ntv_sig_slot(return_type, arg_type)];
+  uint32_t hash = be_ntv_sig_hash(return_type, arg_type);
+  if (sig->valid && sig->return_type == return_type && sig->arg_type == arg_type && sig->hash == hash) { return sig; }
+
+  sig->return_type = return_type;
+  sig->arg_type = arg_type;
+  sig->hash = hash;
+  sig->ret_cl = NULL;
+  if ((return_type == NULL) || (return_type[0] == 0)) { sig->ret = 0; }
+  else if (return_type[0] == '+')                     { sig->ret = '+'; }
+  else if (return_type[1] == 0)                       { sig->ret = return_type[0]; }
+  else                                                { sig->ret = '('; }
+  sig->compiled = be_ntv_sig_compile_args(sig, arg_type);
+  sig->valid = btrue;
+  return sig;
+}
+
+// store the classes resolved in a stack copy, unless a nested call reused the cache entry
+static void be_ntv_sig_update(const be_ntv_sig_t * sig) {
+  be_ntv_sig_t * cached = &be_ntv_sig_cache[be_ntv_sig_slot(sig->return_type, sig->arg_type)];
+  if (cached->valid && cached->return_type == sig->return_type && cached->arg_type == sig->arg_type && cached->hash == sig->hash) {
+    *cached = *sig;
+  }
+}
+
+// same as `be_check_arg_type()` with a precompiled signature
+static void be_check_arg_type_sig(bvm *vm, int arg_start, int argc, be_ntv_sig_t * sig, intptr_t p[8]) {
+  if (!sig->compiled) {
+    be_check_arg_type(vm, arg_start, argc, sig->arg_type, p);
+    return;
+  }
+  const char * arg_type = sig->arg_type;
+  char type_short_name[BE_NTV_SIG_NAME];
+
+  uint32_t p_idx = 0; // index in p[], is incremented with each parameter except '-'
+  for (uint32_t i = 0; i < argc; i++) {
+    be_ntv_arg_t * arg = (i < sig->argc) ? &sig->args[i] : NULL;    // NULL if past the end of types
+    if (arg && arg->type == '-') { continue; }    // ignore current parameter
+    if (p_idx >= 8) { be_raise(vm, "value_error", "Too many arguments"); }
+    if (arg_type == NULL) {
+      p[p_idx++] = be_convert_single_elt_cl(vm, i + arg_start, NULL, "_lvgl.gen_cb", NULL);
+    } else if (arg == NULL) {
+      p[p_idx++] = be_convert_single_elt_cl(vm, i + arg_start, "", "_lvgl.gen_cb", NULL);
+    } else {
+      memcpy(type_short_name, &arg_type[arg->name], arg->len);
+      type_short_name[arg->len] = 0;
+      p[p_idx++] = be_convert_single_elt_cl(vm, i + arg_start, type_short_name, "_lvgl.gen_cb", &arg->cl);
+    }
+  }
+
+  // check if we are missing arguments
+  if (arg_type != NULL && argc < sig->argc) {
+    be_raisef(vm, "value_error", "Missing arguments, remaining type '%s'", &arg_type[sig->args[argc].start]);
+  }
+}
+
 //
 // Internal function
 //
@@ -354,6 +547,8 @@ static void be_set_ctor_ptr(bvm *vm, void * ptr, const char *name) {
 int be_call_c_func(bvm *vm, void * func, const char * return_type, const char * arg_type) {
   intptr_t p[8] = {0,0,0,0,0,0,0,0};
   int argc = be_top(vm); // Get the number of arguments
+  be_ntv_sig_t sig_copy = *be_ntv_sig_get(vm, return_type, arg_type);   // the cache entry can be reused by nested calls
+  be_ntv_sig_t * sig = &sig_copy;
 
   // the following describe the active payload for the C function (start and count)
   // this is because the `init()` constructor first arg is not passed to the C function
@@ -362,7 +557,7 @@ int be_call_c_func(bvm *vm, void * func, const char * return_type, const char *
 
   // check if we call a constructor, in this case we store the return type into the new object
   // check if we call a constructor with a comptr as first arg
-  if (return_type && return_type[0] == '+') {
+  if (sig->ret == '+') {
     if (argc > 1 && be_iscomptr(vm, 2)) {
       void * obj = be_tocomptr(vm, 2);
       be_set_ctor_ptr(vm, obj, return_type);
@@ -375,32 +570,37 @@ int be_call_c_func(bvm *vm, void * func, const char * return_type, const char *
   }
 
   fn_any_callable f = (fn_any_callable) func;
-  be_check_arg_type(vm, arg_start, arg_count, arg_type, p);
+  be_check_arg_type_sig(vm, arg_start, arg_count, sig, p);
+  if (sig->compiled) { be_ntv_sig_update(sig); }    // keep classes resolved during conversion
   intptr_t ret = (*f)(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
   // berry_log_C("be_call_c_func '%s' -> '%s': (%i,%i,%i,%i,%i,%i) -> %i", return_type, arg_type, p[0], p[1], p[2], p[3], p[4], p[5], ret);
 
-  if ((return_type == NULL) || (strlen(return_type) == 0))       { be_return_nil(vm); }  // does not return
-  else if (return_type[0] == '+') {
-    void * obj = (void*) ret;
-    be_set_ctor_ptr(vm, obj, return_type);
-    be_return_nil(vm);
-  }
-  else if (strlen(return_type) == 1) {
-    switch (return_type[0]) {
-      case '.':   // fallback next
-      case 'i':   be_pushint(vm, ret); break;
-      case 'b':   be_pushbool(vm, ret);  break;
-      case 's':   be_pushstring(vm, (const char*) ret);  break;
-      case 'c':   be_pushint(vm, ret); break; // TODO missing 'c' general callback type
-      default:    be_raise(vm, "internal_error", "Unsupported return type"); break;
-    }
-    be_return(vm);
-  } else { // class name
-    be_find_global_or_module_member(vm, return_type);
-    be_pushcomptr(vm, (void*) ret);         // stack = class, ptr
-    be_pushcomptr(vm, (void*) -1);         // stack = class, ptr, -1
-    be_call(vm, 2);                 // instanciate with 2 arguments, stack = instance, -1, ptr
-    be_pop(vm, 2);                  // stack = instance
-    be_return(vm);
+  switch (sig->ret) {
+    case 0:     be_return_nil(vm);  // does not return
+    case '+':
+      {
+        void * obj = (void*) ret;
+        be_set_ctor_ptr(vm, obj, return_type);
+        be_return_nil(vm);
+      }
+    case '.':   // fallback next
+    case 'i':   be_pushint(vm, ret); break;
+    case 'b':   be_pushbool(vm, ret);  break;
+    case 's':   be_pushstring(vm, (const char*) ret);  break;
+    case 'c':   be_pushint(vm, ret); break; // TODO missing 'c' general callback type
+    case '(':   // class name
+      if (sig->ret_cl) {
+        be_pushntvclass(vm, sig->ret_cl);
+      } else if (be_find_global_or_module_member(vm, return_type) == 1) {
+        sig->ret_cl = be_get_const_class(vm, -1);
+        be_ntv_sig_update(sig);
+      }
+      be_pushcomptr(vm, (void*) ret);         // stack = class, ptr
+      be_pushcomptr(vm, (void*) -1);         // stack = class, ptr, -1
+      be_call(vm, 2);                 // instanciate with 2 arguments, stack = instance, -1, ptr
+      be_pop(vm, 2);                  // stack = instance
+      break;
+    default:    be_raise(vm, "internal_error", "Unsupported return type"); break;
   }
+  be_return(vm);
 }
@@ -0,0 +1,63 @@
+/********************************************************************
+ * Host test of the signature cache of `be_call_c_func()`
+ *
+ * `outer()` runs Berry code that calls `inner()` from inside the
+ * native call. Both signatures use the same cache slot, the outer
+ * call must still convert its result with its own return type.
+ *******************************************************************/
+#include "be_mapping.h"
+#include <stdio.h>
+#include <string.h>
+
+static bvm *test_vm;
+
+// descriptors placed so that both signatures get the same cache slot:
+// slots differ by `(return_type >> 2) * 31`, 128 bytes apart is 32 * 31
+static char descriptors[256] __attribute__((aligned(4)));
+#define RET_OUTER   (&descriptors[0])       // "s"
+#define RET_INNER   (&descriptors[128])     // "i"
+#define ARG_TYPE    (&descriptors[64])      // "i"
+
+static intptr_t inner_fn(intptr_t x) {
+  return x + 41;
+}
+
+static intptr_t outer_fn(intptr_t x) {
+  be_getglobal(test_vm, "cb");
+  be_pushint(test_vm, x);
+  be_call(test_vm, 1);
+  be_pop(test_vm, 2);
+  return (intptr_t) "outer";
+}
+
+static int m_inner(bvm *vm) { return be_call_c_func(vm, (void*) inner_fn, RET_INNER, ARG_TYPE); }
+static int m_outer(bvm *vm) { return be_call_c_func(vm, (void*) outer_fn, RET_OUTER, ARG_TYPE); }
+
+static const char test_script[] =
+  "var inner_ret\n"
+  "cb = def (x) inner_ret = inner(x) end\n"
+  "assert(outer(1) == 'outer')\n"
+  "assert(inner_ret == 42)\n"
+  "assert(inner(2) == 43)\n"
+  "assert(outer(3) == 'outer')\n"
+  "assert(inner_ret == 44)\n";
+
+int main(void) {
+  strcpy(RET_OUTER, "s");
+  strcpy(RET_INNER, "i");
+  strcpy(ARG_TYPE, "i");
+
+  test_vm = be_vm_new();
+  be_regfunc(test_vm, "inner", m_inner);
+  be_regfunc(test_vm, "outer", m_outer);
+  int res = be_loadstring(test_vm, test_script);
+  if (res == BE_OK) {
+    res = be_pcall(test_vm, 0);
+  }
+  if (res != BE_OK) {
+    be_dumpexcept(test_vm);
+  }
+  be_vm_delete(test_vm);
+  printf("signature cache: %s\n", res == BE_OK ? "ok" : "FAILED");
+  return res == BE_OK ? 0 : 1;
+}
@@ -32,6 +32,8 @@ re1_5_backtrack(ByteProg *prog, Subject *input, const char **subp, int nsubp, in
 
 	/* queue initial thread */
 	sub = newsub(nsubp);
+	if(sub == nil)
+		re1_5_fatal("out of memory");
 	for(i=0; i<nsubp; i++)
 		sub->sub[i] = nil;
 	ready[0] = thread(HANDLE_ANCHORED(prog->insts, is_anchored), input->begin, sub);
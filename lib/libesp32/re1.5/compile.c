@@ -17,6 +17,8 @@ compile(Regexp *r)
 
 	n = count(r) + 1;
 	p = mal(sizeof *p + n*sizeof p->start[0]);
+	if(p == nil)
+		re1_5_fatal("out of memory");
 	p->start = (Inst*)(p+1);
 	pc = p->start;
 	emit(r);
@@ -91,7 +91,7 @@ main(int argc, char **argv)
 #ifdef DEBUG
 	if (debug) printf("Precalculated size: %d\n", sz);
 #endif
-	if (sz == -1) {
+	if (sz < 0) {
 		re1_5_fatal("Error in regexp");
 	}
 
@@ -71,10 +71,14 @@ addthread(ThreadList *l, Thread t, Subject *input, const char *sp)
 	case Bol:
 		if(sp == input->begin)
 			addthread(l, thread(t.pc + 1, t.sub), input, sp);
+		else
+			decref(t.sub);
 		break;
 	case Eol:
 		if(sp == input->end)
 			addthread(l, thread(t.pc + 1, t.sub), input, sp);
+		else
+			decref(t.sub);
 		break;
 	}
 }
@@ -91,13 +95,20 @@ re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int i
 	matched = nil;	
 	for(i=0; i<nsubp; i++)
 		subp[i] = nil;
-	sub = newsub(nsubp);
-	for(i=0; i<nsubp; i++)
-		sub->sub[i] = nil;
 
+	// allocate up front, a run holds a Sub per thread of both lists,
+	// the match and the one being copied by update()
 	len = prog->len;
 	clist = threadlist(len);
 	nlist = threadlist(len);
+	if(clist == nil || nlist == nil || !reservesub(2 * len + 3)) {
+		free(clist);
+		free(nlist);
+		return RE1_5_NOMEM;
+	}
+	sub = newsub(nsubp);
+	for(i=0; i<nsubp; i++)
+		sub->sub[i] = nil;
 	
 	cleanmarks(prog);
 	addthread(clist, thread(HANDLE_ANCHORED(prog->insts, is_anchored), sub), input, input->begin);
@@ -166,6 +177,8 @@ re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int i
 		//if(*sp == '\0')
 		//	break;
 	}
+	free(clist);
+	free(nlist);
 	if(matched) {
 		for(i=0; i<nsubp; i++)
 			subp[i] = matched->sub[i];
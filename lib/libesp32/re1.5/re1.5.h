@@ -123,6 +123,7 @@ struct Sub
 	const char *sub[MAXSUB];
 };
 
+int reservesub(int n);
 Sub *newsub(int n);
 Sub *incref(Sub*);
 Sub *copy(Sub*);
@@ -152,6 +153,11 @@ enum {
     RE1_5_UNSUPPORTED_SYNTAX = -4,
 };
 
+// re1_5_pikevm() returns RE1_5_NOMEM when out of memory
+enum {
+    RE1_5_NOMEM = -1,
+};
+
 int re1_5_sizecode(const char *re);
 int re1_5_compilecode(ByteProg *prog, const char *re);
 void re1_5_dumpcode(ByteProg *prog);
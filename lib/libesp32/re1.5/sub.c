@@ -5,6 +5,24 @@
 #include "re1.5.h"
 
 Sub *freesub;
+static int nfreesub;
+
+// fill the free list so that the next n newsub() cannot fail, returns 0 when out of memory
+int
+reservesub(int n)
+{
+	Sub *s;
+
+	while(nfreesub < n) {
+		s = mal(sizeof *s);
+		if(s == nil)
+			return 0;
+		s->sub[0] = (char*)freesub;
+		freesub = s;
+		nfreesub++;
+	}
+	return 1;
+}
 
 Sub*
 newsub(int n)
@@ -12,10 +30,14 @@ newsub(int n)
 	Sub *s;
 	
 	s = freesub;
-	if(s != nil)
+	if(s != nil) {
 		freesub = (Sub*)s->sub[0];
-	else
+		nfreesub--;
+	} else {
 		s = mal(sizeof *s);
+		if(s == nil)
+			return nil;
+	}
 	s->nsub = n;
 	s->ref = 1;
 	return s;
@@ -51,5 +73,6 @@ decref(Sub *s)
 	if(--s->ref == 0) {
 		s->sub[0] = (char*)freesub;
 		freesub = s;
+		nfreesub++;
 	}
 }
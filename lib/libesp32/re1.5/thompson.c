@@ -27,7 +27,12 @@ thread(char *pc)
 static ThreadList*
 threadlist(int n)
 {
-	return mal(sizeof(ThreadList)+n*sizeof(Thread));
+	ThreadList *l;
+
+	l = mal(sizeof(ThreadList)+n*sizeof(Thread));
+	if(l == nil)
+		re1_5_fatal("out of memory");
+	return l;
 }
 
 static void
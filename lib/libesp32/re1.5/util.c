@@ -4,24 +4,29 @@
 
 #include "re1.5.h"
 
+#ifndef RE1_5_HOST
 extern void berry_log_C(const char * berry_buf, ...);
+#endif
 
 void
 re1_5_fatal(const char *msg)
 {
+#ifdef RE1_5_HOST
+	fprintf(stderr, "fatal error: %s\n", msg);
+#else
 	berry_log_C("BRY: regex fatal error: %s", msg);
-	// fprintf(stderr, "fatal error: %s\n", msg);
+#endif
 	exit(2);
 }
 
+// returns nil when out of memory, the caller reports it (exiting would reboot an ESP32)
 void*
 mal(int n)
 {
 	void *v;
 	
 	v = malloc(n);
-	if(v == nil)
-		re1_5_fatal("out of memory");
-	memset(v, 0, n);
+	if(v != nil)
+		memset(v, 0, n);
 	return v;
 }	
@@ -358,6 +358,7 @@
 #define D_CMND_HUMOFFSET "HumOffset"
 #define D_CMND_GLOBAL_TEMP "GlobalTemp"
 #define D_CMND_GLOBAL_HUM "GlobalHum"
+#define D_CMND_PROFILE "Profile"
 
 #define D_SO_WIFINOSLEEP "WifiNoSleep"
 
@@ -548,7 +549,10 @@
 // Commands xdrv_08_serial_bridge.ino
 #define D_CMND_SSERIALSEND "SSerialSend"
 #define D_CMND_SBAUDRATE "SBaudrate"
+#define D_CMND_SSERIALFRAME "SSerialFrame"
+#define D_CMND_SSERIALBATCH "SSerialBatch"
   #define D_JSON_SSERIALRECEIVED "SSerialReceived"
+  #define D_JSON_SSERIALFRAMES "SSerialFrames"
 
 // Commands xdrv_09_timers.ino
 #define D_CMND_TIMER "Timer"
@@ -714,6 +718,7 @@
 // Commands xdrv_52_berry.ino - Berry scripting language
 #define D_PRFX_BR "Br"
 #define D_CMND_BR_RUN ""
+#define D_CMND_BR_MEM "Mem"
 #define D_BR_NOT_STARTED  "Berry not started"
 
 // Commands xdrv_60_shift595.ino - 74x595 family shift register driver
@@ -847,6 +847,8 @@
 #define D_GPIO_SHIFT595_RCLK            "74x595 - RCLK"
 #define D_GPIO_SHIFT595_OE              "74x595 - OE"
 #define D_GPIO_SHIFT595_SER             "74x595 - SER"
+#define D_SENSOR_TCP_RTS       "TCP RTS"
+#define D_SENSOR_TCP_CTS       "TCP CTS"
 
 // Units
 #define D_UNIT_AMPERE                     "A"
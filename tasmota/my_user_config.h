@@ -990,6 +990,8 @@
 //  #define ETH_CLKMODE       0                    // [EthClockMode] 0 = ETH_CLOCK_GPIO0_IN, 1 = ETH_CLOCK_GPIO0_OUT, 2 = ETH_CLOCK_GPIO16_OUT, 3 = ETH_CLOCK_GPIO17_OUT
 
 #define USE_ADC                                  // Add support for ADC on GPIO32 to GPIO39
+//  #define USE_ADC_DMA                            // Sample ADC1 continuously using DMA, no blocking reads and true RMS for CT power (ESP32 with Core 2.x only)
+//#define USE_I2C_QUEUE                            // Add I2C transaction queue with a bus task per I2C bus for drivers using I2cQueueRead/I2cQueueWrite (+2k code)
 
 //#define USE_SPI                                  // Add support for hardware SPI
 //#define USE_MI_ESP32                             // Add support for ESP32 as a BLE-bridge (+9k2 mem, +292k flash)
@@ -1070,6 +1072,7 @@
 //#define PROFILE_THRESHOLD            70          // Minimum duration in milliseconds to start logging
 //#define USE_PROFILE_DRIVER                       // Enable driver profiling
 //#define USE_PROFILE_FUNCTION                     // Enable driver function profiling
+//#define USE_PROFILE_STATS                        // Enable runtime statistics per driver function, Berry event and command with command Profile (+3k code)
 
 /*********************************************************************************************\
  * Optional firmware configurations
@@ -742,8 +742,13 @@ typedef struct {
   uint8_t       shd_warmup_time;           // F5E
   uint8_t       tcp_config;                // F5F
   uint8_t       light_step_pixels;				 // F60
+  uint8_t       tcp_baudrate_msb;          // F61
+  uint8_t       sserial_frame_mode;        // F62
+  uint8_t       sserial_frame_param[3];    // F63
+  uint16_t      sserial_batch_ms;          // F66
+  uint8_t       sserial_frame_flags;       // F68
 
-  uint8_t       free_f59[59];              // F61 - Decrement if adding new Setting variables just above and below
+  uint8_t       free_f59[51];              // F69 - Decrement if adding new Setting variables just above and below
 
   // Only 32 bit boundary variables below
 
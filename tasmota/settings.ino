@@ -209,7 +209,6 @@ uint32_t SETTINGS_LOCATION = EEPROM_LOCATION;
 const uint8_t CFG_ROTATES = 7;      // Number of flash sectors used (handles uploads)
 
 uint32_t settings_location = EEPROM_LOCATION;
-uint32_t settings_crc32 = 0;
 uint8_t *settings_buffer = nullptr;
 uint8_t config_xor_on_set = CONFIG_FILE_XOR;
 
@@ -575,10 +574,223 @@ uint32_t GetSettingsAddress(void) {
   return settings_location * SPI_FLASH_SEC_SIZE;
 }
 
+/*********************************************************************************************\
+ * Settings journal - Save only changed parts of settings
+ *
+ * Settings are split in chunks of SETTINGS_CHUNK_SIZE bytes. A hash per chunk detects which
+ * parts changed since the last save without a crc32 over all of TSettings.
+ *
+ * ESP8266 appends changed chunks as records to a journal sector, being the next rotating
+ * flash slot after the base image. The journal header holds save_flag and cfg_crc32 of the
+ * base image it applies to and each record holds its own crc32. A full base image is only
+ * written (compacted) on rotate, when the journal is full or when most chunks changed.
+ * The last four bytes (cfg_crc32) of a journal sector are never written so SettingsLoad
+ * (and older firmware) never accepts a journal sector as valid settings.
+\*********************************************************************************************/
+
+const uint32_t SETTINGS_CHUNK_SIZE = 64;
+const uint32_t SETTINGS_CHUNKS = sizeof(TSettings) / SETTINGS_CHUNK_SIZE;  // Max 64 to fit dirty mask
+const uint32_t SETTINGS_JOURNAL_MAGIC = 0x4C4E524A;                        // "JRNL"
+const uint32_t SETTINGS_JOURNAL_RECORD_MAX = 4 * SETTINGS_CHUNK_SIZE;      // Max bytes per record
+const uint32_t SETTINGS_JOURNAL_END = SPI_FLASH_SEC_SIZE -4;               // Keep cfg_crc32 position erased
+
+static_assert(SETTINGS_CHUNKS <= 64, "Settings chunks do not fit the 64-bit dirty mask");
+
+typedef struct {
+  uint32_t magic;
+  uint32_t base_save_flag;
+  uint32_t base_crc32;
+  uint32_t crc32;
+} SettingsJournalHeader;
+
+typedef struct {
+  uint16_t offset;
+  uint16_t length;
+  uint32_t crc32;
+} SettingsJournalRecord;
+
+struct SETTINGS_JOURNAL {
+  uint32_t chunk_hash[SETTINGS_CHUNKS];
+  uint32_t base_save_flag;
+  uint32_t base_crc32;
+  uint32_t location;                      // Journal flash sector (0 = no journal)
+  uint32_t position;                      // Next record offset in journal sector (0 = full or invalid)
+  bool base_valid;                        // Base image in flash can be extended by journal
+} SettingsJournal;
+
+uint32_t SettingsChunkHash(uint32_t chunk) {
+  const uint32_t *words = (const uint32_t*)((uint8_t*)Settings + (chunk * SETTINGS_CHUNK_SIZE));
+  uint32_t hash = 0x811C9DC5;
+  for (uint32_t i = 0; i < SETTINGS_CHUNK_SIZE / 4; i++) {
+    hash = (hash ^ words[i]) * 0x01000193;
+    hash ^= hash >> 15;
+  }
+  return hash;
+}
+
+uint64_t SettingsDirtyChunks(void) {
+  // Return bitmask of changed chunks since last call and update chunk hashes
+  uint64_t dirty = 0;
+  for (uint32_t chunk = 0; chunk < SETTINGS_CHUNKS; chunk++) {
+    uint32_t hash = SettingsChunkHash(chunk);
+    if (hash != SettingsJournal.chunk_hash[chunk]) {
+      SettingsJournal.chunk_hash[chunk] = hash;
+      dirty |= (1ULL << chunk);
+    }
+  }
+  return dirty;
+}
+
+void SettingsJournalInit(bool base_valid) {
+  // Base image just loaded from or written to flash
+  SettingsDirtyChunks();
+  SettingsJournal.base_save_flag = Settings->save_flag;
+  SettingsJournal.base_crc32 = Settings->cfg_crc32;
+  SettingsJournal.base_valid = base_valid;
+}
+
+#ifdef ESP8266
+uint32_t SettingsRotateLocation(uint32_t location) {
+  // Return next flash slot in rotation EEPROM_LOCATION, SETTINGS_LOCATION .. SETTINGS_LOCATION - CFG_ROTATES +1
+  if (location == EEPROM_LOCATION) {
+    return SETTINGS_LOCATION;
+  }
+  location--;
+  if (location <= (SETTINGS_LOCATION - CFG_ROTATES)) {
+    location = EEPROM_LOCATION;
+  }
+  return location;
+}
+
+uint32_t SettingsJournalHeaderCrc(SettingsJournalHeader *header) {
+  return GetCfgCrc32((uint8_t*)header, sizeof(SettingsJournalHeader) -4);  // Skip crc32
+}
+
+uint32_t SettingsJournalRecordCrc(SettingsJournalRecord *record, const uint8_t *data) {
+  return GetCfgCrc32(data, record->length) ^ ((record->offset << 16) | record->length);
+}
+
+bool SettingsJournalAppend(uint64_t dirty) {
+  if (!SettingsJournal.base_valid || TasmotaGlobal.stop_flash_rotate) { return false; }
+
+  uint32_t dirty_chunks = 0;
+  uint32_t records = 0;
+  bool in_record = false;
+  uint32_t record_chunks = 0;
+  for (uint32_t chunk = 0; chunk < SETTINGS_CHUNKS; chunk++) {
+    if (bitRead(dirty, chunk)) {
+      dirty_chunks++;
+      if (!in_record || (SETTINGS_JOURNAL_RECORD_MAX / SETTINGS_CHUNK_SIZE == record_chunks)) {
+        records++;
+        record_chunks = 0;
+      }
+      record_chunks++;
+      in_record = true;
+    } else {
+      in_record = false;
+    }
+  }
+  if (dirty_chunks > SETTINGS_CHUNKS / 2) { return false; }  // Full write is cheaper
+
+  uint32_t needed = (records * sizeof(SettingsJournalRecord)) + (dirty_chunks * SETTINGS_CHUNK_SIZE);
+  if (!SettingsJournal.location) {
+    // Start new journal in next flash slot
+    uint32_t location = SettingsRotateLocation(settings_location);
+    if (!ESP.flashEraseSector(location)) { return false; }
+    SettingsJournalHeader header;
+    header.magic = SETTINGS_JOURNAL_MAGIC;
+    header.base_save_flag = SettingsJournal.base_save_flag;
+    header.base_crc32 = SettingsJournal.base_crc32;
+    header.crc32 = SettingsJournalHeaderCrc(&header);
+    if (!ESP.flashWrite(location * SPI_FLASH_SEC_SIZE, (uint32*)&header, sizeof(header))) { return false; }
+    SettingsJournal.location = location;
+    SettingsJournal.position = sizeof(header);
+  }
+  if (!SettingsJournal.position || (SettingsJournal.position + needed > SETTINGS_JOURNAL_END)) { return false; }
+
+  uint32_t address = SettingsJournal.location * SPI_FLASH_SEC_SIZE;
+  uint32_t chunk = 0;
+  while (chunk < SETTINGS_CHUNKS) {
+    if (!bitRead(dirty, chunk)) {
+      chunk++;
+      continue;
+    }
+    uint32_t start = chunk;
+    while ((chunk < SETTINGS_CHUNKS) && bitRead(dirty, chunk) && ((chunk - start) * SETTINGS_CHUNK_SIZE < SETTINGS_JOURNAL_RECORD_MAX)) {
+      chunk++;
+    }
+    SettingsJournalRecord record;
+    record.offset = start * SETTINGS_CHUNK_SIZE;
+    record.length = (chunk - start) * SETTINGS_CHUNK_SIZE;
+    const uint8_t *data = (uint8_t*)Settings + record.offset;
+    record.crc32 = SettingsJournalRecordCrc(&record, data);
+    bool ok = ESP.flashWrite(address + SettingsJournal.position, (uint32*)&record, sizeof(record));
+    if (ok) {
+      ok = ESP.flashWrite(address + SettingsJournal.position + sizeof(record), (uint32*)data, record.length);
+    }
+    if (!ok) {
+      SettingsJournal.position = 0;                    // Journal unusable, force full write
+      return false;
+    }
+    SettingsJournal.position += sizeof(record) + record.length;
+  }
+  AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_CONFIG "Journaled at %X, " D_COUNT " %d, " D_BYTES " %d"), SettingsJournal.location, Settings->save_flag, needed);
+  return true;
+}
+
+void SettingsJournalReplay(void) {
+  // Apply journal records on top of just loaded base image
+  SettingsJournal.location = 0;
+  SettingsJournal.position = 0;
+  if ((0xFFFFFFFF == Settings->cfg_crc32) || (0 == Settings->cfg_crc32)) { return; }
+
+  SettingsJournalHeader header;
+  uint32_t location = EEPROM_LOCATION;
+  for (uint32_t slot = 0; slot <= CFG_ROTATES; slot++) {
+    ESP.flashRead(location * SPI_FLASH_SEC_SIZE, (uint32*)&header, sizeof(header));
+    if ((SETTINGS_JOURNAL_MAGIC == header.magic) &&
+        (header.crc32 == SettingsJournalHeaderCrc(&header)) &&
+        (header.base_save_flag == Settings->save_flag) &&
+        (header.base_crc32 == Settings->cfg_crc32)) {
+      SettingsJournal.location = location;
+      break;
+    }
+    location = SettingsRotateLocation(location);
+  }
+  if (!SettingsJournal.location) { return; }
+
+  uint32_t address = SettingsJournal.location * SPI_FLASH_SEC_SIZE;
+  uint32_t position = sizeof(header);
+  uint32_t buffer[SETTINGS_JOURNAL_RECORD_MAX / 4];
+  uint32_t records = 0;
+  while (position + sizeof(SettingsJournalRecord) <= SETTINGS_JOURNAL_END) {
+    SettingsJournalRecord record;
+    ESP.flashRead(address + position, (uint32*)&record, sizeof(record));
+    if ((0xFFFF == record.offset) && (0xFFFF == record.length)) {
+      SettingsJournal.position = position;             // End of journal, append from here
+      break;
+    }
+    if ((0 == record.length) || (record.length > SETTINGS_JOURNAL_RECORD_MAX) || (record.length & 3) ||
+        (record.offset + record.length > sizeof(TSettings)) ||
+        (position + sizeof(record) + record.length > SETTINGS_JOURNAL_END)) {
+      break;                                           // Corrupt record, force full write
+    }
+    ESP.flashRead(address + position + sizeof(record), buffer, record.length);
+    if (record.crc32 != SettingsJournalRecordCrc(&record, (uint8_t*)buffer)) {
+      break;                                           // Interrupted write, force full write
+    }
+    memcpy((uint8_t*)Settings + record.offset, buffer, record.length);
+    position += sizeof(record) + record.length;
+    records++;
+  }
+  AddLog(LOG_LEVEL_NONE, PSTR(D_LOG_CONFIG "Journal at %X, Records %d, " D_COUNT " %lu"), SettingsJournal.location, records, Settings->save_flag);
+}
+#endif  // ESP8266
+
 void SettingsSave(uint8_t rotate) {
 /* Save configuration in eeprom or one of 7 slots below
  *
- * rotate 0 = Save in next flash slot
+ * rotate 0 = Save in next flash slot or journal changes if possible
  * rotate 1 = Save only in eeprom flash slot until SetOption12 0 or restart
  * rotate 2 = Save in eeprom flash slot, erase next flash slots and continue depending on stop_flash_rotate
  * stop_flash_rotate 0 = Allow flash slot rotation (SetOption12 0)
@@ -588,7 +800,26 @@ void SettingsSave(uint8_t rotate) {
   XsnsCall(FUNC_SAVE_SETTINGS);
   XdrvCall(FUNC_SAVE_SETTINGS);
   UpdateBackwardCompatibility();
-  if ((GetSettingsCrc32() != settings_crc32) || rotate) {
+  uint64_t dirty = SettingsDirtyChunks();
+  if (dirty || rotate) {
+    Settings->save_flag++;
+    if (UtcTime() > START_VALID_TIME) {
+      Settings->cfg_timestamp = UtcTime();
+    } else {
+      Settings->cfg_timestamp++;
+    }
+    Settings->cfg_size = sizeof(TSettings);
+
+#ifdef ESP8266
+    if (!rotate) {
+      dirty |= SettingsDirtyChunks();                  // Include save_flag and cfg_timestamp
+      if (SettingsJournalAppend(dirty)) {
+        RtcSettingsSave();
+        return;
+      }
+    }
+#endif  // ESP8266
+
     if (1 == rotate) {                                 // Use eeprom flash slot only and disable flash rotate from now on (upgrade)
       TasmotaGlobal.stop_flash_rotate = 1;
     }
@@ -596,6 +827,12 @@ void SettingsSave(uint8_t rotate) {
     if (TasmotaGlobal.stop_flash_rotate || (2 == rotate)) {  // Use eeprom flash slot and erase next flash slots if stop_flash_rotate is off (default)
       settings_location = EEPROM_LOCATION;
     } else {                                           // Rotate flash slots
+#ifdef ESP8266
+      if (SettingsJournal.location) {                  // Keep base and journal valid until new base is written
+        settings_location = SettingsJournal.location;
+      }
+      settings_location = SettingsRotateLocation(settings_location);
+#else
       if (settings_location == EEPROM_LOCATION) {
         settings_location = SETTINGS_LOCATION;
       } else {
@@ -604,15 +841,9 @@ void SettingsSave(uint8_t rotate) {
       if (settings_location <= (SETTINGS_LOCATION - CFG_ROTATES)) {
         settings_location = EEPROM_LOCATION;
       }
+#endif  // ESP8266
     }
 
-    Settings->save_flag++;
-    if (UtcTime() > START_VALID_TIME) {
-      Settings->cfg_timestamp = UtcTime();
-    } else {
-      Settings->cfg_timestamp++;
-    }
-    Settings->cfg_size = sizeof(TSettings);
     Settings->cfg_crc = GetSettingsCrc();               // Keep for backward compatibility in case of fall-back just after upgrade
     Settings->cfg_crc32 = GetSettingsCrc32();
 
@@ -620,8 +851,9 @@ void SettingsSave(uint8_t rotate) {
 #ifdef USE_UFILESYS
     TfsSaveFile(TASM_FILE_SETTINGS, (const uint8_t*)Settings, sizeof(TSettings));
 #endif  // USE_UFILESYS
+    bool written = false;
     if (ESP.flashEraseSector(settings_location)) {
-      ESP.flashWrite(settings_location * SPI_FLASH_SEC_SIZE, (uint32*)Settings, sizeof(TSettings));
+      written = ESP.flashWrite(settings_location * SPI_FLASH_SEC_SIZE, (uint32*)Settings, sizeof(TSettings));
     }
 
     if (!TasmotaGlobal.stop_flash_rotate && rotate) {  // SetOption12 - (Settings) Switch between dynamic (0) or fixed (1) slot flash save location
@@ -630,14 +862,16 @@ void SettingsSave(uint8_t rotate) {
         delay(1);
       }
     }
+    SettingsJournal.location = 0;                      // Start new journal after new base image
+    SettingsJournal.position = 0;
+    SettingsJournalInit(written);
     AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_CONFIG D_SAVED_TO_FLASH_AT " %X, " D_COUNT " %d, " D_BYTES " %d"), settings_location, Settings->save_flag, sizeof(TSettings));
 #endif  // ESP8266
 #ifdef ESP32
     SettingsWrite(Settings, sizeof(TSettings));
+    SettingsJournalInit(false);
     AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_CONFIG "Saved, " D_COUNT " %d, " D_BYTES " %d"), Settings->save_flag, sizeof(TSettings));
 #endif  // ESP32
-
-    settings_crc32 = Settings->cfg_crc32;
   }
 #endif  // FIRMWARE_MINIMAL
   RtcSettingsSave();
@@ -686,6 +920,9 @@ void SettingsLoad(void) {
       ESP.flashRead(settings_location * SPI_FLASH_SEC_SIZE, (uint32*)Settings, sizeof(TSettings));
       AddLog(LOG_LEVEL_NONE, PSTR(D_LOG_CONFIG D_LOADED_FROM_FLASH_AT " %X, " D_COUNT " %lu"), settings_location, Settings->save_flag);
     }
+#ifndef FIRMWARE_MINIMAL
+    SettingsJournalReplay();
+#endif  // FIRMWARE_MINIMAL
   }
 #endif  // ESP8266
 
@@ -700,19 +937,22 @@ void SettingsLoad(void) {
 #endif  // ESP32
 
 #ifndef FIRMWARE_MINIMAL
+  bool base_valid = (settings_location > 0);
   if ((0 == settings_location) || (Settings->cfg_holder != (uint16_t)CFG_HOLDER)) {  // Init defaults if cfg_holder differs from user settings in my_user_config.h
 //  if ((0 == settings_location) || (Settings->cfg_size != sizeof(TSettings)) || (Settings->cfg_holder != (uint16_t)CFG_HOLDER)) {  // Init defaults if cfg_holder differs from user settings in my_user_config.h
 #ifdef USE_UFILESYS
     if (TfsLoadFile(TASM_FILE_SETTINGS_LKG, (uint8_t*)Settings, sizeof(TSettings)) && (Settings->cfg_crc32 == GetSettingsCrc32())) {
       settings_location = 1;
+      base_valid = false;                              // LKG file is not in flash so write full settings first
       AddLog(LOG_LEVEL_NONE, PSTR(D_LOG_CONFIG "Loaded from LKG File, " D_COUNT " %lu"), Settings->save_flag);
     } else
 #endif  // USE_UFILESYS
     {
       SettingsDefault();
+      base_valid = SettingsJournal.base_valid;         // Set by SettingsSave(2)
     }
   }
-  settings_crc32 = GetSettingsCrc32();
+  SettingsJournalInit(base_valid);
 #endif  // FIRMWARE_MINIMAL
 
   RtcSettingsLoad(1);
@@ -135,6 +135,7 @@ String GetResetReason(void) {
 // - if take=false at creat, it will not be initially taken.
 // - name is used in serial log of mutex deadlock.
 // - maxWait in ticks is how long it will wait before failing in a deadlock scenario (and then emitting on serial)
+// - m.failed() tells if the mutex could not be taken within maxWait, the protected code must then be skipped.
 class TasAutoMutex {
   SemaphoreHandle_t mutex;
   bool taken;
@@ -145,11 +146,13 @@ class TasAutoMutex {
     ~TasAutoMutex();
     void give();
     void take();
+    bool failed();
     static void init(SemaphoreHandle_t* ptr);
 };
 //////////////////////////////////////////
 
 TasAutoMutex::TasAutoMutex(SemaphoreHandle_t*mutex, const char *name, int maxWait, bool take) {
+  this->taken = false;
   if (mutex) {
     if (!(*mutex)){
       TasAutoMutex::init(mutex);
@@ -204,6 +207,10 @@ void TasAutoMutex::take() {
   }
 }
 
+bool TasAutoMutex::failed() {
+  return (this->mutex && !this->taken);   // Without mutex there is nothing to wait for
+}
+
 #endif  // ESP32
 
 
@@ -951,7 +958,9 @@ bool DecodeCommand(const char* haystack, void (* const MyCommand[])(void), const
     if (command_code > syn_count) {
       // We passed the synonyms zone, it's a regular command
       XdrvMailbox.command_code = command_code - 1 - syn_count;
+      PROFILE_STATS_START(profile_stats_start);
       MyCommand[XdrvMailbox.command_code]();
+      PROFILE_STATS(PRF_CMND, command_code, FUNC_COMMAND, haystack, profile_stats_start);
     } else {
       // We have a SetOption synonym
       XdrvMailbox.index = pgm_read_byte(synonyms + command_code);
@@ -2019,6 +2028,32 @@ const uint8_t I2C_RETRY_COUNTER = 3;
 uint32_t i2c_active[4] = { 0 };
 uint32_t i2c_buffer = 0;
 
+#if defined(ESP32) && defined(USE_I2C_QUEUE)
+// Created by I2cQueueBegin() and held for a whole transaction by the bus task and by the I2c* helpers
+// below. TwoWire only locks within each call, not across beginTransmission() to the last read().
+// The main loop also holds it while drivers run, as many of them use Wire directly.
+SemaphoreHandle_t i2c_bus_mutex[2] = { nullptr, nullptr };
+bool i2c_bus_held[2] = { false, false };
+#define I2C_BUS_WAIT 200   // ms
+#define I2C_BUS_LOCK(bus, fail) TasAutoMutex i2c_bus_lock((i2c_bus_mutex[(bus) & 1]) ? &i2c_bus_mutex[(bus) & 1] : nullptr, "I2cBus", pdMS_TO_TICKS(I2C_BUS_WAIT)); \
+                                if (i2c_bus_lock.failed()) { fail; }
+
+// Called from the main loop, the bus tasks only get a queued bus during SleepDelay()
+void I2cBusHold(bool hold) {
+  for (uint32_t bus = 0; bus < 2; bus++) {
+    if (!i2c_bus_mutex[bus] || (hold == i2c_bus_held[bus])) { continue; }
+    if (hold) {
+      xSemaphoreTakeRecursive(i2c_bus_mutex[bus], portMAX_DELAY);  // Bus task holds it one transaction at most
+    } else {
+      xSemaphoreGiveRecursive(i2c_bus_mutex[bus]);
+    }
+    i2c_bus_held[bus] = hold;
+  }
+}
+#else
+#define I2C_BUS_LOCK(bus, fail)
+#endif
+
 bool I2cBegin(int sda, int scl, uint32_t frequency = 100000);
 bool I2cBegin(int sda, int scl, uint32_t frequency) {
   bool result = true;
@@ -2058,6 +2093,7 @@ bool I2cValidRead(uint8_t addr, uint8_t reg, uint8_t size)
 #ifdef ESP32
   if (!TasmotaGlobal.i2c_enabled_2) { bus = 0; }
   TwoWire & myWire = (bus == 0) ? Wire : Wire1;
+  I2C_BUS_LOCK(bus, return false);
 #else
   TwoWire & myWire = Wire;
 #endif
@@ -2173,6 +2209,7 @@ bool I2cWrite(uint8_t addr, uint8_t reg, uint32_t val, uint8_t size)
 #ifdef ESP32
   if (!TasmotaGlobal.i2c_enabled_2) { bus = 0; }
   TwoWire & myWire = (bus == 0) ? Wire : Wire1;
+  I2C_BUS_LOCK(bus, return false);
 #else
   TwoWire & myWire = Wire;
 #endif
@@ -2201,6 +2238,7 @@ bool I2cWrite16(uint8_t addr, uint8_t reg, uint16_t val)
 
 int8_t I2cReadBuffer(uint8_t addr, uint8_t reg, uint8_t *reg_data, uint16_t len)
 {
+  I2C_BUS_LOCK(0, return 1);
   Wire.beginTransmission((uint8_t)addr);
   Wire.write((uint8_t)reg);
   Wire.endTransmission();
@@ -2216,6 +2254,7 @@ int8_t I2cReadBuffer(uint8_t addr, uint8_t reg, uint8_t *reg_data, uint16_t len)
 
 int8_t I2cWriteBuffer(uint8_t addr, uint8_t reg, uint8_t *reg_data, uint16_t len)
 {
+  I2C_BUS_LOCK(0, return 1);
   Wire.beginTransmission((uint8_t)addr);
   Wire.write((uint8_t)reg);
   while (len--) {
@@ -2244,6 +2283,7 @@ void I2cScan(uint32_t bus) {
 #ifdef ESP32
     if (!TasmotaGlobal.i2c_enabled_2) { bus = 0; }
     TwoWire & myWire = (bus == 0) ? Wire : Wire1;
+    I2C_BUS_LOCK(bus, any = 2; Response_P(PSTR("{\"" D_CMND_I2CSCAN "\":\"Error bus locked")); break);
 #else
     TwoWire & myWire = Wire;
 #endif
@@ -2323,6 +2363,7 @@ bool I2cSetDevice(uint32_t addr)
 #ifdef ESP32
   if (!TasmotaGlobal.i2c_enabled_2) { bus = 0; }
   TwoWire & myWire = (bus == 0) ? Wire : Wire1;
+  I2C_BUS_LOCK(bus, return false);
 #else
   TwoWire & myWire = Wire;
 #endif
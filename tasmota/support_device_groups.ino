@@ -28,8 +28,12 @@
 #define DGR_ACK_WAIT_TIME           150     // Initial ms to wait for ack's
 #define DGR_MEMBER_TIMEOUT          45000   // ms to wait for ack's before removing a member
 #define DGR_ANNOUNCEMENT_INTERVAL   60000   // ms between announcements
+#define DGR_COALESCE_TIME           40      // ms to collect state updates into one packet
 #define DEVICE_GROUP_MESSAGE        "TASMOTA_DGR"
 
+// Number of integer state items whose last value is remembered per group
+#define DGR_VALUE_SLOTS             (DGR_ITEM_LAST_8BIT + (DGR_ITEM_LAST_16BIT - DGR_ITEM_MAX_8BIT - 1) + (DGR_ITEM_LAST_32BIT - DGR_ITEM_MAX_16BIT - 1))
+
 const char kDeviceGroupMessage[] PROGMEM = DEVICE_GROUP_MESSAGE;
 
 struct device_group_member {
@@ -45,6 +49,15 @@ struct device_group {
   uint32_t next_ack_check_time;
   uint32_t member_timeout_time;
   uint32_t no_status_share;
+  uint32_t coalesce_time;
+  uint32_t sent_count;
+  uint32_t suppressed_count;
+  uint32_t retry_count;
+  uint32_t duplicate_count;
+  uint32_t last_values[DGR_VALUE_SLOTS];
+  uint32_t last_values_valid;
+  uint8_t last_channels[6];
+  uint8_t coalesce_type;
   uint16_t outgoing_sequence;
   uint16_t last_full_status_sequence;
   uint16_t message_length;
@@ -108,6 +121,56 @@ uint32_t DeviceGroupSharedMask(uint8_t item)
   return mask;
 }
 
+// Get the last_values slot of a state item or -1 if the item is not state (events, commands, ...).
+// DGR_VALUE_SLOTS is the slot of the light channels.
+int32_t DeviceGroupValueSlot(uint8_t item)
+{
+  if (item < DGR_ITEM_LAST_8BIT) return (item > DGR_ITEM_FLAGS ? item : -1);
+  if (item > DGR_ITEM_MAX_8BIT && item < DGR_ITEM_LAST_16BIT) return DGR_ITEM_LAST_8BIT + item - DGR_ITEM_MAX_8BIT - 1;
+  if (item == DGR_ITEM_POWER) return DGR_ITEM_LAST_8BIT + DGR_ITEM_LAST_16BIT - DGR_ITEM_MAX_8BIT - 1 + item - DGR_ITEM_MAX_16BIT - 1;
+  if (item == DGR_ITEM_LIGHT_CHANNELS) return DGR_VALUE_SLOTS;
+  return -1;
+}
+
+// Check if a state item has the last known group value.
+bool DeviceGroupValueKnown(struct device_group * device_group, uint8_t item, uint32_t value, const uint8_t * data)
+{
+  int32_t slot = DeviceGroupValueSlot(item);
+  if (slot < 0 || !(device_group->last_values_valid & (1 << slot))) return false;
+  if (slot == DGR_VALUE_SLOTS) return !memcmp(device_group->last_channels, data, sizeof(device_group->last_channels));
+  if (item <= DGR_ITEM_MAX_8BIT)
+    value &= 0xff;
+  else if (item <= DGR_ITEM_MAX_16BIT)
+    value &= 0xffff;
+  return (device_group->last_values[slot] == value);
+}
+
+// Save the last known group value of a state item. Returns true if the value did not change.
+bool DeviceGroupValueUpdate(struct device_group * device_group, uint8_t item, uint32_t value, const uint8_t * data)
+{
+  int32_t slot = DeviceGroupValueSlot(item);
+  if (slot < 0) return false;
+  bool same = DeviceGroupValueKnown(device_group, item, value, data);
+  if (slot == DGR_VALUE_SLOTS) {
+    memcpy(device_group->last_channels, data, sizeof(device_group->last_channels));
+  }
+  else {
+    if (item <= DGR_ITEM_MAX_8BIT)
+      value &= 0xff;
+    else if (item <= DGR_ITEM_MAX_16BIT)
+      value &= 0xffff;
+    device_group->last_values[slot] = value;
+  }
+  device_group->last_values_valid |= 1 << slot;
+  return same;
+}
+
+void DeviceGroupValueForget(struct device_group * device_group, uint8_t item)
+{
+  int32_t slot = DeviceGroupValueSlot(item);
+  if (slot >= 0) device_group->last_values_valid &= ~(1 << slot);
+}
+
 void DeviceGroupsInit(void)
 {
   // If no module set the device group count, ...
@@ -190,6 +253,8 @@ void DeviceGroupsStart()
     struct device_group * device_group = device_groups;
     for (uint32_t device_group_index = 0; device_group_index < device_group_count; device_group_index++, device_group++) {
       device_group->next_announcement_time = -1;
+      device_group->coalesce_time = 0;
+      device_group->last_values_valid = 0;
       device_group->message_length = BeginDeviceGroupMessage(device_group, DGR_FLAG_RESET | DGR_FLAG_STATUS_REQUEST) - device_group->message;
       device_group->initial_status_requests_remaining = 10;
       device_group->next_ack_check_time = next_check_time;
@@ -395,6 +460,16 @@ void SendReceiveDeviceGroupMessage(struct device_group * device_group, struct de
         device_group->no_status_share &= ~mask;
 
       if ((!(device_group->no_status_share & mask) || device_group_member == nullptr) && (!mask || (mask & Settings->device_group_share_in))) {
+
+        // If a member repeats state we already applied, skip it.
+        if (device_group_member && DeviceGroupValueUpdate(device_group, item, value, (uint8_t *)XdrvMailbox.data)) {
+          device_group->duplicate_count++;
+          *log_ptr++ = '=';
+          log_remaining--;
+          item_flags = 0;
+          continue;
+        }
+
         item_processed = true;
         XdrvMailbox.command_code = item;
         XdrvMailbox.payload = value;
@@ -434,6 +509,9 @@ void SendReceiveDeviceGroupMessage(struct device_group * device_group, struct de
         }
         XdrvCall(FUNC_DEVICE_GROUP_ITEM);
       }
+      else {
+        DeviceGroupValueForget(device_group, item);
+      }
       item_flags = 0;
     }
 
@@ -468,6 +546,7 @@ write_log:
       }
       delay(10);
     }
+    device_group->sent_count++;
     if (attempt > 5) AddLog(LOG_LEVEL_ERROR, PSTR("DGR: Error sending message"));
   }
   goto cleanup;
@@ -512,7 +591,10 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
   struct device_group * device_group = &device_groups[device_group_index];
 
   // If we're still sending initial status requests, ignore this request.
-  if (device_group->initial_status_requests_remaining) return 1;
+  if (device_group->initial_status_requests_remaining) {
+    device_group->last_values_valid = 0;
+    return 1;
+  }
 
   // Load the message header, sequence and flags.
 #ifdef DEVICE_GROUPS_DEBUG
@@ -524,7 +606,7 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
     flags = DGR_FLAG_MORE_TO_COME;
   else if (message_type == DGR_MSGTYP_UPDATE_DIRECT)
     flags = DGR_FLAG_DIRECT;
-  uint8_t * message_ptr = BeginDeviceGroupMessage(device_group, flags, building_status_message || message_type == DGR_MSGTYP_PARTIAL_UPDATE);
+  uint8_t * message_ptr = BeginDeviceGroupMessage(device_group, flags, building_status_message || message_type == DGR_MSGTYP_PARTIAL_UPDATE || device_group->coalesce_time);
 
   // A full status request is a request from a remote device for the status of every item we
   // control. As long as we're building it, we may as well multicast the status update to all
@@ -532,6 +614,7 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
   if (message_type == DGR_MSGTYP_FULL_STATUS) {
     device_group->last_full_status_sequence = device_group->outgoing_sequence;
     device_group->message_length = 0;
+    device_group->coalesce_time = 0;    // A pending update is superseded by the full status
 
     // Set the flag indicating we're currently building a status message. SendDeviceGroupMessage
     // will build but not send messages while this flag is set.
@@ -582,6 +665,7 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
     uint8_t * value_ptr;
     uint8_t * first_item_ptr = message_ptr;
     struct item * item_ptr;
+    bool coalesce = (message_type == DGR_MSGTYP_UPDATE || message_type == DGR_MSGTYP_UPDATE_MORE_TO_COME) && !with_local;
     va_list ap;
 
     // Build an array of all the items and values in this update.
@@ -685,6 +769,24 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
 #endif  // USE_DEVICE_GROUPS_SEND
     item_ptr->item = 0;
 
+    // Drop the state items whose value the group already has so only changed items are sent.
+    // Items changed since the last acknowledged update are carried over from the pending message
+    // below. Status messages and commands are sent as is.
+    struct item * keep_ptr = item_array;
+    for (item_ptr = item_array; (item = item_ptr->item); item_ptr++) {
+
+      // For the power item, the device count is overlayed onto the highest 8 bits.
+      if (item == DGR_ITEM_POWER && !(item_ptr->value >> 24)) item_ptr->value |= (!Settings->flag4.multiple_device_groups && device_group_index == 0 && first_device_group_is_local ? TasmotaGlobal.devices_present : 1) << 24;
+      if (message_type != DGR_MSGTYPE_UPDATE_COMMAND && !with_local && !building_status_message && !item_ptr->flags &&
+          !(DeviceGroupSharedMask(item) & device_group->no_status_share) &&
+          DeviceGroupValueKnown(device_group, item, item_ptr->value, (item == DGR_ITEM_LIGHT_CHANNELS ? (uint8_t *)item_ptr->value_ptr : nullptr))) {
+        continue;
+      }
+      *keep_ptr++ = *item_ptr;
+    }
+    keep_ptr->item = 0;
+    if (keep_ptr == item_array && item_ptr != item_array && !device_group->message_length) device_group->suppressed_count++;
+
     // If we're still building this update or all group members haven't acknowledged the previous
     // update yet, update the message to include these new updates. First we need to rebuild the
     // previous update message to remove any items and their values that are included in this new
@@ -749,6 +851,9 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
     // Itertate through the passed items adding them and their values to the message.
     for (item_ptr = item_array; (item = item_ptr->item); item_ptr++) {
 
+      // Only state items can be coalesced, events and commands must all be delivered.
+      if (DeviceGroupValueSlot(item) < 0 && item != DGR_ITEM_NO_STATUS_SHARE) coalesce = false;
+
       // If this item is shared with the group add it to the message.
       shared = true;
       if ((mask = DeviceGroupSharedMask(item))) {
@@ -770,17 +875,13 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
         // For integer items, add the value to the message.
         if (item <= DGR_ITEM_MAX_32BIT) {
           value = item_ptr->value;
+          DeviceGroupValueUpdate(device_group, item, value, nullptr);
           *message_ptr++ = value & 0xff;
           if (item > DGR_ITEM_MAX_8BIT) {
-            value >>= 8;
-            *message_ptr++ = value & 0xff;
+            *message_ptr++ = (value >> 8) & 0xff;
             if (item > DGR_ITEM_MAX_16BIT) {
-              value >>= 8;
-              *message_ptr++ = value & 0xff;
-              value >>= 8;
-              // For the power item, the device count is overlayed onto the highest 8 bits.
-              if (item == DGR_ITEM_POWER && !value) value = (!Settings->flag4.multiple_device_groups && device_group_index == 0 && first_device_group_is_local ? TasmotaGlobal.devices_present : 1);
-              *message_ptr++ = value;
+              *message_ptr++ = (value >> 16) & 0xff;
+              *message_ptr++ = value >> 24;
             }
           }
         }
@@ -802,8 +903,14 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
           *message_ptr++ = value;
           memcpy(message_ptr, item_ptr->value_ptr, value);
           message_ptr += value;
+          if (item == DGR_ITEM_LIGHT_CHANNELS) DeviceGroupValueUpdate(device_group, item, 0, (uint8_t *)item_ptr->value_ptr);
         }
       }
+
+      // If this item is not shared, our state no longer matches the group's.
+      else {
+        DeviceGroupValueForget(device_group, item);
+      }
     }
 
     // If we added any items, add the EOL item code and calculate the message length.
@@ -814,6 +921,21 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
 
     // If there's going to be more items added to this message, return.
     if (building_status_message || message_type == DGR_MSGTYP_PARTIAL_UPDATE) return 0;
+
+    // Coalesce state updates sent in quick succession, e.g. while sliding a dimmer, into one
+    // packet sent from DeviceGroupsLoop.
+    if (coalesce && device_group->message_length) {
+      if (device_group->coalesce_time) {
+        device_group->suppressed_count++;
+      }
+      else {
+        device_group->coalesce_time = millis() + DGR_COALESCE_TIME;
+        if (!device_group->coalesce_time) device_group->coalesce_time = 1;
+        if ((int32_t)(next_check_time - device_group->coalesce_time) > 0) next_check_time = device_group->coalesce_time;
+      }
+      device_group->coalesce_type = message_type;
+      return 0;
+    }
   }
 
   // If there is no message, restore the sequence number and return.
@@ -822,6 +944,14 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
     return 0;
   }
 
+  DeviceGroupSendUpdate(device_group, message_type, with_local);
+  return 0;
+}
+
+void DeviceGroupSendUpdate(struct device_group * device_group, uint8_t message_type, bool with_local)
+{
+  device_group->coalesce_time = 0;
+
   // Multicast the packet.
   device_group->multicasts_remaining = DGR_MULTICAST_REPEAT_COUNT;
   SendReceiveDeviceGroupMessage(device_group, nullptr, device_group->message, device_group->message_length, false);
@@ -849,7 +979,6 @@ bool _SendDeviceGroupMessage(int32_t device, DevGroupMessageType message_type, .
 
   device_group->next_announcement_time = now + DGR_ANNOUNCEMENT_INTERVAL;
   if ((int32_t)(next_check_time - device_group->next_announcement_time) > 0) next_check_time = device_group->next_announcement_time;
-  return 0;
 }
 
 void ProcessDeviceGroupMessage(uint8_t * message, int message_length)
@@ -903,7 +1032,8 @@ void DeviceGroupStatus(uint8_t device_group_index)
       snprintf_P(buffer, sizeof(buffer), PSTR("%s,{\"IPAddress\":\"%s\",\"ResendCount\":%u,\"LastRcvdSeq\":%u,\"LastAckedSeq\":%u}"), buffer, IPAddressToString(device_group_member->ip_address), device_group_member->unicast_count, device_group_member->received_sequence, device_group_member->acked_sequence);
       member_count++;
     }
-    Response_P(PSTR("{\"" D_CMND_DEVGROUPSTATUS "\":{\"Index\":%u,\"GroupName\":\"%s\",\"MessageSeq\":%u,\"MemberCount\":%d,\"Members\":[%s]}}"), device_group_index, device_group->group_name, device_group->outgoing_sequence, member_count, &buffer[1]);
+    Response_P(PSTR("{\"" D_CMND_DEVGROUPSTATUS "\":{\"Index\":%u,\"GroupName\":\"%s\",\"MessageSeq\":%u,\"Sent\":%u,\"Suppressed\":%u,\"Retried\":%u,\"Duplicates\":%u,\"MemberCount\":%d,\"Members\":[%s]}}"),
+      device_group_index, device_group->group_name, device_group->outgoing_sequence, device_group->sent_count, device_group->suppressed_count, device_group->retry_count, device_group->duplicate_count, member_count, &buffer[1]);
   }
 }
 
@@ -934,6 +1064,16 @@ AddLog(LOG_LEVEL_DEBUG, PSTR("DGR: Checking next_check_time=%u, now=%u"), next_c
     struct device_group * device_group = device_groups;
     for (uint32_t device_group_index = 0; device_group_index < device_group_count; device_group_index++, device_group++) {
 
+      // If a coalesced update is due, send it. Until then, it replaces any resend of the previous
+      // update.
+      if (device_group->coalesce_time) {
+        if ((int32_t)(now - device_group->coalesce_time) < 0) {
+          if ((int32_t)(next_check_time - device_group->coalesce_time) > 0) next_check_time = device_group->coalesce_time;
+          continue;
+        }
+        DeviceGroupSendUpdate(device_group, device_group->coalesce_type, false);
+      }
+
       // If we're still waiting for acks to the last update from this device group, ...
       if (device_group->next_ack_check_time) {
 
@@ -985,6 +1125,7 @@ AddLog(LOG_LEVEL_DEBUG, PSTR("DGR: Checking next_check_time=%u, now=%u"), next_c
                 // otherwise, unicast the message directly to this member.
                 if (device_group->multicasts_remaining) device_group_member = nullptr;
                 SendReceiveDeviceGroupMessage(device_group, device_group_member, device_group->message, device_group->message_length, false);
+                device_group->retry_count++;
                 acked = false;
                 if (device_group->multicasts_remaining) {
                   device_group->multicasts_remaining--;
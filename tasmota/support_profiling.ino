@@ -50,11 +50,7 @@
  * Profiling services
 \*********************************************************************************************/
 
-#ifdef USE_PROFILING
-
-#ifndef PROFILE_THRESHOLD
-#define PROFILE_THRESHOLD            70       // Minimum duration in milliseconds to start logging
-#endif
+#if defined(USE_PROFILING) || defined(USE_PROFILE_STATS)
 
 // Below needs to be inline with enum XsnsFunctions
 const char kXSnsFunctions[] PROGMEM = "SETTINGS_OVERRIDE|PIN_STATE|MODULE_INIT|PRE_INIT|INIT|"
@@ -64,10 +60,18 @@ const char kXSnsFunctions[] PROGMEM = "SETTINGS_OVERRIDE|PIN_STATE|MODULE_INIT|P
                                       "MQTT_SUBSCRIBE|MQTT_INIT|MQTT_DATA|"
                                       "SET_POWER|SET_DEVICE_POWER|SHOW_SENSOR|ANY_KEY|"
                                       "ENERGY_EVERY_SECOND|ENERGY_RESET|"
-                                      "RULES_PROCESS|TELEPERIOD_RULES_PROCESS|SERIAL|FREE_MEM|BUTTON_PRESSED|"
+                                      "RULES_PROCESS|TELEPERIOD_RULES_PROCESS|SERIAL|FREE_MEM|BUTTON_PRESSED|BUTTON_MULTI_PRESSED|"
                                       "WEB_ADD_BUTTON|WEB_ADD_CONSOLE_BUTTON|WEB_ADD_MANAGEMENT_BUTTON|WEB_ADD_MAIN_BUTTON|"
-                                      "WEB_ADD_HANDLER|SET_CHANNELS|SET_SCHEME|HOTPLUG_SCAN|"
-                                      "DEVICE_GROUP_ITEM";
+                                      "WEB_GET_ARG|WEB_ADD_HANDLER|SET_CHANNELS|SET_SCHEME|HOTPLUG_SCAN|"
+                                      "DEVICE_GROUP_ITEM|TICK_MASK";
+
+#endif  // USE_PROFILING or USE_PROFILE_STATS
+
+#ifdef USE_PROFILING
+
+#ifndef PROFILE_THRESHOLD
+#define PROFILE_THRESHOLD            70       // Minimum duration in milliseconds to start logging
+#endif
 
 #ifdef USE_PROFILE_DRIVER
 void AddLogDriver(const char *driver, uint8_t function, uint32_t start) {
@@ -90,3 +94,208 @@ void AddLogFunction(const char *driver, uint8_t index, uint8_t function, uint32_
 #endif  // USE_PROFILE_DRIVER
 
 #endif  // USE_PROFILING
+
+/*********************************************************************************************\
+ * Runtime statistics per driver function, Berry event and command
+ *
+ * Durations are measured with the cpu cycle counter and aggregated per (type, index, function)
+ * in count, total, max and a histogram of log2 microseconds. The table is only allocated while
+ * enabled so the cost when disabled is a cycle count read and a call per driver function.
+ *
+ * Profile    - Show status and busiest entries by total time
+ * Profile 0  - Disable and free statistics
+ * Profile 1  - Enable statistics
+ * Profile 2  - Reset statistics
+\*********************************************************************************************/
+
+#ifdef USE_PROFILE_STATS
+
+#ifndef PROFILE_STATS_SLOTS
+#ifdef ESP8266
+#define PROFILE_STATS_SLOTS          48       // Max (driver, function) entries
+#else
+#define PROFILE_STATS_SLOTS          128      // Max (driver, function) entries
+#endif
+#endif
+#ifndef PROFILE_STATS_TOP
+#define PROFILE_STATS_TOP            10       // Entries shown by command Profile
+#endif
+#define PROFILE_STATS_WEB_TOP        5        // Entries shown on web Information page
+#define PROFILE_STATS_BUCKETS        16       // <1us, <2us, <4us, ... <16ms, >=16ms
+#define PROFILE_STATS_FREE           0xFF
+
+typedef struct {
+  const char *name;                           // Command table or Berry event, nullptr for drivers
+  uint64_t total;                             // Cycles
+  uint32_t max;                               // Cycles
+  uint32_t count;
+  uint16_t buckets[PROFILE_STATS_BUCKETS];    // Saturating counts per log2 microseconds
+  uint8_t type;                               // ProfileStatsTypes or PROFILE_STATS_FREE
+  uint8_t index;                              // Driver number or command code
+  uint8_t function;                           // FUNC_*
+} PROFILE_STATS;
+
+struct {
+  PROFILE_STATS *table = nullptr;
+  uint32_t start;                             // Uptime when statistics were started
+  uint32_t dropped;                           // Samples lost as table was full
+  uint32_t mhz;
+} ProfileStats;
+
+void ProfileStatsReset(void) {
+  if (!ProfileStats.table) { return; }
+  memset(ProfileStats.table, 0, PROFILE_STATS_SLOTS * sizeof(PROFILE_STATS));
+  for (uint32_t i = 0; i < PROFILE_STATS_SLOTS; i++) {
+    ProfileStats.table[i].type = PROFILE_STATS_FREE;
+  }
+  ProfileStats.start = TasmotaGlobal.uptime;
+  ProfileStats.dropped = 0;
+  ProfileStats.mhz = ESP.getCpuFreqMHz();
+}
+
+void ProfileStatsEnable(bool enable) {
+  if (enable && !ProfileStats.table) {
+    ProfileStats.table = (PROFILE_STATS*)malloc(PROFILE_STATS_SLOTS * sizeof(PROFILE_STATS));
+    ProfileStatsReset();
+  }
+  else if (!enable && ProfileStats.table) {
+    free(ProfileStats.table);
+    ProfileStats.table = nullptr;
+  }
+}
+
+void ProfileStatsAdd(uint32_t type, uint32_t index, uint32_t function, const char *name, uint32_t start) {
+  uint32_t cycles = ESP.getCycleCount() - start;
+  if (!ProfileStats.table) { return; }
+
+  // Open addressing on (type, index, function, name)
+  uint32_t slot = ((type * 31 + index) * 31 + function + (uint32_t)name) % PROFILE_STATS_SLOTS;
+  PROFILE_STATS *entry = nullptr;
+  for (uint32_t i = 0; i < PROFILE_STATS_SLOTS; i++) {
+    PROFILE_STATS *probe = &ProfileStats.table[slot];
+    if (PROFILE_STATS_FREE == probe->type) {
+      probe->type = type;
+      probe->index = index;
+      probe->function = function;
+      probe->name = name;
+      entry = probe;
+      break;
+    }
+    if ((probe->type == type) && (probe->index == index) && (probe->function == function) && (probe->name == name)) {
+      entry = probe;
+      break;
+    }
+    if (++slot == PROFILE_STATS_SLOTS) { slot = 0; }
+  }
+  if (!entry) {
+    ProfileStats.dropped++;
+    return;
+  }
+
+  entry->count++;
+  entry->total += cycles;
+  if (cycles > entry->max) { entry->max = cycles; }
+  uint32_t micros = cycles / ProfileStats.mhz;
+  uint32_t bucket = (micros) ? 32 - __builtin_clz(micros) : 0;
+  if (bucket >= PROFILE_STATS_BUCKETS) { bucket = PROFILE_STATS_BUCKETS -1; }
+  if (entry->buckets[bucket] < 0xFFFF) { entry->buckets[bucket]++; }
+}
+
+char* ProfileStatsName(char* name, size_t size, PROFILE_STATS *entry) {
+  char stemp1[24];
+  switch (entry->type) {
+    case PRF_DRV:
+    case PRF_SNS:
+      snprintf_P(name, size, PSTR("%s%02d %s"), (PRF_DRV == entry->type) ? "drv" : "sns", entry->index,
+        GetTextIndexed(stemp1, sizeof(stemp1), entry->function, kXSnsFunctions));
+      break;
+    case PRF_CMND: {
+      char prefix[CMDSZ];
+      GetTextIndexed(prefix, sizeof(prefix), 0, entry->name);
+      snprintf_P(name, size, PSTR("cmnd %s%s"), prefix, GetTextIndexed(stemp1, sizeof(stemp1), entry->index, entry->name));
+      break;
+    }
+    case PRF_BERRY:               // `index` > 0 is a position in list `name`
+      snprintf_P(name, size, PSTR("be %s"), (entry->index) ? GetTextIndexed(stemp1, sizeof(stemp1), entry->index -1, entry->name) : entry->name);
+      break;
+  }
+  return name;
+}
+
+// Fill `top` with table positions of the busiest entries by total time, returns number found
+uint32_t ProfileStatsTop(uint8_t *top, uint32_t count) {
+  uint32_t found = 0;
+  uint64_t below = UINT64_MAX;
+  while (found < count) {
+    int32_t best = -1;
+    for (uint32_t i = 0; i < PROFILE_STATS_SLOTS; i++) {
+      PROFILE_STATS *entry = &ProfileStats.table[i];
+      if ((PROFILE_STATS_FREE == entry->type) || (entry->total >= below)) { continue; }
+      if ((best < 0) || (entry->total > ProfileStats.table[best].total)) { best = i; }
+    }
+    if (best < 0) { break; }
+    top[found++] = best;
+    below = ProfileStats.table[best].total;   // Entries with equal totals are shown once
+  }
+  return found;
+}
+
+void CmndProfile(void) {
+  if (XdrvMailbox.data_len > 0) {
+    switch (XdrvMailbox.payload) {
+      case 0:
+      case 1:
+        ProfileStatsEnable(XdrvMailbox.payload);
+        break;
+      case 2:
+        ProfileStatsReset();
+        break;
+    }
+  }
+  Response_P(PSTR("{\"" D_CMND_PROFILE "\":{\"Enabled\":%d"), (ProfileStats.table != nullptr));
+  if (ProfileStats.table) {
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < PROFILE_STATS_SLOTS; i++) {
+      if (ProfileStats.table[i].type != PROFILE_STATS_FREE) { used++; }
+    }
+    ResponseAppend_P(PSTR(",\"Period\":%d,\"Entries\":%d,\"Dropped\":%d,\"Top\":{"),
+      TasmotaGlobal.uptime - ProfileStats.start, used, ProfileStats.dropped);
+    // "drv52 EVERY_50_MSECOND":[count,total ms,max us,[histogram of log2 us]]
+    uint8_t top[PROFILE_STATS_TOP];
+    uint32_t found = ProfileStatsTop(top, PROFILE_STATS_TOP);
+    for (uint32_t i = 0; i < found; i++) {
+      if (ResponseLength() > ResponseSize() - 160) { break; }    // Leave room for a full entry
+      PROFILE_STATS *entry = &ProfileStats.table[top[i]];
+      char name[40];
+      ResponseAppend_P(PSTR("%s\"%s\":[%d,%d,%d,["), (i) ? "," : "", ProfileStatsName(name, sizeof(name), entry),
+        entry->count, (uint32_t)(entry->total / (ProfileStats.mhz * 1000)), entry->max / ProfileStats.mhz);
+      uint32_t last = PROFILE_STATS_BUCKETS;
+      while ((last > 1) && !entry->buckets[last -1]) { last--; }
+      for (uint32_t j = 0; j < last; j++) {
+        ResponseAppend_P(PSTR("%s%d"), (j) ? "," : "", entry->buckets[j]);
+      }
+      ResponseAppend_P(PSTR("]]"));
+    }
+    ResponseAppend_P(PSTR("}"));
+  }
+  ResponseJsonEnd();
+}
+
+#ifdef USE_WEBSERVER
+void ProfileStatsWebInfo(void) {
+  if (!ProfileStats.table) { return; }
+  WSContentSend_P(PSTR("}1}2&nbsp;"));  // Empty line
+  uint32_t period = TasmotaGlobal.uptime - ProfileStats.start;
+  uint8_t top[PROFILE_STATS_WEB_TOP];
+  uint32_t found = ProfileStatsTop(top, PROFILE_STATS_WEB_TOP);
+  for (uint32_t i = 0; i < found; i++) {
+    PROFILE_STATS *entry = &ProfileStats.table[top[i]];
+    char name[40];
+    uint32_t total_ms = entry->total / (ProfileStats.mhz * 1000);
+    WSContentSend_P(PSTR("}1%s}2%d ms/min, max %d us"), ProfileStatsName(name, sizeof(name), entry),
+      (period) ? (uint32_t)((uint64_t)total_ms * 60 / period) : total_ms, entry->max / ProfileStats.mhz);
+  }
+}
+#endif  // USE_WEBSERVER
+
+#endif  // USE_PROFILE_STATS
@@ -23,6 +23,12 @@
 #define UDP_BUFFER_SIZE         120      // Max UDP buffer size needed for M-SEARCH message
 #endif
 #define UDP_MSEARCH_DEBOUNCE  300        // Don't send new response if same request within 300 ms
+#ifndef UDP_MSEARCH_MAX_DELAY
+#define UDP_MSEARCH_MAX_DELAY 500        // Max random delay in ms of M-SEARCH replies, further bound by the request MX
+#endif
+#ifndef UDP_REPLIES_PER_LOOP
+#define UDP_REPLIES_PER_LOOP  4          // Max M-SEARCH reply packets sent per loop
+#endif
 
 uint32_t  udp_last_received = 0;         // timestamp of last udp received packet
                                          // if non-zero we keep silend and don't send response
@@ -33,6 +39,19 @@ uint16_t udp_remote_port;                // M-Search remote port
 
 bool udp_connected = false;
 
+enum UdpSsdpReplies { UDP_REPLY_NONE, UDP_REPLY_WEMO1, UDP_REPLY_WEMO2, UDP_REPLY_HUE };
+
+// M-SEARCH reply scheduled after a random delay, sent one packet at a time from PollUdp
+struct {
+  uint32_t due;                          // millis when next packet is sent
+  uint8_t type;                          // UdpSsdpReplies
+  uint8_t index;                         // next packet or emulated device to reply for
+} UdpReply;
+
+#ifdef ESP32
+char udp_packet_buffer[UDP_BUFFER_SIZE]; // buffer to hold incoming UDP/SSDP packet
+#endif
+
 #ifdef ESP8266
 #ifndef UDP_MAX_PACKETS
 #define UDP_MAX_PACKETS   3             // we support x more packets than the current one
@@ -52,6 +71,104 @@ const char UPNP_ROOTDEVICE[] PROGMEM = "upnp:rootdevice";
 const char SSDPSEARCH_ALL[] PROGMEM = "ssdpsearch:all";
 const char SSDP_ALL[] PROGMEM = "ssdp:all";
 
+/*********************************************************************************************\
+ * SSDP header matching in place, without changing or copying the packet
+\*********************************************************************************************/
+
+// Find value of header `name_P` (case insensitive), returns value length or -1 if not found
+int32_t UdpSsdpHeader(const char *packet, const char *name_P, const char **value)
+{
+  uint32_t name_len = strlen_P(name_P);
+  const char *line = packet;
+  while (line && *line) {
+    if (!strncasecmp_P(line, name_P, name_len) && (':' == line[name_len])) {
+      const char *start = line + name_len + 1;
+      while ((' ' == *start) || ('\t' == *start)) { start++; }
+      const char *end = start;
+      while (*end && ('\r' != *end) && ('\n' != *end)) { end++; }
+      while ((end > start) && (' ' == *(end -1))) { end--; }
+      *value = start;
+      return end - start;
+    }
+    line = strchr(line, '\n');
+    if (line) { line++; }
+  }
+  return -1;
+}
+
+// Check if `value` of `len` chars contains `target_P` (case insensitive)
+bool UdpSsdpMatch(const char *value, int32_t len, const char *target_P)
+{
+  int32_t target_len = strlen_P(target_P);
+  for (int32_t i = 0; i <= len - target_len; i++) {
+    if (!strncasecmp_P(value + i, target_P, target_len)) { return true; }
+  }
+  return false;
+}
+
+// Find which reply an M-SEARCH packet needs, if any
+uint32_t UdpSsdpReplyType(const char *packet)
+{
+  const char *st;
+  int32_t st_len = UdpSsdpHeader(packet, PSTR("ST"), &st);
+  if (st_len <= 0) { return UDP_REPLY_NONE; }
+  bool search_all = UdpSsdpMatch(st, st_len, UPNP_ROOTDEVICE) ||
+                    UdpSsdpMatch(st, st_len, SSDPSEARCH_ALL) ||
+                    UdpSsdpMatch(st, st_len, SSDP_ALL);
+#ifdef USE_EMULATION_WEMO
+  if (EMUL_WEMO == Settings->flag2.emulation) {
+    if (UdpSsdpMatch(st, st_len, URN_BELKIN_DEVICE)) { return UDP_REPLY_WEMO1; }  // type1 echo dot 2g, echo 1g's
+    if (search_all) { return UDP_REPLY_WEMO2; }                                   // type2 Echo 2g (echo & echo plus)
+  }
+#endif  // USE_EMULATION_WEMO
+#ifdef USE_EMULATION_HUE
+  if (EMUL_HUE == Settings->flag2.emulation) {
+    AddLog(LOG_LEVEL_DEBUG_MORE, PSTR("UDP: HUE"));
+    if (search_all || UdpSsdpMatch(st, st_len, PSTR(":device:basic:1"))) { return UDP_REPLY_HUE; }
+  }
+#endif  // USE_EMULATION_HUE
+  return UDP_REPLY_NONE;
+}
+
+void UdpScheduleReply(uint32_t type, const char *packet)
+{
+  // Reply after a random delay within MX seconds as per UPnP spec, capped to UDP_MSEARCH_MAX_DELAY
+  uint32_t max_delay = UDP_MSEARCH_MAX_DELAY;
+  const char *mx;
+  if (UdpSsdpHeader(packet, PSTR("MX"), &mx) > 0) {
+    uint32_t mx_delay = atoi(mx) * 1000;
+    if (mx_delay < max_delay) { max_delay = mx_delay; }
+  }
+  UdpReply.due = millis() + ((max_delay) ? random(max_delay) : 0);
+  UdpReply.type = type;
+  UdpReply.index = 0;
+}
+
+void UdpSendReplies(void)
+{
+  for (uint32_t i = 0; i < UDP_REPLIES_PER_LOOP; i++) {
+    bool more = false;
+    switch (UdpReply.type) {
+#ifdef USE_EMULATION_WEMO
+      case UDP_REPLY_WEMO1:
+      case UDP_REPLY_WEMO2:
+        more = WemoRespondToMSearch((UDP_REPLY_WEMO1 == UdpReply.type) ? 1 : 2, UdpReply.index);
+        break;
+#endif  // USE_EMULATION_WEMO
+#ifdef USE_EMULATION_HUE
+      case UDP_REPLY_HUE:
+        more = HueRespondToMSearch(UdpReply.index);
+        break;
+#endif  // USE_EMULATION_HUE
+    }
+    UdpReply.index++;
+    if (!more) {
+      UdpReply.type = UDP_REPLY_NONE;
+      return;
+    }
+  }
+}
+
 /*********************************************************************************************\
  * UDP support routines
 \*********************************************************************************************/
@@ -73,6 +190,7 @@ bool UdpDisconnect(void)
 #endif  // !USE_DEVICE_GROUPS
     AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_UPNP D_MULTICAST_DISABLED));
     udp_connected = false;
+    UdpReply.type = UDP_REPLY_NONE;
   }
   return udp_connected;
 }
@@ -124,8 +242,7 @@ void PollUdp(void)
 #endif  // ESP8266
 #ifdef ESP32
     while (uint32_t pack_len = PortUdp.parsePacket()) {
-      char packet_buffer[UDP_BUFFER_SIZE];     // buffer to hold incoming UDP/SSDP packet
-
+      char * packet_buffer = udp_packet_buffer;
       int32_t len = PortUdp.read(packet_buffer, UDP_BUFFER_SIZE -1);
       packet_buffer[len] = 0;
       PortUdp.flush();
@@ -137,58 +254,34 @@ void PollUdp(void)
       // Simple Service Discovery Protocol (SSDP)
       if (Settings->flag2.emulation) {
 #if defined(USE_SCRIPT_HUE) || defined(USE_ZIGBEE)
-        if (strstr_P(packet_buffer, PSTR("M-SEARCH")) != nullptr) {
+        if (!strncmp_P(packet_buffer, PSTR("M-SEARCH"), 8)) {
 #else
-        if (TasmotaGlobal.devices_present && (strstr_P(packet_buffer, PSTR("M-SEARCH")) != nullptr)) {
+        if (TasmotaGlobal.devices_present && !strncmp_P(packet_buffer, PSTR("M-SEARCH"), 8)) {
 #endif
-          if (0 == udp_last_received) {
-            udp_last_received = millis();
-#ifdef ESP8266
-            udp_remote_ip = packet->srcaddr;
-            udp_remote_port = packet->srcport;
-#else
-            udp_remote_ip = PortUdp.remoteIP();
-            udp_remote_port = PortUdp.remotePort();
-#endif
-
+          if ((0 == udp_last_received) && (UDP_REPLY_NONE == UdpReply.type)) {
             // AddLog(LOG_LEVEL_DEBUG_MORE, PSTR("UDP: M-SEARCH Packet from %_I:%d\n%s"),
             //   (uint32_t)udp_remote_ip, udp_remote_port, packet_buffer);
 
-            LowerCase(packet_buffer, packet_buffer);
-            RemoveSpace(packet_buffer);
-
-            bool udp_proccessed = false;      // make sure we process the packet only once
-#ifdef USE_EMULATION_WEMO
-            if (!udp_proccessed && (EMUL_WEMO == Settings->flag2.emulation)) {
-              if (strstr_P(packet_buffer, URN_BELKIN_DEVICE) != nullptr) {     // type1 echo dot 2g, echo 1g's
-                WemoRespondToMSearch(1);
-                udp_proccessed = true;
-              }
-              else if ((strstr_P(packet_buffer, UPNP_ROOTDEVICE) != nullptr) ||  // type2 Echo 2g (echo & echo plus)
-                      (strstr_P(packet_buffer, SSDPSEARCH_ALL) != nullptr) ||
-                      (strstr_P(packet_buffer, SSDP_ALL) != nullptr)) {
-                WemoRespondToMSearch(2);
-                udp_proccessed = true;
-              }
-            }
-#endif  // USE_EMULATION_WEMO
-
-#ifdef USE_EMULATION_HUE
-            if (!udp_proccessed && (EMUL_HUE == Settings->flag2.emulation)) {
-              AddLog(LOG_LEVEL_DEBUG_MORE, PSTR("UDP: HUE"));
-              if ((strstr_P(packet_buffer, PSTR(":device:basic:1")) != nullptr) ||
-                  (strstr_P(packet_buffer, UPNP_ROOTDEVICE) != nullptr) ||
-                  (strstr_P(packet_buffer, SSDPSEARCH_ALL) != nullptr) ||
-                  (strstr_P(packet_buffer, SSDP_ALL) != nullptr)) {
-                HueRespondToMSearch();
-                udp_proccessed = true;
-              }
+            uint32_t reply_type = UdpSsdpReplyType(packet_buffer);
+            if (reply_type != UDP_REPLY_NONE) {
+              udp_last_received = millis();
+#ifdef ESP8266
+              udp_remote_ip = packet->srcaddr;
+              udp_remote_port = packet->srcport;
+#else
+              udp_remote_ip = PortUdp.remoteIP();
+              udp_remote_port = PortUdp.remotePort();
+#endif
+              UdpScheduleReply(reply_type, packet_buffer);
             }
-#endif  // USE_EMULATION_HUE
           }
         }
       }
     }
+
+    if ((UdpReply.type != UDP_REPLY_NONE) && TimeReached(UdpReply.due)) {
+      UdpSendReplies();
+    }
     optimistic_yield(100);
   }
 }
@@ -344,7 +344,12 @@ enum XsnsFunctions {FUNC_SETTINGS_OVERRIDE, FUNC_PIN_STATE, FUNC_MODULE_INIT, FU
                     FUNC_RULES_PROCESS, FUNC_TELEPERIOD_RULES_PROCESS, FUNC_SERIAL, FUNC_FREE_MEM, FUNC_BUTTON_PRESSED, FUNC_BUTTON_MULTI_PRESSED,
                     FUNC_WEB_ADD_BUTTON, FUNC_WEB_ADD_CONSOLE_BUTTON, FUNC_WEB_ADD_MANAGEMENT_BUTTON, FUNC_WEB_ADD_MAIN_BUTTON,
                     FUNC_WEB_GET_ARG, FUNC_WEB_ADD_HANDLER, FUNC_SET_CHANNELS, FUNC_SET_SCHEME, FUNC_HOTPLUG_SCAN,
-                    FUNC_DEVICE_GROUP_ITEM };
+                    FUNC_DEVICE_GROUP_ITEM, FUNC_TICK_MASK, FUNC_SENSOR_COLLECT };
+
+enum ProfileStatsTypes { PRF_DRV, PRF_SNS, PRF_CMND, PRF_BERRY };
+
+enum SchedulerTicks { TICK_50_MSECOND, TICK_100_MSECOND, TICK_250_MSECOND, TICK_SECOND, TICK_MAX };
+const uint8_t TICK_MASK_ALL = (1 << TICK_MAX) -1;   // Default for drivers not answering FUNC_TICK_MASK
 
 enum AddressConfigSteps { ADDR_IDLE, ADDR_RECEIVE, ADDR_SEND };
 
@@ -508,6 +508,7 @@ void SleepDelay(uint32_t mseconds) {
 void Scheduler(void) {
   XdrvCall(FUNC_LOOP);
   XsnsCall(FUNC_LOOP);
+  XsnsCollectLoop();
 
 // check LEAmDNS.h
 // MDNS.update() needs to be called in main loop
@@ -535,32 +536,32 @@ void Scheduler(void) {
 #ifdef ROTARY_V1
     RotaryHandler();
 #endif  // ROTARY_V1
-    XdrvCall(FUNC_EVERY_50_MSECOND);
-    XsnsCall(FUNC_EVERY_50_MSECOND);
+    XdrvTickCall(TICK_50_MSECOND);
+    XsnsTickCall(TICK_50_MSECOND);
   }
 
   static uint32_t state_100msecond = 0;            // State 100msecond timer
   if (TimeReached(state_100msecond)) {
     SetNextTimeInterval(state_100msecond, 100);
     Every100mSeconds();
-    XdrvCall(FUNC_EVERY_100_MSECOND);
-    XsnsCall(FUNC_EVERY_100_MSECOND);
+    XdrvTickCall(TICK_100_MSECOND);
+    XsnsTickCall(TICK_100_MSECOND);
   }
 
   static uint32_t state_250msecond = 0;            // State 250msecond timer
   if (TimeReached(state_250msecond)) {
     SetNextTimeInterval(state_250msecond, 250);
     Every250mSeconds();
-    XdrvCall(FUNC_EVERY_250_MSECOND);
-    XsnsCall(FUNC_EVERY_250_MSECOND);
+    XdrvTickCall(TICK_250_MSECOND);
+    XsnsTickCall(TICK_250_MSECOND);
   }
 
   static uint32_t state_second = 0;                // State second timer
   if (TimeReached(state_second)) {
     SetNextTimeInterval(state_second, 1000);
     PerformEverySecond();
-    XdrvCall(FUNC_EVERY_SECOND);
-    XsnsCall(FUNC_EVERY_SECOND);
+    XdrvTickCall(TICK_SECOND);
+    XsnsTickCall(TICK_SECOND);
   }
 
   if (!TasmotaGlobal.serial_local) { SerialInput(); }
@@ -573,7 +574,13 @@ void Scheduler(void) {
 void loop(void) {
   uint32_t my_sleep = millis();
 
+#if defined(ESP32) && defined(USE_I2C) && defined(USE_I2C_QUEUE)
+  I2cBusHold(true);                                // Drivers using Wire directly run in Scheduler()
+#endif
   Scheduler();
+#if defined(ESP32) && defined(USE_I2C) && defined(USE_I2C_QUEUE)
+  I2cBusHold(false);                               // Queued transactions run during SleepDelay()
+#endif
 
   uint32_t my_activity = millis() - my_sleep;
 
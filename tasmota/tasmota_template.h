@@ -177,6 +177,7 @@ enum UserSelectablePins {
   GPIO_HM330X_SET,                     // HM330X SET pin (sleep when low)
   GPIO_HEARTBEAT, GPIO_HEARTBEAT_INV,
   GPIO_SHIFT595_SRCLK, GPIO_SHIFT595_RCLK, GPIO_SHIFT595_OE, GPIO_SHIFT595_SER,   // 74x595 Shift register
+  GPIO_TCP_RTS, GPIO_TCP_CTS,          // TCP to serial bridge hardware flow control
   GPIO_SENSOR_END };
 
 enum ProgramSelectablePins {
@@ -375,6 +376,7 @@ const char kSensorNames[] PROGMEM =
   D_SENSOR_HEARTBEAT "|" D_SENSOR_HEARTBEAT "_i|"
 
   D_GPIO_SHIFT595_SRCLK "|" D_GPIO_SHIFT595_RCLK "|" D_GPIO_SHIFT595_OE "|" D_GPIO_SHIFT595_SER "|"
+  D_SENSOR_TCP_RTS "|" D_SENSOR_TCP_CTS "|"
 ;
 
 const char kSensorNamesFixed[] PROGMEM =
@@ -738,6 +740,10 @@ const uint16_t kGpioNiceList[] PROGMEM = {
 #ifdef USE_TCP_BRIDGE
   AGPIO(GPIO_TCP_TX),         // TCP Serial bridge
   AGPIO(GPIO_TCP_RX),         // TCP Serial bridge
+#ifdef ESP32
+  AGPIO(GPIO_TCP_RTS),        // TCP Serial bridge hardware flow control
+  AGPIO(GPIO_TCP_CTS),
+#endif
 #endif
 #ifdef USE_ZIGBEE
   AGPIO(GPIO_ZIGBEE_TX),      // Zigbee Serial interface
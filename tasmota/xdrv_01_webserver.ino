@@ -2414,6 +2414,9 @@ void HandleInformation(void)
 #else // ESP32
   WSContentSend_PD(PSTR("}1" D_FREE_MEMORY "}2%1_f kB"), &freemem);
 #endif // ESP32
+#ifdef USE_PROFILE_STATS
+  ProfileStatsWebInfo();
+#endif  // USE_PROFILE_STATS
   WSContentSend_P(PSTR("</td></tr></table>"));
 
   WSContentSend_P(HTTP_SCRIPT_INFO_END);
@@ -3481,6 +3484,11 @@ void CmndCors(void)
 
 bool Xdrv01(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -1920,6 +1920,11 @@ void MqttSaveSettings(void) {
 
 bool Xdrv02(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_50_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (Settings->flag.mqtt_enabled) {  // SetOption3 - Enable MQTT
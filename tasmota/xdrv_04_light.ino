@@ -3183,6 +3183,11 @@ void CmndUndocA(void)
 
 bool Xdrv04(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_50_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (FUNC_MODULE_INIT == function) {
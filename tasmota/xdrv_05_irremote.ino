@@ -407,6 +407,11 @@ void IrRemoteCmndResponse(uint32_t error)
 
 bool Xdrv05(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_50_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (PinUsed(GPIO_IRSEND) || PinUsed(GPIO_IRRECV)) {
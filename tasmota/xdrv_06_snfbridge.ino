@@ -537,6 +537,11 @@ void SonoffBridgeWebGetArg(void) {
 
 bool Xdrv06(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
 #ifdef ESP8266
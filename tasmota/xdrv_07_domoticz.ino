@@ -629,6 +629,11 @@ void DomoticzSaveSettings(void) {
 \*********************************************************************************************/
 
 bool Xdrv07(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (Settings->flag.mqtt_enabled) {  // SetOption3 - Enable MQTT
@@ -28,12 +28,13 @@
 const uint8_t SERIAL_BRIDGE_BUFFER_SIZE = 130;
 
 const char kSerialBridgeCommands[] PROGMEM = "|"  // No prefix
-  D_CMND_SSERIALSEND "|" D_CMND_SBAUDRATE;
+  D_CMND_SSERIALSEND "|" D_CMND_SBAUDRATE "|" D_CMND_SSERIALFRAME "|" D_CMND_SSERIALBATCH;
 
 void (* const SerialBridgeCommand[])(void) PROGMEM = {
-  &CmndSSerialSend, &CmndSBaudrate };
+  &CmndSSerialSend, &CmndSBaudrate, &CmndSSerialFrame, &CmndSSerialBatch };
 
 #include <TasmotaSerial.h>
+#include <base64.hpp>
 
 TasmotaSerial *SerialBridgeSerial = nullptr;
 
@@ -99,6 +100,207 @@ void SerialBridgeInput(void)
   }
 }
 
+/*********************************************************************************************\
+ * Framed mode selected with SSerialFrame <mode>,<param1>,<param2>,<param3>
+ *   0 - Off, publish SSerialReceived per message as above
+ *   1 - Delimiter: frame ends with byte param1 which is not part of the frame
+ *   2 - Length prefix: length field of param2 (1 or 2 big endian) bytes at offset param1,
+ *       frame is param1 + param2 + length + param3 (checksum) bytes
+ *   3 - Inter-byte gap: frame ends after param1 ms of silence (resolution is the loop time)
+ *
+ * Frames are collected for SSerialBatch <ms>,<binary>,<norules> and published to tele/SSERIALFRAMES as
+ *   {"SSerialFrames":{"Time":"2021-11-20T18:33:27","Frames":[[125,"AQID"],[630,"BAUG"]]}}
+ *   or binary <uint32 UTC epoch> followed by records <uint16 ms> <uint16 length> <data> (little endian)
+ * where ms is the frame end time relative to the start of the Time/epoch second.
+\*********************************************************************************************/
+
+#define SERIAL_BRIDGE_FRAME_DELIMITER  1
+#define SERIAL_BRIDGE_FRAME_LENGTH     2
+#define SERIAL_BRIDGE_FRAME_GAP        3
+
+const uint16_t SERIAL_BRIDGE_BATCH_SIZE = MQTT_MAX_PACKET_SIZE - 200;  // Binary batch must fit one MQTT packet including topic
+const uint16_t SERIAL_BRIDGE_BATCH_MAX_MS = 60000;                    // Frame time offsets are 16 bit
+const uint16_t SERIAL_BRIDGE_RESYNC_MS = 1000;                        // Drop incomplete length prefixed frame after this idle time
+const uint8_t SERIAL_BRIDGE_EPOCH = 4;                                // Batch header <uint32 UTC epoch>
+const uint8_t SERIAL_BRIDGE_RECORD = 4;                               // Frame header <uint16 ms> <uint16 length>
+
+struct {
+  uint8_t *batch = nullptr;                                           // <epoch> <record>... <record header room> <frame in progress>
+  uint32_t batch_second;                                              // millis() at start of epoch second
+  uint32_t last_byte;                                                 // millis() of last received byte
+  uint32_t frames = 0;
+  uint32_t dropped = 0;
+  uint16_t batch_len;                                                 // End of completed records
+  uint16_t frame_len;                                                 // Bytes of frame in progress
+  uint16_t frame_need;                                                // Length prefixed frame size once known
+  uint16_t frame_max;
+} SBFrame;
+
+uint8_t* SerialBridgeFrameData(void) {
+  return SBFrame.batch + SBFrame.batch_len + SERIAL_BRIDGE_RECORD;
+}
+
+void SerialBridgeFrameDrop(void) {
+  if (SBFrame.frame_len) { SBFrame.dropped++; }
+  SBFrame.frame_len = 0;
+  SBFrame.frame_need = 0;
+}
+
+void SerialBridgeAppendBase64(uint8_t *data, uint32_t length) {
+  char b64[65];                                                       // 48 bytes (multiple of 3) encode to 64 chars
+  while (length) {
+    uint32_t chunk = (length > 48) ? 48 : length;
+    encode_base64(data, chunk, (unsigned char*)b64);
+    ResponseAppend_P(PSTR("%s"), b64);
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void SerialBridgeBinaryPublish(void) {
+  // MqttPublishPayload() would log the whole batch as hex so only log topic and length
+  char subtopic[16];
+  UpperCase_P(subtopic, PSTR(D_JSON_SSERIALFRAMES));
+  char stopic[TOPSZ];
+  GetTopic_P(stopic, TELE, TasmotaGlobal.mqtt_topic, subtopic);
+  if (Settings->flag.mqtt_enabled && MqttPublishLib(stopic, SBFrame.batch, SBFrame.batch_len, false)) {  // SetOption3 - Enable MQTT
+    AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_MQTT "%s = %d bytes"), stopic, SBFrame.batch_len);
+  }
+}
+
+void SerialBridgeBatchPublish(void) {
+  if (SBFrame.batch_len > SERIAL_BRIDGE_EPOCH) {
+    if (Settings->sserial_frame_flags & 1) {                          // Binary, never processed by rules
+      SerialBridgeBinaryPublish();
+    } else {
+      uint32_t epoch;
+      memcpy(&epoch, SBFrame.batch, sizeof(epoch));
+      String time = GetDT(epoch + LocalTime() - UtcTime());
+      uint32_t index = SERIAL_BRIDGE_EPOCH;
+      while (index < SBFrame.batch_len) {
+        Response_P(PSTR("{\"" D_JSON_SSERIALFRAMES "\":{\"" D_JSON_TIME "\":\"%s\",\"Frames\":["), time.c_str());
+        bool first = true;
+        while (index < SBFrame.batch_len) {
+          uint16_t record[2];
+          memcpy(record, SBFrame.batch + index, sizeof(record));
+          if (!first && (ResponseLength() + encode_base64_length(record[1]) + 16 > ResponseSize())) {
+            break;                                                    // Continue in next message
+          }
+          ResponseAppend_P(PSTR("%s[%u,\""), (first) ? "" : ",", record[0]);
+          SerialBridgeAppendBase64(SBFrame.batch + index + SERIAL_BRIDGE_RECORD, record[1]);
+          ResponseAppend_P(PSTR("\"]"));
+          index += SERIAL_BRIDGE_RECORD + record[1];
+          first = false;
+        }
+        ResponseAppend_P(PSTR("]}}"));
+        MqttPublishPrefixTopic_P(TELE, PSTR(D_JSON_SSERIALFRAMES));
+        if (!(Settings->sserial_frame_flags & 2)) {
+          XdrvRulesProcess(0);
+        }
+      }
+    }
+  }
+  memmove(SBFrame.batch + SERIAL_BRIDGE_EPOCH + SERIAL_BRIDGE_RECORD, SerialBridgeFrameData(), SBFrame.frame_len);  // Keep frame in progress
+  SBFrame.batch_len = SERIAL_BRIDGE_EPOCH;
+}
+
+void SerialBridgeFrameEnd(void) {
+  if (!SBFrame.frame_len) { return; }                                 // Skip empty frames like consecutive delimiters
+  uint32_t now = millis();
+  if ((SBFrame.batch_len > SERIAL_BRIDGE_EPOCH) && (now - SBFrame.batch_second > 0xFFFF)) {
+    SerialBridgeBatchPublish();                                       // Time offset would overflow
+  }
+  if (SERIAL_BRIDGE_EPOCH == SBFrame.batch_len) {                     // First frame of batch
+    uint32_t epoch = UtcTime();
+    memcpy(SBFrame.batch, &epoch, sizeof(epoch));
+    SBFrame.batch_second = now - RtcMillis();
+  }
+  uint16_t record[2] = { (uint16_t)(now - SBFrame.batch_second), SBFrame.frame_len };
+  memcpy(SBFrame.batch + SBFrame.batch_len, record, sizeof(record));
+  SBFrame.batch_len += SERIAL_BRIDGE_RECORD + SBFrame.frame_len;
+  SBFrame.frame_len = 0;
+  SBFrame.frame_need = 0;
+  SBFrame.frames++;
+}
+
+void SerialBridgeFrameByte(uint8_t serial_in_byte) {
+  uint32_t mode = Settings->sserial_frame_mode;
+  if ((SERIAL_BRIDGE_FRAME_DELIMITER == mode) && (serial_in_byte == Settings->sserial_frame_param[0])) {
+    SerialBridgeFrameEnd();
+    return;
+  }
+  if (SBFrame.frame_len >= SBFrame.frame_max) {                       // Frame too long so resync
+    SerialBridgeFrameDrop();
+  }
+  if (SBFrame.batch_len + SERIAL_BRIDGE_RECORD + SBFrame.frame_len >= SERIAL_BRIDGE_BATCH_SIZE) {
+    SerialBridgeBatchPublish();                                       // Batch full
+  }
+  SerialBridgeFrameData()[SBFrame.frame_len++] = serial_in_byte;
+
+  if (SERIAL_BRIDGE_FRAME_LENGTH == mode) {
+    uint32_t offset = Settings->sserial_frame_param[0];
+    uint32_t size = (2 == Settings->sserial_frame_param[1]) ? 2 : 1;
+    if (SBFrame.frame_len == offset + size) {                         // Length field complete
+      uint8_t *field = SerialBridgeFrameData() + offset;
+      uint32_t length = (2 == size) ? (field[0] << 8) | field[1] : field[0];
+      uint32_t need = offset + size + length + Settings->sserial_frame_param[2];
+      if (need > SBFrame.frame_max) {                                 // Implausible length so resync
+        SerialBridgeFrameDrop();
+        return;
+      }
+      SBFrame.frame_need = need;
+    }
+    if (SBFrame.frame_len == SBFrame.frame_need) {
+      SerialBridgeFrameEnd();
+    }
+  }
+}
+
+void SerialBridgeFrameInput(void) {
+  char buffer[64];
+  uint32_t available;
+  while ((available = SerialBridgeSerial->available()) > 0) {
+    yield();
+    uint32_t length = SerialBridgeSerial->read(buffer, (available > sizeof(buffer)) ? sizeof(buffer) : available);
+    if (!length) { break; }
+    SBFrame.last_byte = millis();
+    for (uint32_t i = 0; i < length; i++) {
+      SerialBridgeFrameByte(buffer[i]);
+    }
+  }
+
+  if (SBFrame.frame_len) {
+    uint32_t idle = millis() - SBFrame.last_byte;
+    if ((SERIAL_BRIDGE_FRAME_GAP == Settings->sserial_frame_mode) && (idle >= Settings->sserial_frame_param[0])) {
+      SerialBridgeFrameEnd();
+    }
+    else if ((SERIAL_BRIDGE_FRAME_LENGTH == Settings->sserial_frame_mode) && (idle >= SERIAL_BRIDGE_RESYNC_MS)) {
+      SerialBridgeFrameDrop();
+    }
+  }
+  if ((SBFrame.batch_len > SERIAL_BRIDGE_EPOCH) && (millis() - SBFrame.batch_second >= Settings->sserial_batch_ms)) {
+    SerialBridgeBatchPublish();
+  }
+}
+
+void SerialBridgeFrameInit(void) {
+  if (Settings->sserial_frame_mode && !SBFrame.batch) {
+    SBFrame.batch = (uint8_t*)malloc(SERIAL_BRIDGE_BATCH_SIZE);      // Falls back to SSerialReceived if out of memory
+  }
+  else if (!Settings->sserial_frame_mode && SBFrame.batch) {
+    free(SBFrame.batch);
+    SBFrame.batch = nullptr;
+  }
+  SBFrame.frame_max = SERIAL_BRIDGE_BATCH_SIZE - SERIAL_BRIDGE_EPOCH - SERIAL_BRIDGE_RECORD;
+  if (!(Settings->sserial_frame_flags & 1)) {
+    uint32_t json_max = (ResponseSize() - 96) / 4 * 3;                // Base64 frame must fit one JSON message
+    if (json_max < SBFrame.frame_max) { SBFrame.frame_max = json_max; }
+  }
+  SBFrame.batch_len = SERIAL_BRIDGE_EPOCH;
+  SBFrame.frame_len = 0;
+  SBFrame.frame_need = 0;
+}
+
 /********************************************************************************************/
 
 void SerialBridgeInit(void)
@@ -115,6 +317,7 @@ void SerialBridgeInit(void)
       }
       serial_bridge_active = true;
       SerialBridgeSerial->flush();
+      SerialBridgeFrameInit();
     }
   }
 }
@@ -178,18 +381,67 @@ void CmndSBaudrate(void)
   ResponseCmndNumber(Settings->sbaudrate * 300);
 }
 
+void CmndSSerialFrame(void) {
+  // SSerialFrame 0          - Off, publish SSerialReceived
+  // SSerialFrame 1,10       - Frames end with delimiter 10 (LF)
+  // SSerialFrame 2,1,1,2    - One length byte at offset 1, frame is 1 + 1 + length + 2 (CRC) bytes
+  // SSerialFrame 3,20       - Frames end after 20 ms of silence
+  // Setting a mode also resets the Frames and Dropped counters
+  uint32_t values[4] = { 0 };
+  uint32_t params = ParseParameters(4, values);
+  if ((params > 0) && (values[0] <= SERIAL_BRIDGE_FRAME_GAP)) {
+    if (SBFrame.batch) { SerialBridgeBatchPublish(); }
+    SBFrame.frames = 0;
+    SBFrame.dropped = 0;
+    Settings->sserial_frame_mode = values[0];
+    for (uint32_t i = 0; i < 3; i++) {
+      Settings->sserial_frame_param[i] = values[i +1];
+    }
+    SerialBridgeFrameInit();
+  }
+  Response_P(PSTR("{\"" D_CMND_SSERIALFRAME "\":{\"Mode\":%d,\"Param\":[%d,%d,%d],\"Frames\":%u,\"Dropped\":%u}}"),
+    Settings->sserial_frame_mode, Settings->sserial_frame_param[0], Settings->sserial_frame_param[1], Settings->sserial_frame_param[2],
+    SBFrame.frames, SBFrame.dropped);
+}
+
+void CmndSSerialBatch(void) {
+  // SSerialBatch 0          - Publish frames every loop as base64 JSON
+  // SSerialBatch 1000,1,1   - Publish frames once per second as binary payload without rules
+  uint32_t values[3] = { 0 };
+  uint32_t params = ParseParameters(3, values);
+  if (params > 0) {
+    if (SBFrame.batch) { SerialBridgeBatchPublish(); }
+    Settings->sserial_batch_ms = (values[0] > SERIAL_BRIDGE_BATCH_MAX_MS) ? SERIAL_BRIDGE_BATCH_MAX_MS : values[0];
+    if (params > 1) { bitWrite(Settings->sserial_frame_flags, 0, values[1] &1); }
+    if (params > 2) { bitWrite(Settings->sserial_frame_flags, 1, values[2] &1); }
+    SerialBridgeFrameInit();                                          // Maximum frame size depends on format
+  }
+  Response_P(PSTR("{\"" D_CMND_SSERIALBATCH "\":{\"Interval\":%d,\"Binary\":%d,\"NoRules\":%d}}"),
+    Settings->sserial_batch_ms, Settings->sserial_frame_flags &1, (Settings->sserial_frame_flags >> 1) &1);
+}
+
 /*********************************************************************************************\
  * Interface
 \*********************************************************************************************/
 
 bool Xdrv08(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   if (serial_bridge_active) {
     switch (function) {
       case FUNC_LOOP:
-        if (SerialBridgeSerial) { SerialBridgeInput(); }
+        if (SBFrame.batch) {
+          SerialBridgeFrameInput();
+        }
+        else if (SerialBridgeSerial) {
+          SerialBridgeInput();
+        }
         break;
       case FUNC_PRE_INIT:
         SerialBridgeInit();
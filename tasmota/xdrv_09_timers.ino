@@ -55,6 +55,22 @@ void (* const TimerCommand[])(void) PROGMEM = {
 uint16_t timer_last_minute = 60;
 int8_t timer_window[MAX_TIMERS] = { 0 };
 
+// Today's schedule, rebuilt when timer settings, date or timezone change
+struct {
+  int16_t set_time[MAX_TIMERS];        // Minute of today a timer fires
+  uint8_t queue[MAX_TIMERS];           // Timers firing today sorted by set_time
+  uint8_t count;                       // Number of timers in queue
+  uint8_t next;                        // Queue position of next event
+  uint16_t day_of_year;                // Day the schedule was built for
+  int32_t timezone;                    // Timezone the schedule was built for
+  int16_t minute;                      // Last minute handled
+  bool dirty = true;
+} TimerSchedule;
+
+void TimerScheduleInvalidate(void) {
+  TimerSchedule.dirty = true;
+}
+
 #ifdef USE_SUNRISE
 /*********************************************************************************************\
  * Sunrise and sunset (+13k code)
@@ -115,10 +131,30 @@ float TimeFormula(float *DK, uint32_t Tdays) {
   return dRA;
 }
 
+// Last computed sunrise and sunset, valid for one day, timezone and location
+struct {
+  uint32_t JD;
+  int32_t timezone;
+  int32_t latitude;
+  int32_t longitude;
+  uint8_t hour_up;
+  uint8_t minute_up;
+  uint8_t hour_down;
+  uint8_t minute_down;
+} SunCache = { 0 };
+
 void DuskTillDawn(uint8_t *hour_up,uint8_t *minute_up, uint8_t *hour_down, uint8_t *minute_down)
 {
   const uint32_t JD2000 = 2451545;
   uint32_t JD = JulianDate(RtcTime);
+  if ((JD == SunCache.JD) && (Rtc.time_timezone == SunCache.timezone) &&
+      (Settings->latitude == SunCache.latitude) && (Settings->longitude == SunCache.longitude)) {
+    *hour_up = SunCache.hour_up;
+    *minute_up = SunCache.minute_up;
+    *hour_down = SunCache.hour_down;
+    *minute_down = SunCache.minute_down;
+    return;
+  }
   uint32_t Tdays = JD - JD2000;           // number of days since Jan 1 2000
 
   // ex 2458977 (2020 May 7) - 2451545 -> 7432 -> 0,2034
@@ -160,6 +196,15 @@ void DuskTillDawn(uint8_t *hour_up,uint8_t *minute_up, uint8_t *hour_down, uint8
   *minute_up = AufgangMinuten;
   *hour_down = UntergangStunden;
   *minute_down = UntergangMinuten;
+
+  SunCache.JD = JD;
+  SunCache.timezone = Rtc.time_timezone;
+  SunCache.latitude = Settings->latitude;
+  SunCache.longitude = Settings->longitude;
+  SunCache.hour_up = *hour_up;
+  SunCache.minute_up = *minute_up;
+  SunCache.hour_down = *hour_down;
+  SunCache.minute_down = *minute_down;
 }
 
 void ApplyTimerOffsets(Timer *duskdawn)
@@ -243,6 +288,7 @@ void TimerSetRandomWindow(uint32_t index)
   if (Settings->timer[index].window) {
     timer_window[index] = (random(0, (Settings->timer[index].window << 1) +1)) - Settings->timer[index].window;  // -15 .. 15
   }
+  TimerScheduleInvalidate();
 }
 
 void TimerSetRandomWindows(void)
@@ -250,6 +296,63 @@ void TimerSetRandomWindows(void)
   for (uint32_t i = 0; i < MAX_TIMERS; i++) { TimerSetRandomWindow(i); }
 }
 
+void TimerScheduleBuild(int32_t time)
+{
+  // Precompute today's fire time of all armed timers including sunrise/sunset and random window
+  uint8_t days = 1 << (RtcTime.day_of_week -1);
+
+  TimerSchedule.count = 0;
+  for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+    Timer xtimer = Settings->timer[i];
+    if (!xtimer.arm) { continue; }
+#ifdef USE_SUNRISE
+    if ((1 == xtimer.mode) || (2 == xtimer.mode)) {      // Sunrise or Sunset
+      ApplyTimerOffsets(&xtimer);
+      if (xtimer.time>=2046) { continue; }
+    }
+#endif
+    if (!(xtimer.days & days)) { continue; }
+
+    int32_t set_time = xtimer.time + timer_window[i];  // Add random time offset
+    if (set_time < 0) {
+      set_time = abs(timer_window[i]);                 // After midnight and within negative window so stay today but allow positive randomness;
+    }
+    if (set_time > 1439) {
+      set_time = xtimer.time - abs(timer_window[i]);   // Before midnight and within positive window so stay today but allow negative randomness;
+    }
+    if (set_time > 1439) { set_time = 1439; }          // Stay today
+
+    DEBUG_DRIVER_LOG(PSTR("TIM: Timer %d, Time %d, Window %d, SetTime %d"), i +1, xtimer.time, timer_window[i], set_time);
+
+    TimerSchedule.set_time[i] = set_time;
+    uint32_t pos = TimerSchedule.count++;              // Insertion sort on set_time, keeps timer order on equal time
+    while ((pos > 0) && (TimerSchedule.set_time[TimerSchedule.queue[pos -1]] > set_time)) {
+      TimerSchedule.queue[pos] = TimerSchedule.queue[pos -1];
+      pos--;
+    }
+    TimerSchedule.queue[pos] = i;
+  }
+
+  TimerSchedule.next = 0;
+  while ((TimerSchedule.next < TimerSchedule.count) && (TimerSchedule.set_time[TimerSchedule.queue[TimerSchedule.next]] < time)) {
+    TimerSchedule.next++;                              // Skip events already passed today
+  }
+  TimerSchedule.day_of_year = RtcTime.day_of_year;
+  TimerSchedule.timezone = Rtc.time_timezone;
+  TimerSchedule.minute = time;
+  TimerSchedule.dirty = false;
+}
+
+void TimerScheduleUpdate(int32_t time)
+{
+  if (TimerSchedule.dirty ||
+      (TimerSchedule.day_of_year != RtcTime.day_of_year) ||
+      (TimerSchedule.timezone != Rtc.time_timezone) ||
+      (time < TimerSchedule.minute)) {                 // Time moved backwards
+    TimerScheduleBuild(time);
+  }
+}
+
 void TimerEverySecond(void)
 {
   if (RtcTime.valid) {
@@ -258,41 +361,21 @@ void TimerEverySecond(void)
         (TasmotaGlobal.uptime > 60) && (RtcTime.minute != timer_last_minute)) {  // Execute from one minute after restart every minute only once
       timer_last_minute = RtcTime.minute;
       int32_t time = (RtcTime.hour *60) + RtcTime.minute;
-      uint8_t days = 1 << (RtcTime.day_of_week -1);
+      TimerScheduleUpdate(time);
+      TimerSchedule.minute = time;
 
-      for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+      while ((TimerSchedule.next < TimerSchedule.count) && (TimerSchedule.set_time[TimerSchedule.queue[TimerSchedule.next]] <= time)) {
+        uint32_t i = TimerSchedule.queue[TimerSchedule.next++];
+        if (TimerSchedule.set_time[i] != time) { continue; }  // Missed while time was not handled
         Timer xtimer = Settings->timer[i];
-        if (xtimer.arm) {
-#ifdef USE_SUNRISE
-          if ((1 == xtimer.mode) || (2 == xtimer.mode)) {      // Sunrise or Sunset
-            ApplyTimerOffsets(&xtimer);
-            if (xtimer.time>=2046) { continue; }
-          }
-#endif
-          int32_t set_time = xtimer.time + timer_window[i];  // Add random time offset
-          if (set_time < 0) {
-            set_time = abs(timer_window[i]);                 // After midnight and within negative window so stay today but allow positive randomness;
-          }
-          if (set_time > 1439) {
-            set_time = xtimer.time - abs(timer_window[i]);   // Before midnight and within positive window so stay today but allow negative randomness;
-          }
-          if (set_time > 1439) { set_time = 1439; }          // Stay today
-
-          DEBUG_DRIVER_LOG(PSTR("TIM: Timer %d, Time %d, Window %d, SetTime %d"), i +1, xtimer.time, timer_window[i], set_time);
-
-          if (time == set_time) {
-            if (xtimer.days & days) {
-              Settings->timer[i].arm = xtimer.repeat;
+        Settings->timer[i].arm = xtimer.repeat;
 #if defined(USE_RULES) || defined(USE_SCRIPT)
-              if (POWER_BLINK == xtimer.power) {             // Blink becomes Rule disregarding device and allowing use of Backlog commands
-                Response_P(PSTR("{\"Clock\":{\"Timer\":%d}}"), i +1);
-                XdrvRulesProcess(0);
-              } else
+        if (POWER_BLINK == xtimer.power) {             // Blink becomes Rule disregarding device and allowing use of Backlog commands
+          Response_P(PSTR("{\"Clock\":{\"Timer\":%d}}"), i +1);
+          XdrvRulesProcess(0);
+        } else
 #endif  // USE_RULES
-                if (TasmotaGlobal.devices_present) { ExecuteCommandPower(xtimer.device +1, xtimer.power, SRC_TIMER); }
-            }
-          }
-        }
+          if (TasmotaGlobal.devices_present) { ExecuteCommandPower(xtimer.device +1, xtimer.power, SRC_TIMER); }
       }
     }
   }
@@ -443,6 +526,7 @@ void CmndTimer(void)
       }
     }
     if (!error) {
+      TimerScheduleInvalidate();
       Response_P(PSTR("{"));
       PrepShowTimer(index);
       ResponseJsonEnd();
@@ -459,6 +543,7 @@ void CmndTimers(void)
     if (XdrvMailbox.payload == 2) {
       Settings->flag3.timers_enable = !Settings->flag3.timers_enable;  // CMND_TIMERS
     }
+    TimerScheduleInvalidate();
   }
 #ifdef MQTT_DATA_STRING
   Response_P(PSTR("{\"" D_CMND_TIMERS "\":\"%s\""), GetStateText(Settings->flag3.timers_enable));
@@ -496,6 +581,7 @@ void CmndLongitude(void)
 {
   if (XdrvMailbox.data_len) {
     Settings->longitude = (int)(CharToFloat(XdrvMailbox.data) *1000000);
+    TimerScheduleInvalidate();
   }
   ResponseCmndFloat((float)(Settings->longitude) /1000000, 6);
 }
@@ -504,6 +590,7 @@ void CmndLatitude(void)
 {
   if (XdrvMailbox.data_len) {
     Settings->latitude = (int)(CharToFloat(XdrvMailbox.data) *1000000);
+    TimerScheduleInvalidate();
   }
   ResponseCmndFloat((float)(Settings->latitude) /1000000, 6);
 }
@@ -902,6 +989,7 @@ void TimerSaveSettings(void)
       if (flag) TimerSetRandomWindow(i);
     }
   }
+  TimerScheduleInvalidate();
   char command[CMDSZ];
   snprintf_P(command, sizeof(command), PSTR(D_CMND_TIMERS));
   ExecuteWebCommand(command);
@@ -915,6 +1003,11 @@ void TimerSaveSettings(void)
 
 bool Xdrv09(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
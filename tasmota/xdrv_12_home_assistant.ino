@@ -199,6 +199,97 @@ const char kHAssError3[] PROGMEM =
 uint8_t hass_mode = 0;
 int hass_tele_period = 0;
 
+/*********************************************************************************************\
+ * Paced discovery
+ *
+ * Discovery is split in steps run from FUNC_EVERY_50_MSECOND. Each slot stops as soon as
+ * HASS_DISCOVERY_BUDGET payload bytes or HASS_DISCOVERY_MAX_MS milliseconds are used, so a
+ * device with many sensors no longer floods the broker or blocks the loop. Buttons, switches
+ * and relays check the budget per entity and resume in the next slot.
+ * The hash of every retained config payload is remembered per topic so unchanged configs are
+ * not republished when discovery runs again in the same MQTT session. A new MQTT session (the
+ * broker may have lost its retained store), Home Assistant coming online or a forced discovery
+ * (SetOption19/30) resends everything.
+\*********************************************************************************************/
+
+#ifndef HASS_DISCOVERY_BUDGET
+#define HASS_DISCOVERY_BUDGET      1536     // Max config payload bytes published per 50 ms slot
+#endif
+#ifndef HASS_DISCOVERY_MAX_MS
+#define HASS_DISCOVERY_MAX_MS      20       // Max time spent on discovery per 50 ms slot
+#endif
+#ifndef HASS_CONFIG_HASH_MAX
+#define HASS_CONFIG_HASH_MAX       64       // Number of config topics remembered (8 bytes each)
+#endif
+
+enum HAssDiscoverySteps { HASS_STEP_IDLE, HASS_STEP_BUTTONS, HASS_STEP_SWITCHES, HASS_STEP_SENSORS,
+                          HASS_STEP_SHUTTERS, HASS_STEP_RELAYS, HASS_STEP_STATUS };
+
+struct HASS_CONFIG_HASH {
+  uint32_t topic;                          // 0 = free slot
+  uint32_t payload;
+};
+
+struct {
+  HASS_CONFIG_HASH config[HASS_CONFIG_HASH_MAX];
+  uint32_t budget;                         // Payload bytes published in current slot
+  uint32_t slot_start;                     // millis() at start of current slot
+  uint8_t step;                            // HAssDiscoverySteps
+  uint8_t index;                           // Next button, switch or relay of current step
+  uint8_t xsns_index;
+  struct {                                 // HAssAnnounceRelayLight() state kept between slots
+    uint8_t dimmer;
+    uint8_t max_lights;
+    bool ind_light;
+    bool ct_light;
+    bool err_flag;
+  } relay;
+} HAss;
+
+uint32_t HAssHash(const char *data, uint32_t hash = 2166136261) {
+  // FNV-1a
+  while (*data) {
+    hash ^= (uint8_t)*data++;
+    hash *= 16777619;
+  }
+  return hash;
+}
+
+void HAssHashClear(void) {
+  memset(HAss.config, 0, sizeof(HAss.config));
+}
+
+bool HAssBudgetUsed(void) {
+  return (HAss.budget >= HASS_DISCOVERY_BUDGET) || (TimePassedSince(HAss.slot_start) >= HASS_DISCOVERY_MAX_MS);
+}
+
+void HAssPublish(const char *stopic) {
+  // Publish retained config in ResponseData() unless the broker already holds the same payload
+  uint32_t topic_hash = HAssHash(stopic);
+  if (!topic_hash) { topic_hash = 1; }
+  uint32_t payload_hash = HAssHash(ResponseData());
+
+  uint32_t slot = topic_hash % HASS_CONFIG_HASH_MAX;
+  uint32_t probe;
+  for (probe = 0; probe < HASS_CONFIG_HASH_MAX; probe++) {
+    HASS_CONFIG_HASH *entry = &HAss.config[slot];
+    if (!entry->topic || (entry->topic == topic_hash)) { break; }
+    slot = (slot + 1) % HASS_CONFIG_HASH_MAX;
+  }
+  if (probe < HASS_CONFIG_HASH_MAX) {
+    HASS_CONFIG_HASH *entry = &HAss.config[slot];
+    if ((entry->topic == topic_hash) && (entry->payload == payload_hash)) {
+      return;                              // Unchanged retained message
+    }
+    if (Mqtt.connected) {                  // Only remember what reached the broker
+      entry->topic = topic_hash;
+      entry->payload = payload_hash;
+    }
+  }
+  HAss.budget += ResponseLength() + strlen(stopic);
+  MqttPublish(stopic, true);
+}
+
 // NEW DISCOVERY
 void HassDiscoverMessage(void) {
   Response_P(PSTR("{\"ip\":\"%_I\","                           // IP Address
@@ -427,8 +518,9 @@ void TryResponseAppend_P(const char *format, ...) {
 #endif
 }
 
-void HAssAnnounceRelayLight(void)
+bool HAssAnnounceRelayLight(void)
 {
+  // Announce relays and lights from HAss.index, returns true once all are done
   char stopic[TOPSZ];
   char stemp1[TOPSZ];
   char stemp2[TOPSZ];
@@ -473,6 +565,14 @@ void HAssAnnounceRelayLight(void)
   }
 #endif //USE_LIGHT
 
+  if (HAss.index) {                                     // Resume where the previous slot stopped
+    dimmer = HAss.relay.dimmer;
+    max_lights = HAss.relay.max_lights;
+    ind_light = HAss.relay.ind_light;
+    ct_light = HAss.relay.ct_light;
+    err_flag = HAss.relay.err_flag;
+  }
+
 #ifdef USE_SHUTTER
   if (Settings->flag3.shutter_mode) {
     for (uint32_t i = 0; i < MAX_SHUTTERS; i++) {
@@ -487,8 +587,17 @@ void HAssAnnounceRelayLight(void)
   }
 #endif
 
-  for (uint32_t i = 1; i <= MAX_RELAYS; i++)
+  for (uint32_t i = HAss.index + 1; i <= MAX_RELAYS; i++)
   {
+    if (HAssBudgetUsed()) {
+      HAss.index = i - 1;
+      HAss.relay.dimmer = dimmer;
+      HAss.relay.max_lights = max_lights;
+      HAss.relay.ind_light = ind_light;
+      HAss.relay.ct_light = ct_light;
+      HAss.relay.err_flag = err_flag;
+      return false;
+    }
 
 #ifdef USE_TUYA_MCU
   TuyaRel = TuyaGetDpId((TUYA_MCU_FUNC_REL1+ i-1) + TasmotaGlobal.active_device - 1);
@@ -511,7 +620,7 @@ void HAssAnnounceRelayLight(void)
     snprintf_P(unique_id, sizeof(unique_id), PSTR("%06X_%s_%d"), ESP_getChipId(), (is_topic_light) ? "RL" : "LI", i);
     snprintf_P(stopic, sizeof(stopic), PSTR(HOME_ASSISTANT_DISCOVERY_PREFIX "/%s/%s/config"),
                (is_topic_light) ? "switch" : "light", unique_id);
-    MqttPublish(stopic, true);
+    HAssPublish(stopic);
     // Clear or Set topic
     snprintf_P(unique_id, sizeof(unique_id), PSTR("%06X_%s_%d"), ESP_getChipId(), (is_topic_light) ? "LI" : "RL", i);
     snprintf_P(stopic, sizeof(stopic), PSTR(HOME_ASSISTANT_DISCOVERY_PREFIX "/%s/%s/config"),
@@ -615,8 +724,9 @@ void HAssAnnounceRelayLight(void)
       }
     }
     TasmotaGlobal.masterlog_level = ShowTopic;
-    MqttPublish(stopic, true);
+    HAssPublish(stopic);
   }
+  return true;
 }
 
 void HAssAnnouncerTriggers(uint8_t device, uint8_t present, uint8_t key, uint8_t toggle, uint8_t hold, uint8_t single, uint8_t trg_start, uint8_t trg_end)
@@ -674,7 +784,7 @@ void HAssAnnouncerTriggers(uint8_t device, uint8_t present, uint8_t key, uint8_t
       }
     }
     TasmotaGlobal.masterlog_level = ShowTopic;
-    MqttPublish(stopic, true);
+    HAssPublish(stopic);
   }
 }
 
@@ -731,14 +841,19 @@ void HAssAnnouncerBinSensors(uint8_t device, uint8_t present, uint8_t dual, uint
     }
   }
   TasmotaGlobal.masterlog_level = ShowTopic;
-  MqttPublish(stopic, true);
+  HAssPublish(stopic);
 
 }
 
-void HAssAnnounceSwitches(void)
+bool HAssAnnounceSwitches(void)
 {
-  for (uint32_t switch_index = 0; switch_index < MAX_SWITCHES; switch_index++)
+  // Announce switches from HAss.index, returns true once all are done
+  for (uint32_t switch_index = HAss.index; switch_index < MAX_SWITCHES; switch_index++)
   {
+    if (HAssBudgetUsed()) {
+      HAss.index = switch_index;
+      return false;
+    }
     uint8_t switch_present = 0;
     uint8_t dual = 0;
     uint8_t toggle = 1;
@@ -809,12 +924,18 @@ void HAssAnnounceSwitches(void)
     HAssAnnouncerTriggers(switch_index, switch_present, 1, toggle, hold, 0, 2, 3);
     HAssAnnouncerBinSensors(switch_index, switch_present, dual, toggle, pir);
   }
+  return true;
 }
 
-void HAssAnnounceButtons(void)
+bool HAssAnnounceButtons(void)
 {
-  for (uint32_t button_index = 0; button_index < MAX_KEYS; button_index++)
+  // Announce buttons from HAss.index, returns true once all are done
+  for (uint32_t button_index = HAss.index; button_index < MAX_KEYS; button_index++)
   {
+    if (HAssBudgetUsed()) {
+      HAss.index = button_index;
+      return false;
+    }
     uint8_t button_present = 0;
     uint8_t single = 0;
 
@@ -852,6 +973,7 @@ void HAssAnnounceButtons(void)
     }
     HAssAnnouncerTriggers(button_index, button_present, 0, 0, 0, single, 1, 6);
   }
+  return true;
 }
 
 void HAssAnnounceSensor(const char *sensorname, const char *subsensortype, const char *MultiSubName, uint8_t subqty, bool nested, const char* SubKey)
@@ -922,84 +1044,81 @@ void HAssAnnounceSensor(const char *sensorname, const char *subsensortype, const
 
     TryResponseAppend_P(PSTR("}}\"}"));
   }
-  MqttPublish(stopic, true);
+  HAssPublish(stopic);
 }
 
-void HAssAnnounceSensors(void)
+bool HAssAnnounceSensors(void)
 {
-  uint8_t hass_xsns_index = 0;
-  do
+  // Announce sensors of one driver per call, returns true once all drivers are done
+  ResponseClear();
+  int tele_period_save = TasmotaGlobal.tele_period;
+  TasmotaGlobal.tele_period = 2;                                 // Do not allow HA updates during next function call
+  XsnsNextCall(FUNC_JSON_APPEND, HAss.xsns_index); // ,"INA219":{"Voltage":4.494,"Current":0.020,"Power":0.089}
+  TasmotaGlobal.tele_period = tele_period_save;
+  size_t sensordata_len = ResponseLength();
+  char sensordata[sensordata_len+2];   // dynamically adjust the size
+  strcpy(sensordata, ResponseData());    // we can use strcpy since the buffer has the right size
+
+  // ******************* JSON TEST *******************
+  // char sensordata[512];
+  // snprintf_P(sensordata, sizeof(sensordata), PSTR("{\"ENERGY\":{\"TotalStartTime\":\"2018-11-23T15:33:47\",\"ExportTariff\":[0.000,0.017],\"Speed\":{\"Act\":\"NE\"}}}"));
+  // size_t sensordata_len = strlen(sensordata);
+  // ******************* JSON TEST *******************
+
+  if (sensordata_len > 0)
   {
-    ResponseClear();
-    int tele_period_save = TasmotaGlobal.tele_period;
-    TasmotaGlobal.tele_period = 2;                                 // Do not allow HA updates during next function call
-    XsnsNextCall(FUNC_JSON_APPEND, hass_xsns_index); // ,"INA219":{"Voltage":4.494,"Current":0.020,"Power":0.089}
-    TasmotaGlobal.tele_period = tele_period_save;
-    size_t sensordata_len = ResponseLength();
-    char sensordata[sensordata_len+2];   // dynamically adjust the size
-    strcpy(sensordata, ResponseData());    // we can use strcpy since the buffer has the right size
-
-    // ******************* JSON TEST *******************
-    // char sensordata[512];
-    // snprintf_P(sensordata, sizeof(sensordata), PSTR("{\"ENERGY\":{\"TotalStartTime\":\"2018-11-23T15:33:47\",\"ExportTariff\":[0.000,0.017],\"Speed\":{\"Act\":\"NE\"}}}"));
-    // size_t sensordata_len = strlen(sensordata);
-    // ******************* JSON TEST *******************
-
-    if (sensordata_len > 0)
+    // // We replace the leader ',' with '{'
+    sensordata[0] = '{';
+    // // and we add a trailing '}' after the last '}'
+    sensordata[sensordata_len] = '}';
+    sensordata[sensordata_len+1] = '\0';
+
+    JsonParser parser(sensordata);
+    JsonParserObject root = parser.getRootObject();
+    if (!root)
+    {
+      AddLog(LOG_LEVEL_ERROR, PSTR("%s '%s' (ERR1)"), kHAssError3, sensordata);
+      return (0 == HAss.xsns_index);
+    }
+    for (auto sensor_key : root)
     {
-      // // We replace the leader ',' with '{'
-      sensordata[0] = '{';
-      // // and we add a trailing '}' after the last '}'
-      sensordata[sensordata_len] = '}';
-      sensordata[sensordata_len+1] = '\0';
-
-      JsonParser parser(sensordata);
-      JsonParserObject root = parser.getRootObject();
-      if (!root)
+      // sensor is of type JsonParserKey
+      const char *sensorname = sensor_key.getStr();
+      JsonParserObject sensors = sensor_key.getValue().getObject();
+
+      if (!sensors)
       {
-        AddLog(LOG_LEVEL_ERROR, PSTR("%s '%s' (ERR1)"), kHAssError3, sensordata);
+        AddLog(LOG_LEVEL_ERROR, PSTR("%s '%s' (ERR2)"), kHAssError3, sensorname);
         continue;
       }
-      for (auto sensor_key : root)
-      {
-        // sensor is of type JsonParserKey
-        const char *sensorname = sensor_key.getStr();
-        JsonParserObject sensors = sensor_key.getValue().getObject();
 
-        if (!sensors)
-        {
-          AddLog(LOG_LEVEL_ERROR, PSTR("%s '%s' (ERR2)"), kHAssError3, sensorname);
-          continue;
-        }
-
-        for (auto subsensor_key_token : sensors)
-        {
-          const char * subsensor_key = subsensor_key_token.getStr();
-          JsonParserToken subsensor = subsensor_key_token.getValue();
-          if (subsensor.isObject()) {
-            // If there is a nested json on sensor data, second level entitites will be created
-            JsonParserObject subsensors = subsensor.getObject();
-            char NewSensorName[20];
-            for (auto subsensor2_key : subsensors) {
-              snprintf_P(NewSensorName, sizeof(NewSensorName), PSTR("%s %s"), subsensor_key, subsensor2_key.getStr());
-              HAssAnnounceSensor(sensorname, subsensor_key, NewSensorName, 0, 1, subsensor2_key.getStr());
-            }
-          } else if (subsensor.isArray()) {
-            // If there is more than a value on sensor data, 'n' entitites will be created
-            JsonParserArray subsensors = subsensor.getArray();
-            uint8_t subqty = subsensors.size();
-            char MultiSubName[20];
-            for (int i = 1; i <= subqty; i++) {
-              snprintf_P(MultiSubName, sizeof(MultiSubName), PSTR("%s %d"), subsensor_key, i);
-              HAssAnnounceSensor(sensorname, subsensor_key, MultiSubName, i, 0, subsensor_key);
-            }
-          } else {
-            HAssAnnounceSensor(sensorname, subsensor_key, subsensor_key, 0, 0, subsensor_key);}
-        }
+      for (auto subsensor_key_token : sensors)
+      {
+        const char * subsensor_key = subsensor_key_token.getStr();
+        JsonParserToken subsensor = subsensor_key_token.getValue();
+        if (subsensor.isObject()) {
+          // If there is a nested json on sensor data, second level entitites will be created
+          JsonParserObject subsensors = subsensor.getObject();
+          char NewSensorName[20];
+          for (auto subsensor2_key : subsensors) {
+            snprintf_P(NewSensorName, sizeof(NewSensorName), PSTR("%s %s"), subsensor_key, subsensor2_key.getStr());
+            HAssAnnounceSensor(sensorname, subsensor_key, NewSensorName, 0, 1, subsensor2_key.getStr());
+          }
+        } else if (subsensor.isArray()) {
+          // If there is more than a value on sensor data, 'n' entitites will be created
+          JsonParserArray subsensors = subsensor.getArray();
+          uint8_t subqty = subsensors.size();
+          char MultiSubName[20];
+          for (int i = 1; i <= subqty; i++) {
+            snprintf_P(MultiSubName, sizeof(MultiSubName), PSTR("%s %d"), subsensor_key, i);
+            HAssAnnounceSensor(sensorname, subsensor_key, MultiSubName, i, 0, subsensor_key);
+          }
+        } else {
+          HAssAnnounceSensor(sensorname, subsensor_key, subsensor_key, 0, 0, subsensor_key);}
       }
     }
-    yield();
-  } while (hass_xsns_index != 0);
+  }
+  return (0 == HAss.xsns_index);
 }
 
 void HAssAnnounceShutters(void)
@@ -1050,7 +1169,7 @@ void HAssAnnounceShutters(void)
     }
 
     TasmotaGlobal.masterlog_level = ShowTopic;
-    MqttPublish(stopic, true);
+    HAssPublish(stopic);
   }
 #endif
 }
@@ -1089,7 +1208,7 @@ void HAssAnnounceDeviceInfoAndStatusSensor(void)
     TryResponseAppend_P(PSTR("}"));
   }
   TasmotaGlobal.masterlog_level = ShowTopic;
-  MqttPublish(stopic, true);
+  HAssPublish(stopic);
 
   if (!Settings->flag.hass_discovery) {
     TasmotaGlobal.masterlog_level = 0;
@@ -1124,27 +1243,65 @@ void HAssDiscovery(void)
 
   if (Settings->flag.hass_discovery || (1 == hass_mode))
   { // SetOption19 - Control Home Assistantautomatic discovery (See SetOption59)
-    hass_mode = 2; // Needed for generating bluetooth entities for MI_ESP32
-    // Send info about buttons
-    HAssAnnounceButtons();
-
-    // Send info about switches
-    HAssAnnounceSwitches();
-
-    // Send info about sensors
-    HAssAnnounceSensors();
-
-    // Send info about shutters
-    HAssAnnounceShutters();
+    if (1 == hass_mode) {
+      HAssHashClear();                        // Forced discovery resends all configs
+    }
+    HAss.xsns_index = 0;
+    HAss.index = 0;
+    HAss.step = HASS_STEP_BUTTONS;            // Paced from FUNC_EVERY_50_MSECOND
+    hass_mode = 3;
+  }
+}
 
-    // Send info about relays and lights
-    HAssAnnounceRelayLight();
+void HAssDiscoveryStep(void)
+{
+  // Run discovery steps until the slot budget is used
+  HAss.slot_start = millis();
+  HAss.budget = 0;
+  hass_mode = 2; // Needed for generating bluetooth entities for MI_ESP32
+  while (HAss.step != HASS_STEP_IDLE) {
+    if (!Mqtt.connected) {
+      HAss.step = HASS_STEP_IDLE;             // FUNC_MQTT_SUBSCRIBE restarts discovery on reconnect
+      break;
+    }
+    if (HAssBudgetUsed()) { break; }
 
-    // Send info about status sensor
-    HAssAnnounceDeviceInfoAndStatusSensor();
-    TasmotaGlobal.masterlog_level = 0; // Restores weblog level
-    hass_mode = 3; // Needed for generating bluetooth entities for MI_ESP32
+    switch (HAss.step) {
+      case HASS_STEP_BUTTONS:
+        if (HAssAnnounceButtons()) {          // Send info about buttons
+          HAss.index = 0;
+          HAss.step++;
+        }
+        break;
+      case HASS_STEP_SWITCHES:
+        if (HAssAnnounceSwitches()) {         // Send info about switches
+          HAss.index = 0;
+          HAss.step++;
+        }
+        break;
+      case HASS_STEP_SENSORS:
+        if (HAssAnnounceSensors()) {          // Send info about sensors, one driver at a time
+          HAss.step++;
+        }
+        break;
+      case HASS_STEP_SHUTTERS:
+        HAssAnnounceShutters();               // Send info about shutters
+        HAss.step++;
+        break;
+      case HASS_STEP_RELAYS:
+        if (HAssAnnounceRelayLight()) {       // Send info about relays and lights
+          HAss.index = 0;
+          HAss.step++;
+        }
+        break;
+      case HASS_STEP_STATUS:
+        HAssAnnounceDeviceInfoAndStatusSensor();  // Send info about status sensor
+        HAss.step = HASS_STEP_IDLE;
+        break;
+    }
   }
+  TasmotaGlobal.masterlog_level = 0; // Restores weblog level
+  hass_mode = 3; // Needed for generating bluetooth entities for MI_ESP32
 }
 
 void HAssDiscover(void)
@@ -1199,6 +1356,7 @@ bool HAssMqttLWT(void)
     return false;
   }
   if (Settings->flag.hass_discovery && (strncasecmp_P(XdrvMailbox.data, PSTR("online"), strlen("online")) == 0) && (XdrvMailbox.data_len == 6)) {
+    HAssHashClear();                            // Home Assistant may come back with another broker, resend all configs
     MqttPublishTeleState();
     return true;
   } else { return false; }
@@ -1219,6 +1377,11 @@ void HassLwtSubscribe(bool hasslwt)
 
 bool Xdrv12(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_50_MSECOND) | bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
   bool hasslwt = HOME_ASSISTANT_LWT_SUBSCRIBE;
   if (Settings->flag.mqtt_enabled)
@@ -1246,6 +1409,11 @@ bool Xdrv12(uint8_t function)
         }
       }
       break;
+    case FUNC_EVERY_50_MSECOND:
+      if (HAss.step != HASS_STEP_IDLE) {
+        HAssDiscoveryStep();
+      }
+      break;
     case FUNC_ANY_KEY:
       HAssAnyKey();
       break;
@@ -1259,6 +1427,7 @@ bool Xdrv12(uint8_t function)
       break;
 */
     case FUNC_MQTT_SUBSCRIBE:
+      HAssHashClear();    // New session, the broker may have lost its retained configs
       HassLwtSubscribe(hasslwt);
       hass_mode = 0;      // Discovery only if Settings->flag.hass_discovery is set
       TasmotaGlobal.discovery_counter = (0 == Mqtt.initial_connection_state) ? 1 : 10; // Delayed discovery
@@ -320,6 +320,11 @@ bool MP3PlayerCmd(void) {
 
 bool Xdrv14(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   if (PinUsed(GPIO_MP3_DFR562)) {
@@ -1473,6 +1473,11 @@ void TuyaAddButton(void) {
 
 bool Xdrv16(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (TUYA_DIMMER == TasmotaGlobal.module_type) {
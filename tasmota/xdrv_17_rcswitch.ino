@@ -220,6 +220,11 @@ void CmndRfSend(void)
 
 bool Xdrv17(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_50_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (PinUsed(GPIO_RFSEND) || PinUsed(GPIO_RFRECV)) {
@@ -193,38 +193,55 @@ String HueUuid(void)
   return uuid;  // f6543a06-da50-11ba-8d8f-5ccf7f139f3d
 }
 
-void HueRespondToMSearch(void)
+// M-SEARCH response header and uuid only change with the IP address, so build them once
+struct {
+  String head;
+  String uuid;
+  uint32_t address = 0;
+} HueMSearch;
+
+// Send M-SEARCH response packet `index` (0..2), returns true if more packets are to be sent
+bool HueRespondToMSearch(uint32_t index)
 {
   char message[TOPSZ];
 
-  if (PortUdp.beginPacket(udp_remote_ip, udp_remote_port)) {
+  uint32_t address = (uint32_t)NetworkAddress();
+  if ((address != HueMSearch.address) || !HueMSearch.head.length()) {
+    UnishoxStrings msg(HUE_RESP_MSG);
+    char head[240];
+    snprintf_P(head, sizeof(head), msg[HUE_RESP_RESPONSE], NetworkAddress().toString().c_str(), HueBridgeId().c_str());
+    HueMSearch.head = head;
+    HueMSearch.uuid = HueUuid();
+    HueMSearch.address = address;
+  }
+
+  bool sent = false;
+  if ((index < 3) && PortUdp.beginPacket(udp_remote_ip, udp_remote_port)) {
     UnishoxStrings msg(HUE_RESP_MSG);
     char response[320];
-    snprintf_P(response, sizeof(response), msg[HUE_RESP_RESPONSE], NetworkAddress().toString().c_str(), HueBridgeId().c_str());
+    strlcpy(response, HueMSearch.head.c_str(), sizeof(response));
     int len = strlen(response);
-    String uuid = HueUuid();
-
-    snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST1], uuid.c_str());
-    PortUdp.write(response);
-    PortUdp.endPacket();
-    // AddLog(LOG_LEVEL_DEBUG_MORE, PSTR(D_LOG_UPNP "UDP resp=%s"), response);
+    const char *uuid = HueMSearch.uuid.c_str();
 
-    snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST2], uuid.c_str(), uuid.c_str());
-    PortUdp.write(response);
-    PortUdp.endPacket();
-    // AddLog(LOG_LEVEL_DEBUG_MORE, PSTR(D_LOG_UPNP "UDP resp=%s"), response);
-
-    snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST3], uuid.c_str());
+    switch (index) {
+      case 0: snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST1], uuid); break;
+      case 1: snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST2], uuid, uuid); break;
+      case 2: snprintf_P(response + len, sizeof(response) - len, msg[HUE_RESP_ST3], uuid); break;
+    }
     PortUdp.write(response);
-    PortUdp.endPacket();
+    sent = PortUdp.endPacket();
     // AddLog(LOG_LEVEL_DEBUG_MORE, PSTR(D_LOG_UPNP "UDP resp=%s"), response);
+  }
+  if (sent && (index < 2)) { return true; }
 
+  if (sent) {
     snprintf_P(message, sizeof(message), PSTR(D_3_RESPONSE_PACKETS_SENT));
   } else {
     snprintf_P(message, sizeof(message), PSTR(D_FAILED_TO_SEND_RESPONSE));
   }
   AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_UPNP D_HUE " %s " D_TO " %s:%d"),
     message, udp_remote_ip.toString().c_str(), udp_remote_port);
+  return false;
 }
 
 /*********************************************************************************************\
@@ -597,6 +614,99 @@ void HueLightStatus2(uint8_t device, String *response)
   *response += buf;
   free(buf);
 }
+
+// Signature of everything HueLightStatus1/2 depend on, used to invalidate cached fragments
+uint32_t HueLightSignature(uint8_t device)
+{
+  struct {
+    uint32_t power;
+    uint16_t hue;
+    uint16_t ct;
+    uint16_t prev_hue;
+    uint16_t shutter;
+    uint8_t  bri;
+    uint8_t  sat;
+    uint8_t  color_mode;
+    uint8_t  gotct;
+    uint8_t  prev_sat;
+    uint8_t  echo_gen;
+    uint8_t  subtype;
+  } state;
+  memset(&state, 0, sizeof(state));          // no random padding in hash
+
+  state.power = (TasmotaGlobal.power >> (device-1)) & 1;
+  state.bri = LightGetBri(device);
+  if (TasmotaGlobal.light_type) {
+    light_state.getHSB(&state.hue, &state.sat, nullptr);
+    state.ct = light_state.getCT();
+    state.color_mode = light_state.getColorMode();
+  }
+#ifdef USE_SHUTTER
+  if (ShutterState(device)) {
+    state.shutter = 0x100 | Settings->shutter_position[device-1];
+  }
+#endif
+  state.gotct = g_gotct;
+  state.prev_hue = prev_hue;
+  state.prev_sat = prev_sat;
+  state.echo_gen = findEchoGeneration();
+  state.subtype = getLocalLightSubtype(device);
+
+  uint32_t hash = 2166136261;                // FNV-1a
+  const uint8_t *data = (const uint8_t*)&state;
+  for (uint32_t i = 0; i < sizeof(state); i++) {
+    hash = (hash ^ data[i]) * 16777619;
+  }
+  const char *texts[4] = { prev_x_str, prev_y_str, Settings->user_template_name,
+                           SettingsText(SET_FRIENDLYNAME1 + ((device <= MAX_FRIENDLYNAMES) ? device : MAX_FRIENDLYNAMES) -1) };
+  for (uint32_t t = 0; t < 4; t++) {
+    for (const char *c = texts[t]; *c; c++) {
+      hash = (hash ^ (uint8_t)*c) * 16777619;
+    }
+    hash = (hash ^ 0xFF) * 16777619;         // separator
+  }
+  return hash;
+}
+
+#ifdef ESP32
+// Cache of the last generated `"<id>":{"state":...}` fragment per local light
+struct HUE_FRAGMENT {
+  uint32_t signature;
+  String json;
+};
+HUE_FRAGMENT *hue_fragments = nullptr;       // MAX_HUE_DEVICES entries, allocated on first use
+#endif  // ESP32
+
+// Stream the fragment of one local light through the chunked webserver writer
+void HueLightStream(uint8_t device)
+{
+#ifdef ESP32
+  if (nullptr == hue_fragments) {
+    hue_fragments = new HUE_FRAGMENT[MAX_HUE_DEVICES];
+  }
+  HUE_FRAGMENT &fragment = hue_fragments[device-1];
+  uint32_t signature = HueLightSignature(device);
+  if ((0 == fragment.json.length()) || (fragment.signature != signature)) {
+    fragment.json = "";
+    fragment.json += F("\"");
+    fragment.json += EncodeLightId(device);
+    fragment.json += F("\":{\"state\":");
+    HueLightStatus1(device, &fragment.json);
+    HueLightStatus2(device, &fragment.json);
+    fragment.signature = signature;
+  }
+  WSContentSend(fragment.json.c_str(), fragment.json.length());
+#else
+  String json((char*)nullptr);
+  json.reserve(512);                         // one light only
+  json += F("\"");
+  json += EncodeLightId(device);
+  json += F("\":{\"state\":");
+  HueLightStatus1(device, &json);
+  HueLightStatus2(device, &json);
+  WSContentSend(json.c_str(), json.length());
+#endif  // ESP32
+}
 #endif // USE_LIGHT
 
 // generate a unique lightId mixing local IP address and device number
@@ -667,21 +777,22 @@ inline uint32_t findEchoGeneration(void) {
 }
 
 void HueGlobalConfig(String *path) {
-  String response;
-
   path->remove(0,1);                                 // cut leading / to get <id>
-  response = F("{\"lights\":{");
+  WSContentBegin(200, CT_APP_JSON);
+  WSContentSend_P(PSTR("{\"lights\":{"));
   bool appending = false;                             // do we need to add a comma to append
 #ifdef USE_LIGHT
-  CheckHue(&response, appending);
+  CheckHue(appending);
 #endif // USE_LIGHT
 #ifdef USE_ZIGBEE
-  ZigbeeCheckHue(&response, appending);
+  ZigbeeCheckHue(appending);
 #endif // USE_ZIGBEE
-  response += F("},\"groups\":{},\"schedules\":{},\"config\":");
+  String response((char*)nullptr);
   HueConfigResponse(&response);
-  response += F("}");
-  WSSend(200, CT_APP_JSON, response);
+  WSContentSend_P(PSTR("},\"groups\":{},\"schedules\":{},\"config\":"));
+  WSContentSend(response.c_str(), response.length());
+  WSContentSend_P(PSTR("}"));
+  WSContentEnd();
 }
 
 void HueAuthentication(String *path)
@@ -694,17 +805,13 @@ void HueAuthentication(String *path)
 }
 
 #ifdef USE_LIGHT
-// refactored to remove code duplicates
-void CheckHue(String * response, bool &appending) {
+// refactored to remove code duplicates, streams all local lights
+void CheckHue(bool &appending) {
   uint8_t maxhue = (TasmotaGlobal.devices_present > MAX_HUE_DEVICES) ? MAX_HUE_DEVICES : TasmotaGlobal.devices_present;
   for (uint32_t i = 1; i <= maxhue; i++) {
     if (HueActive(i)) {
-      if (appending) { *response += ","; }
-      *response += F("\"");
-      *response += EncodeLightId(i);
-      *response += F("\":{\"state\":");
-      HueLightStatus1(i, response);
-      HueLightStatus2(i, response);
+      if (appending) { WSContentSend_P(PSTR(",")); }
+      HueLightStream(i);
       appending = true;
     }
   }
@@ -927,18 +1034,24 @@ void HueLights(String *path)
 
   path->remove(0,path->indexOf(F("/lights")));          // Remove until /lights
   if (path->endsWith(F("/lights"))) {                   // Got /lights
-    response = F("{");
+    // Stream the list so memory usage is bound to a single light
+    WSContentBegin(200, CT_APP_JSON);
+    WSContentSend_P(PSTR("{"));
     bool appending = false;
 #ifdef USE_LIGHT
-    CheckHue(&response, appending);
+    CheckHue(appending);
 #endif // USE_LIGHT
 #ifdef USE_ZIGBEE
-    ZigbeeCheckHue(&response, appending);
+    ZigbeeCheckHue(appending);
 #endif // USE_ZIGBEE
 #ifdef USE_SCRIPT_HUE
     Script_Check_Hue(&response);
+    WSContentSend(response.c_str(), response.length());
 #endif
-    response += F("}");
+    WSContentSend_P(PSTR("}"));
+    WSContentEnd();
+    AddLog(LOG_LEVEL_DEBUG_MORE, PSTR(D_LOG_HTTP D_HUE " Result (lights streamed)"));
+    return;
   }
   else if (path->endsWith(F("/state"))) {               // Got ID/state
     path->remove(0,8);                               // Remove /lights/
@@ -1082,6 +1195,11 @@ void HandleHueApi(String *path)
 
 bool Xdrv20(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
 #if defined(USE_SCRIPT_HUE) || defined(USE_ZIGBEE)
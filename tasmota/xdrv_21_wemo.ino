@@ -54,7 +54,7 @@ String WemoUuid(void)
   return String(uuid);
 }
 
-void WemoRespondToMSearch(int echo_type)
+bool WemoRespondToMSearch(int echo_type, uint32_t index)
 {
   char message[TOPSZ];
 
@@ -75,6 +75,7 @@ void WemoRespondToMSearch(int echo_type)
   }
   AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_UPNP D_WEMO " " D_JSON_TYPE " %d, %s " D_TO " %s:%d"),
     echo_type, message, udp_remote_ip.toString().c_str(), udp_remote_port);
+  return false;                        // single device, no more responses
 }
 
 /*********************************************************************************************\
@@ -344,6 +345,11 @@ void HandleUpnpSetupWemo(void)
 
 bool Xdrv21(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   if (TasmotaGlobal.devices_present && (EMUL_WEMO == Settings->flag2.emulation)) {
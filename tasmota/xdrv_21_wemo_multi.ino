@@ -417,10 +417,12 @@ public:
 WemoSwitch *wemoDevice[MAX_FRIENDLYNAMES] = {};
 int numOfWemoSwitch = 0;
 
-void WemoRespondToMSearch(int echo_type) {
-  for (uint32_t i = 0; i < numOfWemoSwitch; i++) {
-    wemoDevice[i]->WemoRespondToMSearch(echo_type);
+// Respond for emulated device `index`, returns true if more devices are to respond
+bool WemoRespondToMSearch(int echo_type, uint32_t index) {
+  if (index < numOfWemoSwitch) {
+    wemoDevice[index]->WemoRespondToMSearch(echo_type);
   }
+  return (index +1 < numOfWemoSwitch);
 }
 
 /*********************************************************************************************\
@@ -429,6 +431,11 @@ void WemoRespondToMSearch(int echo_type) {
 
 bool Xdrv21(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   if (TasmotaGlobal.devices_present && (EMUL_WEMO == Settings->flag2.emulation)) {
@@ -246,6 +246,11 @@ void SonoffIfanUpdate(void)
 
 bool Xdrv22(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_250_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (IsModuleIfan()) {
@@ -118,7 +118,9 @@ void ZigbeeHueStatus(String * response, uint16_t shortaddr) {
   HueLightStatus2Zigbee(shortaddr, response);
 }
 
-void ZigbeeCheckHue(String * response, bool &appending) {
+void ZigbeeCheckHue(bool &appending) {
+  // stream bulbs one at a time, memory usage is bound to a single bulb
+  String response((char*)nullptr);
   uint32_t zigbee_num = zigbee_devices.devicesSize();
   for (uint32_t i = 0; i < zigbee_num; i++) {
     uint16_t shortaddr = zigbee_devices.devicesAt(i).shortaddr;
@@ -126,12 +128,12 @@ void ZigbeeCheckHue(String * response, bool &appending) {
 
     if (bulbtype >= 0) {
       // this bulb is advertized
-      if (appending) { *response += ","; }
-      *response += "\"";
-      *response += EncodeLightId(0, shortaddr);
-      *response += F("\":{\"state\":");
-      HueLightStatus1Zigbee(shortaddr, bulbtype, response);    // TODO
-      HueLightStatus2Zigbee(shortaddr, response);
+      response = (appending) ? F(",\"") : F("\"");
+      response += EncodeLightId(0, shortaddr);
+      response += F("\":{\"state\":");
+      HueLightStatus1Zigbee(shortaddr, bulbtype, &response);    // TODO
+      HueLightStatus2Zigbee(shortaddr, &response);
+      WSContentSend(response.c_str(), response.length());
       appending = true;
     }
   }
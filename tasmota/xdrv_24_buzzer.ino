@@ -233,6 +233,11 @@ void CmndBuzzer(void) {
 \*********************************************************************************************/
 
 bool Xdrv24(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_100_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (Buzzer.active) {
@@ -197,6 +197,11 @@ void CmndDeepsleepTime(void)
 
 bool Xdrv29(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -780,6 +780,11 @@ void CmndPWMDimmerPWMs(void)
 
 bool Xdrv35(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (PWM_DIMMER != TasmotaGlobal.module_type) return result;
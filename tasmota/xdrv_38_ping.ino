@@ -367,6 +367,11 @@ void CmndPing(void) {
 
 bool Xdrv38(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_250_MSECOND);
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -29,6 +29,15 @@
 #define TCP_BRIDGE_BUF_SIZE    255  // size of the buffer, above 132 required for efficient XMODEM
 #endif
 
+#ifdef ESP32
+#ifndef TCP_BRIDGE_RING_SIZE
+#define TCP_BRIDGE_RING_SIZE   4096 // size of the ring buffer for each direction and of the UART receive buffer
+#endif
+#define TCP_BRIDGE_MAX_BAUDRATE 921600
+#else
+#define TCP_BRIDGE_MAX_BAUDRATE 115200
+#endif
+
 //const uint16_t tcp_port = 8880;
 WiFiServer   *server_tcp = nullptr;
 //WiFiClient   client_tcp1, client_tcp2;
@@ -42,24 +51,93 @@ TasmotaSerial *TCPSerial = nullptr;
 
 const char kTCPCommands[] PROGMEM = "TCP" "|"    // prefix
   "Start" "|" "Baudrate" "|" "Config"
+#ifdef ESP32
+  "|" "NoDelay" "|" "Stats"
+#endif
   ;
 
 void (* const TCPCommand[])(void) PROGMEM = {
   &CmndTCPStart, &CmndTCPBaudrate, &CmndTCPConfig
+#ifdef ESP32
+  , &CmndTCPNoDelay, &CmndTCPStats
+#endif
   };
 
-//
-// Called at event loop, checks for incoming data from the CC2530
-//
-void TCPLoop(void)
-{
-  uint8_t c;
-  bool busy;    // did we transfer some data?
-  int32_t buf_len;
+#ifdef ESP32
+#include "freertos/ringbuf.h"
+#include "driver/uart.h"
+
+struct {
+  RingbufHandle_t to_tcp = nullptr;     // serial to TCP clients
+  RingbufHandle_t to_serial = nullptr;  // TCP clients to serial
+  uint32_t to_tcp_bytes = 0;
+  uint32_t to_tcp_dropped = 0;          // bytes received from serial while the ring was full
+  uint32_t to_tcp_rate = 0;             // bytes per second
+  uint32_t to_tcp_last = 0;
+  uint32_t to_serial_bytes = 0;
+  uint32_t to_serial_throttled = 0;     // TCP reads postponed because the ring was full
+  uint32_t to_serial_rate = 0;          // bytes per second
+  uint32_t to_serial_last = 0;
+  int32_t port_request = -1;            // TCPStart port for the TCP task, -1 if none
+  bool serial_request = false;          // TCPBaudrate or TCPConfig for the serial task
+  bool nodelay = true;
+  bool nodelay_request = false;
+} TCPBridge;
+#endif  // ESP32
+
+uint32_t TCPGetBaudrate(void) {
+  return ((Settings->tcp_baudrate_msb << 8) | Settings->tcp_baudrate) * 1200;
+}
 
-  if (!TCPSerial) return;
+void TCPSetBaudrate(uint32_t baudrate) {
+  baudrate /= 1200;  // Make it a valid baudrate
+  Settings->tcp_baudrate = baudrate & 0xFF;
+  Settings->tcp_baudrate_msb = baudrate >> 8;
+}
 
-  // check for a new client connection
+bool TCPSerialBegin(void) {
+  if (!TCPSerial->begin(TCPGetBaudrate(), ConvertSerialConfig(0x7F & Settings->tcp_config))) { return false; }
+#ifdef ESP32
+  // hardware flow control, RTS is driven by the UART receive FIFO level
+  if (PinUsed(GPIO_TCP_RTS) || PinUsed(GPIO_TCP_CTS)) {
+    uint32_t uart = TCPSerial->getUart();
+    uart_hw_flowcontrol_t mode = UART_HW_FLOWCTRL_CTS_RTS;
+    if (!PinUsed(GPIO_TCP_CTS)) { mode = UART_HW_FLOWCTRL_RTS; }
+    if (!PinUsed(GPIO_TCP_RTS)) { mode = UART_HW_FLOWCTRL_CTS; }
+    uart_set_pin(uart, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE,
+                 PinUsed(GPIO_TCP_RTS) ? Pin(GPIO_TCP_RTS) : UART_PIN_NO_CHANGE,
+                 PinUsed(GPIO_TCP_CTS) ? Pin(GPIO_TCP_CTS) : UART_PIN_NO_CHANGE);
+    uart_set_hw_flow_ctrl(uart, mode, UART_FIFO_LEN - 16);
+  }
+#endif  // ESP32
+  return true;
+}
+
+void TCPServerStart(int32_t tcp_port) {
+  if (server_tcp) {
+    AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Stopping TCP server"));
+    server_tcp->stop();
+    delete server_tcp;
+    server_tcp = nullptr;
+
+    for (uint32_t i=0; i<nitems(client_tcp); i++) {
+      WiFiClient &client = client_tcp[i];
+      client.stop();
+    }
+  }
+  if (tcp_port > 0) {
+    AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Starting TCP server on port %d"), tcp_port);
+    if (ip_filter) {
+      AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Filtering %s"), ip_filter.toString().c_str());
+    }
+    server_tcp = new WiFiServer(tcp_port);
+    server_tcp->begin(); // start TCP server
+    server_tcp->setNoDelay(true);
+  }
+}
+
+// check for a new client connection
+void TCPAccept(void) {
   if ((server_tcp) && (server_tcp->hasClient())) {
     WiFiClient new_client = server_tcp->available();
 
@@ -73,6 +151,9 @@ void TCPLoop(void)
         AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Allowed through filter"));
       }
     }
+#ifdef ESP32
+    if (new_client) { new_client.setNoDelay(TCPBridge.nodelay); }
+#endif
 
     // find an empty slot
     uint32_t i;
@@ -90,6 +171,21 @@ void TCPLoop(void)
       client = new_client;
     }
   }
+}
+
+#ifdef ESP8266
+//
+// Called at event loop, checks for incoming data from the CC2530
+//
+void TCPLoop(void)
+{
+  uint8_t c;
+  bool busy;    // did we transfer some data?
+  int32_t buf_len;
+
+  if (!TCPSerial) return;
+
+  TCPAccept();
 
   do {
     busy = false;       // exit loop if no data was transferred
@@ -132,6 +228,105 @@ void TCPLoop(void)
     yield();    // avoid WDT if heavy traffic
   } while (busy);
 }
+#endif  // ESP8266
+
+#ifdef ESP32
+/*********************************************************************************************\
+ * ESP32 bridge tasks
+ *
+ * The serial task owns the UART, the TCP task owns the server and its clients. They exchange
+ * data in bulk through a ring buffer per direction, so nothing is lost while the main loop is
+ * busy. Commands only post requests the tasks pick up.
+\*********************************************************************************************/
+
+void TCPSerialTask(void *arg) {
+  uint8_t buf[TCP_BRIDGE_BUF_SIZE];
+
+  while (true) {
+    if (TCPBridge.serial_request) {
+      TCPBridge.serial_request = false;
+      TCPSerialBegin();
+    }
+    uint32_t uart = TCPSerial->getUart();
+
+    // serial to TCP, wait at most one tick for data
+    int32_t len = uart_read_bytes(uart, buf, sizeof(buf), 1);
+    if (len > 0) {
+      int32_t room = xRingbufferGetCurFreeSize(TCPBridge.to_tcp);
+      if (room > len) { room = len; }
+      if ((room > 0) && xRingbufferSend(TCPBridge.to_tcp, buf, room, 0)) {
+        len -= room;
+      }
+      TCPBridge.to_tcp_dropped += len;
+    }
+
+    // TCP to serial, blocks while CTS holds off transmission
+    size_t size;
+    uint8_t *data = (uint8_t*)xRingbufferReceiveUpTo(TCPBridge.to_serial, &size, 0, TCP_BRIDGE_BUF_SIZE);
+    if (data) {
+      uart_write_bytes(uart, (const char*)data, size);
+      vRingbufferReturnItem(TCPBridge.to_serial, data);
+      TCPBridge.to_serial_bytes += size;
+    }
+  }
+}
+
+void TCPClientTask(void *arg) {
+  uint8_t buf[TCP_BRIDGE_BUF_SIZE];
+
+  while (true) {
+    if (TCPBridge.port_request >= 0) {
+      TCPServerStart(TCPBridge.port_request);
+      TCPBridge.port_request = -1;
+    }
+    if (TCPBridge.nodelay_request) {
+      TCPBridge.nodelay_request = false;
+      for (uint32_t i=0; i<nitems(client_tcp); i++) {
+        if (client_tcp[i]) { client_tcp[i].setNoDelay(TCPBridge.nodelay); }
+      }
+    }
+    TCPAccept();
+
+    // serial to TCP, wait at most one tick for data
+    size_t size;
+    uint8_t *data = (uint8_t*)xRingbufferReceiveUpTo(TCPBridge.to_tcp, &size, 1, TCP_BRIDGE_BUF_SIZE);
+    if (data) {
+      for (uint32_t i=0; i<nitems(client_tcp); i++) {
+        WiFiClient &client = client_tcp[i];
+        if (client) { client.write(data, size); }
+      }
+      vRingbufferReturnItem(TCPBridge.to_tcp, data);
+      TCPBridge.to_tcp_bytes += size;
+    }
+
+    // TCP to serial, only read what fits so TCP flow control throttles the sender
+    for (uint32_t i=0; i<nitems(client_tcp); i++) {
+      WiFiClient &client = client_tcp[i];
+      if (!client) { continue; }
+      int32_t len = client.available();
+      if (len <= 0) { continue; }
+      int32_t room = xRingbufferGetCurFreeSize(TCPBridge.to_serial);
+      if (0 == room) {
+        TCPBridge.to_serial_throttled++;
+        break;
+      }
+      if (len > room) { len = room; }
+      if (len > (int32_t)sizeof(buf)) { len = sizeof(buf); }
+      len = client.read(buf, len);
+      if (len > 0) { xRingbufferSend(TCPBridge.to_serial, buf, len, 0); }
+    }
+  }
+}
+
+void TCPEverySecond(void) {
+  uint32_t bytes = TCPBridge.to_tcp_bytes;
+  TCPBridge.to_tcp_rate = bytes - TCPBridge.to_tcp_last;
+  TCPBridge.to_tcp_last = bytes;
+  bytes = TCPBridge.to_serial_bytes;
+  TCPBridge.to_serial_rate = bytes - TCPBridge.to_serial_last;
+  TCPBridge.to_serial_last = bytes;
+}
+#endif  // ESP32
 
 /********************************************************************************************/
 
@@ -139,15 +334,31 @@ void TCPInit(void) {
   if (PinUsed(GPIO_TCP_RX) && PinUsed(GPIO_TCP_TX)) {
     if (0 == (0x80 & Settings->tcp_config)) // !0x80 means unitialized
       Settings->tcp_config = 0x80 | ParseSerialConfig("8N1"); // default as 8N1 for backward compatibility
+#ifdef ESP8266
     tcp_buf = (uint8_t*) malloc(TCP_BRIDGE_BUF_SIZE);
     if (!tcp_buf) { AddLog(LOG_LEVEL_ERROR, PSTR(D_LOG_TCP "could not allocate buffer")); return; }
-
-    if (!Settings->tcp_baudrate)  { Settings->tcp_baudrate = 115200 / 1200; }
+#endif  // ESP8266
+
+    if (!TCPGetBaudrate())  { TCPSetBaudrate(115200); }
+#ifdef ESP32
+    TCPSerial = new TasmotaSerial(Pin(GPIO_TCP_RX), Pin(GPIO_TCP_TX), TasmotaGlobal.seriallog_level ? 1 : 2, 0, TCP_BRIDGE_RING_SIZE);
+    TCPBridge.to_tcp = xRingbufferCreate(TCP_BRIDGE_RING_SIZE, RINGBUF_TYPE_BYTEBUF);
+    TCPBridge.to_serial = xRingbufferCreate(TCP_BRIDGE_RING_SIZE, RINGBUF_TYPE_BYTEBUF);
+    if (!TCPSerialBegin() || !TCPBridge.to_tcp || !TCPBridge.to_serial) {
+      AddLog(LOG_LEVEL_ERROR, PSTR(D_LOG_TCP "could not start bridge"));
+      delete TCPSerial;
+      TCPSerial = nullptr;
+      return;
+    }
+    xTaskCreatePinnedToCore(TCPSerialTask, "TCPS", 3072, nullptr, 2, nullptr, ARDUINO_RUNNING_CORE);
+    xTaskCreatePinnedToCore(TCPClientTask, "TCPC", 4096, nullptr, 2, nullptr, ARDUINO_RUNNING_CORE);
+#else
     TCPSerial = new TasmotaSerial(Pin(GPIO_TCP_RX), Pin(GPIO_TCP_TX), TasmotaGlobal.seriallog_level ? 1 : 2, 0, TCP_BRIDGE_BUF_SIZE);   // set a receive buffer of 256 bytes
-    TCPSerial->begin(Settings->tcp_baudrate * 1200, ConvertSerialConfig(0x7F & Settings->tcp_config));
+    TCPSerialBegin();
     if (TCPSerial->hardwareSerial()) {
       ClaimSerial();
 		}
+#endif  // ESP32
   }
 }
 
@@ -172,37 +383,21 @@ void CmndTCPStart(void) {
     ip_filter = (uint32_t)0;
   }
 
-  if (server_tcp) {
-    AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Stopping TCP server"));
-    server_tcp->stop();
-    delete server_tcp;
-    server_tcp = nullptr;
-
-    for (uint32_t i=0; i<nitems(client_tcp); i++) {
-      WiFiClient &client = client_tcp[i];
-      client.stop();
-    }
-  }
-  if (tcp_port > 0) {
-    AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Starting TCP server on port %d"), tcp_port);
-    if (ip_filter) {
-      AddLog(LOG_LEVEL_INFO, PSTR(D_LOG_TCP "Filtering %s"), ip_filter.toString().c_str());
-    }
-    server_tcp = new WiFiServer(tcp_port);
-    server_tcp->begin(); // start TCP server
-    server_tcp->setNoDelay(true);
-  }
+#ifdef ESP32
+  TCPBridge.port_request = (tcp_port > 0) ? tcp_port : 0;
+#else
+  TCPServerStart(tcp_port);
+#endif
 
   ResponseCmndDone();
 }
 
 void CmndTCPBaudrate(void) {
-  if ((XdrvMailbox.payload >= 1200) && (XdrvMailbox.payload <= 115200)) {
-    XdrvMailbox.payload /= 1200;  // Make it a valid baudrate
-    Settings->tcp_baudrate = XdrvMailbox.payload;
-    TCPSerial->begin(Settings->tcp_baudrate * 1200, ConvertSerialConfig(0x7F & Settings->tcp_config));  // Reinitialize serial port with new baud rate
+  if ((XdrvMailbox.payload >= 1200) && (XdrvMailbox.payload <= TCP_BRIDGE_MAX_BAUDRATE)) {
+    TCPSetBaudrate(XdrvMailbox.payload);
+    TCPSerialReconfigure();
   }
-  ResponseCmndNumber(Settings->tcp_baudrate * 1200);
+  ResponseCmndNumber(TCPGetBaudrate());
 }
 
 void CmndTCPConfig(void) {
@@ -210,12 +405,51 @@ void CmndTCPConfig(void) {
     uint8_t serial_config = ParseSerialConfig(XdrvMailbox.data);
     if (serial_config >= 0) {
       Settings->tcp_config = 0x80 | serial_config; // default 0x00 should be 8N1
-      TCPSerial->begin(Settings->tcp_baudrate * 1200, ConvertSerialConfig(0x7F & Settings->tcp_config));  // Reinitialize serial port with new config
+      TCPSerialReconfigure();
     }
   }
   ResponseCmndChar_P(GetSerialConfig(0x7F & Settings->tcp_config).c_str());
 }
 
+// Reinitialize serial port with new baud rate or config
+void TCPSerialReconfigure(void) {
+  if (!TCPSerial) { return; }
+#ifdef ESP32
+  TCPBridge.serial_request = true;
+#else
+  TCPSerialBegin();
+#endif
+}
+
+#ifdef ESP32
+//
+// Command `TCPNoDelay`
+// Params: 0 = use Nagle's algorithm to send fewer and larger packets, 1 = send immediately (default)
+//
+void CmndTCPNoDelay(void) {
+  if ((XdrvMailbox.payload >= 0) && (XdrvMailbox.payload <= 1)) {
+    TCPBridge.nodelay = XdrvMailbox.payload;
+    TCPBridge.nodelay_request = true;
+  }
+  ResponseCmndStateText(TCPBridge.nodelay);
+}
+
+//
+// Command `TCPStats`
+// Params: 0 = reset counters
+//
+void CmndTCPStats(void) {
+  if (0 == XdrvMailbox.payload) {
+    TCPBridge.to_tcp_dropped = 0;
+    TCPBridge.to_serial_throttled = 0;
+  }
+  Response_P(PSTR("{\"%s\":{\"ToTCP\":{\"Bytes\":%u,\"Rate\":%u,\"Dropped\":%u},\"ToSerial\":{\"Bytes\":%u,\"Rate\":%u,\"Throttled\":%u}}}"),
+    XdrvMailbox.command,
+    TCPBridge.to_tcp_bytes, TCPBridge.to_tcp_rate, TCPBridge.to_tcp_dropped,
+    TCPBridge.to_serial_bytes, TCPBridge.to_serial_rate, TCPBridge.to_serial_throttled);
+}
+#endif  // ESP32
+
 /*********************************************************************************************\
  * Interface
 \*********************************************************************************************/
@@ -225,9 +459,15 @@ bool Xdrv41(uint8_t function)
   bool result = false;
 
   switch (function) {
+#ifdef ESP32
+    case FUNC_EVERY_SECOND:
+      if (TCPSerial) { TCPEverySecond(); }
+      break;
+#else
     case FUNC_LOOP:
       TCPLoop();
       break;
+#endif  // ESP32
     case FUNC_PRE_INIT:
       TCPInit();
       break;
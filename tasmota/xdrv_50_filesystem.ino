@@ -1078,6 +1078,11 @@ void UfsEditorUpload(void) {
 \*********************************************************************************************/
 
 bool Xdrv50(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -83,6 +83,9 @@ public:
 \*********************************************************************************************/
 class BerryLog;
 
+// Frequent events dispatched natively to Berry drivers, see kBerryDriverEvents
+enum BerryDriverEvents { BE_EV_EVERY_50MS, BE_EV_EVERY_100MS, BE_EV_EVERY_SECOND, BE_EV_WEB_SENSOR, BE_EV_JSON_APPEND, BE_EV_MAX };
+
 class BerrySupport {
 public:
   bvm *vm = nullptr;                    // berry vm
@@ -90,6 +93,9 @@ public:
   bool rules_busy = false;              // are we already processing rules, avoid infinite loop
   bool autoexec_done = false;           // do we still need to load 'autoexec.be'
   bool repl_active = false;             // is REPL running (activates log recording)
+  bool events_valid = false;            // is the driver event cache below valid
+  uint32_t events_signature = 0;        // signature of `tasmota._drivers` when the cache was built
+  uint32_t events_drivers[BE_EV_MAX];   // per event, bit mask of the positions in `tasmota._drivers` implementing it
   // output log is stored as a LinkedList of buffers
   // and active only when a REPL command is running
   BerryLog log;
@@ -108,19 +108,17 @@ extern "C" {
   int be_call_c_func(bvm *vm, void * func, const char * return_type, const char * arg_type);
 
   // native closure to call `be_call_c_func`
+  // the upval points to the method definition, so that `be_call_c_func` receives
+  // the constant type descriptors and can use their precompiled signature
   int lvx_call_c(bvm *vm) {
     // berry_log_C("lvx_call_c enter");
     // keep parameters unchanged
     be_getupval(vm, 0, 0);    // if index is zero, it's the current native closure
-    void * func = be_tocomptr(vm, -1);
-    be_getupval(vm, 0, 1);    // if index is zero, it's the current native closure
-    const char * return_type = be_tostring(vm, -1);
-    be_getupval(vm, 0, 2);    // if index is zero, it's the current native closure
-    const char * arg_type = be_tostring(vm, -1);
-    be_pop(vm, 3);            // remove 3 upvals
-
-    // berry_log_C("lvx_call_c %p '%s' <- (%s)", func, return_type, arg_type);
-    return be_call_c_func(vm, func, return_type, arg_type);
+    const be_ntv_func_def_t * method = (const be_ntv_func_def_t *) be_tocomptr(vm, -1);
+    be_pop(vm, 1);            // remove upval
+
+    // berry_log_C("lvx_call_c %p '%s' <- (%s)", method->func, method->return_type, method->arg_type);
+    return be_call_c_func(vm, method->func, method->return_type, method->arg_type);
   }
 
   // virtual method, arg1: instance, arg2: name of method
@@ -144,20 +142,12 @@ extern "C" {
             const be_ntv_func_def_t * method = &methods_calls[method_idx];
             // berry_log_C("lvx_member method found func=%p return_type=%s arg_type=%s", method->func, method->return_type, method->arg_type);
             // push native closure
-            be_pushntvclosure(vm, &lvx_call_c, 3);   // 3 upvals
+            be_pushntvclosure(vm, &lvx_call_c, 1);   // 1 upval
 
-            be_pushcomptr(vm, method->func);
+            be_pushcomptr(vm, (void*) method);
             be_setupval(vm, -2, 0);
             be_pop(vm, 1);
 
-            be_pushstring(vm, method->return_type);
-            be_setupval(vm, -2, 1);
-            be_pop(vm, 1);
-
-            be_pushstring(vm, method->arg_type);
-            be_setupval(vm, -2, 2);
-            be_pop(vm, 1);
-
             // all good
             be_return(vm);
           }
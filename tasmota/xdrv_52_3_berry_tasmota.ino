@@ -67,6 +67,37 @@ const uint32_t BERRY_MAX_REPL_LOGS = 1024;   // max number of print output recor
  * tasmota.set_light(idx:int, values:map) -> map
  *
 \*********************************************************************************************/
+
+// Find the value designated by a rule trigger, ex: "Power1#State"
+// Keys are case-insensitive and '?' matches any key, returns an invalid token if not found
+// If `tele` is true, the payload is considered wrapped as `{"Tele": payload}`
+JsonParserToken BerryRuleFind(JsonParserToken tok, const char * trigger, bool tele) {
+  const char * seg = trigger;
+  while (true) {
+    const char * sep = strchr(seg, '#');
+    size_t seg_len = (sep != nullptr) ? sep - seg : strlen(seg);
+    bool any = (1 == seg_len) && ('?' == seg[0]);
+    if (tele) {
+      tele = false;
+      if (!any && !((4 == seg_len) && (0 == strncasecmp_P(seg, PSTR("Tele"), 4)))) { return JsonParserToken(); }
+    } else {
+      if (!tok.isObject()) { return JsonParserToken(); }
+      JsonParserToken found;
+      for (auto key : JsonParserObject(tok)) {
+        const char * k = key.getStr();
+        if (any || ((0 == strncasecmp(k, seg, seg_len)) && (0 == k[seg_len]))) {
+          found = key.getValue();
+          break;
+        }
+      }
+      if (!found) { return found; }
+      tok = found;
+    }
+    if (nullptr == sep) { return tok; }
+    seg = sep + 1;
+  }
+}
+
 extern "C" {
   // Berry: `tasmota.publish(topic, payload [,retain]) -> nil``
   //
@@ -481,6 +512,65 @@ extern "C" {
     be_return(vm); // Return
   }
 
+  // Berry: `tasmota._rule_values(payload:string, rules:list [, tele:bool]) -> list or nil`
+  //
+  // For each rule `[pattern, f, trigger, op, value]` returns the raw JSON of the value
+  // designated by the trigger, or nil if absent. The payload is tokenized once and only
+  // the triggers are looked up. Returns nil if the payload can't be tokenized, in which
+  // case the caller decodes it entirely.
+  int32_t l_rulevalues(bvm *vm);
+  int32_t l_rulevalues(bvm *vm) {
+    int32_t top = be_top(vm); // Get the number of arguments
+    if (top >= 3 && be_isstring(vm, 2) && be_isinstance(vm, 3)) {
+      const char * payload = be_tostring(vm, 2);
+      bool tele = (top >= 4) && be_tobool(vm, 4);
+      size_t payload_len = strlen(payload);
+      if (payload_len >= 2047) { be_return_nil(vm); }   // beyond the offsets of the tokenizer
+      char * json = (char*) malloc(payload_len + 1);
+      if (nullptr == json) { be_return_nil(vm); }
+      strcpy(json, payload);
+
+      JsonParser parser(json);
+      JsonParserToken root = parser.getRoot();
+      JsonParserToken end = root;
+      end.skipToken();
+      if (!root || end) {                   // invalid JSON, or more than 63 items in an object or array
+        free(json);
+        be_return_nil(vm);
+      }
+
+      int32_t size = be_data_size(vm, 3);
+      be_newobject(vm, "list");
+      for (int32_t i = 0; i < size; i++) {
+        be_pushint(vm, i);
+        be_getindex(vm, 3);                 // rule
+        be_pushint(vm, 2);
+        be_getindex(vm, -2);                // trigger
+        JsonParserToken val;
+        if (be_isstring(vm, -1)) {
+          val = BerryRuleFind(root, be_tostring(vm, -1), tele);
+        }
+        be_pop(vm, 4);
+        if (val) {
+          const jsmntok_t * t = val.t;
+          if (val.isStr() || val.isKey()) {
+            be_pushnstring(vm, payload + t->start - 1, t->len + 2);   // include quotes
+          } else {
+            be_pushnstring(vm, payload + t->start, t->len);
+          }
+        } else {
+          be_pushnil(vm);
+        }
+        be_data_push(vm, -2);
+        be_pop(vm, 1);
+      }
+      be_pop(vm, 1);
+      free(json);
+      be_return(vm); // Return
+    }
+    be_raise(vm, kTypeError, nullptr);
+  }
+
 #ifdef USE_I2C
   // I2C specific
   // Berry: `i2c_enabled(index:int) -> bool` is I2C device enabled
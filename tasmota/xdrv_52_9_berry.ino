@@ -24,6 +24,10 @@
 
 #include <berry.h>
 #include "be_vm.h"
+#include "be_list.h"
+#include "be_gc.h"
+#include "be_class.h"
+#include "be_string.h"
 #include "ZipReadFS.h"
 
 extern "C" {
@@ -32,14 +36,15 @@ extern "C" {
 }
 
 const char kBrCommands[] PROGMEM = D_PRFX_BR "|"    // prefix
-  D_CMND_BR_RUN
+  D_CMND_BR_RUN "|" D_CMND_BR_MEM
   ;
 
 void (* const BerryCommand[])(void) PROGMEM = {
-  CmndBrRun,
+  CmndBrRun, CmndBrMem,
   };
 
 int32_t callBerryEventDispatcher(const char *type, const char *cmd, int32_t idx, const char *payload, uint32_t data_len = 0);
+int32_t BerryEventDispatch(const char *type, const char *cmd, int32_t idx, const char *payload, uint32_t data_len);
 
 //
 // Sanity Check for be_top()
@@ -135,6 +140,13 @@ size_t callBerryGC(void) {
 // call the event dispatcher from Tasmota object
 // if data_len is non-zero, the event is also sent as raw `bytes()` object because the string may lose data
 int32_t callBerryEventDispatcher(const char *type, const char *cmd, int32_t idx, const char *payload, uint32_t data_len) {
+  PROFILE_STATS_START(profile_stats_start);
+  int32_t ret = BerryEventDispatch(type, cmd, idx, payload, data_len);
+  PROFILE_STATS(PRF_BERRY, 0, 0, type, profile_stats_start);   // `type` must be a constant string
+  return ret;
+}
+
+int32_t BerryEventDispatch(const char *type, const char *cmd, int32_t idx, const char *payload, uint32_t data_len) {
   int32_t ret = 0;
   bvm *vm = berry.vm;
 
@@ -175,6 +187,143 @@ int32_t callBerryEventDispatcher(const char *type, const char *cmd, int32_t idx,
   return ret;
 }
 
+/*********************************************************************************************\
+ * Native dispatch of frequent events to Berry drivers
+ *
+ * `tasmota.event()` looks up the method of every driver with `introspect.get()` on each call.
+ * For the events below, the drivers implementing them are cached as a bit mask per event and
+ * called directly. The cache is rebuilt when `tasmota._drivers` changes or after Berry code was
+ * loaded or run from console, as classes may have changed.
+\*********************************************************************************************/
+
+const char kBerryDriverEvents[] PROGMEM = "every_50ms|every_100ms|every_second|web_sensor|json_append";
+
+// Signature of the `tasmota._drivers` list on top of stack, 0 if no drivers
+uint32_t BerryDriversSignature(bvm *vm) {
+  bvalue *v = be_indexof(vm, -1);
+  if (!var_islist(v)) { return 0; }
+  blist *list = (blist*)var_toobj(v);
+  uint32_t signature = be_list_count(list);
+  for (uint32_t i = 0; i < be_list_count(list); i++) {
+    signature = signature * 31 + (uint32_t)var_toobj(be_list_at(list, i));
+  }
+  return signature;
+}
+
+// Build the event cache from the `tasmota._drivers` list on top of stack
+void BerryDriverEventsBuild(bvm *vm) {
+  memset(berry.events_drivers, 0, sizeof(berry.events_drivers));
+  berry.events_signature = BerryDriversSignature(vm);
+  berry.events_valid = true;
+
+  int32_t size = be_data_size(vm, -1);
+  if (size > 32) {                        // too many drivers for the bit mask, let `tasmota.event()` handle it
+    berry.events_valid = false;
+    return;
+  }
+  char event[16];
+  for (int32_t i = 0; i < size; i++) {
+    be_pushint(vm, i);
+    be_getindex(vm, -2);
+    if (be_isinstance(vm, -1)) {
+      for (uint32_t ev = 0; ev < BE_EV_MAX; ev++) {
+        be_getmember(vm, -1, GetTextIndexed(event, sizeof(event), ev, kBerryDriverEvents));
+        if (be_isfunction(vm, -1)) { berry.events_drivers[ev] |= (1 << i); }
+        be_pop(vm, 1);
+      }
+    }
+    be_pop(vm, 2);
+  }
+}
+
+int32_t callBerryDriverEvent(uint32_t ev) {
+  int32_t ret = 0;
+  bvm *vm = berry.vm;
+
+  if (nullptr == vm) { return ret; }
+  PROFILE_STATS_START(profile_stats_start);
+  checkBeTop();
+  char event[16];
+  GetTextIndexed(event, sizeof(event), ev, kBerryDriverEvents);
+
+  be_getglobal(vm, PSTR("tasmota"));
+  if (!be_isnil(vm, -1)) {
+    be_getmember(vm, -1, PSTR("_drivers"));
+    bool valid = berry.events_valid && (BerryDriversSignature(vm) == berry.events_signature);
+    if (!valid) {
+      BerryDriverEventsBuild(vm);
+    }
+    if (!berry.events_valid) {            // more drivers than the cache handles, `tasmota.event()` also runs deferred events
+      be_pop(vm, 2);
+      ret = BerryEventDispatch(event, nullptr, 0, nullptr, 0);
+      PROFILE_STATS(PRF_BERRY, ev +1, 0, kBerryDriverEvents, profile_stats_start);
+      return ret;
+    }
+
+    if (BE_EV_EVERY_50MS == ev) {         // first run deferred events
+      be_pop(vm, 1);                      // remove drivers, deferred events may change them
+      be_getmember(vm, -1, PSTR("_timers"));
+      bool timers = (be_data_size(vm, -1) > 0);
+      be_pop(vm, 1);
+      if (timers) {
+        be_getmethod(vm, -1, PSTR("run_deferred"));
+        be_pushvalue(vm, -2);
+        BrTimeoutStart();
+        int32_t err = be_pcall(vm, 1);
+        BrTimeoutReset();
+        if (err) {
+          be_error_pop_all(vm);           // clear Berry stack
+          return err;
+        }
+        be_pop(vm, 2);
+      }
+      be_getmember(vm, -1, PSTR("_drivers"));
+      if (!berry.events_valid || (BerryDriversSignature(vm) != berry.events_signature)) {
+        BerryDriverEventsBuild(vm);
+        if (!berry.events_valid) {        // too many drivers now, skip this tick rather than run deferred events twice
+          be_pop(vm, 2);
+          checkBeTop();
+          return ret;
+        }
+      }
+    }
+
+    uint32_t drivers = berry.events_drivers[ev];
+    for (uint32_t i = 0; drivers; i++, drivers >>= 1) {
+      if (!(drivers & 1)) { continue; }
+      int32_t top = be_top(vm);
+      be_pushint(vm, i);
+      be_getindex(vm, -2);                // driver instance
+      be_getmember(vm, -1, event);
+      if (be_isfunction(vm, -1)) {
+        be_pushvalue(vm, -2);             // add instance as first arg
+        be_pushstring(vm, "");
+        be_pushint(vm, 0);
+        be_pushstring(vm, "");
+        BrTimeoutStart();
+        int32_t err = be_pcall(vm, 4);
+        BrTimeoutReset();
+        if (err) {
+          // log the exception and go on with next driver, like `tasmota.event()`
+          if (vm->obshook != NULL) { (*vm->obshook)(vm, BE_OBS_PCALL_ERROR); }
+          be_pop(vm, be_top(vm) - top);
+          continue;
+        }
+        be_pop(vm, 4);
+        ret = be_tobool(vm, -1);
+      }
+      be_pop(vm, 3);                      // remove method or result, instance and index
+      if (ret) { break; }
+      if (BerryDriversSignature(vm) != berry.events_signature) { break; }   // drivers changed while running
+    }
+    be_pop(vm, 1);                        // remove drivers
+  }
+  be_pop(vm, 1);                          // remove instance object
+  checkBeTop();
+  PROFILE_STATS(PRF_BERRY, ev +1, 0, kBerryDriverEvents, profile_stats_start);
+  return ret;
+}
+
 /*********************************************************************************************\
  * VM Observability
 \*********************************************************************************************/
@@ -255,6 +404,7 @@ void BrShowState(void) {
  * VM Init
 \*********************************************************************************************/
 void BerryInit(void) {
+  berry.events_valid = false;
   // clean previous VM if any
   if (berry.vm != nullptr) {
     be_vm_delete(berry.vm);
@@ -268,6 +418,7 @@ void BerryInit(void) {
     be_set_obs_hook(berry.vm, &BerryObservability);  /* attach observability hook */
     comp_set_named_gbl(berry.vm);  /* Enable named globals in Berry compiler */
     comp_set_strict(berry.vm);  /* Enable strict mode in Berry compiler, equivalent of `import strict` */
+    comp_set_optimize(berry.vm);  /* Fold constants and remove dead code and jumps to jumps in compiled code */
 
     be_load_custom_libs(berry.vm);  // load classes and modules
 
@@ -321,6 +472,7 @@ void BerryInit(void) {
 \*********************************************************************************************/
 void BrLoad(const char * script_name) {
   if (berry.vm == nullptr || TasmotaGlobal.no_autoexec) { return; }   // abort is berry is not running, or bootloop prevention kicked in
+  berry.events_valid = false;           // classes may change
 
   int32_t ret_code1, ret_code2;
   bool berry_init_ok = false;
@@ -356,6 +508,7 @@ void CmndBrRun(void) {
   const char * ret_type, * ret_val;
 
   if (berry.vm == nullptr) { ResponseCmndChar_P(PSTR(D_BR_NOT_STARTED)); return; }
+  berry.events_valid = false;           // classes may change
 
   char br_cmd[XdrvMailbox.data_len+12];
   // encapsulate into a function, copied from `be_repl.c` / `try_return()`
@@ -398,6 +551,154 @@ void CmndBrRun(void) {
   checkBeTop();
 }
 
+//
+// Command `BrMem`
+//
+// `BrMem`       dump a snapshot of the Berry heap after a full GC: bytes and counts per type,
+//               instances per class, string table, largest objects and sampled allocation sites
+// `BrMem <n>`   sample one allocation out of <n> and remember the enclosing function
+// `BrMem 0`     stop sampling and release the sampling table
+//
+#define BR_MEM_CLASSES      24      // distinct classes tracked, others are counted as "..."
+#define BR_MEM_CLASSES_OUT  8       // classes reported, by decreasing size
+#define BR_MEM_LARGEST      5       // largest objects reported
+
+typedef struct {
+  const char * name;
+  uint32_t count;
+  uint32_t bytes;
+} br_mem_entry_t;
+
+static const char * BrMemTypeName(int type) {
+  switch (type) {
+    case BE_STRING:   return PSTR("string");
+    case BE_CLASS:    return PSTR("class");
+    case BE_INSTANCE: return PSTR("instance");
+    case BE_PROTO:    return PSTR("proto");
+    case BE_LIST:     return PSTR("list");
+    case BE_MAP:      return PSTR("map");
+    case BE_MODULE:   return PSTR("module");
+    case BE_COMOBJ:   return PSTR("comobj");
+    case BE_CLOSURE:  return PSTR("closure");
+    case BE_NTVCLOS:  return PSTR("ntvclos");
+    case BE_COROUTINE: return PSTR("coroutine");
+    default:          return PSTR("other");
+  }
+}
+
+// add `bytes` to the entry called `name`, using the last entry as overflow when the table is full
+static void BrMemAdd(br_mem_entry_t * table, uint32_t * used, uint32_t size, const char * name, uint32_t bytes) {
+  uint32_t i;
+  for (i = 0; i < *used; i++) {
+    if (strcmp(table[i].name, name) == 0) { break; }
+  }
+  if (i == *used) {
+    if (*used < size) {
+      table[i].name = name;
+      table[i].count = 0;
+      table[i].bytes = 0;
+      (*used)++;
+    } else {
+      i = size - 1;
+      table[i].name = PSTR("...");
+    }
+  }
+  table[i].count++;
+  table[i].bytes += bytes;
+}
+
+static void BrMemAppend(const char * label, br_mem_entry_t * table, uint32_t used, uint32_t max_out) {
+  // sort by decreasing size, tables are small
+  for (uint32_t i = 1; i < used; i++) {
+    br_mem_entry_t e = table[i];
+    uint32_t j = i;
+    for (; j > 0 && table[j-1].bytes < e.bytes; j--) { table[j] = table[j-1]; }
+    table[j] = e;
+  }
+  ResponseAppend_P(PSTR(",\"%s\":{"), label);
+  for (uint32_t i = 0; i < used && i < max_out; i++) {
+    ResponseAppend_P(PSTR("%s\"%s\":[%u,%u]"), i ? "," : "", table[i].name, table[i].count, table[i].bytes);
+  }
+  ResponseAppend_P(PSTR("}"));
+}
+
+void CmndBrMem(void) {
+  bvm * vm = berry.vm;
+  if (vm == nullptr) { ResponseCmndChar_P(PSTR(D_BR_NOT_STARTED)); return; }
+
+  if (XdrvMailbox.data_len > 0) {
+    be_gc_sampling(vm, XdrvMailbox.payload);
+  }
+  be_gc_collect(vm);                    // only report what is still reachable
+
+  br_mem_entry_t types[12];
+  uint32_t types_used = 0;
+  br_mem_entry_t classes[BR_MEM_CLASSES];
+  uint32_t classes_used = 0;
+  struct {
+    bgcobject * obj;
+    uint32_t bytes;
+  } largest[BR_MEM_LARGEST] = {};
+  uint32_t objects = 0;
+
+  for (bgcobject * o = vm->gc.list; o != nullptr; o = o->next) {
+    uint32_t bytes = be_gc_objsize(o);
+    objects++;
+    BrMemAdd(types, &types_used, nitems(types), BrMemTypeName(o->type), bytes);
+    if (BE_INSTANCE == o->type) {
+      binstance * ins = cast_instance(o);
+      BrMemAdd(classes, &classes_used, BR_MEM_CLASSES, str(be_class_name(ins->_class)), bytes);
+    }
+    // keep the largest objects, sorted by decreasing size
+    for (uint32_t i = 0; i < BR_MEM_LARGEST; i++) {
+      if (bytes > largest[i].bytes) {
+        for (uint32_t j = BR_MEM_LARGEST - 1; j > i; j--) { largest[j] = largest[j-1]; }
+        largest[i].obj = o;
+        largest[i].bytes = bytes;
+        break;
+      }
+    }
+  }
+
+  // short strings live in the string table, not in the GC list
+  uint32_t str_bytes = vm->strtab.size * sizeof(bstring*);
+  for (int32_t i = 0; i < vm->strtab.size; i++) {
+    for (bstring * s = vm->strtab.table[i]; s != nullptr; s = (bstring*) s->next) {
+      str_bytes += be_gc_objsize(gc_object(s));
+    }
+  }
+
+  Response_P(PSTR("{\"" D_PRFX_BR D_CMND_BR_MEM "\":{\"Usage\":%u,\"Objects\":%u"), vm->gc.usage, objects);
+  BrMemAppend(PSTR("Types"), types, types_used, types_used);
+  BrMemAppend(PSTR("Classes"), classes, classes_used, BR_MEM_CLASSES_OUT);
+  ResponseAppend_P(PSTR(",\"Strings\":{\"Count\":%i,\"Buckets\":%i,\"Bytes\":%u},\"Largest\":["),
+                   vm->strtab.count, vm->strtab.size, str_bytes);
+  for (uint32_t i = 0; i < BR_MEM_LARGEST && largest[i].obj; i++) {
+    bgcobject * o = largest[i].obj;
+    const char * cl_name = (BE_INSTANCE == o->type) ? str(be_class_name(cast_instance(o)->_class)) :
+                           (BE_CLASS == o->type) ? str(be_class_name(cast_class(o))) : "";
+    ResponseAppend_P(PSTR("%s[\"%s\",\"%s\",%u]"), i ? "," : "", BrMemTypeName(o->type), cl_name, largest[i].bytes);
+  }
+  ResponseAppend_P(PSTR("]"));
+
+  struct bgcsampler * sampler = vm->gc.sampler;
+  if (sampler) {
+    // live sampled objects per allocation site, each one stands for about `rate` allocations
+    br_mem_entry_t sites[GC_SAMPLE_SLOTS];
+    uint32_t sites_used = 0;
+    for (uint32_t i = 0; i < GC_SAMPLE_SLOTS; i++) {
+      if (sampler->slot[i].obj) {
+        BrMemAdd(sites, &sites_used, GC_SAMPLE_SLOTS, sampler->slot[i].site, be_gc_objsize(sampler->slot[i].obj));
+      }
+    }
+    ResponseAppend_P(PSTR(",\"Sampling\":%i"), sampler->rate);
+    BrMemAppend(PSTR("Sites"), sites, sites_used, sites_used);
+  } else {
+    ResponseAppend_P(PSTR(",\"Sampling\":0"));
+  }
+  ResponseAppend_P(PSTR("}}"));
+}
+
 /*********************************************************************************************\
  * Berry console
 \*********************************************************************************************/
@@ -405,6 +706,7 @@ void CmndBrRun(void) {
 
 void BrREPLRun(char * cmd) {
   if (berry.vm == nullptr) { return; }
+  berry.events_valid = false;           // classes may change
 
   size_t cmd_len = strlen(cmd);
   size_t cmd2_len = cmd_len + 12;
@@ -748,13 +1050,13 @@ bool Xdrv52(uint8_t function)
 
     // Module specific events
     case FUNC_EVERY_50_MSECOND:
-      callBerryEventDispatcher(PSTR("every_50ms"), nullptr, 0, nullptr);
+      callBerryDriverEvent(BE_EV_EVERY_50MS);
       break;
     case FUNC_EVERY_100_MSECOND:
-      callBerryEventDispatcher(PSTR("every_100ms"), nullptr, 0, nullptr);
+      callBerryDriverEvent(BE_EV_EVERY_100MS);
       break;
     case FUNC_EVERY_SECOND:
-      callBerryEventDispatcher(PSTR("every_second"), nullptr, 0, nullptr);
+      callBerryDriverEvent(BE_EV_EVERY_SECOND);
       break;
     case FUNC_SET_DEVICE_POWER:
       result = callBerryEventDispatcher(PSTR("set_power_handler"), nullptr, XdrvMailbox.index, nullptr);
@@ -787,11 +1089,11 @@ bool Xdrv52(uint8_t function)
       callBerryEventDispatcher(PSTR("save_before_restart"), nullptr, 0, nullptr);
       break;
     case FUNC_WEB_SENSOR:
-      callBerryEventDispatcher(PSTR("web_sensor"), nullptr, 0, nullptr);
+      callBerryDriverEvent(BE_EV_WEB_SENSOR);
       break;
 
     case FUNC_JSON_APPEND:
-      callBerryEventDispatcher(PSTR("json_append"), nullptr, 0, nullptr);
+      callBerryDriverEvent(BE_EV_JSON_APPEND);
       break;
 
     case FUNC_BUTTON_PRESSED:
@@ -0,0 +1,338 @@
+/*
+  xdrv_87_esp32_i2c_queue.ino - I2C transaction queue for Tasmota
+
+  Copyright (C) 2021  Theo Arends
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifdef ESP32
+#ifdef USE_I2C
+#ifdef USE_I2C_QUEUE
+#if ESP_IDF_VERSION_MAJOR > 3  // Needs the Core 2.x TwoWire locking so concurrent calls don't corrupt the driver state
+/*********************************************************************************************\
+ * I2C transaction queue with a bus task per I2C bus
+ *
+ * Drivers fill a transaction descriptor and submit it instead of calling the blocking I2c*
+ * helpers. A FreeRTOS task per bus (Wire and Wire1) executes the transactions in order and
+ * hands them back to the main loop, where the descriptor callback is called. Callbacks thus
+ * run in the same context as any other driver code.
+ *
+ * Consecutive register reads flagged I2C_QUEUE_BURST from the same device are merged into a
+ * single burst read (device must auto-increment its register address).
+ *
+ * TwoWire only locks within each call, the rx buffer read by Wire.read() is shared. Once a bus
+ * queue is started i2c_bus_mutex is held by the bus task for each transaction and by the main
+ * loop while drivers run (see I2cBusHold()), so drivers using Wire directly keep working on a
+ * queued bus. Transactions thus run while the main loop sleeps and, as the bus task waits for
+ * the bus before collecting a burst, reads submitted in the same loop are merged. A transaction
+ * not getting the bus within I2C_QUEUE_LOCK_WAIT fails with I2C_QUEUE_ERROR_LOCK.
+ *
+ * Example (see xsns_94_hdc2010.ino):
+ *   struct I2cQueueTxn MyTxn;
+ *   void MyDone(struct I2cQueueTxn *txn) { if (0 == txn->status) { value = txn->rbuf[0] << 8 | txn->rbuf[1]; } }
+ *   MyTxn.callback = &MyDone;
+ *   I2cQueueRead(&MyTxn, MY_ADDRESS, MY_REGISTER, 2);
+ *
+ * Commands:
+ *   I2cQueue     - Show per address transaction count, errors, merged reads and bus time
+ *   I2cQueue 0   - Reset statistics
+\*********************************************************************************************/
+
+#define XDRV_87                      87
+
+#ifndef I2C_QUEUE_DEPTH
+#define I2C_QUEUE_DEPTH              16      // Pending transactions per bus
+#endif
+#ifndef I2C_QUEUE_STATS
+#define I2C_QUEUE_STATS              16      // Number of tracked (bus, address) pairs
+#endif
+#define I2C_QUEUE_WRITE_MAX          16      // Max bytes written per transaction (including register)
+#define I2C_QUEUE_READ_MAX           32      // Max bytes read per transaction, also max burst length
+#define I2C_QUEUE_MERGE_MAX          8       // Max transactions merged into one burst
+#define I2C_QUEUE_LOCK_WAIT          2000    // Max ms waiting for the main loop to release the bus
+
+#define I2C_QUEUE_BURST              0x01    // Read may be merged with adjacent register reads
+
+#define I2C_QUEUE_ERROR_SHORT_READ   6       // TwoWire uses 1 to 5
+#define I2C_QUEUE_ERROR_LOCK         7       // Bus not released in time
+
+struct I2cQueueTxn {
+  void (*callback)(struct I2cQueueTxn *txn); // Called from main loop when done, may be nullptr
+  uint32_t arg;                              // Free for driver use
+  uint32_t queued;                           // Submit time in ms
+  uint8_t bus;
+  uint8_t addr;
+  uint8_t flags;
+  uint8_t wlen;                              // Bytes in wbuf (register address first)
+  uint8_t rlen;                              // Bytes to read into rbuf after a repeated start, 0 = write only
+  int8_t status;                             // 0 = Ok, otherwise TwoWire or I2C_QUEUE_ERROR_* error
+  bool busy;                                 // Submitted and not yet handed back
+  uint8_t wbuf[I2C_QUEUE_WRITE_MAX];
+  uint8_t rbuf[I2C_QUEUE_READ_MAX];
+};
+
+struct I2cQueueStat {
+  uint32_t count;
+  uint32_t merged;
+  uint32_t time_us;
+  uint16_t max_us;
+  uint16_t errors;
+  uint16_t max_wait_ms;
+  uint8_t bus;
+  uint8_t addr;
+};
+
+struct {
+  QueueHandle_t pending[2] = { nullptr, nullptr };
+  QueueHandle_t done = nullptr;
+  TaskHandle_t task[2] = { nullptr, nullptr };
+  I2cQueueStat stat[I2C_QUEUE_STATS];
+  portMUX_TYPE stat_mux = portMUX_INITIALIZER_UNLOCKED;  // Statistics are shared by both bus tasks
+  uint8_t stat_count = 0;
+  bool stat_reset = false;
+} I2cQueue;
+
+/*********************************************************************************************\
+ * Bus task
+\*********************************************************************************************/
+
+struct I2cQueueStat* I2cQueueGetStat(uint32_t bus, uint32_t addr) {
+  for (uint32_t i = 0; i < I2cQueue.stat_count; i++) {
+    if ((I2cQueue.stat[i].bus == bus) && (I2cQueue.stat[i].addr == addr)) { return &I2cQueue.stat[i]; }
+  }
+  if (I2cQueue.stat_count >= I2C_QUEUE_STATS) { return nullptr; }
+  I2cQueueStat *stat = &I2cQueue.stat[I2cQueue.stat_count];
+  memset(stat, 0, sizeof(I2cQueueStat));
+  stat->bus = bus;
+  stat->addr = addr;
+  I2cQueue.stat_count++;
+  return stat;
+}
+
+bool I2cQueueMergeable(struct I2cQueueTxn *first, struct I2cQueueTxn *next, uint32_t len) {
+  return (first->flags & I2C_QUEUE_BURST) && (next->flags & I2C_QUEUE_BURST) &&
+         (next->addr == first->addr) && (1 == next->wlen) && (next->rlen > 0) &&
+         (next->wbuf[0] == (uint8_t)(first->wbuf[0] + len)) &&
+         (len + next->rlen <= I2C_QUEUE_READ_MAX);
+}
+
+int32_t I2cQueueTransfer(TwoWire &myWire, struct I2cQueueTxn *txn, uint8_t *data, uint32_t len) {
+  int32_t status = 0;
+  uint32_t retry = I2C_RETRY_COUNTER;
+  while (retry--) {
+    myWire.beginTransmission(txn->addr);
+    myWire.write(txn->wbuf, txn->wlen);
+    if (0 == len) {
+      status = myWire.endTransmission(true);
+    } else {
+      status = myWire.endTransmission(false);
+      if (0 == status) {
+        if (myWire.requestFrom(txn->addr, (uint8_t)len) == len) {
+          myWire.readBytes(data, len);
+        } else {
+          status = I2C_QUEUE_ERROR_SHORT_READ;
+        }
+      }
+    }
+    if (0 == status) { break; }
+  }
+  return status;
+}
+
+void I2cQueueTask(void *arg) {
+  uint32_t bus = (uint32_t)arg;
+  TwoWire &myWire = (0 == bus) ? Wire : Wire1;
+  struct I2cQueueTxn *batch[I2C_QUEUE_MERGE_MAX];
+  uint8_t data[I2C_QUEUE_READ_MAX];
+
+  while (true) {
+    if (xQueueReceive(I2cQueue.pending[bus], &batch[0], portMAX_DELAY) != pdTRUE) { continue; }
+
+    uint32_t count = 1;
+    uint32_t time_us = 0;
+    int32_t status = I2C_QUEUE_ERROR_LOCK;
+    TasAutoMutex bus_lock(&i2c_bus_mutex[bus], "I2cBus", pdMS_TO_TICKS(I2C_QUEUE_LOCK_WAIT));
+    uint32_t wait_ms = millis() - batch[0]->queued;
+    if (!bus_lock.failed()) {
+      // Collect adjacent register reads of the same device into a single burst
+      uint32_t len = batch[0]->rlen;
+      struct I2cQueueTxn *next;
+      while ((count < I2C_QUEUE_MERGE_MAX) && (1 == batch[0]->wlen) &&
+             (xQueuePeek(I2cQueue.pending[bus], &next, 0) == pdTRUE) &&
+             I2cQueueMergeable(batch[0], next, len)) {
+        xQueueReceive(I2cQueue.pending[bus], &batch[count++], 0);
+        len += next->rlen;
+      }
+
+      uint32_t start = micros();
+      status = I2cQueueTransfer(myWire, batch[0], data, len);
+      time_us = micros() - start;
+    }
+    bus_lock.give();
+
+    portENTER_CRITICAL(&I2cQueue.stat_mux);
+    if (I2cQueue.stat_reset) {
+      I2cQueue.stat_count = 0;
+      I2cQueue.stat_reset = false;
+    }
+    I2cQueueStat *stat = I2cQueueGetStat(bus, batch[0]->addr);
+    if (stat) {
+      stat->count++;
+      stat->merged += count -1;
+      if (status) { stat->errors++; }
+      stat->time_us += time_us;
+      if (time_us > stat->max_us) { stat->max_us = (time_us > 0xFFFF) ? 0xFFFF : time_us; }
+      if (wait_ms > stat->max_wait_ms) { stat->max_wait_ms = (wait_ms > 0xFFFF) ? 0xFFFF : wait_ms; }
+    }
+    portEXIT_CRITICAL(&I2cQueue.stat_mux);
+
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      struct I2cQueueTxn *txn = batch[i];
+      txn->status = status;
+      if (!status) {
+        memcpy(txn->rbuf, data + offset, txn->rlen);
+      }
+      offset += txn->rlen;
+      xQueueSend(I2cQueue.done, &txn, portMAX_DELAY);
+    }
+  }
+}
+
+/*********************************************************************************************\
+ * Driver API - main loop only
+\*********************************************************************************************/
+
+bool I2cQueueBegin(uint32_t bus) {
+  if (bus > 1) { return false; }
+  if (I2cQueue.task[bus]) { return true; }
+  if (!((0 == bus) ? TasmotaGlobal.i2c_enabled : TasmotaGlobal.i2c_enabled_2)) { return false; }
+  if (!i2c_bus_mutex[bus]) {
+    TasAutoMutex::init(&i2c_bus_mutex[bus]);  // Before the task exists, the main loop helpers lock from now on
+    I2cBusHold(true);                         // Until the end of this main loop, like the other queued bus
+  }
+
+  if (!I2cQueue.done) {
+    I2cQueue.done = xQueueCreate(2 * I2C_QUEUE_DEPTH, sizeof(struct I2cQueueTxn*));
+    if (!I2cQueue.done) { return false; }
+  }
+  I2cQueue.pending[bus] = xQueueCreate(I2C_QUEUE_DEPTH, sizeof(struct I2cQueueTxn*));
+  if (!I2cQueue.pending[bus]) { return false; }
+  if (xTaskCreatePinnedToCore(I2cQueueTask, (0 == bus) ? "I2C1" : "I2C2", 3072, (void*)bus, 2, &I2cQueue.task[bus], ARDUINO_RUNNING_CORE) != pdPASS) {
+    vQueueDelete(I2cQueue.pending[bus]);
+    I2cQueue.pending[bus] = nullptr;
+    I2cQueue.task[bus] = nullptr;
+    return false;
+  }
+  AddLog(LOG_LEVEL_DEBUG, PSTR("I2C: Bus%d queue started"), bus +1);
+  return true;
+}
+
+bool I2cQueueSubmit(struct I2cQueueTxn *txn) {
+  // Descriptor is owned by the queue until its callback is called
+  if (txn->busy || (txn->wlen > I2C_QUEUE_WRITE_MAX) || (txn->rlen > I2C_QUEUE_READ_MAX)) { return false; }
+  if (!I2cQueueBegin(txn->bus)) { return false; }
+  txn->busy = true;
+  txn->status = 0;
+  txn->queued = millis();
+  if (xQueueSend(I2cQueue.pending[txn->bus], &txn, 0) != pdTRUE) {
+    txn->busy = false;
+    return false;
+  }
+  return true;
+}
+
+bool I2cQueueRead(struct I2cQueueTxn *txn, uint8_t addr, uint8_t reg, uint8_t len, uint32_t bus = 0, uint32_t flags = 0);
+bool I2cQueueRead(struct I2cQueueTxn *txn, uint8_t addr, uint8_t reg, uint8_t len, uint32_t bus, uint32_t flags) {
+  if (txn->busy) { return false; }
+  txn->bus = bus;
+  txn->addr = addr;
+  txn->flags = flags;                        // I2C_QUEUE_BURST only if the device auto-increments
+  txn->wbuf[0] = reg;
+  txn->wlen = 1;
+  txn->rlen = len;
+  return I2cQueueSubmit(txn);
+}
+
+bool I2cQueueWrite(struct I2cQueueTxn *txn, uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len, uint32_t bus = 0);
+bool I2cQueueWrite(struct I2cQueueTxn *txn, uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len, uint32_t bus) {
+  if (txn->busy || (len >= I2C_QUEUE_WRITE_MAX)) { return false; }
+  txn->bus = bus;
+  txn->addr = addr;
+  txn->flags = 0;
+  txn->wbuf[0] = reg;
+  memcpy(&txn->wbuf[1], data, len);
+  txn->wlen = len +1;
+  txn->rlen = 0;
+  return I2cQueueSubmit(txn);
+}
+
+void I2cQueueLoop(void) {
+  if (!I2cQueue.done) { return; }
+  struct I2cQueueTxn *txn;
+  while (xQueueReceive(I2cQueue.done, &txn, 0) == pdTRUE) {
+    txn->busy = false;                       // Callback may resubmit the descriptor
+    if (txn->callback) { txn->callback(txn); }
+  }
+}
+
+/*********************************************************************************************\
+ * Commands
+\*********************************************************************************************/
+
+const char kI2cQueueCommands[] PROGMEM = "|"  // No prefix
+  "I2cQueue";
+
+void (* const I2cQueueCommand[])(void) PROGMEM = {
+  &CmndI2cQueue };
+
+void CmndI2cQueue(void) {
+  if (0 == XdrvMailbox.payload) {
+    I2cQueue.stat_reset = true;              // Handled by the bus task owning the statistics
+    ResponseCmndDone();
+    return;
+  }
+  Response_P(PSTR("{\"%s\":{"), XdrvMailbox.command);
+  for (uint32_t i = 0; i < I2cQueue.stat_count; i++) {
+    I2cQueueStat *stat = &I2cQueue.stat[i];
+    ResponseAppend_P(PSTR("%s\"%d-0x%02X\":{\"Count\":%u,\"Errors\":%u,\"Merged\":%u,\"AvgUs\":%u,\"MaxUs\":%u,\"MaxWaitMs\":%u}"),
+      (i) ? "," : "", stat->bus +1, stat->addr, stat->count, stat->errors, stat->merged,
+      (stat->count) ? stat->time_us / stat->count : 0, stat->max_us, stat->max_wait_ms);
+  }
+  ResponseAppend_P(PSTR("}}"));
+}
+
+/*********************************************************************************************\
+ * Interface
+\*********************************************************************************************/
+
+bool Xdrv87(uint8_t function) {
+  bool result = false;
+
+  switch (function) {
+    case FUNC_LOOP:
+      I2cQueueLoop();
+      break;
+    case FUNC_COMMAND:
+      result = DecodeCommand(kI2cQueueCommands, I2cQueueCommand);
+      break;
+  }
+  return result;
+}
+
+#endif  // ESP_IDF_VERSION_MAJOR > 3
+#endif  // USE_I2C_QUEUE
+#endif  // USE_I2C
+#endif  // ESP32
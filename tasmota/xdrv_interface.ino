@@ -1142,9 +1142,18 @@ bool XdrvCall(uint8_t Function)
   for (uint32_t x = 0; x < xdrv_present; x++) {
 
     uint32_t profile_function_start = millis();
+    PROFILE_STATS_START(profile_stats_start);
 
     result = xdrv_func_ptr[x](Function);
 
+#ifdef USE_PROFILE_STATS
+#ifdef XFUNC_PTR_IN_ROM
+    PROFILE_STATS(PRF_DRV, pgm_read_byte(kXdrvList + x), Function, nullptr, profile_stats_start);
+#else
+    PROFILE_STATS(PRF_DRV, kXdrvList[x], Function, nullptr, profile_stats_start);
+#endif
+#endif  // USE_PROFILE_STATS
+
 #ifdef USE_PROFILE_FUNCTION
 #ifdef XFUNC_PTR_IN_ROM
       uint32_t index = pgm_read_byte(kXdrvList + x);
@@ -1173,3 +1182,64 @@ bool XdrvCall(uint8_t Function)
 
   return result;
 }
+
+/*********************************************************************************************\
+ * Periodic tick call to xdrv having registered for it
+ *
+ * Each driver is asked once with FUNC_TICK_MASK which of the 50ms, 100ms, 250ms and second ticks
+ * it handles by setting bits of SchedulerTicks in XdrvMailbox.index. Drivers not answering keep
+ * TICK_MASK_ALL so they are called on every tick as before.
+\*********************************************************************************************/
+
+const uint8_t kTickFunctions[TICK_MAX] PROGMEM = { FUNC_EVERY_50_MSECOND, FUNC_EVERY_100_MSECOND, FUNC_EVERY_250_MSECOND, FUNC_EVERY_SECOND };
+
+struct {
+  uint8_t mask[xdrv_present];
+  bool ready = false;
+} XdrvTicks;
+
+void XdrvTickMaskInit(void) {
+  uint32_t index_save = XdrvMailbox.index;
+  for (uint32_t x = 0; x < xdrv_present; x++) {
+    XdrvMailbox.index = TICK_MASK_ALL;
+    xdrv_func_ptr[x](FUNC_TICK_MASK);
+    XdrvTicks.mask[x] = XdrvMailbox.index & TICK_MASK_ALL;
+  }
+  XdrvMailbox.index = index_save;
+  XdrvTicks.ready = true;
+}
+
+void XdrvTickCall(uint32_t tick) {
+  if (!XdrvTicks.ready) { XdrvTickMaskInit(); }
+
+  uint8_t Function = pgm_read_byte(kTickFunctions + tick);
+  uint32_t profile_driver_start = millis();
+
+  for (uint32_t x = 0; x < xdrv_present; x++) {
+    if (!bitRead(XdrvTicks.mask[x], tick)) { continue; }
+
+    uint32_t profile_function_start = millis();
+    PROFILE_STATS_START(profile_stats_start);
+
+    xdrv_func_ptr[x](Function);
+
+#ifdef USE_PROFILE_STATS
+#ifdef XFUNC_PTR_IN_ROM
+    PROFILE_STATS(PRF_DRV, pgm_read_byte(kXdrvList + x), Function, nullptr, profile_stats_start);
+#else
+    PROFILE_STATS(PRF_DRV, kXdrvList[x], Function, nullptr, profile_stats_start);
+#endif
+#endif  // USE_PROFILE_STATS
+
+#ifdef USE_PROFILE_FUNCTION
+#ifdef XFUNC_PTR_IN_ROM
+    uint32_t index = pgm_read_byte(kXdrvList + x);
+#else
+    uint32_t index = kXdrvList[x];
+#endif
+    PROFILE_FUNCTION("drv", index, Function, profile_function_start);
+#endif  // USE_PROFILE_FUNCTION
+  }
+
+  PROFILE_DRIVER("drv", Function, profile_driver_start);
+}
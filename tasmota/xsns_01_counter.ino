@@ -333,6 +333,11 @@ void CmndCounterDebounceHigh(void)
 
 bool Xsns01(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (Counter.any_counter) {
@@ -24,6 +24,12 @@
 
 #define XSNS_02                       2
 
+#ifdef USE_ADC_DMA
+#if !defined(ESP32) || !CONFIG_IDF_TARGET_ESP32 || (ESP_IDF_VERSION_MAJOR < 4)
+#undef USE_ADC_DMA                                     // Continuous mode is supported on ESP32 with Core 2.x only
+#endif
+#endif  // USE_ADC_DMA
+
 #ifdef ESP8266
 #define ANALOG_RESOLUTION             10               // 12 = 4095, 11 = 2047, 10 = 1023
 #define ANALOG_RANGE                  1023             // 4095 = 12, 2047 = 11, 1023 = 10
@@ -125,11 +131,146 @@ struct {
   int param3 = 0;
   int param4 = 0;
   uint32_t previous_millis = 0;
+#ifdef USE_ADC_DMA
+  float rms = 0;                                       // AC part over the last DMA window
+  uint16_t mean = 0;                                   // Average over the last DMA window
+#endif  // USE_ADC_DMA
   uint16_t last_value = 0;
   uint8_t type = 0;
   uint8_t pin = 0;
 } Adc[MAX_ADCS];
 
+#ifdef USE_ADC_DMA
+/*********************************************************************************************\
+ * ESP32 continuous ADC1 sampling using DMA
+ *
+ * All ADC1 pins are converted in turn at ADC_DMA_SAMPLE_FREQ. A task accumulates the samples
+ * and publishes mean and true RMS of the AC part per pin, over ADC_DMA_CYCLES mains cycles for
+ * current transformers and over ADC_DMA_SHORT samples for the other types so buttons and
+ * inputs keep their response time. The mean is seeded with analogRead() before sampling starts.
+ * AdcRead() and AdcGetCurrentPower() then just pick up the latest window.
+\*********************************************************************************************/
+
+#include "driver/adc.h"
+
+#ifndef ADC_DMA_SAMPLE_FREQ
+#define ADC_DMA_SAMPLE_FREQ           20000            // Conversions per second shared by all pins (ESP32 minimum is 20000)
+#endif
+#ifndef ADC_DMA_MAINS_FREQ
+#define ADC_DMA_MAINS_FREQ            50               // Mains frequency in Hz
+#endif
+#define ADC_DMA_CYCLES                10               // Mains cycles per window of ADC_CT_POWER pins
+#define ADC_DMA_SHORT                 32               // Samples per window of other pins, as AdcRead(pin, 5)
+#define ADC_DMA_FRAME                 256              // Bytes per DMA transfer
+#define ADC_DMA_CHANNELS              8                // ADC1 channels
+
+struct {
+  TaskHandle_t task = nullptr;
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  uint16_t window[ADC_DMA_CHANNELS];                   // Samples per window per ADC1 channel
+  uint8_t index[ADC_DMA_CHANNELS];                     // ADC1 channel to Adc[] index
+} AdcDma;
+
+void AdcDmaTask(void *arg) {
+  struct {
+    uint64_t sumsq;
+    uint32_t sum;
+    uint32_t count;
+  } acc[ADC_DMA_CHANNELS];
+  uint8_t buffer[ADC_DMA_FRAME];
+
+  memset(acc, 0, sizeof(acc));
+  while (true) {
+    uint32_t length = 0;
+    esp_err_t err = adc_digi_read_bytes(buffer, sizeof(buffer), &length, 100);
+    if ((err != ESP_OK) && (err != ESP_ERR_INVALID_STATE)) { continue; }  // Invalid state flags an overrun, data is still valid
+
+    for (uint32_t i = 0; i + sizeof(adc_digi_output_data_t) <= length; i += sizeof(adc_digi_output_data_t)) {
+      adc_digi_output_data_t *sample = (adc_digi_output_data_t*)&buffer[i];
+      uint32_t channel = sample->type1.channel;
+      if ((channel >= ADC_DMA_CHANNELS) || (AdcDma.index[channel] >= MAX_ADCS)) { continue; }
+      uint32_t value = sample->type1.data;
+      acc[channel].sum += value;
+      acc[channel].sumsq += value * value;
+      acc[channel].count++;
+      if (acc[channel].count >= AdcDma.window[channel]) {
+        float n = acc[channel].count;
+        float mean = (float)acc[channel].sum / n;
+        // Variance over whole mains cycles is the square of the RMS value without the DC bias
+        float variance = (float)(acc[channel].count * acc[channel].sumsq - (uint64_t)acc[channel].sum * acc[channel].sum) / (n * n);
+        uint32_t idx = AdcDma.index[channel];
+        portENTER_CRITICAL(&AdcDma.mux);
+        Adc[idx].mean = (uint16_t)(mean + 0.5f);
+        Adc[idx].rms = (variance > 0) ? sqrtf(variance) : 0;
+        portEXIT_CRITICAL(&AdcDma.mux);
+        memset(&acc[channel], 0, sizeof(acc[channel]));
+      }
+    }
+  }
+}
+
+void AdcDmaInit(void) {
+  adc_digi_pattern_config_t pattern[ADC_DMA_CHANNELS];
+  uint32_t mask = 0;
+  uint32_t count = 0;
+
+  memset(AdcDma.index, 0xFF, sizeof(AdcDma.index));
+  for (uint32_t idx = 0; idx < Adcs.present; idx++) {
+    int8_t channel = digitalPinToAnalogChannel(Adc[idx].pin);
+    if ((channel < 0) || (channel >= ADC_DMA_CHANNELS)) { continue; }  // ADC2 pins keep using analogRead()
+    AdcDma.index[channel] = idx;
+    Adc[idx].mean = analogRead(Adc[idx].pin);          // Valid until the first window is published
+    mask |= 1 << channel;
+    pattern[count].atten = ADC_ATTEN_DB_11;
+    pattern[count].channel = channel;
+    pattern[count].unit = 0;
+    pattern[count].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    count++;
+  }
+  if (!count) { return; }
+
+  adc_digi_init_config_t init_config = {
+    .max_store_buf_size = 4 * ADC_DMA_FRAME,
+    .conv_num_each_intr = ADC_DMA_FRAME,
+    .adc1_chan_mask = mask,
+    .adc2_chan_mask = 0,
+  };
+  if (adc_digi_initialize(&init_config) != ESP_OK) {
+    AddLog(LOG_LEVEL_INFO, PSTR("ADC: DMA init failed"));
+    return;
+  }
+  adc_digi_configuration_t config = {
+    .conv_limit_en = ADC_CONV_LIMIT_EN,
+    .conv_limit_num = 250,
+    .pattern_num = count,
+    .adc_pattern = pattern,
+    .sample_freq_hz = ADC_DMA_SAMPLE_FREQ,
+    .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+    .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+  };
+  uint32_t window = (ADC_DMA_SAMPLE_FREQ / count) * ADC_DMA_CYCLES / ADC_DMA_MAINS_FREQ;
+  for (uint32_t channel = 0; channel < ADC_DMA_CHANNELS; channel++) {
+    uint32_t idx = AdcDma.index[channel];
+    AdcDma.window[channel] = ((idx < MAX_ADCS) && (ADC_CT_POWER == Adc[idx].type)) ? window : ADC_DMA_SHORT;
+  }
+  if ((adc_digi_controller_configure(&config) != ESP_OK) ||
+      (xTaskCreatePinnedToCore(AdcDmaTask, "ADC", 2048 + ADC_DMA_FRAME, nullptr, 2, &AdcDma.task, ARDUINO_RUNNING_CORE) != pdPASS)) {
+    AdcDma.task = nullptr;
+    adc_digi_deinitialize();
+    AddLog(LOG_LEVEL_INFO, PSTR("ADC: DMA init failed"));
+    return;
+  }
+  adc_digi_start();
+  AddLog(LOG_LEVEL_DEBUG, PSTR("ADC: DMA sampling %d pins, CT window %d samples"), count, window);
+}
+
+bool AdcDmaActive(uint32_t idx) {
+  if (!AdcDma.task) { return false; }
+  int8_t channel = digitalPinToAnalogChannel(Adc[idx].pin);
+  return ((channel >= 0) && (channel < ADC_DMA_CHANNELS) && (AdcDma.index[channel] == idx));
+}
+#endif  // USE_ADC_DMA
+
 #ifdef ESP8266
 bool adcAttachPin(uint8_t pin) {
   return (ADC0_PIN == pin);
@@ -257,6 +398,9 @@ void AdcInit(void) {
       AdcInitParams(idx);
       AdcSaveSettings(idx);
     }
+#ifdef USE_ADC_DMA
+    AdcDmaInit();
+#endif  // USE_ADC_DMA
   }
 }
 
@@ -266,6 +410,13 @@ uint16_t AdcRead(uint32_t pin, uint32_t factor) {
   // factor 3 = 8 samples
   // factor 4 = 16 samples
   // factor 5 = 32 samples
+#ifdef USE_ADC_DMA
+  for (uint32_t idx = 0; idx < Adcs.present; idx++) {
+    if ((Adc[idx].pin == pin) && AdcDmaActive(idx)) {
+      return Adc[idx].mean;                            // Already averaged over the last window
+    }
+  }
+#endif  // USE_ADC_DMA
   uint32_t samples = 1 << factor;
   uint32_t analog = 0;
   for (uint32_t i = 0; i < samples; i++) {
@@ -376,6 +527,25 @@ void AdcGetCurrentPower(uint8_t idx, uint8_t factor) {
   uint16_t analog_min = ANALOG_RANGE;
   uint16_t analog_max = 0;
 
+#ifdef USE_ADC_DMA
+  if (AdcDmaActive(idx)) {
+    portENTER_CRITICAL(&AdcDma.mux);
+    float rms = Adc[idx].rms;
+    analog = Adc[idx].mean;
+    portEXIT_CRITICAL(&AdcDma.mux);
+    if (0 == Adc[idx].param1) {
+      // True RMS scaled to the peak to peak of a sine wave to keep the ANALOG_CT_MULTIPLIER calibration
+      Adc[idx].current = rms * 2 * M_SQRT2 * ((float)(Adc[idx].param2) / 100000);
+    }
+    else if (analog > Adc[idx].param1) {
+      Adc[idx].current = ((float)(analog) - (float)Adc[idx].param1) * ((float)(Adc[idx].param2) / 100000);
+    }
+    else {
+      Adc[idx].current = 0;
+    }
+  }
+  else
+#endif  // USE_ADC_DMA
   if (0 == Adc[idx].param1) {
     for (uint32_t i = 0; i < samples; i++) {
       analog = analogRead(Adc[idx].pin);
@@ -678,6 +848,11 @@ void CmndAdcParam(void) {
 \*********************************************************************************************/
 
 bool Xsns02(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_250_MSECOND) | bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -150,6 +150,11 @@ void SonoffScShow(bool json)
 
 bool Xsns04(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   if (SONOFF_SC == TasmotaGlobal.module_type) {
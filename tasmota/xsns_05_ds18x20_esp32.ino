@@ -252,6 +252,11 @@ void Ds18x20Show(bool json) {
 \*********************************************************************************************/
 
 bool Xsns05(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (PinUsed(GPIO_DSB)) {
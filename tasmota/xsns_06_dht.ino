@@ -63,20 +63,20 @@ bool DhtWaitState(uint32_t sensor, uint32_t level) {
   return true;
 }
 
-bool DhtRead(uint32_t sensor) {
-  dht_data[0] = dht_data[1] = dht_data[2] = dht_data[3] = dht_data[4] = 0;
-
+// Send the start signal, it is held low until DhtRead()
+void DhtStart(uint32_t sensor) {
   if (!dht_dual_mode) {
     pinMode(Dht[sensor].pin, OUTPUT);
     digitalWrite(Dht[sensor].pin, LOW);
   } else {
     digitalWrite(dht_pin_out, LOW);
   }
+}
+
+bool DhtRead(uint32_t sensor) {
+  dht_data[0] = dht_data[1] = dht_data[2] = dht_data[3] = dht_data[4] = 0;
 
   switch (Dht[sensor].type) {
-    case GPIO_DHT11:                                    // DHT11
-      delay(19);  // minimum 18ms
-      break;
     case GPIO_DHT22:                                    // DHT21, DHT22, AM2301, AM2302, AM2321
 //      delay(2);   // minimum 1ms
       delayMicroseconds(2000);                          // 20200621: See https://github.com/arendst/Tasmota/pull/7468#issuecomment-647067015
@@ -210,16 +210,26 @@ void DhtInit(void) {
   }
 }
 
+void DhtCollect(uint32_t sensor) {
+  if (sensor >= dht_sensors) { return; }
+  // Data transfer takes about 5mS per sensor
+  if (!DhtRead(sensor)) {
+    Dht[sensor].lastresult++;
+    if (Dht[sensor].lastresult > DHT_MAX_RETRY) {  // Reset after 8 misses
+      Dht[sensor].t = NAN;
+      Dht[sensor].h = NAN;
+    }
+  }
+}
+
 void DhtEverySecond(void) {
   if (TasmotaGlobal.uptime &1) {  // Every 2 seconds
     for (uint32_t sensor = 0; sensor < dht_sensors; sensor++) {
-      // DHT11 and AM2301 25mS per sensor, SI7021 5mS per sensor
-      if (!DhtRead(sensor)) {
-        Dht[sensor].lastresult++;
-        if (Dht[sensor].lastresult > DHT_MAX_RETRY) {  // Reset after 8 misses
-          Dht[sensor].t = NAN;
-          Dht[sensor].h = NAN;
-        }
+      DhtStart(sensor);
+      if (GPIO_DHT11 == Dht[sensor].type) {
+        XsnsCollectIn(19, sensor);                      // minimum 18ms
+      } else {
+        DhtCollect(sensor);
       }
     }
   }
@@ -236,6 +246,11 @@ void DhtShow(bool json) {
 \*********************************************************************************************/
 
 bool Xsns06(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (dht_active) {
@@ -243,6 +258,9 @@ bool Xsns06(uint8_t function) {
       case FUNC_EVERY_SECOND:
         DhtEverySecond();
         break;
+      case FUNC_SENSOR_COLLECT:
+        DhtCollect(XdrvMailbox.index);
+        break;
       case FUNC_JSON_APPEND:
         DhtShow(1);
         break;
@@ -37,6 +37,9 @@ enum {
   SHT1X_CMD_SOFT_RESET    = B00011110
 };
 
+// Steps of a split-phase read, passed to ShtCollect()
+enum { SHT1X_STEP_RESET, SHT1X_STEP_START, SHT1X_STEP_TEMP, SHT1X_STEP_RH };
+
 int8_t sht_sda_pin;
 int8_t sht_scl_pin;
 uint8_t sht_type = 0;
@@ -44,6 +47,8 @@ char sht_types[] = "SHT1X";
 uint8_t sht_valid = 0;
 float sht_temperature = 0;
 float sht_humidity = 0;
+float sht_temp_raw;
+uint8_t sht_polls;
 
 bool ShtReset(void)
 {
@@ -126,17 +131,8 @@ int ShtReadData(void)
   return val;
 }
 
-bool ShtRead(void)
+void ShtConvert(float tempRaw, float humRaw)
 {
-  if (sht_valid) { sht_valid--; }
-  if (!ShtReset()) { return false; }
-  if (!ShtSendCommand(SHT1X_CMD_MEASURE_TEMP)) { return false; }
-  if (!ShtAwaitResult()) { return false; }
-  float tempRaw = ShtReadData();
-  if (!ShtSendCommand(SHT1X_CMD_MEASURE_RH)) { return false; }
-  if (!ShtAwaitResult()) { return false; }
-  float humRaw = ShtReadData();
-
   // Temperature conversion coefficients from SHT1X datasheet for version 4
   const float d1 = -39.7;  // 3.5V
   const float d2 = 0.01;   // 14-bit
@@ -152,9 +148,78 @@ bool ShtRead(void)
   sht_humidity = ConvertHumidity(sht_humidity);
 
   sht_valid = SENSOR_MAX_MISS;
+}
+
+// Blocking read, used for detection
+bool ShtRead(void)
+{
+  if (sht_valid) { sht_valid--; }
+  if (!ShtReset()) { return false; }
+  if (!ShtSendCommand(SHT1X_CMD_MEASURE_TEMP)) { return false; }
+  if (!ShtAwaitResult()) { return false; }
+  float tempRaw = ShtReadData();
+  if (!ShtSendCommand(SHT1X_CMD_MEASURE_RH)) { return false; }
+  if (!ShtAwaitResult()) { return false; }
+  float humRaw = ShtReadData();
+  ShtConvert(tempRaw, humRaw);
   return true;
 }
 
+// Split-phase read, ShtCollect() runs each step when the sensor is ready
+void ShtStart(void)
+{
+  if (sht_valid) { sht_valid--; }
+  pinMode(sht_sda_pin, INPUT_PULLUP);
+  pinMode(sht_scl_pin, OUTPUT);
+  XsnsCollectIn(11, SHT1X_STEP_RESET);
+}
+
+bool ShtStartMeasure(uint32_t step)
+{
+  if (!ShtSendCommand((SHT1X_STEP_TEMP == step) ? SHT1X_CMD_MEASURE_TEMP : SHT1X_CMD_MEASURE_RH)) { return false; }
+  sht_polls = 0;
+  XsnsCollectIn(20, step);
+  return true;
+}
+
+void ShtCollect(uint32_t step)
+{
+  bool success = true;
+  switch (step) {
+    case SHT1X_STEP_RESET:
+      for (uint32_t i = 0; i < 9; i++) {
+        digitalWrite(sht_scl_pin, HIGH);
+        digitalWrite(sht_scl_pin, LOW);
+      }
+      success = ShtSendCommand(SHT1X_CMD_SOFT_RESET);
+      if (success) { XsnsCollectIn(11, SHT1X_STEP_START); }
+      break;
+    case SHT1X_STEP_START:
+      success = ShtStartMeasure(SHT1X_STEP_TEMP);
+      break;
+    case SHT1X_STEP_TEMP:
+    case SHT1X_STEP_RH:
+      if (digitalRead(sht_sda_pin) != LOW) {
+        // Maximum 320ms for 14 bit measurement
+        if (++sht_polls < 16) {
+          XsnsCollectIn(20, step);
+        } else {
+          AddLog(LOG_LEVEL_DEBUG, PSTR(D_LOG_SHT1 D_SENSOR_BUSY));
+          success = false;
+        }
+      } else if (SHT1X_STEP_TEMP == step) {
+        sht_temp_raw = ShtReadData();
+        success = ShtStartMeasure(SHT1X_STEP_RH);
+      } else {
+        ShtConvert(sht_temp_raw, ShtReadData());
+      }
+      break;
+  }
+  if (!success) {
+    AddLogMissed(sht_types, sht_valid);
+  }
+}
+
 /********************************************************************************************/
 
 void ShtDetect(void)
@@ -173,10 +238,8 @@ void ShtDetect(void)
 void ShtEverySecond(void)
 {
   if (!(TasmotaGlobal.uptime %4)) {  // Every 4 seconds
-    // 344mS
-    if (!ShtRead()) {
-      AddLogMissed(sht_types, sht_valid);
-    }
+    // 344mS, mostly waiting for the conversions
+    ShtStart();
   }
 }
 
@@ -193,6 +256,11 @@ void ShtShow(bool json)
 
 bool Xsns07(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_08)) { return false; }
 
   bool result = false;
@@ -205,6 +273,9 @@ bool Xsns07(uint8_t function)
       case FUNC_EVERY_SECOND:
         ShtEverySecond();
         break;
+      case FUNC_SENSOR_COLLECT:
+        ShtCollect(XdrvMailbox.index);
+        break;
       case FUNC_JSON_APPEND:
         ShtShow(1);
         break;
@@ -147,40 +147,59 @@ void HtuInit(void)
   HtuSetResolution(HTU21_RES_RH12_T14);
 }
 
-bool HtuRead(void)
+bool HtuStart(uint8_t command)
 {
-  uint8_t  checksum = 0;
-  uint16_t sensorval = 0;
-
-  if (Htu.valid) { Htu.valid--; }
-
   Wire.beginTransmission(HTU21_ADDR);
-  Wire.write(HTU21_READTEMP);
-  if (Wire.endTransmission() != 0) { return false; }           // In case of error
-  delay(Htu.delay_temp);                                       // Sensor time at max resolution
+  Wire.write(command);
+  return (0 == Wire.endTransmission());                        // In case of error
+}
+
+bool HtuGet(uint16_t &sensorval)
+{
+  uint8_t  checksum = 0;
 
+  sensorval = 0;
   Wire.requestFrom(HTU21_ADDR, 3);
-  if (3 == Wire.available()) {
+  if (3 <= Wire.available()) {
     sensorval = Wire.read() << 8;                              // MSB
     sensorval |= Wire.read();                                  // LSB
     checksum = Wire.read();
   }
-  if (HtuCheckCrc8(sensorval) != checksum) { return false; }   // Checksum mismatch
+  return (HtuCheckCrc8(sensorval) == checksum);
+}
 
-  Htu.temperature = ConvertTemp(0.002681 * (float)sensorval - 46.85);
+// Start the temperature conversion, HtuCollect(0) is called when it is done
+void HtuRead(void)
+{
+  if (Htu.valid) { Htu.valid--; }
 
-  Wire.beginTransmission(HTU21_ADDR);
-  Wire.write(HTU21_READHUM);
-  if (Wire.endTransmission() != 0) { return false; }           // In case of error
-  delay(Htu.delay_humidity);                                   // Sensor time at max resolution
+  if (!HtuStart(HTU21_READTEMP)) {
+    AddLogMissed(Htu.types, Htu.valid);
+    return;
+  }
+  XsnsCollectIn(Htu.delay_temp, 0);                            // Sensor time at max resolution
+}
 
-  Wire.requestFrom(HTU21_ADDR, 3);
-  if (3 <= Wire.available()) {
-    sensorval = Wire.read() << 8;                              // MSB
-    sensorval |= Wire.read();                                  // LSB
-    checksum = Wire.read();
+// Temperature (index 0) or humidity (index 1) conversion done
+void HtuCollect(uint32_t index)
+{
+  uint16_t sensorval;
+
+  if (!HtuGet(sensorval)) {
+    AddLogMissed(Htu.types, Htu.valid);
+    return;
+  }
+
+  if (0 == index) {
+    Htu.temperature = ConvertTemp(0.002681 * (float)sensorval - 46.85);
+
+    if (!HtuStart(HTU21_READHUM)) {
+      AddLogMissed(Htu.types, Htu.valid);
+      return;
+    }
+    XsnsCollectIn(Htu.delay_humidity, 1);                      // Sensor time at max resolution
+    return;
   }
-  if (HtuCheckCrc8(sensorval) != checksum) { return false; }   // Checksum mismatch
 
   sensorval ^= 0x02;                                           // clear status bits
   Htu.humidity = 0.001907 * (float)sensorval - 6;
@@ -196,7 +215,6 @@ bool HtuRead(void)
   Htu.humidity = ConvertHumidity(Htu.humidity);
 
   Htu.valid = SENSOR_MAX_MISS;
-  return true;
 }
 
 /********************************************************************************************/
@@ -237,10 +255,8 @@ void HtuDetect(void)
 void HtuEverySecond(void)
 {
   if (TasmotaGlobal.uptime &1) {  // Every 2 seconds
-    // HTU21: 68mS, SI70xx: 37mS
-    if (!HtuRead()) {
-      AddLogMissed(Htu.types, Htu.valid);
-    }
+    // HTU21: 68mS, SI70xx: 37mS conversion time
+    HtuRead();
   }
 }
 
@@ -257,6 +273,11 @@ void HtuShow(bool json)
 
 bool Xsns08(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_09)) { return false; }
 
   bool result = false;
@@ -269,6 +290,9 @@ bool Xsns08(uint8_t function)
       case FUNC_EVERY_SECOND:
         HtuEverySecond();
         break;
+      case FUNC_SENSOR_COLLECT:
+        HtuCollect(XdrvMailbox.index);
+        break;
       case FUNC_JSON_APPEND:
         HtuShow(1);
         break;
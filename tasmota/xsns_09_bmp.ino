@@ -54,7 +54,6 @@ typedef struct {
   uint8_t bmp_type;
   uint8_t bmp_model;
 #ifdef USE_BME680
-  uint8_t bme680_state;
   float bmp_gas_resistance;
 #endif  // USE_BME680
   float bmp_temperature;
@@ -102,6 +101,8 @@ typedef struct {
   uint16_t cal_ac4;
   uint16_t cal_ac5;
   uint16_t cal_ac6;
+  int32_t  b5;         // Temperature compensation for the pending pressure conversion
+  bool     pressure;   // Pressure conversion pending
 } bmp180_cal_data_t;
 
 bmp180_cal_data_t *bmp180_cal_data = nullptr;
@@ -153,23 +154,38 @@ bool Bmp180Calibration(uint8_t bmp_idx)
   return true;
 }
 
+// Start the temperature conversion, Bmp180Collect() is called when it is done
 void Bmp180Read(uint8_t bmp_idx)
 {
   if (!bmp180_cal_data) { return; }
 
   I2cWrite8(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_CONTROL, BMP180_TEMPERATURE);
-  delay(5); // 5ms conversion time
-  int ut = I2cRead16(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_RESULT);
-  int32_t xt1 = (ut - (int32_t)bmp180_cal_data[bmp_idx].cal_ac6) * ((int32_t)bmp180_cal_data[bmp_idx].cal_ac5) >> 15;
-  int32_t xt2 = ((int32_t)bmp180_cal_data[bmp_idx].cal_mc << 11) / (xt1 + (int32_t)bmp180_cal_data[bmp_idx].cal_md);
-  int32_t bmp180_b5 = xt1 + xt2;
-  bmp_sensors[bmp_idx].bmp_temperature = ((bmp180_b5 + 8) >> 4) / 10.0;
-
-  I2cWrite8(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_CONTROL, BMP180_PRESSURE3); // Highest resolution
-  delay(2 + (4 << BMP180_OSS));                                 // 26ms conversion time at ultra high resolution
+  bmp180_cal_data[bmp_idx].pressure = false;
+  XsnsCollectIn(5, bmp_idx);                                    // 5ms conversion time
+}
+
+void Bmp180Collect(uint8_t bmp_idx)
+{
+  if (!bmp180_cal_data) { return; }
+
+  if (!bmp180_cal_data[bmp_idx].pressure) {
+    int ut = I2cRead16(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_RESULT);
+    int32_t xt1 = (ut - (int32_t)bmp180_cal_data[bmp_idx].cal_ac6) * ((int32_t)bmp180_cal_data[bmp_idx].cal_ac5) >> 15;
+    int32_t xt2 = ((int32_t)bmp180_cal_data[bmp_idx].cal_mc << 11) / (xt1 + (int32_t)bmp180_cal_data[bmp_idx].cal_md);
+    bmp180_cal_data[bmp_idx].b5 = xt1 + xt2;
+    bmp_sensors[bmp_idx].bmp_temperature = ((bmp180_cal_data[bmp_idx].b5 + 8) >> 4) / 10.0;
+
+    I2cWrite8(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_CONTROL, BMP180_PRESSURE3); // Highest resolution
+    bmp180_cal_data[bmp_idx].pressure = true;
+    XsnsCollectIn(2 + (4 << BMP180_OSS), bmp_idx);              // 26ms conversion time at ultra high resolution
+    return;
+  }
+
+  bmp180_cal_data[bmp_idx].pressure = false;
   uint32_t up = I2cRead24(bmp_sensors[bmp_idx].bmp_address, BMP180_REG_RESULT);
   up >>= (8 - BMP180_OSS);
 
+  int32_t bmp180_b5 = bmp180_cal_data[bmp_idx].b5;
   int32_t b6 = bmp180_b5 - 4000;
   int32_t x1 = ((int32_t)bmp180_cal_data[bmp_idx].cal_b2 * ((b6 * b6) >> 12)) >> 11;
   int32_t x2 = ((int32_t)bmp180_cal_data[bmp_idx].cal_ac2 * b6) >> 11;
@@ -400,49 +416,39 @@ bool Bme680Init(uint8_t bmp_idx)
   rslt = bme680_set_sensor_settings(set_required_settings,&gas_sensor[bmp_idx]);
   if (rslt != BME680_OK) { return false; }
 
-  bmp_sensors[bmp_idx].bme680_state = 0;
-
   return true;
 }
 
+// Start a forced mode measurement every other second, Bme680Collect() is called when it is done
 void Bme680Read(uint8_t bmp_idx)
 {
   if (!gas_sensor) { return; }
+  if (!(TasmotaGlobal.uptime & 1)) { return; }  // Keep one heater cycle per 2 seconds, limits gas sensor self-heating
 
-  int8_t rslt = BME680_OK;
+  if (BME680_OK != bme680_set_sensor_mode(&gas_sensor[bmp_idx])) { return; }
 
-  if (BME680_CHIPID == bmp_sensors[bmp_idx].bmp_type) {
-    if (0 == bmp_sensors[bmp_idx].bme680_state) {
-      /* Trigger the next measurement if you would like to read data out continuously */
-      rslt = bme680_set_sensor_mode(&gas_sensor[bmp_idx]);
-      if (rslt != BME680_OK) { return; }
-
-      /* Get the total measurement duration so as to sleep or wait till the
-       * measurement is complete */
-//      uint16_t meas_period;
-//      bme680_get_profile_dur(&meas_period, &gas_sensor[bmp_idx]);
-//      delay(meas_period); /* Delay till the measurement is ready */  // 183 mSec - we'll wait a second
-
-      bmp_sensors[bmp_idx].bme680_state = 1;
-    } else {
-      bmp_sensors[bmp_idx].bme680_state = 0;
-
-      struct bme680_field_data data;
-      rslt = bme680_get_sensor_data(&data, &gas_sensor[bmp_idx]);
-      if (rslt != BME680_OK) { return; }
-
-      bmp_sensors[bmp_idx].bmp_temperature = data.temperature / 100.0;
-      bmp_sensors[bmp_idx].bmp_humidity = data.humidity / 1000.0;
-      bmp_sensors[bmp_idx].bmp_pressure = data.pressure / 100.0;
-      /* Avoid using measurements from an unstable heating setup */
-      if (data.status & BME680_GASM_VALID_MSK) {
-        bmp_sensors[bmp_idx].bmp_gas_resistance = data.gas_resistance / 1000.0;
-      } else {
-        bmp_sensors[bmp_idx].bmp_gas_resistance = 0;
-      }
-    }
+  /* Get the total measurement duration, 183 mSec with the heater settings above */
+  uint16_t meas_period;
+  bme680_get_profile_dur(&meas_period, &gas_sensor[bmp_idx]);
+  XsnsCollectIn(meas_period, bmp_idx);
+}
+
+void Bme680Collect(uint8_t bmp_idx)
+{
+  if (!gas_sensor) { return; }
+
+  struct bme680_field_data data;
+  if (BME680_OK != bme680_get_sensor_data(&data, &gas_sensor[bmp_idx])) { return; }
+
+  bmp_sensors[bmp_idx].bmp_temperature = data.temperature / 100.0;
+  bmp_sensors[bmp_idx].bmp_humidity = data.humidity / 1000.0;
+  bmp_sensors[bmp_idx].bmp_pressure = data.pressure / 100.0;
+  /* Avoid using measurements from an unstable heating setup */
+  if (data.status & BME680_GASM_VALID_MSK) {
+    bmp_sensors[bmp_idx].bmp_gas_resistance = data.gas_resistance / 1000.0;
+  } else {
+    bmp_sensors[bmp_idx].bmp_gas_resistance = 0;
   }
-  return;
 }
 
 #endif  // USE_BME680
@@ -513,6 +519,21 @@ void BmpRead(void)
   }
 }
 
+void BmpCollect(uint32_t bmp_idx)
+{
+  if (bmp_idx >= bmp_count) { return; }
+  switch (bmp_sensors[bmp_idx].bmp_type) {
+    case BMP180_CHIPID:
+      Bmp180Collect(bmp_idx);
+      break;
+#ifdef USE_BME680
+    case BME680_CHIPID:
+      Bme680Collect(bmp_idx);
+      break;
+#endif  // USE_BME680
+  }
+}
+
 void BmpShow(bool json)
 {
   for (uint32_t bmp_idx = 0; bmp_idx < bmp_count; bmp_idx++) {
@@ -630,6 +651,11 @@ void BMP_EnterSleep(void)
 
 bool Xsns09(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_10)) { return false; }
 
   bool result = false;
@@ -642,6 +668,9 @@ bool Xsns09(uint8_t function)
       case FUNC_EVERY_SECOND:
         BmpRead();
         break;
+      case FUNC_SENSOR_COLLECT:
+        BmpCollect(XdrvMailbox.index);
+        break;
       case FUNC_JSON_APPEND:
         BmpShow(1);
         break;
@@ -194,6 +194,11 @@ void Bh1750Show(bool json) {
 \*********************************************************************************************/
 
 bool Xsns10(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_11)) { return false; }
 
   bool result = false;
@@ -316,6 +316,11 @@ void Ina219Show(bool json)
 
 bool Xsns13(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_14)) { return false; }
 
   bool result = false;
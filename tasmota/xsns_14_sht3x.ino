@@ -39,17 +39,15 @@ uint8_t sht3x_addresses[] = { SHT3X_ADDR_GND, SHT3X_ADDR_VDD, SHTC3_ADDR };
 
 uint8_t sht3x_count = 0;
 struct SHT3XSTRUCT {
+  float temperature;
+  float humidity;
   uint8_t address;    // I2C bus address
+  bool valid;         // Last measurement succeeded
   char types[6];      // Sensor type name and address - "SHT3X-0xXX"
 } sht3x_sensors[SHT3X_MAX_SENSORS];
 
-bool Sht3xRead(float &t, float &h, uint8_t sht3x_address)
+bool Sht3xStart(uint8_t sht3x_address)
 {
-  unsigned int data[6];
-
-  t = NAN;
-  h = NAN;
-
   Wire.beginTransmission(sht3x_address);
   if (SHTC3_ADDR == sht3x_address) {
     Wire.write(0x35);                  // Wake from
@@ -62,11 +60,20 @@ bool Sht3xRead(float &t, float &h, uint8_t sht3x_address)
     Wire.write(0x2C);                  // Enable clock stretching
     Wire.write(0x06);                  // High repeatability
   }
-  if (Wire.endTransmission() != 0) {   // Stop I2C transmission
+  return (0 == Wire.endTransmission());  // Stop I2C transmission
+}
+
+// Result is ready 30ms after Sht3xStart() - Timing verified with logic analyzer (10 is to short)
+bool Sht3xGet(float &t, float &h, uint8_t sht3x_address)
+{
+  unsigned int data[6];
+
+  t = NAN;
+  h = NAN;
+
+  if (Wire.requestFrom(sht3x_address, (uint8_t)6) != 6) {  // Request 6 bytes of data
     return false;
   }
-  delay(30);                           // Timing verified with logic analyzer (10 is to short)
-  Wire.requestFrom(sht3x_address, (uint8_t)6);   // Request 6 bytes of data
   for (uint32_t i = 0; i < 6; i++) {
     data[i] = Wire.read();             // cTemp msb, cTemp lsb, cTemp crc, humidity msb, humidity lsb, humidity crc
   };
@@ -83,8 +90,13 @@ void Sht3xDetect(void)
     if (!I2cSetDevice(sht3x_addresses[i])) { continue; }
     float t;
     float h;
-    if (Sht3xRead(t, h, sht3x_addresses[i])) {
+    if (!Sht3xStart(sht3x_addresses[i])) { continue; }
+    delay(30);
+    if (Sht3xGet(t, h, sht3x_addresses[i])) {
       sht3x_sensors[sht3x_count].address = sht3x_addresses[i];
+      sht3x_sensors[sht3x_count].temperature = t;
+      sht3x_sensors[sht3x_count].humidity = h;
+      sht3x_sensors[sht3x_count].valid = true;
       GetTextIndexed(sht3x_sensors[sht3x_count].types, sizeof(sht3x_sensors[sht3x_count].types), i, kShtTypes);
       I2cSetActiveFound(sht3x_sensors[sht3x_count].address, sht3x_sensors[sht3x_count].types);
       sht3x_count++;
@@ -92,18 +104,39 @@ void Sht3xDetect(void)
   }
 }
 
+void Sht3xEverySecond(void)
+{
+  for (uint32_t i = 0; i < sht3x_count; i++) {
+    if (Sht3xStart(sht3x_sensors[i].address)) {
+      XsnsCollectIn(30, i);
+    } else {
+      sht3x_sensors[i].valid = false;
+    }
+  }
+}
+
+void Sht3xCollect(uint32_t index)
+{
+  if (index >= sht3x_count) { return; }
+  float t;
+  float h;
+  sht3x_sensors[index].valid = Sht3xGet(t, h, sht3x_sensors[index].address);
+  if (sht3x_sensors[index].valid) {
+    sht3x_sensors[index].temperature = t;
+    sht3x_sensors[index].humidity = h;
+  }
+}
+
 void Sht3xShow(bool json)
 {
   for (uint32_t i = 0; i < sht3x_count; i++) {
-    float t;
-    float h;
-    if (Sht3xRead(t, h, sht3x_sensors[i].address)) {
+    if (sht3x_sensors[i].valid) {
       char types[11];
       strlcpy(types, sht3x_sensors[i].types, sizeof(types));
       if (sht3x_count > 1) {
         snprintf_P(types, sizeof(types), PSTR("%s%c%02X"), sht3x_sensors[i].types, IndexSeparator(), sht3x_sensors[i].address);  // "SHT3X-0xXX"
       }
-      TempHumDewShow(json, ((0 == TasmotaGlobal.tele_period) && (0 == i)), types, t, h);
+      TempHumDewShow(json, ((0 == TasmotaGlobal.tele_period) && (0 == i)), types, sht3x_sensors[i].temperature, sht3x_sensors[i].humidity);
     }
   }
 }
@@ -114,6 +147,11 @@ void Sht3xShow(bool json)
 
 bool Xsns14(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_15)) { return false; }
 
   bool result = false;
@@ -123,6 +161,12 @@ bool Xsns14(uint8_t function)
   }
   else if (sht3x_count) {
     switch (function) {
+      case FUNC_EVERY_SECOND:
+        Sht3xEverySecond();
+        break;
+      case FUNC_SENSOR_COLLECT:
+        Sht3xCollect(XdrvMailbox.index);
+        break;
       case FUNC_JSON_APPEND:
         Sht3xShow(1);
         break;
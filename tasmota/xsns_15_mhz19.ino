@@ -364,6 +364,11 @@ void MhzShow(bool json)
 
 bool Xsns15(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (mhz_type) {
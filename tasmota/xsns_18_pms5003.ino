@@ -339,6 +339,11 @@ void PmsShow(bool json)
 
 bool Xsns18(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (Pms.type) {
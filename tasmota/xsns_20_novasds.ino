@@ -251,6 +251,11 @@ void NovaSdsShow(bool json)
 
 bool Xsns20(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (novasds_type) {
@@ -187,6 +187,11 @@ void Sr04Show(bool json)
 
 bool Xsns22(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = bit(TICK_SECOND);
+    return false;
+  }
+
   bool result = false;
 
   if (sr04_type) {
@@ -102,6 +102,11 @@ void LM75ADShow(bool json)
 
 bool Xsns26(uint8_t function)
 {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   if (!I2cEnabled(XI2C_20)) { return false; }
 
   bool result = false;
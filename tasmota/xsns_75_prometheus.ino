@@ -352,6 +352,11 @@ void HandleMetrics(void) {
 \*********************************************************************************************/
 
 bool Xsns75(uint8_t function) {
+  if (FUNC_TICK_MASK == function) {
+    XdrvMailbox.index = 0;            // No periodic tick needed
+    return false;
+  }
+
   bool result = false;
 
   switch (function) {
@@ -113,6 +113,9 @@ uint16_t scd40_CO2EAvg = 0;
 float scd40_Humid = 0.0;
 float scd40_Temp = 0.0;
 
+// Detection waits >500ms for the sensor after stopping measurements, split in steps run by Scd40DetectStep()
+enum { SCD40_DETECT_STOP, SCD40_DETECT_REINIT, SCD40_DETECT_START };
+
 void Scd40Detect(void)
 {
   if (!I2cSetDevice(SCD40_ADDRESS)) { return; }
@@ -120,34 +123,48 @@ void Scd40Detect(void)
   scd40.begin();
 
   // don't stop in case of error, try to continue
-  delay(10); // not sure whether this is needed
-  int error = scd40.forceStopPeriodicMeasurement();  // after reboot, stop (if any) periodic measurement, or reinit may not work
+  XsnsCollectIn(10, SCD40_DETECT_STOP); // not sure whether this is needed
+}
+
+void Scd40DetectStep(uint32_t step)
+{
+  int error;
+  switch (step) {
+    case SCD40_DETECT_STOP:
+      error = scd40.forceStopPeriodicMeasurement();  // after reboot, stop (if any) periodic measurement, or reinit may not work
 #ifdef SCD40_DEBUG
-  AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 force-stop error: %d"), error);
+      AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 force-stop error: %d"), error);
 #endif
-  delay(550); // wait >500ms after stopPeriodicMeasurement before SCD40 allows any other command
+      XsnsCollectIn(550, SCD40_DETECT_REINIT); // wait >500ms after stopPeriodicMeasurement before SCD40 allows any other command
+      break;
 
-  error = scd40.reinit(); // just in case
+    case SCD40_DETECT_REINIT:
+      error = scd40.reinit(); // just in case
 #ifdef SCD40_DEBUG
-  AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 reinit error: %d"), error);
+      AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 reinit error: %d"), error);
 #endif
-  delay(20); // not sure whether this is needed
+      XsnsCollectIn(20, SCD40_DETECT_START); // not sure whether this is needed
+      break;
 
-  uint16_t sn[3];
-  error = scd40.getSerialNumber(sn);
-  AddLog(LOG_LEVEL_NONE, PSTR("SCD40 serial nr 0x%X 0x%X 0x%X") ,sn[0], sn[1], sn[2]);
+    case SCD40_DETECT_START: {
+      uint16_t sn[3];
+      error = scd40.getSerialNumber(sn);
+      AddLog(LOG_LEVEL_NONE, PSTR("SCD40 serial nr 0x%X 0x%X 0x%X") ,sn[0], sn[1], sn[2]);
 
-  //  by default, start measurements, only register device if this succeeds
+      //  by default, start measurements, only register device if this succeeds
 #ifdef USE_SCD40_LOWPOWER
-  if (scd40.startLowPowerPeriodicMeasurement()) { return; }
+      if (scd40.startLowPowerPeriodicMeasurement()) { return; }
 #else
-  if (scd40.startPeriodicMeasurement()) { return; }
+      if (scd40.startPeriodicMeasurement()) { return; }
 #endif
-  I2cSetActiveFound(SCD40_ADDRESS, "SCD40");
-  scd40Found = true;
+      I2cSetActiveFound(SCD40_ADDRESS, "SCD40");
+      scd40Found = true;
 #ifdef SCD40_DEBUG
-  AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 found, measurements started."));
+      AddLog(LOG_LEVEL_DEBUG, PSTR("SCD40 found, measurements started."));
 #endif
+      break;
+    }
+  }
 }
 
 // gets data from the sensor
@@ -463,6 +480,9 @@ bool Xsns92(byte function)
   if (FUNC_INIT == function) {
     Scd40Detect();
   }
+  else if (FUNC_SENSOR_COLLECT == function) {
+    Scd40DetectStep(XdrvMailbox.index);
+  }
   else if (scd40Found) {
     switch (function) {
       case FUNC_EVERY_SECOND:
@@ -87,10 +87,37 @@ void Hdc2010Init(void)  {
   HDC2010.hdc_valid = 1;
 }
 
+#if defined(ESP32) && defined(USE_I2C_QUEUE) && ESP_IDF_VERSION_MAJOR > 3
+/**
+ * Temperature and humidity registers are adjacent, the queue merges both reads into one burst
+ */
+struct I2cQueueTxn Hdc2010Txn[2];
+
+void Hdc2010ReadDone(struct I2cQueueTxn *txn) {
+  if (txn->status) { return; }                      // Keep last values
+  uint16_t raw = (uint16_t)txn->rbuf[1] << 8 | txn->rbuf[0];
+  if (&Hdc2010Txn[0] == txn) {
+    HDC2010.hdc_temperature = (float)(raw) * 165 / 65536 - 40;
+  } else {
+    HDC2010.hdc_humidity = (float)(raw)/( 65536 )* 100;
+  }
+}
+#endif
+
 /**
  * Performs a temp and humidity read
  */
 void Hdc2010Read(void) {
+#if defined(ESP32) && defined(USE_I2C_QUEUE) && ESP_IDF_VERSION_MAJOR > 3
+  if (Hdc2010Txn[0].busy || Hdc2010Txn[1].busy) { return; }  // Previous read still queued
+  Hdc2010Txn[0].callback = &Hdc2010ReadDone;
+  Hdc2010Txn[1].callback = &Hdc2010ReadDone;
+  if (I2cQueueRead(&Hdc2010Txn[0], HDC2010_ADDR, HDC2010_REG_TEMP_LSB, 2, 0, I2C_QUEUE_BURST)) {
+    I2cQueueRead(&Hdc2010Txn[1], HDC2010_ADDR, HDC2010_REG_RH_LSB, 2, 0, I2C_QUEUE_BURST);
+    return;
+  }
+  // No queue, read synchronously
+#endif
   uint8_t byte[2];
 	uint16_t temp;
   uint16_t humidity;
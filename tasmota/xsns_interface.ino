@@ -1090,6 +1090,77 @@ void XsnsSensorState(uint32_t sensor_list) {
   ResponseAppend_P(PSTR("\""));
 }
 
+/*********************************************************************************************\
+ * Split-phase sensor read
+ *
+ * Instead of waiting for a conversion a driver starts it and calls XsnsCollectIn(ms, tag).
+ * Once ms have elapsed it is called from the main loop with FUNC_SENSOR_COLLECT and
+ * XdrvMailbox.index = tag to read the result. The conversions of all sensors run at the same
+ * time and the bus transactions of the drivers are interleaved with the rest of the loop.
+\*********************************************************************************************/
+
+#define XSNS_COLLECT_MAX    16
+
+struct {
+  uint32_t due[XSNS_COLLECT_MAX];
+  uint8_t sensor[XSNS_COLLECT_MAX];   // Index in xsns_func_ptr
+  uint8_t tag[XSNS_COLLECT_MAX];      // Driver defined, passed in XdrvMailbox.index
+  uint8_t count = 0;
+  uint8_t current = 0xFF;             // Sensor being called, owner of new requests
+} XsnsCollect;
+
+void XsnsCollectCall(uint32_t sensor, uint32_t tag) {
+  uint32_t index_save = XdrvMailbox.index;
+  uint8_t current_save = XsnsCollect.current;
+  XsnsCollect.current = sensor;
+  XdrvMailbox.index = tag;
+  xsns_func_ptr[sensor](FUNC_SENSOR_COLLECT);
+  XdrvMailbox.index = index_save;
+  XsnsCollect.current = current_save;
+}
+
+// Call the current sensor with FUNC_SENSOR_COLLECT and index tag in ms milliseconds.
+// A pending request with the same tag is moved. When the queue is full this waits for ms.
+void XsnsCollectIn(uint32_t ms, uint32_t tag) {
+  uint32_t sensor = XsnsCollect.current;
+  if (sensor >= xsns_present) { return; }
+  uint32_t i;
+  for (i = 0; i < XsnsCollect.count; i++) {
+    if ((XsnsCollect.sensor[i] == sensor) && (XsnsCollect.tag[i] == tag)) { break; }
+  }
+  if (i == XsnsCollect.count) {
+    if (XSNS_COLLECT_MAX == XsnsCollect.count) {
+      delay(ms);
+      XsnsCollectCall(sensor, tag);
+      return;
+    }
+    XsnsCollect.count++;
+  }
+  XsnsCollect.due[i] = millis() + ms;
+  XsnsCollect.sensor[i] = sensor;
+  XsnsCollect.tag[i] = tag;
+}
+
+// Called from the main loop, collect the results of finished conversions
+void XsnsCollectLoop(void) {
+  uint32_t i = 0;
+  while (i < XsnsCollect.count) {
+    if (!TimeReached(XsnsCollect.due[i])) {
+      i++;
+      continue;
+    }
+    uint32_t sensor = XsnsCollect.sensor[i];
+    uint32_t tag = XsnsCollect.tag[i];
+    XsnsCollect.count--;                // Remove first, the driver may start a new conversion
+    XsnsCollect.due[i] = XsnsCollect.due[XsnsCollect.count];
+    XsnsCollect.sensor[i] = XsnsCollect.sensor[XsnsCollect.count];
+    XsnsCollect.tag[i] = XsnsCollect.tag[XsnsCollect.count];
+    if (XsnsEnabled(0, sensor)) {
+      XsnsCollectCall(sensor, tag);
+    }
+  }
+}
+
 /*********************************************************************************************\
  * Function call to all xsns
 \*********************************************************************************************/
@@ -1108,7 +1179,10 @@ bool XsnsNextCall(uint8_t Function, uint8_t &xsns_index) {
     if (xsns_index == xsns_present) { xsns_index = 0; }
   }
 
-  return xsns_func_ptr[xsns_index](Function);
+  XsnsCollect.current = xsns_index;
+  bool result = xsns_func_ptr[xsns_index](Function);
+  XsnsCollect.current = 0xFF;
+  return result;
 }
 
 bool XsnsCall(uint8_t Function) {
@@ -1123,8 +1197,19 @@ bool XsnsCall(uint8_t Function) {
       if ((FUNC_WEB_SENSOR == Function) && !XsnsEnabled(1, x)) { continue; }  // Skip web info for disabled sensors
 
       uint32_t profile_function_start = millis();
+      PROFILE_STATS_START(profile_stats_start);
 
+      XsnsCollect.current = x;
       result = xsns_func_ptr[x](Function);
+      XsnsCollect.current = 0xFF;
+
+#ifdef USE_PROFILE_STATS
+#ifdef XFUNC_PTR_IN_ROM
+      PROFILE_STATS(PRF_SNS, pgm_read_byte(kXsnsList + x), Function, nullptr, profile_stats_start);
+#else
+      PROFILE_STATS(PRF_SNS, kXsnsList[x], Function, nullptr, profile_stats_start);
+#endif
+#endif  // USE_PROFILE_STATS
 
 #ifdef USE_PROFILE_FUNCTION
 #ifdef XFUNC_PTR_IN_ROM
@@ -1148,3 +1233,61 @@ bool XsnsCall(uint8_t Function) {
 
   return result;
 }
+
+/*********************************************************************************************\
+ * Periodic tick call to xsns having registered for it, see XdrvTickCall
+\*********************************************************************************************/
+
+struct {
+  uint8_t mask[xsns_present];
+  bool ready = false;
+} XsnsTicks;
+
+void XsnsTickMaskInit(void) {
+  uint32_t index_save = XdrvMailbox.index;
+  for (uint32_t x = 0; x < xsns_present; x++) {
+    XdrvMailbox.index = TICK_MASK_ALL;
+    xsns_func_ptr[x](FUNC_TICK_MASK);
+    XsnsTicks.mask[x] = XdrvMailbox.index & TICK_MASK_ALL;
+  }
+  XdrvMailbox.index = index_save;
+  XsnsTicks.ready = true;
+}
+
+void XsnsTickCall(uint32_t tick) {
+  if (!XsnsTicks.ready) { XsnsTickMaskInit(); }
+
+  uint8_t Function = pgm_read_byte(kTickFunctions + tick);
+  uint32_t profile_driver_start = millis();
+
+  for (uint32_t x = 0; x < xsns_present; x++) {
+    if (!bitRead(XsnsTicks.mask[x], tick)) { continue; }
+    if (!XsnsEnabled(0, x)) { continue; }  // Skip disabled sensor
+
+    uint32_t profile_function_start = millis();
+    PROFILE_STATS_START(profile_stats_start);
+
+    XsnsCollect.current = x;
+    xsns_func_ptr[x](Function);
+    XsnsCollect.current = 0xFF;
+
+#ifdef USE_PROFILE_STATS
+#ifdef XFUNC_PTR_IN_ROM
+    PROFILE_STATS(PRF_SNS, pgm_read_byte(kXsnsList + x), Function, nullptr, profile_stats_start);
+#else
+    PROFILE_STATS(PRF_SNS, kXsnsList[x], Function, nullptr, profile_stats_start);
+#endif
+#endif  // USE_PROFILE_STATS
+
+#ifdef USE_PROFILE_FUNCTION
+#ifdef XFUNC_PTR_IN_ROM
+    uint32_t index = pgm_read_byte(kXsnsList + x);
+#else
+    uint32_t index = kXsnsList[x];
+#endif
+    PROFILE_FUNCTION("sns", index, Function, profile_function_start);
+#endif  // USE_PROFILE_FUNCTION
+  }
+
+  PROFILE_DRIVER("sns", Function, profile_driver_start);
+}